@@ -249,6 +249,334 @@ palStatus_t pal_sendTo(palSocket_t socket, const void* buffer, size_t length, co
 }
 
 
+palStatus_t pal_sendToMulti(palSocket_t socket, palDatagram_t* datagrams, uint32_t count, uint32_t* datagramsSent)
+{
+    palStatus_t result = PAL_SUCCESS;
+    uint32_t index = 0;
+
+    if ((NULL == datagrams) || (0 == count) || (NULL == datagramsSent))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    for (index = 0; index < count; ++index)
+    {
+        if ((NULL == datagrams[index].buffer) || (NULL == datagrams[index].address))
+        {
+            return PAL_ERR_RTOS_PARAMETER;
+        }
+    }
+    *datagramsSent = 0;
+    result = pal_plat_sendToMulti(socket, datagrams, count, datagramsSent);
+    return result;
+}
+
+
+palStatus_t pal_receiveFromMulti(palSocket_t socket, palDatagram_t* datagrams, uint32_t count, uint32_t* datagramsReceived)
+{
+    palStatus_t result = PAL_SUCCESS;
+    uint32_t index = 0;
+
+    if ((NULL == datagrams) || (0 == count) || (NULL == datagramsReceived))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    for (index = 0; index < count; ++index)
+    {
+        if (NULL == datagrams[index].buffer)
+        {
+            return PAL_ERR_RTOS_PARAMETER;
+        }
+    }
+    *datagramsReceived = 0;
+    result = pal_plat_receiveFromMulti(socket, datagrams, count, datagramsReceived);
+    return result;
+}
+
+
+//! \return true if the segments can be passed to a scatter / gather call of the platform, receive segments are checked by their maxBufferLength.
+PAL_PRIVATE bool pal_segmentsValid(const palConstBuffer_t* segments, uint32_t segmentCount, bool receive)
+{
+    uint32_t index = 0;
+
+    if ((NULL == segments) || (0 == segmentCount) || (PAL_NET_MAX_SEGMENTS < segmentCount))
+    {
+        return false;
+    }
+    for (index = 0; index < segmentCount; ++index)
+    {
+        if ((NULL == segments[index].buffer) && (0 != (receive ? segments[index].maxBufferLength : segments[index].bufferLength)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! Sets the bufferLength of each receive segment, the platform filled them in order.
+PAL_PRIVATE void pal_segmentsReceived(palBuffer_t* segments, uint32_t segmentCount, size_t received)
+{
+    uint32_t index = 0;
+
+    for (index = 0; index < segmentCount; ++index)
+    {
+        segments[index].bufferLength = (received < segments[index].maxBufferLength) ? (uint32_t)received : segments[index].maxBufferLength;
+        received -= segments[index].bufferLength;
+    }
+}
+
+
+palStatus_t pal_sendTov(palSocket_t socket, const palConstBuffer_t* segments, uint32_t segmentCount, const palSocketAddress_t* to, palSocketLength_t toLength, size_t* bytesSent)
+{
+    palStatus_t result = PAL_SUCCESS;
+    if (!pal_segmentsValid(segments, segmentCount, false) || (NULL == bytesSent) || (NULL == to))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    result = pal_plat_sendTov(socket, segments, segmentCount, to, toLength, bytesSent);
+    return result;
+}
+
+
+palStatus_t pal_receiveFromv(palSocket_t socket, palBuffer_t* segments, uint32_t segmentCount, palSocketAddress_t* from, palSocketLength_t* fromLength, size_t* bytesReceived)
+{
+    palStatus_t result = PAL_SUCCESS;
+    if (!pal_segmentsValid((const palConstBuffer_t*)segments, segmentCount, true) || (NULL == bytesReceived))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    result = pal_plat_receiveFromv(socket, segments, segmentCount, from, fromLength, bytesReceived);
+    if (PAL_SUCCESS == result)
+    {
+        pal_segmentsReceived(segments, segmentCount, *bytesReceived);
+    }
+    return result;
+}
+
+
+palStatus_t pal_netBufAlloc(palMemoryPoolID_t pool, uint32_t headroom, palNetBuf_t** netBuf)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palMemoryPoolStats_t stats;
+    palNetBuf_t* buffer = NULL;
+
+    if ((NULLPTR == pool) || (NULL == netBuf))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    result = pal_osPoolGetStats(pool, &stats);
+    if (PAL_SUCCESS != result)
+    {
+        return result;
+    }
+    if ((stats.blockSize <= PAL_NET_BUF_HEADER_SIZE) || ((stats.blockSize - PAL_NET_BUF_HEADER_SIZE) < headroom))
+    {
+        return PAL_ERR_BUFFER_TOO_SMALL;
+    }
+
+    buffer = (palNetBuf_t*)pal_osPoolAlloc(pool);
+    if (NULL == buffer)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+    buffer->next = NULL;
+    buffer->pool = pool;
+    buffer->refCount = 1;
+    buffer->size = stats.blockSize - PAL_NET_BUF_HEADER_SIZE;
+    buffer->offset = headroom;
+    buffer->length = 0;
+    *netBuf = buffer;
+    return PAL_SUCCESS;
+}
+
+
+palStatus_t pal_netBufRef(palNetBuf_t* netBuf)
+{
+    if (NULL == netBuf)
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    pal_osAtomicFetchAdd32(&netBuf->refCount, 1, PAL_MEMORY_ORDER_RELAXED);
+    return PAL_SUCCESS;
+}
+
+
+palStatus_t pal_netBufFree(palNetBuf_t** netBuf)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palNetBuf_t* buffer = NULL;
+    palNetBuf_t* next = NULL;
+
+    if ((NULL == netBuf) || (NULL == *netBuf))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+
+    buffer = *netBuf;
+    *netBuf = NULL;
+    //! the release orders the writes of this owner before the free, the acquire of the last owner sees all of them.
+    while ((NULL != buffer) && (1 == pal_osAtomicFetchSub32(&buffer->refCount, 1, PAL_MEMORY_ORDER_ACQ_REL)))
+    {
+        next = buffer->next;
+        result = pal_osPoolFree(buffer->pool, buffer);
+        if (PAL_SUCCESS != result)
+        {
+            break;
+        }
+        buffer = next;
+    }
+    return result;
+}
+
+
+palStatus_t pal_netBufChain(palNetBuf_t* head, palNetBuf_t* tail)
+{
+    if ((NULL == head) || (NULL == tail) || (head == tail))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    while (NULL != head->next)
+    {
+        head = head->next;
+    }
+    head->next = tail;
+    return PAL_SUCCESS;
+}
+
+
+uint8_t* pal_netBufData(const palNetBuf_t* netBuf)
+{
+    return (uint8_t*)netBuf + PAL_NET_BUF_HEADER_SIZE + netBuf->offset;
+}
+
+
+size_t pal_netBufChainLength(const palNetBuf_t* netBuf)
+{
+    size_t length = 0;
+
+    for (; NULL != netBuf; netBuf = netBuf->next)
+    {
+        length += netBuf->length;
+    }
+    return length;
+}
+
+
+palStatus_t pal_netBufPrepend(palNetBuf_t* netBuf, uint32_t length, uint8_t** header)
+{
+    if ((NULL == netBuf) || (NULL == header))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    if (netBuf->offset < length)
+    {
+        return PAL_ERR_BUFFER_TOO_SMALL;
+    }
+    netBuf->offset -= length;
+    netBuf->length += length;
+    *header = pal_netBufData(netBuf);
+    return PAL_SUCCESS;
+}
+
+
+palStatus_t pal_netBufAppend(palNetBuf_t* netBuf, uint32_t length, uint8_t** data)
+{
+    if ((NULL == netBuf) || (NULL == data))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    if ((netBuf->size - netBuf->offset - netBuf->length) < length)
+    {
+        return PAL_ERR_BUFFER_TOO_SMALL;
+    }
+    *data = pal_netBufData(netBuf) + netBuf->length;
+    netBuf->length += length;
+    return PAL_SUCCESS;
+}
+
+
+palStatus_t pal_netBufConsume(palNetBuf_t* netBuf, uint32_t length)
+{
+    if ((NULL == netBuf) || (netBuf->length < length))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    netBuf->offset += length;
+    netBuf->length -= length;
+    return PAL_SUCCESS;
+}
+
+
+//! Describes up to PAL_NET_MAX_SEGMENTS buffers of a chain as send segments.
+//! \return the number of segments, *rest is set to the first buffer which was left out (NULL after the whole chain).
+PAL_PRIVATE uint32_t pal_netBufSegments(const palNetBuf_t* netBuf, palBuffer_t* segments, size_t* length, const palNetBuf_t** rest)
+{
+    uint32_t count = 0;
+
+    *length = 0;
+    for (; (NULL != netBuf) && (count < PAL_NET_MAX_SEGMENTS); netBuf = netBuf->next)
+    {
+        segments[count].maxBufferLength = netBuf->length;
+        segments[count].bufferLength = netBuf->length;
+        segments[count].buffer = pal_netBufData(netBuf);
+        *length += netBuf->length;
+        ++count;
+    }
+    *rest = netBuf;
+    return count;
+}
+
+
+palStatus_t pal_netBufReceiveFrom(palSocket_t socket, palMemoryPoolID_t pool, uint32_t headroom, palSocketAddress_t* from, palSocketLength_t* fromLength, palNetBuf_t** netBuf)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palNetBuf_t* buffer = NULL;
+    size_t bytesReceived = 0;
+
+    if (NULL == netBuf)
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    result = pal_netBufAlloc(pool, headroom, &buffer);
+    if (PAL_SUCCESS != result)
+    {
+        return result;
+    }
+
+    result = pal_plat_receiveFrom(socket, pal_netBufData(buffer), buffer->size - buffer->offset, from, fromLength, &bytesReceived);
+    if (PAL_SUCCESS != result)
+    {
+        pal_netBufFree(&buffer);
+        return result;
+    }
+    buffer->length = (uint32_t)bytesReceived;
+    *netBuf = buffer;
+    return PAL_SUCCESS;
+}
+
+
+palStatus_t pal_netBufSendTo(palSocket_t socket, const palNetBuf_t* netBuf, const palSocketAddress_t* to, palSocketLength_t toLength, size_t* bytesSent)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palBuffer_t segments[PAL_NET_MAX_SEGMENTS];
+    const palNetBuf_t* rest = NULL;
+    uint32_t segmentCount = 0;
+    size_t length = 0;
+
+    if ((NULL == netBuf) || (NULL == to) || (NULL == bytesSent))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    segmentCount = pal_netBufSegments(netBuf, segments, &length, &rest);
+    if (NULL != rest)
+    {
+        return PAL_ERR_RTOS_PARAMETER; // a datagram has to leave in one call.
+    }
+    //! palBuffer_t and palConstBuffer_t have the same layout.
+    result = pal_plat_sendTov(socket, (const palConstBuffer_t*)segments, segmentCount, to, toLength, bytesSent);
+    return result;
+}
+
+
 palStatus_t pal_close(palSocket_t* socket)
 {
     palStatus_t result = PAL_SUCCESS;
@@ -290,12 +618,106 @@ palStatus_t pal_socketMiniSelect(const palSocket_t socketsToCheck[PAL_NET_SOCKET
     pal_timeVal_t* timeout, uint8_t palSocketStatus[PAL_NET_SOCKET_SELECT_MAX_SOCKETS], uint32_t * numberOfSocketsSet)
 {
     palStatus_t result = PAL_SUCCESS;
-    if ((NULL == socketsToCheck) || (NULL == numberOfSocketsSet) || (PAL_NET_SOCKET_SELECT_MAX_SOCKETS < numberOfSockets))
+    result = pal_socketMiniSelectInterest(socketsToCheck, numberOfSockets, timeout, PAL_NET_SOCKET_SELECT_RX_BIT | PAL_NET_SOCKET_SELECT_TX_BIT,
+                                          palSocketStatus, numberOfSocketsSet);
+    return result;
+}
+
+
+palStatus_t pal_socketMiniSelectInterest(const palSocket_t socketsToCheck[PAL_NET_SOCKET_SELECT_MAX_SOCKETS], uint32_t numberOfSockets,
+    pal_timeVal_t* timeout, uint8_t interestMask, uint8_t palSocketStatus[PAL_NET_SOCKET_SELECT_MAX_SOCKETS], uint32_t * numberOfSocketsSet)
+{
+    palStatus_t result = PAL_SUCCESS;
+    uint64_t timeoutMilliSec = 0;
+
+    if ((NULL == socketsToCheck) || (NULL == palSocketStatus) || (NULL == numberOfSocketsSet) || (NULL == timeout) || (PAL_NET_SOCKET_SELECT_MAX_SOCKETS < numberOfSockets))
     {
         return PAL_ERR_RTOS_PARAMETER;
     }
-    result = pal_plat_socketMiniSelect(socketsToCheck, numberOfSockets, timeout, palSocketStatus, numberOfSocketsSet);
-    return result; // TODO(nirson01) ADD debug print for error propagation(once debug print infrastructure is finalized)
+    if ((0 > timeout->pal_tv_sec) || (0 > timeout->pal_tv_usec) || (1000000 <= timeout->pal_tv_usec))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    //! a timeout the milliseconds count can not hold waits forever.
+    timeoutMilliSec = ((uint64_t)timeout->pal_tv_sec * 1000) + ((uint64_t)timeout->pal_tv_usec / 1000);
+    if (PAL_RTOS_WAIT_FOREVER < timeoutMilliSec)
+    {
+        timeoutMilliSec = PAL_RTOS_WAIT_FOREVER;
+    }
+    result = pal_plat_socketMiniSelect(socketsToCheck, numberOfSockets, (uint32_t)timeoutMilliSec, interestMask, palSocketStatus, numberOfSocketsSet);
+    return result;
+}
+
+
+palStatus_t pal_socketPollerCreate(palSocketPollerID_t* poller)
+{
+    palStatus_t result = PAL_SUCCESS;
+    if (NULL == poller)
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    result = pal_plat_socketPollerCreate(poller);
+    return result;
+}
+
+
+palStatus_t pal_socketPollerDestroy(palSocketPollerID_t* poller)
+{
+    palStatus_t result = PAL_SUCCESS;
+    if ((NULL == poller) || (NULLPTR == *poller))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    result = pal_plat_socketPollerDestroy(poller);
+    return result;
+}
+
+
+palStatus_t pal_socketPollerAdd(palSocketPollerID_t poller, palSocket_t socket, uint8_t interestMask)
+{
+    palStatus_t result = PAL_SUCCESS;
+    if (NULLPTR == poller)
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    result = pal_plat_socketPollerAdd(poller, socket, interestMask);
+    return result;
+}
+
+
+palStatus_t pal_socketPollerModify(palSocketPollerID_t poller, palSocket_t socket, uint8_t interestMask)
+{
+    palStatus_t result = PAL_SUCCESS;
+    if (NULLPTR == poller)
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    result = pal_plat_socketPollerModify(poller, socket, interestMask);
+    return result;
+}
+
+
+palStatus_t pal_socketPollerRemove(palSocketPollerID_t poller, palSocket_t socket)
+{
+    palStatus_t result = PAL_SUCCESS;
+    if (NULLPTR == poller)
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    result = pal_plat_socketPollerRemove(poller, socket);
+    return result;
+}
+
+
+palStatus_t pal_socketPollerWait(palSocketPollerID_t poller, palSocketPollEvent_t* events, uint32_t maxEvents, uint32_t timeout, uint32_t* numberOfEvents)
+{
+    palStatus_t result = PAL_SUCCESS;
+    if ((NULLPTR == poller) || (NULL == events) || (0 == maxEvents) || (NULL == numberOfEvents))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    result = pal_plat_socketPollerWait(poller, events, maxEvents, timeout, numberOfEvents);
+    return result;
 }
 
 
@@ -357,6 +779,97 @@ palStatus_t pal_send(palSocket_t socket, const void* buf, size_t len, size_t* se
 }
 
 
+palStatus_t pal_sendv(palSocket_t socket, const palConstBuffer_t* segments, uint32_t segmentCount, size_t* sentDataSize)
+{
+    palStatus_t result = PAL_SUCCESS;
+    if (!pal_segmentsValid(segments, segmentCount, false) || (NULL == sentDataSize))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    result = pal_plat_sendv(socket, segments, segmentCount, sentDataSize);
+    return result;
+}
+
+
+palStatus_t pal_recvv(palSocket_t socket, palBuffer_t* segments, uint32_t segmentCount, size_t* recievedDataSize)
+{
+    palStatus_t result = PAL_SUCCESS;
+    if (!pal_segmentsValid((const palConstBuffer_t*)segments, segmentCount, true) || (NULL == recievedDataSize))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    result = pal_plat_recvv(socket, segments, segmentCount, recievedDataSize);
+    if (PAL_SUCCESS == result)
+    {
+        pal_segmentsReceived(segments, segmentCount, *recievedDataSize);
+    }
+    return result;
+}
+
+
+palStatus_t pal_netBufRecv(palSocket_t socket, palMemoryPoolID_t pool, uint32_t headroom, palNetBuf_t** netBuf)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palNetBuf_t* buffer = NULL;
+    size_t recievedDataSize = 0;
+
+    if (NULL == netBuf)
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    result = pal_netBufAlloc(pool, headroom, &buffer);
+    if (PAL_SUCCESS != result)
+    {
+        return result;
+    }
+
+    result = pal_plat_recv(socket, pal_netBufData(buffer), buffer->size - buffer->offset, &recievedDataSize);
+    if (PAL_SUCCESS != result)
+    {
+        pal_netBufFree(&buffer);
+        return result;
+    }
+    buffer->length = (uint32_t)recievedDataSize;
+    *netBuf = buffer;
+    return PAL_SUCCESS;
+}
+
+
+palStatus_t pal_netBufSend(palSocket_t socket, const palNetBuf_t* netBuf, size_t* sentDataSize)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palBuffer_t segments[PAL_NET_MAX_SEGMENTS];
+    uint32_t segmentCount = 0;
+    size_t length = 0;
+    size_t sent = 0;
+    size_t total = 0;
+
+    if ((NULL == netBuf) || (NULL == sentDataSize))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+
+    //! a long chain is sent PAL_NET_MAX_SEGMENTS buffers at a time, until the socket takes less than offered.
+    while (NULL != netBuf)
+    {
+        segmentCount = pal_netBufSegments(netBuf, segments, &length, &netBuf);
+        result = pal_plat_sendv(socket, (const palConstBuffer_t*)segments, segmentCount, &sent);
+        if (PAL_SUCCESS != result)
+        {
+            break;
+        }
+        total += sent;
+        if (sent < length)
+        {
+            break;
+        }
+    }
+
+    *sentDataSize = total;
+    return (0 < total) ? PAL_SUCCESS : result;
+}
+
+
 #endif //PAL_NET_TCP_AND_TLS_SUPPORT
 
 
@@ -373,6 +886,19 @@ palStatus_t pal_asynchronousSocket(palSocketDomain_t domain, palSocketType_t typ
     return result; // TODO(nirson01) ADD debug print for error propagation(once debug print infrastructure is finalized)
 }
 
+
+palStatus_t pal_asynchronousSocketWithContext(palSocketDomain_t domain, palSocketType_t type, bool nonBlockingSocket, uint32_t interfaceNum, palAsyncSocketContextCallback_t callback, void* context,
+                                              palMessageQID_t deferralQueue, palSocket_t* socket)
+{
+    palStatus_t result = PAL_SUCCESS;
+    if ((NULL == socket) || (NULL == callback))
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+    result = pal_plat_asynchronousSocketWithContext(domain, type, nonBlockingSocket, interfaceNum, callback, context, deferralQueue, socket);
+    return result;
+}
+
 #endif
 
 #if PAL_NET_DNS_SUPPORT
@@ -17,11 +17,7 @@
 
 #include "pal_rtos.h"
 #include "pal_plat_rtos.h"
-
-#if PAL_UNIQUE_THREAD_PRIORITY
-//! Threads priorities array.
-uint8_t g_palThreadPriorities[PAL_MAX_NUMBER_OF_THREADS] = {0};
-#endif //PAL_UNIQUE_THREAD_PRIORITY
+#include <string.h>
 
 void pal_osReboot(void)
 {
@@ -36,6 +32,39 @@ uint32_t pal_osKernelSysTick(void)
 }
 
 
+//! The 64 bit tick is extended from a 32 bit tick with a single 32 bit state word, so any thread or interrupt can update it
+//! with a compare and swap: the high bits count the wraparounds of the tick and the low PAL_TICK_STATE_TOP_BITS bits hold the
+//! top bits of the last tick seen. A tick whose top bits are lower than those has wrapped around since, so the state must
+//! be updated at least once every 15/16 of the tick wraparound period.
+#define PAL_TICK_STATE_TOP_BITS     4
+#define PAL_TICK_STATE_TOP_MASK     ((1U << PAL_TICK_STATE_TOP_BITS) - 1)
+#if !PAL_RTOS_64BIT_TICK_SUPPORTED
+PAL_PRIVATE uint32_t s_palTickState = 0;
+#endif //!PAL_RTOS_64BIT_TICK_SUPPORTED
+
+uint64_t pal_osKernelSysTickExtend(uint32_t* state, palTickFuncPtr tickFunction)
+{
+    uint32_t oldState = 0;
+    uint32_t newState = 0;
+    uint32_t tick = 0;
+    uint32_t wraparounds = 0;
+
+    do
+    {
+        //! the state is read before the tick, so the tick is never older than the tick the state was made from.
+        oldState = pal_plat_osAtomicLoad32(state, PAL_MEMORY_ORDER_ACQUIRE);
+        tick = tickFunction();
+        wraparounds = oldState >> PAL_TICK_STATE_TOP_BITS;
+        if ((tick >> (32 - PAL_TICK_STATE_TOP_BITS)) < (oldState & PAL_TICK_STATE_TOP_MASK))
+        {
+            wraparounds++;
+        }
+        newState = (wraparounds << PAL_TICK_STATE_TOP_BITS) | (tick >> (32 - PAL_TICK_STATE_TOP_BITS));
+    } while ((newState != oldState) && !pal_plat_osAtomicCompareAndSwap32(state, &oldState, newState, PAL_MEMORY_ORDER_ACQ_REL));
+
+    return ((uint64_t)wraparounds << 32) | tick;
+}
+
 uint64_t pal_osKernelSysTick64(void)
 {
 
@@ -44,17 +73,7 @@ uint64_t pal_osKernelSysTick64(void)
     result = pal_plat_osKernelSysTick64();
     return result;
 #else
-    static uint64_t lastValue = 0;
-    static uint64_t wraparoundsDetected = 0;
-    const uint64_t one = 1;
-    uint64_t tmp = pal_plat_osKernelSysTick() + (wraparoundsDetected << 32);
-    if (tmp < lastValue) //erez's "wraparound algorithm" if we detect a wrap around add 1 to the higher 32 bits
-    {
-        tmp = tmp + (one << 32);
-        wraparoundsDetected++;
-    }
-    lastValue = tmp;
-    return (uint64_t)tmp;
+    return pal_osKernelSysTickExtend(&s_palTickState, pal_osKernelSysTick);
 #endif
 }
 
@@ -79,28 +98,34 @@ uint64_t pal_osKernelSysTickFrequency(void)
     return result;
 }
 
-palStatus_t pal_osThreadCreate(palThreadFuncPtr function, void* funcArgument, palThreadPriority_t priority, uint32_t stackSize, uint32_t* stackPtr, palThreadLocalStore_t* store, palThreadID_t* threadID)
+#if PAL_THREAD_STACK_PAINT
+//! Paint the stack down from its top to the first word which holds the paint already: a stack from the pool is painted, and
+//! a stack which ran a thread before is painted as deep as that thread reached (a word it wrote with the pattern's value,
+//! or left unwritten, stops the paint early and makes the high water mark of the next thread err on the high side).
+PAL_PRIVATE void palThreadStackPaint(uint32_t* stackPtr, uint32_t stackSize)
 {
-    palStatus_t status = PAL_SUCCESS;
+    uint32_t i = stackSize / sizeof(uint32_t);
 
-#if PAL_UNIQUE_THREAD_PRIORITY
-    //! check if the priority have been used by other thread before
-    if(PAL_osPriorityError == priority)
+    while ((i > 0) && (PAL_THREAD_STACK_PAINT_PATTERN != stackPtr[i - 1]))
     {
-        status = PAL_ERR_INVALID_ARGUMENT;
+        stackPtr[--i] = PAL_THREAD_STACK_PAINT_PATTERN;
     }
+}
+#endif //PAL_THREAD_STACK_PAINT
+
+palStatus_t pal_osThreadCreate(palThreadFuncPtr function, void* funcArgument, palThreadPriority_t priority, uint32_t stackSize, uint32_t* stackPtr, palThreadLocalStore_t* store, palThreadID_t* threadID)
+{
+    palStatus_t status = PAL_SUCCESS;
 
-    if ((PAL_SUCCESS == status) && (g_palThreadPriorities[priority+PRIORITY_INDEX_OFFSET]))
+    if (NULL == threadID || NULL == function || 0 == stackSize || NULL == stackPtr || priority < PAL_osPriorityIdle || priority > PAL_osPriorityRealtime)
     {
-        *threadID = NULLPTR;
-        status = PAL_ERR_RTOS_PRIORITY;
+        return PAL_ERR_INVALID_ARGUMENT; //! checked before the stack is painted, the stack of a rejected call may not be as large as told.
     }
-#endif //PAL_IGNORE_UNIQUE_THREAD_PRIORITY
 
-    if (PAL_SUCCESS == status)
-    {
-        status = pal_plat_osThreadCreate(function, funcArgument, priority, stackSize, stackPtr, store, threadID);
-    }       
+#if PAL_THREAD_STACK_PAINT
+    palThreadStackPaint(stackPtr, stackSize);
+#endif //PAL_THREAD_STACK_PAINT
+    status = pal_plat_osThreadCreate(function, funcArgument, priority, stackSize, stackPtr, store, threadID);
     return status;
 }
 
@@ -126,6 +151,13 @@ palThreadLocalStore_t*  pal_osThreadGetLocalStore(void)
     return result;
 }
 
+palStatus_t pal_osThreadGetStats(palThreadID_t threadID, palThreadStats_t* stats)
+{
+    palStatus_t status;
+    status = pal_plat_osThreadGetStats(threadID, stats);
+    return status;
+}
+
 palStatus_t pal_osDelay(uint32_t milliseconds)
 {
     palStatus_t status;
@@ -162,157 +194,4178 @@ palStatus_t pal_osTimerDelete(palTimerID_t* timerID)
     return status;
 }
 
-palStatus_t pal_osMutexCreate(palMutexID_t* mutexID)
+//! Links of a wheel timer in a wheel slot (or in the expired list), next is NULL while the timer does not run.
+typedef struct palWheelTimerLink{
+    struct palWheelTimerLink*   next;
+    struct palWheelTimerLink*   prev;
+} palWheelTimerLink_t;
+
+typedef struct palWheelTimer{
+    palWheelTimerLink_t     link;           //! must be first, a link taken from a slot is its timer.
+    uint64_t                expires;        //! the wheel tick the timer expires on.
+    uint32_t                period;         //! the timer period in wheel ticks.
+    palTimerType_t          timerType;
+    palTimerFuncPtr         function;
+    void*                   funcArgument;
+} palWheelTimer_t;
+
+#define PAL_TIMER_WHEEL_SLOTS       (1U << PAL_TIMER_WHEEL_SLOT_BITS)
+#define PAL_TIMER_WHEEL_SLOT_MASK   (PAL_TIMER_WHEEL_SLOTS - 1)
+//! the ticks spanned by the wheel, a timer further away waits in the top level and is cascaded again until it is in range.
+#define PAL_TIMER_WHEEL_RANGE       (1ULL << (PAL_TIMER_WHEEL_SLOT_BITS * PAL_TIMER_WHEEL_LEVELS))
+
+/*! Hierarchical timer wheel: slots[0] holds the timers of the next 2^bits ticks one tick per slot, and every level above holds
+*   2^bits times longer periods per slot. When a level wraps around, the next slot of the level above is cascaded down.
+*/
+typedef struct palTimerWheel{
+    palWheelTimerLink_t     slots[PAL_TIMER_WHEEL_LEVELS][PAL_TIMER_WHEEL_SLOTS];
+    palWheelTimerLink_t     expired;        //! timers whose callbacks are due, in expiry order.
+    uint64_t                currentTick;    //! the last wheel tick which was processed.
+    int32_t                 osTicks;        //! incremented by the OS timer, the wheel processes ticks until it catches up with it.
+    uint32_t                runningTimers;  //! timers in the slots or in the expired list, the OS timer runs only while there are any.
+    uint32_t                timers;         //! created wheel timers, the wheel is released with the last one.
+    uint32_t                stopping;
+    palMutexID_t            lock;
+    palSemaphoreID_t        tick;
+    palSemaphoreID_t        stopped;
+    palTimerID_t            osTimer;
+    palThreadID_t           threadID;
+    uint32_t*               stack;
+} palTimerWheel_t;
+
+/*! A lock for objects which are created on their first use, so there is no init function to create the lock in. Its platform
+*   semaphore is created by the first acquire, a thread which loses the race to publish its own semaphore deletes it and waits
+*   for the published one. The semaphore lives as long as the program and is not profiled.
+*/
+PAL_PRIVATE palStatus_t palLazyLockAcquire(void** lock)
 {
-    palStatus_t status;
-    status = pal_plat_osMutexCreate(mutexID);
-    return status;
+    palStatus_t status = PAL_SUCCESS;
+    palSemaphoreID_t semaphore = (palSemaphoreID_t)pal_osAtomicLoadPointer(lock, PAL_MEMORY_ORDER_ACQUIRE);
+    void* expected = NULL;
+    int32_t countersAvailable = 0;
+
+    if (NULLPTR == semaphore)
+    {
+        status = pal_plat_osSemaphoreCreate(1, &semaphore);
+        if (PAL_SUCCESS != status)
+        {
+            return status;
+        }
+        if (!pal_osAtomicCompareAndSwapPointer(lock, &expected, (void*)semaphore, PAL_MEMORY_ORDER_ACQ_REL))
+        {
+            pal_plat_osSemaphoreDelete(&semaphore);
+            semaphore = (palSemaphoreID_t)expected;
+        }
+    }
+    return pal_plat_osSemaphoreWait(semaphore, PAL_RTOS_WAIT_FOREVER, &countersAvailable);
 }
 
-palStatus_t pal_osMutexWait(palMutexID_t mutexID, uint32_t millisec)
+PAL_PRIVATE void palLazyLockRelease(void** lock)
 {
-    palStatus_t status;
-    status = pal_plat_osMutexWait(mutexID, millisec);
-    return status;
+    pal_plat_osSemaphoreRelease((palSemaphoreID_t)pal_osAtomicLoadPointer(lock, PAL_MEMORY_ORDER_RELAXED));
 }
 
-palStatus_t pal_osMutexRelease(palMutexID_t mutexID)
+PAL_PRIVATE palTimerWheel_t* s_palTimerWheel = NULL;
+//! protects creating and releasing s_palTimerWheel together with its timers count.
+PAL_PRIVATE void* s_palTimerWheelInitLock = NULL;
+
+PAL_PRIVATE void palTimerWheelListAppend(palWheelTimerLink_t* list, palWheelTimerLink_t* link)
 {
-    palStatus_t status;
-    status = pal_plat_osMutexRelease(mutexID);
-    return status;
+    link->prev = list->prev;
+    link->next = list;
+    list->prev->next = link;
+    list->prev = link;
 }
 
-palStatus_t pal_osMutexDelete(palMutexID_t* mutexID)
+PAL_PRIVATE void palTimerWheelListRemove(palWheelTimerLink_t* link)
 {
-    palStatus_t status;
-    status = pal_plat_osMutexDelete(mutexID);
-    return status;
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->next = NULL;
+    link->prev = NULL;
 }
-palStatus_t pal_osSemaphoreCreate(uint32_t count, palSemaphoreID_t* semaphoreID)
+
+//! The current wheel tick, it is extended from the 32 bit OS ticks counter. Must be called with the wheel lock held.
+PAL_PRIVATE uint64_t palTimerWheelNow(palTimerWheel_t* wheel)
 {
-    palStatus_t status;
-    status = pal_plat_osSemaphoreCreate(count, semaphoreID);
-    return status;
+    uint32_t osTicks = pal_plat_osAtomicLoad32((uint32_t*)&wheel->osTicks, PAL_MEMORY_ORDER_ACQUIRE);
+    return wheel->currentTick + (uint32_t)(osTicks - (uint32_t)wheel->currentTick);
 }
 
-palStatus_t pal_osSemaphoreWait(palSemaphoreID_t semaphoreID, uint32_t millisec,  int32_t* countersAvailable)
+//! Link a timer to the slot of its expiry tick in constant time. Must be called with the wheel lock held.
+PAL_PRIVATE void palTimerWheelInsert(palTimerWheel_t* wheel, palWheelTimer_t* timer)
 {
-    palStatus_t status;
-    status = pal_plat_osSemaphoreWait(semaphoreID, millisec, countersAvailable);
-    return status;
+    uint64_t expires = timer->expires;
+    uint64_t delta = 0;
+    uint32_t level = 0;
+
+    if (expires <= wheel->currentTick)
+    {
+        palTimerWheelListAppend(&wheel->expired, &timer->link);
+        return;
+    }
+
+    delta = expires - wheel->currentTick;
+    if (delta >= PAL_TIMER_WHEEL_RANGE)
+    {
+        delta = PAL_TIMER_WHEEL_RANGE - 1;
+        expires = wheel->currentTick + delta;
+    }
+    while (delta >= (1ULL << (PAL_TIMER_WHEEL_SLOT_BITS * (level + 1))))
+    {
+        level++;
+    }
+    palTimerWheelListAppend(&wheel->slots[level][(expires >> (PAL_TIMER_WHEEL_SLOT_BITS * level)) & PAL_TIMER_WHEEL_SLOT_MASK], &timer->link);
 }
 
-palStatus_t pal_osSemaphoreRelease(palSemaphoreID_t semaphoreID)
+//! Move the timers of a slot to the lower levels (or to the expired list). Must be called with the wheel lock held.
+PAL_PRIVATE void palTimerWheelCascade(palTimerWheel_t* wheel, palWheelTimerLink_t* slot)
 {
-    palStatus_t status;
-    status = pal_plat_osSemaphoreRelease(semaphoreID);
-    return status;
+    palWheelTimerLink_t* link = NULL;
+
+    while (slot->next != slot)
+    {
+        link = slot->next;
+        palTimerWheelListRemove(link);
+        palTimerWheelInsert(wheel, (palWheelTimer_t*)link);
+    }
 }
 
-palStatus_t pal_osSemaphoreDelete(palSemaphoreID_t* semaphoreID)
+//! Process the next wheel tick, its timers are moved to the expired list. Must be called with the wheel lock held.
+PAL_PRIVATE void palTimerWheelAdvance(palTimerWheel_t* wheel)
 {
-    palStatus_t status;
-    status = pal_plat_osSemaphoreDelete(semaphoreID);
-    return status;
+    palWheelTimerLink_t* slot = NULL;
+    uint32_t level = 0;
+
+    wheel->currentTick++;
+    for (level = 1; level < PAL_TIMER_WHEEL_LEVELS; ++level)
+    {
+        if (0 != ((wheel->currentTick >> (PAL_TIMER_WHEEL_SLOT_BITS * (level - 1))) & PAL_TIMER_WHEEL_SLOT_MASK))
+        {
+            break;
+        }
+        palTimerWheelCascade(wheel, &wheel->slots[level][(wheel->currentTick >> (PAL_TIMER_WHEEL_SLOT_BITS * level)) & PAL_TIMER_WHEEL_SLOT_MASK]);
+    }
+
+    slot = &wheel->slots[0][wheel->currentTick & PAL_TIMER_WHEEL_SLOT_MASK];
+    palTimerWheelCascade(wheel, slot);
 }
 
-palStatus_t pal_osPoolCreate(uint32_t blockSize, uint32_t blockCount, palMemoryPoolID_t* memoryPoolID)
+//! Account for a timer which stopped running, the OS timer is stopped with the last one. Must be called with the wheel lock held.
+PAL_PRIVATE void palTimerWheelTimerStopped(palTimerWheel_t* wheel)
 {
-    palStatus_t status;
-    status = pal_plat_osPoolCreate(blockSize, blockCount, memoryPoolID);
-    return status;
+    wheel->runningTimers--;
+    if (0 == wheel->runningTimers)
+    {
+        pal_osTimerStop(wheel->osTimer);
+    }
 }
 
-void* pal_osPoolAlloc(palMemoryPoolID_t memoryPoolID)
+PAL_PRIVATE void palTimerWheelTick(void const* argument)
 {
-    void* result;
-    result = pal_plat_osPoolAlloc(memoryPoolID);
-    return result;
+    palTimerWheel_t* wheel = (palTimerWheel_t*)argument;
+
+    pal_osAtomicIncrement(&wheel->osTicks, 1);
+    pal_osSemaphoreRelease(wheel->tick);
 }
 
-void* pal_osPoolCAlloc(palMemoryPoolID_t memoryPoolID)
+//! The timer wheel thread, it processes the wheel ticks and runs the callbacks of the expired timers without the wheel lock.
+PAL_PRIVATE void palTimerWheelThread(void const* argument)
 {
-    void* result;
-    //TODO(nirson01): debug print in case of failed alloc?
-    result = pal_plat_osPoolCAlloc(memoryPoolID);
-    return result;
+    palTimerWheel_t* wheel = (palTimerWheel_t*)argument;
+    palWheelTimer_t* timer = NULL;
+    palTimerFuncPtr function = NULL;
+    void* funcArgument = NULL;
+    uint64_t now = 0;
+    int32_t countersAvailable = 0;
+
+    while (true)
+    {
+        pal_osSemaphoreWait(wheel->tick, PAL_RTOS_WAIT_FOREVER, &countersAvailable);
+        pal_osMutexWait(wheel->lock, PAL_RTOS_WAIT_FOREVER);
+        if (0 != pal_plat_osAtomicLoad32(&wheel->stopping, PAL_MEMORY_ORDER_ACQUIRE))
+        {
+            //! the thread waits here to be terminated, so its slot is not released (and reused) before that.
+            pal_osMutexRelease(wheel->lock);
+            pal_osSemaphoreRelease(wheel->stopped);
+            continue;
+        }
+
+        now = palTimerWheelNow(wheel);
+        while (wheel->currentTick < now)
+        {
+            palTimerWheelAdvance(wheel);
+        }
+
+        while (wheel->expired.next != &wheel->expired)
+        {
+            timer = (palWheelTimer_t*)wheel->expired.next;
+            palTimerWheelListRemove(&timer->link);
+            function = timer->function;
+            funcArgument = timer->funcArgument;
+            if (palOsTimerPeriodic == timer->timerType)
+            {
+                //! a period missed while the thread was late is skipped rather than run back to back.
+                timer->expires += timer->period;
+                if (timer->expires <= wheel->currentTick)
+                {
+                    timer->expires = wheel->currentTick + timer->period;
+                }
+                palTimerWheelInsert(wheel, timer);
+            }
+            else
+            {
+                palTimerWheelTimerStopped(wheel);
+            }
+
+            //! the timer is not touched after the lock is released, the callback may stop or delete it.
+            pal_osMutexRelease(wheel->lock);
+            function(funcArgument);
+            pal_osMutexWait(wheel->lock, PAL_RTOS_WAIT_FOREVER);
+        }
+        pal_osMutexRelease(wheel->lock);
+    }
 }
 
-palStatus_t pal_osPoolFree(palMemoryPoolID_t memoryPoolID, void* block)
+PAL_PRIVATE void palTimerWheelDestroy(palTimerWheel_t* wheel)
 {
-    palStatus_t status;
-    //TODO(nirson01): debug print in case of failed alloc?
-    status = pal_plat_osPoolFree(memoryPoolID, block);
-    return status;
+    int32_t countersAvailable = 0;
+
+    if (PAL_INVALID_THREAD != wheel->threadID)
+    {
+        pal_osMutexWait(wheel->lock, PAL_RTOS_WAIT_FOREVER);
+        pal_plat_osAtomicStore32(&wheel->stopping, 1, PAL_MEMORY_ORDER_SEQ_CST);
+        pal_osMutexRelease(wheel->lock);
+        pal_osSemaphoreRelease(wheel->tick);
+        pal_osSemaphoreWait(wheel->stopped, PAL_RTOS_WAIT_FOREVER, &countersAvailable);
+        pal_osThreadTerminate(&wheel->threadID);
+    }
+    if (NULLPTR != wheel->osTimer)
+    {
+        pal_osTimerDelete(&wheel->osTimer);
+    }
+    if (NULLPTR != wheel->stopped)
+    {
+        pal_osSemaphoreDelete(&wheel->stopped);
+    }
+    if (NULLPTR != wheel->tick)
+    {
+        pal_osSemaphoreDelete(&wheel->tick);
+    }
+    if (NULLPTR != wheel->lock)
+    {
+        pal_osMutexDelete(&wheel->lock);
+    }
+    pal_osThreadStackFree(&wheel->stack);
+    pal_plat_free(wheel);
 }
 
-palStatus_t pal_osPoolDestroy(palMemoryPoolID_t* memoryPoolID)
+PAL_PRIVATE palStatus_t palTimerWheelCreate(palTimerWheel_t** wheelOut)
 {
-    palStatus_t status;
-    status = pal_plat_osPoolDestroy(memoryPoolID);  
+    palStatus_t status = PAL_SUCCESS;
+    palTimerWheel_t* wheel = NULL;
+    uint32_t level = 0;
+    uint32_t slot = 0;
+
+    wheel = (palTimerWheel_t*)pal_plat_malloc(sizeof(palTimerWheel_t));
+    if (NULL == wheel)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+
+    memset(wheel, 0, sizeof(palTimerWheel_t));
+    for (level = 0; level < PAL_TIMER_WHEEL_LEVELS; ++level)
+    {
+        for (slot = 0; slot < PAL_TIMER_WHEEL_SLOTS; ++slot)
+        {
+            wheel->slots[level][slot].next = &wheel->slots[level][slot];
+            wheel->slots[level][slot].prev = &wheel->slots[level][slot];
+        }
+    }
+    wheel->expired.next = &wheel->expired;
+    wheel->expired.prev = &wheel->expired;
+    wheel->threadID = PAL_INVALID_THREAD;
+
+    status = pal_osMutexCreate(&wheel->lock);
+    if (PAL_SUCCESS == status)
+    {
+        status = pal_osSemaphoreCreate(0, &wheel->tick);
+    }
+    if (PAL_SUCCESS == status)
+    {
+        status = pal_osSemaphoreCreate(0, &wheel->stopped);
+    }
+    if (PAL_SUCCESS == status)
+    {
+        status = pal_osTimerCreate(palTimerWheelTick, wheel, palOsTimerPeriodic, &wheel->osTimer);
+    }
+    if (PAL_SUCCESS == status)
+    {
+        status = pal_osThreadStackAlloc(PAL_TIMER_WHEEL_THREAD_STACK_SIZE, &wheel->stack);
+    }
+    if (PAL_SUCCESS == status)
+    {
+        status = pal_osThreadCreate(palTimerWheelThread, wheel, PAL_TIMER_WHEEL_THREAD_PRIORITY, PAL_TIMER_WHEEL_THREAD_STACK_SIZE, wheel->stack, NULL, &wheel->threadID);
+        if (PAL_SUCCESS != status)
+        {
+            wheel->threadID = PAL_INVALID_THREAD;
+        }
+    }
+
+    if (PAL_SUCCESS != status)
+    {
+        palTimerWheelDestroy(wheel);
+        wheel = NULL;
+    }
+    *wheelOut = wheel;
     return status;
 }
 
-palStatus_t pal_osMessageQueueCreate(uint32_t messageQSize, palMessageQID_t* messageQID)
+palStatus_t pal_osWheelTimerCreate(palTimerFuncPtr function, void* funcArgument, palTimerType_t timerType, palWheelTimerID_t* timerID)
 {
-    palStatus_t status;
-    status = pal_plat_osMessageQueueCreate(messageQSize, messageQID);
+    palStatus_t status = PAL_SUCCESS;
+    palWheelTimer_t* timer = NULL;
+
+    if ((NULL == timerID) || (NULL == function))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    timer = (palWheelTimer_t*)pal_osMalloc(sizeof(palWheelTimer_t));
+    if (NULL == timer)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+    memset(timer, 0, sizeof(palWheelTimer_t));
+    timer->function = function;
+    timer->funcArgument = funcArgument;
+    timer->timerType = timerType;
+
+    status = palLazyLockAcquire(&s_palTimerWheelInitLock);
+    if (PAL_SUCCESS != status)
+    {
+        pal_osFree(timer);
+        return status;
+    }
+    if (NULL == s_palTimerWheel)
+    {
+        status = palTimerWheelCreate(&s_palTimerWheel);
+    }
+    if (PAL_SUCCESS == status)
+    {
+        s_palTimerWheel->timers++;
+    }
+    palLazyLockRelease(&s_palTimerWheelInitLock);
+
+    if (PAL_SUCCESS != status)
+    {
+        pal_osFree(timer);
+        return status;
+    }
+    *timerID = (palWheelTimerID_t)timer;
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osWheelTimerStart(palWheelTimerID_t timerID, uint32_t millisec)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palTimerWheel_t* wheel = s_palTimerWheel;
+    palWheelTimer_t* timer = (palWheelTimer_t*)timerID;
+    uint64_t now = 0;
+
+    if ((NULLPTR == timerID) || (0 == millisec) || (NULL == wheel))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    status = pal_osMutexWait(wheel->lock, PAL_RTOS_WAIT_FOREVER);
+    if (PAL_SUCCESS != status)
+    {
+        return status;
+    }
+
+    if (NULL != timer->link.next)
+    {
+        palTimerWheelListRemove(&timer->link);
+    }
+    else
+    {
+        if (0 == wheel->runningTimers)
+        {
+            status = pal_osTimerStart(wheel->osTimer, PAL_TIMER_WHEEL_TICK_MS);
+        }
+        if (PAL_SUCCESS == status)
+        {
+            wheel->runningTimers++;
+        }
+    }
+
+    if (PAL_SUCCESS == status)
+    {
+        //! the next OS tick may be just ahead, one more tick makes sure the timer does not expire early.
+        timer->period = (uint32_t)((millisec + (uint64_t)PAL_TIMER_WHEEL_TICK_MS - 1) / PAL_TIMER_WHEEL_TICK_MS);
+        now = palTimerWheelNow(wheel);
+        timer->expires = now + timer->period + 1;
+        palTimerWheelInsert(wheel, timer);
+    }
+    pal_osMutexRelease(wheel->lock);
     return status;
 }
 
-palStatus_t pal_osMessagePut(palMessageQID_t messageQID, uint32_t info, uint32_t timeout)
+palStatus_t pal_osWheelTimerStop(palWheelTimerID_t timerID)
 {
-    palStatus_t status;
-    status = pal_plat_osMessagePut(messageQID, info, timeout);
+    palStatus_t status = PAL_SUCCESS;
+    palTimerWheel_t* wheel = s_palTimerWheel;
+    palWheelTimer_t* timer = (palWheelTimer_t*)timerID;
+
+    if ((NULLPTR == timerID) || (NULL == wheel))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    status = pal_osMutexWait(wheel->lock, PAL_RTOS_WAIT_FOREVER);
+    if (PAL_SUCCESS != status)
+    {
+        return status;
+    }
+    if (NULL != timer->link.next)
+    {
+        palTimerWheelListRemove(&timer->link);
+        palTimerWheelTimerStopped(wheel);
+    }
+    pal_osMutexRelease(wheel->lock);
     return status;
 }
 
-palStatus_t pal_osMessageGet(palMessageQID_t messageQID, uint32_t timeout, uint32_t* messageValue)
+palStatus_t pal_osWheelTimerDelete(palWheelTimerID_t* timerID)
 {
-    palStatus_t status;
-    status = pal_plat_osMessageGet(messageQID, timeout, messageValue);
+    palStatus_t status = PAL_SUCCESS;
+    palTimerWheel_t* wheel = NULL;
+
+    if ((NULL == timerID) || (NULLPTR == *timerID))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    status = pal_osWheelTimerStop(*timerID);
+    if (PAL_SUCCESS != status)
+    {
+        return status;
+    }
+    status = palLazyLockAcquire(&s_palTimerWheelInitLock);
+    if (PAL_SUCCESS != status)
+    {
+        return status;
+    }
+    pal_osFree((void*)*timerID);
+    *timerID = NULLPTR;
+
+    wheel = s_palTimerWheel;
+    wheel->timers--;
+    //! the wheel thread can not wait for itself to stop, a callback which deletes the last timer leaves the wheel running.
+    if ((0 == wheel->timers) && (pal_osThreadGetId() != wheel->threadID))
+    {
+        s_palTimerWheel = NULL;
+        palTimerWheelDestroy(wheel);
+    }
+    palLazyLockRelease(&s_palTimerWheelInitLock);
     return status;
 }
 
-palStatus_t pal_osMessageQueueDestroy(palMessageQID_t* messageQID)
+//! The wheel timer of the periodic thread statistics dump, NULLPTR when the dump does not run.
+PAL_PRIVATE palWheelTimerID_t s_palThreadStatsTimer = NULLPTR;
+
+void pal_osThreadStatsDump(void)
 {
-    palStatus_t status;
-    status = pal_plat_osMessageQueueDestroy(messageQID);
+    palThreadStats_t stats;
+    palThreadID_t threadID = 0;
+
+    for (threadID = 0; threadID < PAL_MAX_NUMBER_OF_THREADS; ++threadID)
+    {
+        if (PAL_SUCCESS == pal_plat_osThreadGetStats(threadID, &stats))
+        {
+            pal_osLogPrintf(__FUNCTION__, __LINE__, "pal thread stats: id=%lu stack=%lu/%lu run_us=%llu switches=%lu mutex_waits=%lu mutex_wait_us=%llu\r\n",
+                (unsigned long)threadID, (unsigned long)stats.stackHighWaterMark, (unsigned long)stats.stackSize, (unsigned long long)stats.runTimeMicroSec,
+                (unsigned long)stats.contextSwitches, (unsigned long)stats.mutexWaits, (unsigned long long)stats.mutexWaitMicroSec);
+        }
+    }
+}
+
+PAL_PRIVATE void palThreadStatsDumpTimer(void const* argument)
+{
+    (void)argument;
+    pal_osThreadStatsDump();
+}
+
+palStatus_t pal_osThreadStatsDumpStart(uint32_t millisec)
+{
+    palStatus_t status = PAL_SUCCESS;
+
+    if (0 == millisec)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    if (NULLPTR == s_palThreadStatsTimer)
+    {
+        status = pal_osWheelTimerCreate(palThreadStatsDumpTimer, NULL, palOsTimerPeriodic, &s_palThreadStatsTimer);
+    }
+    if (PAL_SUCCESS == status)
+    {
+        status = pal_osWheelTimerStart(s_palThreadStatsTimer, millisec);
+        if (PAL_SUCCESS != status)
+        {
+            pal_osWheelTimerDelete(&s_palThreadStatsTimer);
+        }
+    }
     return status;
 }
 
-int32_t pal_osAtomicIncrement(int32_t* valuePtr, int32_t increment)
+palStatus_t pal_osThreadStatsDumpStop(void)
 {
-    int32_t result;
-    result = pal_plat_osAtomicIncrement(valuePtr, increment);
-    return result;
+    if (NULLPTR != s_palThreadStatsTimer)
+    {
+        pal_osWheelTimerDelete(&s_palThreadStatsTimer);
+    }
+    return PAL_SUCCESS;
 }
 
+//! The milliseconds left until the deadline of a wait, PAL_ERR_RTOS_TIMEOUT once it passed.
+PAL_PRIVATE palStatus_t palDeadlineRemaining(uint64_t deadline, uint32_t millisec, uint32_t* remaining)
+{
+    uint64_t now = 0;
 
+    if (PAL_RTOS_WAIT_FOREVER == millisec)
+    {
+        *remaining = PAL_RTOS_WAIT_FOREVER;
+        return PAL_SUCCESS;
+    }
+    now = pal_osKernelSysTick64();
+    if (now >= deadline)
+    {
+        return PAL_ERR_RTOS_TIMEOUT;
+    }
+    //! rounded up, a wait shorter than a millisecond would not block.
+    *remaining = (uint32_t)pal_osKernelSysMilliSecTick(deadline - now) + 1;
+    return PAL_SUCCESS;
+}
 
-#ifdef DEBUG
-#include "stdarg.h"
-#endif
+#if PAL_RTOS_MUTEX_FAST_PATH
+//! A mutex of PAL: the owner word is the lock, so a free mutex is taken and released with atomic operations alone, and
+//! the semaphore of the platform is used only by the threads which wait. The mutex is recursive like the ones of the platforms.
+typedef struct palFastMutex{
+    void*               owner;      //! the pal_plat_osThreadSelf of the holder, NULL when the mutex is free.
+    uint32_t            depth;      //! written by the holder only.
+    uint32_t            waiters;    //! the threads which wait, or are about to wait, on the semaphore.
+    palSemaphoreID_t    semaphore;
+} palFastMutex_t;
 
-void dbgPrintf( const char* function, uint32_t line, const char * format, ... )
+PAL_PRIVATE palStatus_t palMutexCreate(palMutexID_t* mutexID)
 {
-#ifdef DEBUG
-    static palMutexID_t printfMutex = NULLPTR;
+    palStatus_t status = PAL_SUCCESS;
+    palFastMutex_t* mutex = NULL;
 
-    va_list args;
-    if (!printfMutex)
+    if (NULL == mutexID)
     {
-        pal_osMutexCreate(&printfMutex);
+        return PAL_ERR_INVALID_ARGUMENT;
     }
-    pal_osMutexWait(printfMutex, PAL_MAX_UINT32);
-#ifdef VERBOSE
-    pal_plat_printf("%s:%ld\t",function,line);
-#endif
+
+    mutex = (palFastMutex_t*)pal_osMalloc(sizeof(palFastMutex_t));
+    if (NULL == mutex)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+    memset(mutex, 0, sizeof(palFastMutex_t));
+
+    status = pal_plat_osSemaphoreCreate(0, &mutex->semaphore);
+    if (PAL_SUCCESS != status)
+    {
+        pal_osFree(mutex);
+        return status;
+    }
+    *mutexID = (palMutexID_t)mutex;
+    return status;
+}
+
+PAL_PRIVATE palStatus_t palMutexWait(palMutexID_t mutexID, uint32_t millisec)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palFastMutex_t* mutex = (palFastMutex_t*)mutexID;
+    void* self = (void*)pal_plat_osThreadSelf();
+    void* owner = NULL;
+    uint64_t deadline = 0;
+    uint32_t remaining = 0;
+    uint32_t spins = 0;
+
+    if (NULLPTR == mutexID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    //! only this thread stores its own value in the owner word.
+    if (self == pal_osAtomicLoadPointer(&mutex->owner, PAL_MEMORY_ORDER_RELAXED))
+    {
+        mutex->depth++;
+        return PAL_SUCCESS;
+    }
+
+    if (!pal_osAtomicCompareAndSwapPointer(&mutex->owner, &owner, self, PAL_MEMORY_ORDER_ACQUIRE))
+    {
+        //! on a target with more cores the holder may leave before this thread would be put to sleep.
+        for (spins = 0; spins < PAL_RTOS_MUTEX_SPIN_COUNT; ++spins)
+        {
+            owner = NULL;
+            if ((NULL == pal_osAtomicLoadPointer(&mutex->owner, PAL_MEMORY_ORDER_RELAXED)) &&
+                pal_osAtomicCompareAndSwapPointer(&mutex->owner, &owner, self, PAL_MEMORY_ORDER_ACQUIRE))
+            {
+                break;
+            }
+        }
+
+        if (PAL_RTOS_MUTEX_SPIN_COUNT == spins)
+        {
+            if (0 == millisec)
+            {
+                return PAL_ERR_RTOS_RESOURCE;
+            }
+
+            deadline = pal_osKernelSysTick64() + pal_osKernelSysTickMicroSec((uint64_t)millisec * 1000);
+            //! counted before the owner word is tried again, so the holder which leaves after that try releases the semaphore.
+            pal_osAtomicFetchAdd32(&mutex->waiters, 1, PAL_MEMORY_ORDER_SEQ_CST);
+            do
+            {
+                owner = NULL;
+                if (pal_osAtomicCompareAndSwapPointer(&mutex->owner, &owner, self, PAL_MEMORY_ORDER_SEQ_CST))
+                {
+                    break;
+                }
+                status = palDeadlineRemaining(deadline, millisec, &remaining);
+                if (PAL_SUCCESS == status)
+                {
+                    status = pal_plat_osSemaphoreWait(mutex->semaphore, remaining, NULL);
+                }
+            } while (PAL_SUCCESS == status);
+            pal_osAtomicFetchSub32(&mutex->waiters, 1, PAL_MEMORY_ORDER_SEQ_CST);
+
+            if (PAL_SUCCESS != status)
+            {
+                return status;
+            }
+        }
+    }
+
+    mutex->depth = 1;
+    return PAL_SUCCESS;
+}
+
+PAL_PRIVATE palStatus_t palMutexRelease(palMutexID_t mutexID)
+{
+    palFastMutex_t* mutex = (palFastMutex_t*)mutexID;
+
+    if (NULLPTR == mutexID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    if ((void*)pal_plat_osThreadSelf() != pal_osAtomicLoadPointer(&mutex->owner, PAL_MEMORY_ORDER_RELAXED))
+    {
+        return PAL_ERR_RTOS_RESOURCE;
+    }
+    mutex->depth--;
+    if (0 == mutex->depth)
+    {
+        pal_osAtomicExchangePointer(&mutex->owner, NULL, PAL_MEMORY_ORDER_SEQ_CST);
+        //! a woken thread tries the owner word again, a release nobody waits for any more only costs it one more try.
+        if (0 != pal_osAtomicLoad32(&mutex->waiters, PAL_MEMORY_ORDER_SEQ_CST))
+        {
+            pal_plat_osSemaphoreRelease(mutex->semaphore);
+        }
+    }
+    return PAL_SUCCESS;
+}
+
+//! \return the times the calling thread holds the mutex, 0 if it does not hold it.
+PAL_PRIVATE uint32_t palMutexDepth(palMutexID_t mutexID)
+{
+    palFastMutex_t* mutex = (palFastMutex_t*)mutexID;
+
+    if ((void*)pal_plat_osThreadSelf() != pal_osAtomicLoadPointer(&mutex->owner, PAL_MEMORY_ORDER_RELAXED))
+    {
+        return 0;
+    }
+    return mutex->depth;
+}
+
+PAL_PRIVATE palStatus_t palMutexDelete(palMutexID_t* mutexID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palFastMutex_t* mutex = NULL;
+
+    if ((NULL == mutexID) || (NULLPTR == *mutexID))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    mutex = (palFastMutex_t*)*mutexID;
+    if (NULL != pal_osAtomicLoadPointer(&mutex->owner, PAL_MEMORY_ORDER_ACQUIRE))
+    {
+        return PAL_ERR_RTOS_RESOURCE;
+    }
+    status = pal_plat_osSemaphoreDelete(&mutex->semaphore);
+    if (PAL_SUCCESS == status)
+    {
+        pal_osFree(mutex);
+        *mutexID = NULLPTR;
+    }
+    return status;
+}
+#else
+PAL_PRIVATE palStatus_t palMutexCreate(palMutexID_t* mutexID)
+{
+    return pal_plat_osMutexCreate(mutexID);
+}
+
+PAL_PRIVATE palStatus_t palMutexWait(palMutexID_t mutexID, uint32_t millisec)
+{
+    return pal_plat_osMutexWait(mutexID, millisec);
+}
+
+PAL_PRIVATE palStatus_t palMutexRelease(palMutexID_t mutexID)
+{
+    return pal_plat_osMutexRelease(mutexID);
+}
+
+PAL_PRIVATE uint32_t palMutexDepth(palMutexID_t mutexID)
+{
+    return pal_plat_osMutexDepth(mutexID);
+}
+
+PAL_PRIVATE palStatus_t palMutexDelete(palMutexID_t* mutexID)
+{
+    return pal_plat_osMutexDelete(mutexID);
+}
+#endif //PAL_RTOS_MUTEX_FAST_PATH
+
+#if PAL_RTOS_CONTENTION_PROFILING
+//! A profiled mutex or semaphore, its address is the ID PAL gives out. The records are listed for pal_osLockStatsIterate.
+typedef struct palLockProfile{
+    uintptr_t                   platID;     //! the mutex or semaphore of the platform.
+    palLockStats_t              stats;
+    uint32_t                    depth;      //! the times the holder took the mutex, which is recursive. Atomic, as is stats.holder, other threads read them.
+    struct palLockProfile*      prev;
+    struct palLockProfile*      next;
+} palLockProfile_t;
+
+PAL_PRIVATE palLockProfile_t* s_palLockProfiles = NULL;
+//! protects the list of records, it is held while pal_osLockStatsIterate calls its function.
+PAL_PRIVATE void* s_palLockProfilesLock = NULL;
+
+PAL_PRIVATE palLockProfile_t* palLockProfileCreate(palLockType_t type)
+{
+    palLockProfile_t* profile = (palLockProfile_t*)pal_osMalloc(sizeof(palLockProfile_t));
+
+    if (NULL != profile)
+    {
+        memset(profile, 0, sizeof(palLockProfile_t));
+        profile->stats.id = (uintptr_t)profile;
+        profile->stats.type = type;
+        profile->stats.holder = PAL_INVALID_THREAD;
+    }
+    return profile;
+}
+
+PAL_PRIVATE palThreadID_t palLockProfileHolder(const palLockProfile_t* profile)
+{
+    return (palThreadID_t)pal_osAtomicLoadPointer((void* const*)&profile->stats.holder, PAL_MEMORY_ORDER_RELAXED);
+}
+
+PAL_PRIVATE void palLockProfileSetHolder(palLockProfile_t* profile, palThreadID_t holder)
+{
+    pal_osAtomicStorePointer((void**)&profile->stats.holder, (void*)holder, PAL_MEMORY_ORDER_RELAXED);
+}
+
+PAL_PRIVATE palStatus_t palLockProfileInsert(palLockProfile_t* profile)
+{
+    palStatus_t status = palLazyLockAcquire(&s_palLockProfilesLock);
+
+    if (PAL_SUCCESS != status)
+    {
+        return status;
+    }
+    profile->next = s_palLockProfiles;
+    if (NULL != s_palLockProfiles)
+    {
+        s_palLockProfiles->prev = profile;
+    }
+    s_palLockProfiles = profile;
+    palLazyLockRelease(&s_palLockProfilesLock);
+    return status;
+}
+
+PAL_PRIVATE void palLockProfileRemove(palLockProfile_t* profile)
+{
+    //! the lock was created when the record was inserted, waiting for it does not fail.
+    (void)palLazyLockAcquire(&s_palLockProfilesLock);
+    if (NULL != profile->prev)
+    {
+        profile->prev->next = profile->next;
+    }
+    else
+    {
+        s_palLockProfiles = profile->next;
+    }
+    if (NULL != profile->next)
+    {
+        profile->next->prev = profile->prev;
+    }
+    palLazyLockRelease(&s_palLockProfilesLock);
+}
+
+//! Wait for the object of the platform. The wait is tried without blocking first, so only the waits which block are timed.
+PAL_PRIVATE palStatus_t palLockProfileWait(palLockProfile_t* profile, uint32_t millisec, int32_t* countersAvailable)
+{
+    palStatus_t status = PAL_SUCCESS;
+    bool isMutex = (PAL_LOCK_TYPE_MUTEX == profile->stats.type);
+    bool contended = false;
+    uint64_t waitStart = 0;
+    uint64_t waited = 0;
+    uint64_t maxWait = 0;
+
+    status = isMutex ? palMutexWait(profile->platID, 0) : pal_plat_osSemaphoreWait(profile->platID, 0, countersAvailable);
+    if ((PAL_SUCCESS != status) && (0 != millisec))
+    {
+        contended = true;
+        waitStart = pal_osKernelSysTick64();
+        status = isMutex ? palMutexWait(profile->platID, millisec) : pal_plat_osSemaphoreWait(profile->platID, millisec, countersAvailable);
+        waited = pal_osKernelSysTick64() - waitStart;
+        pal_osAtomicFetchAdd64(&profile->stats.totalWaitTicks, waited, PAL_MEMORY_ORDER_RELAXED);
+        maxWait = pal_osAtomicLoad64(&profile->stats.maxWaitTicks, PAL_MEMORY_ORDER_RELAXED);
+        while ((waited > maxWait) && !pal_osAtomicCompareAndSwap64(&profile->stats.maxWaitTicks, &maxWait, waited, PAL_MEMORY_ORDER_RELAXED));
+    }
+
+    if (PAL_SUCCESS == status)
+    {
+        pal_osAtomicFetchAdd32(&profile->stats.acquisitions, 1, PAL_MEMORY_ORDER_RELAXED);
+        if (contended)
+        {
+            pal_osAtomicFetchAdd32(&profile->stats.contendedAcquisitions, 1, PAL_MEMORY_ORDER_RELAXED);
+        }
+        //! only the holder of a mutex changes its holder and depth.
+        palLockProfileSetHolder(profile, pal_osThreadGetId());
+        if (isMutex)
+        {
+            pal_osAtomicStore32(&profile->depth, pal_osAtomicLoad32(&profile->depth, PAL_MEMORY_ORDER_RELAXED) + 1, PAL_MEMORY_ORDER_RELAXED);
+        }
+    }
+    return status;
+}
+
+palStatus_t pal_osMutexCreate(palMutexID_t* mutexID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palLockProfile_t* profile = NULL;
+
+    if (NULL == mutexID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    profile = palLockProfileCreate(PAL_LOCK_TYPE_MUTEX);
+    if (NULL == profile)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+    status = palMutexCreate(&profile->platID);
+    if (PAL_SUCCESS != status)
+    {
+        pal_osFree(profile);
+        return status;
+    }
+    status = palLockProfileInsert(profile);
+    if (PAL_SUCCESS != status)
+    {
+        palMutexDelete(&profile->platID);
+        pal_osFree(profile);
+        return status;
+    }
+    *mutexID = (palMutexID_t)profile;
+    return status;
+}
+
+palStatus_t pal_osMutexWait(palMutexID_t mutexID, uint32_t millisec)
+{
+    if (NULLPTR == mutexID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+    return palLockProfileWait((palLockProfile_t*)mutexID, millisec, NULL);
+}
+
+palStatus_t pal_osMutexRelease(palMutexID_t mutexID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palLockProfile_t* profile = (palLockProfile_t*)mutexID;
+    uint32_t depth = 0;
+
+    if (NULLPTR == mutexID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    //! the holder is cleared before the mutex is released, after it another thread may hold it already.
+    depth = pal_osAtomicLoad32(&profile->depth, PAL_MEMORY_ORDER_RELAXED);
+    if ((0 != depth) && (pal_osThreadGetId() == palLockProfileHolder(profile)))
+    {
+        if (1 == depth)
+        {
+            palLockProfileSetHolder(profile, PAL_INVALID_THREAD);
+        }
+        pal_osAtomicStore32(&profile->depth, depth - 1, PAL_MEMORY_ORDER_RELAXED);
+    }
+    status = palMutexRelease(profile->platID);
+    return status;
+}
+
+palStatus_t pal_osMutexDelete(palMutexID_t* mutexID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palLockProfile_t* profile = NULL;
+
+    if ((NULL == mutexID) || (NULLPTR == *mutexID))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    profile = (palLockProfile_t*)*mutexID;
+    status = palMutexDelete(&profile->platID);
+    if (PAL_SUCCESS == status)
+    {
+        palLockProfileRemove(profile);
+        pal_osFree(profile);
+        *mutexID = NULLPTR;
+    }
+    return status;
+}
+
+palStatus_t pal_osSemaphoreCreate(uint32_t count, palSemaphoreID_t* semaphoreID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palLockProfile_t* profile = NULL;
+
+    if (NULL == semaphoreID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    profile = palLockProfileCreate(PAL_LOCK_TYPE_SEMAPHORE);
+    if (NULL == profile)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+    status = pal_plat_osSemaphoreCreate(count, &profile->platID);
+    if (PAL_SUCCESS != status)
+    {
+        pal_osFree(profile);
+        return status;
+    }
+    status = palLockProfileInsert(profile);
+    if (PAL_SUCCESS != status)
+    {
+        pal_plat_osSemaphoreDelete(&profile->platID);
+        pal_osFree(profile);
+        return status;
+    }
+    *semaphoreID = (palSemaphoreID_t)profile;
+    return status;
+}
+
+palStatus_t pal_osSemaphoreWait(palSemaphoreID_t semaphoreID, uint32_t millisec,  int32_t* countersAvailable)
+{
+    if (NULLPTR == semaphoreID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+    return palLockProfileWait((palLockProfile_t*)semaphoreID, millisec, countersAvailable);
+}
+
+palStatus_t pal_osSemaphoreRelease(palSemaphoreID_t semaphoreID)
+{
+    palStatus_t status;
+
+    if (NULLPTR == semaphoreID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+    status = pal_plat_osSemaphoreRelease(((palLockProfile_t*)semaphoreID)->platID);
+    return status;
+}
+
+palStatus_t pal_osSemaphoreDelete(palSemaphoreID_t* semaphoreID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palLockProfile_t* profile = NULL;
+
+    if ((NULL == semaphoreID) || (NULLPTR == *semaphoreID))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    profile = (palLockProfile_t*)*semaphoreID;
+    status = pal_plat_osSemaphoreDelete(&profile->platID);
+    if (PAL_SUCCESS == status)
+    {
+        palLockProfileRemove(profile);
+        pal_osFree(profile);
+        *semaphoreID = NULLPTR;
+    }
+    return status;
+}
+
+palStatus_t pal_osLockStatsIterate(palLockStatsFuncPtr function, void* funcArgument)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palLockProfile_t* profile = NULL;
+    palLockStats_t stats;
+
+    if (NULL == function)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    status = palLazyLockAcquire(&s_palLockProfilesLock);
+    if (PAL_SUCCESS != status)
+    {
+        return status;
+    }
+    for (profile = s_palLockProfiles; NULL != profile; profile = profile->next)
+    {
+        //! the ID and type do not change, the counters and holder are changed by the waiting threads meanwhile.
+        stats.id = profile->stats.id;
+        stats.type = profile->stats.type;
+        stats.acquisitions = pal_osAtomicLoad32(&profile->stats.acquisitions, PAL_MEMORY_ORDER_RELAXED);
+        stats.contendedAcquisitions = pal_osAtomicLoad32(&profile->stats.contendedAcquisitions, PAL_MEMORY_ORDER_RELAXED);
+        stats.holder = palLockProfileHolder(profile);
+        stats.totalWaitTicks = pal_osAtomicLoad64(&profile->stats.totalWaitTicks, PAL_MEMORY_ORDER_RELAXED);
+        stats.maxWaitTicks = pal_osAtomicLoad64(&profile->stats.maxWaitTicks, PAL_MEMORY_ORDER_RELAXED);
+        function(&stats, funcArgument);
+    }
+    palLazyLockRelease(&s_palLockProfilesLock);
+    return status;
+}
+
+//! Convert kernel ticks to microseconds without overflowing for long totals.
+PAL_PRIVATE uint64_t palLockTicksToMicroSec(uint64_t ticks, uint64_t frequency)
+{
+    return ((ticks / frequency) * 1000000) + (((ticks % frequency) * 1000000) / frequency);
+}
+
+PAL_PRIVATE void palLockStatsLog(const palLockStats_t* stats, void* funcArgument)
+{
+    uint64_t frequency = pal_osKernelSysTickFrequency();
+
+    (void)funcArgument;
+    if (0 != stats->contendedAcquisitions)
+    {
+        pal_osLogPrintf(__FUNCTION__, __LINE__, "pal lock stats: %s=0x%lx acquisitions=%lu contended=%lu wait_us=%llu max_wait_us=%llu holder=%lu\r\n",
+            (PAL_LOCK_TYPE_MUTEX == stats->type) ? "mutex" : "semaphore", (unsigned long)stats->id, (unsigned long)stats->acquisitions,
+            (unsigned long)stats->contendedAcquisitions, (unsigned long long)palLockTicksToMicroSec(stats->totalWaitTicks, frequency),
+            (unsigned long long)palLockTicksToMicroSec(stats->maxWaitTicks, frequency), (unsigned long)stats->holder);
+    }
+}
+
+void pal_osLockStatsReport(void)
+{
+    pal_osLockStatsIterate(palLockStatsLog, NULL);
+}
+
+#else
+palStatus_t pal_osMutexCreate(palMutexID_t* mutexID)
+{
+    palStatus_t status;
+    status = palMutexCreate(mutexID);
+    return status;
+}
+
+palStatus_t pal_osMutexWait(palMutexID_t mutexID, uint32_t millisec)
+{
+    palStatus_t status;
+    status = palMutexWait(mutexID, millisec);
+    return status;
+}
+
+palStatus_t pal_osMutexRelease(palMutexID_t mutexID)
+{
+    palStatus_t status;
+    status = palMutexRelease(mutexID);
+    return status;
+}
+
+palStatus_t pal_osMutexDelete(palMutexID_t* mutexID)
+{
+    palStatus_t status;
+    status = palMutexDelete(mutexID);
+    return status;
+}
+palStatus_t pal_osSemaphoreCreate(uint32_t count, palSemaphoreID_t* semaphoreID)
+{
+    palStatus_t status;
+    status = pal_plat_osSemaphoreCreate(count, semaphoreID);
+    return status;
+}
+
+palStatus_t pal_osSemaphoreWait(palSemaphoreID_t semaphoreID, uint32_t millisec,  int32_t* countersAvailable)
+{
+    palStatus_t status;
+    status = pal_plat_osSemaphoreWait(semaphoreID, millisec, countersAvailable);
+    return status;
+}
+
+palStatus_t pal_osSemaphoreRelease(palSemaphoreID_t semaphoreID)
+{
+    palStatus_t status;
+    status = pal_plat_osSemaphoreRelease(semaphoreID);
+    return status;
+}
+
+palStatus_t pal_osSemaphoreDelete(palSemaphoreID_t* semaphoreID)
+{
+    palStatus_t status;
+    status = pal_plat_osSemaphoreDelete(semaphoreID);
+    return status;
+}
+
+palStatus_t pal_osLockStatsIterate(palLockStatsFuncPtr function, void* funcArgument)
+{
+    (void)function;
+    (void)funcArgument;
+    return PAL_ERR_NOT_SUPPORTED;
+}
+
+void pal_osLockStatsReport(void)
+{
+}
+#endif //PAL_RTOS_CONTENTION_PROFILING
+
+//! The state of a reader-writer lock: the readers which hold it in the low 16 bits, a bit for the writer which holds it, and the
+//! writers which wait for it above. Readers get in only while no writer holds the lock or waits for it.
+#define PAL_RWLOCK_READERS_MASK     0x0000FFFFU
+#define PAL_RWLOCK_WRITER           0x00010000U
+#define PAL_RWLOCK_WAITING_WRITER   0x00020000U
+#define PAL_RWLOCK_WAITING_MASK     0xFFFE0000U
+
+typedef struct palRwLock{
+    uint32_t            state;
+    uint32_t            waitingReaders;     //! the readers which wait, or are about to wait, on readersGate.
+    palSemaphoreID_t    readersGate;        //! released once per waiting reader when readers may get in.
+    palSemaphoreID_t    writersGate;        //! released once when a waiting writer may get in.
+} palRwLock_t;
+
+//! \return PAL_SUCCESS when the lock was taken for reading, PAL_ERR_RTOS_TIMEOUT when a writer holds it or waits for it,
+//!         PAL_ERR_RTOS_RESOURCE when PAL_RTOS_RWLOCK_MAX_READERS readers hold it.
+PAL_PRIVATE palStatus_t palRwLockTryRead(palRwLock_t* rwLock)
+{
+    uint32_t state = pal_osAtomicLoad32(&rwLock->state, PAL_MEMORY_ORDER_SEQ_CST);
+
+    do
+    {
+        if (0 != (state & (PAL_RWLOCK_WRITER | PAL_RWLOCK_WAITING_MASK)))
+        {
+            return PAL_ERR_RTOS_TIMEOUT;
+        }
+        if (PAL_RTOS_RWLOCK_MAX_READERS == (state & PAL_RWLOCK_READERS_MASK))
+        {
+            return PAL_ERR_RTOS_RESOURCE;
+        }
+    } while (!pal_osAtomicCompareAndSwap32(&rwLock->state, &state, state + 1, PAL_MEMORY_ORDER_SEQ_CST));
+    return PAL_SUCCESS;
+}
+
+//! Take the lock for writing if nobody holds it, a waiting writer (waiting is PAL_RWLOCK_WAITING_WRITER) stops waiting as it takes it.
+PAL_PRIVATE bool palRwLockTryWrite(palRwLock_t* rwLock, uint32_t waiting)
+{
+    uint32_t state = pal_osAtomicLoad32(&rwLock->state, PAL_MEMORY_ORDER_SEQ_CST);
+
+    do
+    {
+        if (0 != (state & (PAL_RWLOCK_READERS_MASK | PAL_RWLOCK_WRITER)))
+        {
+            return false;
+        }
+    } while (!pal_osAtomicCompareAndSwap32(&rwLock->state, &state, state - waiting + PAL_RWLOCK_WRITER, PAL_MEMORY_ORDER_SEQ_CST));
+    return true;
+}
+
+//! Called after the lock changed so readers may get in. The readers count themselves as waiting before they try the lock, so
+//! a reader which found the lock taken is always seen here.
+PAL_PRIVATE void palRwLockWakeReaders(palRwLock_t* rwLock)
+{
+    uint32_t waiting = pal_osAtomicLoad32(&rwLock->waitingReaders, PAL_MEMORY_ORDER_SEQ_CST);
+
+    while (waiting > 0)
+    {
+        pal_osSemaphoreRelease(rwLock->readersGate);
+        --waiting;
+    }
+}
+
+palStatus_t pal_osRwLockCreate(palRwLockID_t* rwLockID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palRwLock_t* rwLock = NULL;
+
+    if (NULL == rwLockID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    rwLock = (palRwLock_t*)pal_osMalloc(sizeof(palRwLock_t));
+    if (NULL == rwLock)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+    memset(rwLock, 0, sizeof(palRwLock_t));
+
+    status = pal_osSemaphoreCreate(0, &rwLock->readersGate);
+    if (PAL_SUCCESS == status)
+    {
+        status = pal_osSemaphoreCreate(0, &rwLock->writersGate);
+        if (PAL_SUCCESS != status)
+        {
+            pal_osSemaphoreDelete(&rwLock->readersGate);
+        }
+    }
+
+    if (PAL_SUCCESS != status)
+    {
+        pal_osFree(rwLock);
+        return status;
+    }
+    *rwLockID = (palRwLockID_t)rwLock;
+    return status;
+}
+
+palStatus_t pal_osRwLockReadLock(palRwLockID_t rwLockID, uint32_t millisec)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palRwLock_t* rwLock = (palRwLock_t*)rwLockID;
+    uint64_t deadline = 0;
+    uint32_t remaining = 0;
+
+    if (NULLPTR == rwLockID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    status = palRwLockTryRead(rwLock);
+    if ((PAL_ERR_RTOS_TIMEOUT == status) && (0 != millisec))
+    {
+        deadline = pal_osKernelSysTick64() + pal_osKernelSysTickMicroSec((uint64_t)millisec * 1000);
+        //! counted before the lock is tried again, so the writer which leaves after that try wakes this reader.
+        pal_osAtomicFetchAdd32(&rwLock->waitingReaders, 1, PAL_MEMORY_ORDER_SEQ_CST);
+        while (PAL_ERR_RTOS_TIMEOUT == (status = palRwLockTryRead(rwLock)))
+        {
+            if ((PAL_SUCCESS != palDeadlineRemaining(deadline, millisec, &remaining)) ||
+                (PAL_SUCCESS != pal_osSemaphoreWait(rwLock->readersGate, remaining, NULL)))
+            {
+                break;
+            }
+        }
+        pal_osAtomicFetchSub32(&rwLock->waitingReaders, 1, PAL_MEMORY_ORDER_SEQ_CST);
+    }
+    return status;
+}
+
+palStatus_t pal_osRwLockWriteLock(palRwLockID_t rwLockID, uint32_t millisec)
+{
+    palRwLock_t* rwLock = (palRwLock_t*)rwLockID;
+    uint64_t deadline = 0;
+    uint32_t remaining = 0;
+    uint32_t state = 0;
+
+    if (NULLPTR == rwLockID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    if (palRwLockTryWrite(rwLock, 0))
+    {
+        return PAL_SUCCESS;
+    }
+    if (0 == millisec)
+    {
+        return PAL_ERR_RTOS_TIMEOUT;
+    }
+
+    deadline = pal_osKernelSysTick64() + pal_osKernelSysTickMicroSec((uint64_t)millisec * 1000);
+    //! a waiting writer holds new readers back, and the last reader out wakes it.
+    pal_osAtomicFetchAdd32(&rwLock->state, PAL_RWLOCK_WAITING_WRITER, PAL_MEMORY_ORDER_SEQ_CST);
+    while (!palRwLockTryWrite(rwLock, PAL_RWLOCK_WAITING_WRITER))
+    {
+        if ((PAL_SUCCESS != palDeadlineRemaining(deadline, millisec, &remaining)) ||
+            (PAL_SUCCESS != pal_osSemaphoreWait(rwLock->writersGate, remaining, NULL)))
+        {
+            state = pal_osAtomicFetchSub32(&rwLock->state, PAL_RWLOCK_WAITING_WRITER, PAL_MEMORY_ORDER_SEQ_CST) - PAL_RWLOCK_WAITING_WRITER;
+            if (0 == (state & (PAL_RWLOCK_WRITER | PAL_RWLOCK_WAITING_MASK)))
+            {
+                palRwLockWakeReaders(rwLock); //! the readers this writer held back.
+            }
+            return PAL_ERR_RTOS_TIMEOUT;
+        }
+    }
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osRwLockUnlock(palRwLockID_t rwLockID)
+{
+    palRwLock_t* rwLock = (palRwLock_t*)rwLockID;
+    uint32_t state = 0;
+
+    if (NULLPTR == rwLockID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    //! while a writer holds the lock no reader does, so the caller is the writer.
+    state = pal_osAtomicLoad32(&rwLock->state, PAL_MEMORY_ORDER_RELAXED);
+    if (0 != (state & PAL_RWLOCK_WRITER))
+    {
+        state = pal_osAtomicFetchSub32(&rwLock->state, PAL_RWLOCK_WRITER, PAL_MEMORY_ORDER_SEQ_CST) - PAL_RWLOCK_WRITER;
+        if (0 != (state & PAL_RWLOCK_WAITING_MASK))
+        {
+            pal_osSemaphoreRelease(rwLock->writersGate);
+        }
+        else
+        {
+            palRwLockWakeReaders(rwLock);
+        }
+    }
+    else if (0 != (state & PAL_RWLOCK_READERS_MASK))
+    {
+        state = pal_osAtomicFetchSub32(&rwLock->state, 1, PAL_MEMORY_ORDER_SEQ_CST) - 1;
+        if ((0 == (state & PAL_RWLOCK_READERS_MASK)) && (0 != (state & PAL_RWLOCK_WAITING_MASK)))
+        {
+            pal_osSemaphoreRelease(rwLock->writersGate);
+        }
+    }
+    else
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osRwLockDelete(palRwLockID_t* rwLockID)
+{
+    palRwLock_t* rwLock = NULL;
+
+    if ((NULL == rwLockID) || (NULLPTR == *rwLockID))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    rwLock = (palRwLock_t*)*rwLockID;
+    pal_osSemaphoreDelete(&rwLock->writersGate);
+    pal_osSemaphoreDelete(&rwLock->readersGate);
+    pal_osFree(rwLock);
+    *rwLockID = NULLPTR;
+    return PAL_SUCCESS;
+}
+
+//! A thread which waits for event flags or for a condition variable. Each waiter sleeps on its own semaphore, so the thread
+//! which changed the state wakes exactly the threads it concerns.
+typedef struct palWaiter{
+    palSemaphoreID_t    semaphore;
+    uint32_t            flags;      //! the event flags waited for, the flags which ended the wait after it.
+    uint32_t            options;
+    struct palWaiter*   next;
+} palWaiter_t;
+
+//! The waiters of an object, oldest first, and the waiters it used before with their semaphores, all guarded by lock.
+typedef struct palWaitQueue{
+    palMutexID_t        lock;
+    palWaiter_t*        head;
+    palWaiter_t**       tail;       //! the link a new waiter is appended at, &head when the queue is empty.
+    palWaiter_t*        free;
+} palWaitQueue_t;
+
+PAL_PRIVATE palStatus_t palWaitQueueInit(palWaitQueue_t* queue)
+{
+    memset(queue, 0, sizeof(palWaitQueue_t));
+    queue->tail = &queue->head;
+    return pal_osMutexCreate(&queue->lock);
+}
+
+//! Nobody may wait on the queue any more.
+PAL_PRIVATE void palWaitQueueDestroy(palWaitQueue_t* queue)
+{
+    palWaiter_t* waiter = NULL;
+
+    while (NULL != queue->free)
+    {
+        waiter = queue->free;
+        queue->free = waiter->next;
+        pal_plat_osSemaphoreDelete(&waiter->semaphore);
+        pal_osFree(waiter);
+    }
+    pal_osMutexDelete(&queue->lock);
+}
+
+//! Called with the lock held, a waiter of the queue before is reused so a wait does not create a semaphore.
+PAL_PRIVATE palWaiter_t* palWaiterGet(palWaitQueue_t* queue)
+{
+    palWaiter_t* waiter = queue->free;
+
+    if (NULL != waiter)
+    {
+        queue->free = waiter->next;
+        return waiter;
+    }
+
+    waiter = (palWaiter_t*)pal_osMalloc(sizeof(palWaiter_t));
+    if ((NULL != waiter) && (PAL_SUCCESS != pal_plat_osSemaphoreCreate(0, &waiter->semaphore)))
+    {
+        pal_osFree(waiter);
+        waiter = NULL;
+    }
+    return waiter;
+}
+
+//! Called with the lock held.
+PAL_PRIVATE void palWaitQueueAppend(palWaitQueue_t* queue, palWaiter_t* waiter)
+{
+    waiter->next = NULL;
+    *queue->tail = waiter;
+    queue->tail = &waiter->next;
+}
+
+//! Called with the lock held, the waiter at link leaves the queue.
+PAL_PRIVATE void palWaitQueueUnlink(palWaitQueue_t* queue, palWaiter_t** link)
+{
+    palWaiter_t* waiter = *link;
+
+    *link = waiter->next;
+    if (queue->tail == &waiter->next)
+    {
+        queue->tail = link;
+    }
+    waiter->next = NULL;
+}
+
+//! Called with the lock held, the waiter leaves the queue and its thread is woken.
+PAL_PRIVATE void palWaiterWake(palWaitQueue_t* queue, palWaiter_t** link)
+{
+    palWaiter_t* waiter = *link;
+
+    palWaitQueueUnlink(queue, link);
+    pal_plat_osSemaphoreRelease(waiter->semaphore);
+}
+
+//! Called without the lock, after the waiter was appended. The waiter is back in the free list of the queue on return, its
+//! flags are copied to flags (if not NULL) before another wait may reuse it.
+//! \return PAL_SUCCESS when the waiter was woken, PAL_ERR_RTOS_TIMEOUT when the time ended first.
+PAL_PRIVATE palStatus_t palWaiterSleep(palWaitQueue_t* queue, palWaiter_t* waiter, uint32_t millisec, uint32_t* flags)
+{
+    palStatus_t status = pal_plat_osSemaphoreWait(waiter->semaphore, millisec, NULL);
+    palWaiter_t** link = &queue->head;
+
+    pal_osMutexWait(queue->lock, PAL_RTOS_WAIT_FOREVER);
+    if (PAL_SUCCESS != status)
+    {
+        while ((NULL != *link) && (waiter != *link))
+        {
+            link = &(*link)->next;
+        }
+        if (NULL != *link)
+        {
+            palWaitQueueUnlink(queue, link);
+            status = PAL_ERR_RTOS_TIMEOUT;
+        }
+        else
+        {
+            //! woken after the wait ended but before the lock was taken, the wake left its token in the semaphore.
+            pal_plat_osSemaphoreWait(waiter->semaphore, PAL_RTOS_WAIT_FOREVER, NULL);
+            status = PAL_SUCCESS;
+        }
+    }
+    if (NULL != flags)
+    {
+        *flags = waiter->flags;
+    }
+    waiter->next = queue->free;
+    queue->free = waiter;
+    pal_osMutexRelease(queue->lock);
+    return status;
+}
+
+typedef struct palEventFlags{
+    uint32_t            flags;
+    palWaitQueue_t      waiters;
+} palEventFlags_t;
+
+//! \return true when flags end a wait for wanted with options.
+PAL_PRIVATE bool palEventFlagsMatch(uint32_t flags, uint32_t wanted, uint32_t options)
+{
+    if (0 != (options & PAL_OS_FLAGS_WAIT_ALL))
+    {
+        return (wanted == (flags & wanted));
+    }
+    return (0 != (flags & wanted));
+}
+
+palStatus_t pal_osEventFlagsCreate(palEventFlagsID_t* eventFlagsID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palEventFlags_t* eventFlags = NULL;
+
+    if (NULL == eventFlagsID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    eventFlags = (palEventFlags_t*)pal_osMalloc(sizeof(palEventFlags_t));
+    if (NULL == eventFlags)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+    eventFlags->flags = 0;
+    status = palWaitQueueInit(&eventFlags->waiters);
+    if (PAL_SUCCESS != status)
+    {
+        pal_osFree(eventFlags);
+        return status;
+    }
+    *eventFlagsID = (palEventFlagsID_t)eventFlags;
+    return status;
+}
+
+palStatus_t pal_osEventFlagsSet(palEventFlagsID_t eventFlagsID, uint32_t flags, uint32_t* flagsAfter)
+{
+    palEventFlags_t* eventFlags = (palEventFlags_t*)eventFlagsID;
+    palWaiter_t** link = NULL;
+    palWaiter_t* waiter = NULL;
+    uint32_t seen = 0;
+
+    if (NULLPTR == eventFlagsID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    pal_osMutexWait(eventFlags->waiters.lock, PAL_RTOS_WAIT_FOREVER);
+    eventFlags->flags |= flags;
+    //! the oldest waiters are served first, a waiter which clears the flags it waited for may leave nothing for the next ones.
+    link = &eventFlags->waiters.head;
+    while (NULL != *link)
+    {
+        waiter = *link;
+        seen = eventFlags->flags;
+        if (palEventFlagsMatch(seen, waiter->flags, waiter->options))
+        {
+            if (0 == (waiter->options & PAL_OS_FLAGS_NO_CLEAR))
+            {
+                eventFlags->flags &= ~waiter->flags;
+            }
+            waiter->flags = seen;
+            palWaiterWake(&eventFlags->waiters, link);
+        }
+        else
+        {
+            link = &waiter->next;
+        }
+    }
+    if (NULL != flagsAfter)
+    {
+        *flagsAfter = eventFlags->flags;
+    }
+    pal_osMutexRelease(eventFlags->waiters.lock);
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osEventFlagsClear(palEventFlagsID_t eventFlagsID, uint32_t flags, uint32_t* flagsBefore)
+{
+    palEventFlags_t* eventFlags = (palEventFlags_t*)eventFlagsID;
+
+    if (NULLPTR == eventFlagsID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    pal_osMutexWait(eventFlags->waiters.lock, PAL_RTOS_WAIT_FOREVER);
+    if (NULL != flagsBefore)
+    {
+        *flagsBefore = eventFlags->flags;
+    }
+    eventFlags->flags &= ~flags;
+    pal_osMutexRelease(eventFlags->waiters.lock);
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osEventFlagsWait(palEventFlagsID_t eventFlagsID, uint32_t flags, uint32_t options, uint32_t millisec, uint32_t* flagsOut)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palEventFlags_t* eventFlags = (palEventFlags_t*)eventFlagsID;
+    palWaiter_t* waiter = NULL;
+    uint32_t seen = 0;
+
+    if ((NULLPTR == eventFlagsID) || (0 == flags))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    pal_osMutexWait(eventFlags->waiters.lock, PAL_RTOS_WAIT_FOREVER);
+    seen = eventFlags->flags;
+    if (palEventFlagsMatch(seen, flags, options))
+    {
+        if (0 == (options & PAL_OS_FLAGS_NO_CLEAR))
+        {
+            eventFlags->flags &= ~flags;
+        }
+    }
+    else if (0 == millisec)
+    {
+        status = PAL_ERR_RTOS_TIMEOUT;
+    }
+    else
+    {
+        waiter = palWaiterGet(&eventFlags->waiters);
+        if (NULL == waiter)
+        {
+            status = PAL_ERR_NO_MEMORY;
+        }
+        else
+        {
+            waiter->flags = flags;
+            waiter->options = options;
+            palWaitQueueAppend(&eventFlags->waiters, waiter);
+        }
+    }
+    pal_osMutexRelease(eventFlags->waiters.lock);
+
+    if (NULL != waiter)
+    {
+        status = palWaiterSleep(&eventFlags->waiters, waiter, millisec, &seen);
+    }
+    if ((PAL_SUCCESS == status) && (NULL != flagsOut))
+    {
+        *flagsOut = seen;
+    }
+    return status;
+}
+
+palStatus_t pal_osEventFlagsDelete(palEventFlagsID_t* eventFlagsID)
+{
+    palEventFlags_t* eventFlags = NULL;
+
+    if ((NULL == eventFlagsID) || (NULLPTR == *eventFlagsID))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    eventFlags = (palEventFlags_t*)*eventFlagsID;
+    palWaitQueueDestroy(&eventFlags->waiters);
+    pal_osFree(eventFlags);
+    *eventFlagsID = NULLPTR;
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osCondVarCreate(palCondVarID_t* condVarID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palWaitQueue_t* condVar = NULL;
+
+    if (NULL == condVarID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    condVar = (palWaitQueue_t*)pal_osMalloc(sizeof(palWaitQueue_t));
+    if (NULL == condVar)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+    status = palWaitQueueInit(condVar);
+    if (PAL_SUCCESS != status)
+    {
+        pal_osFree(condVar);
+        return status;
+    }
+    *condVarID = (palCondVarID_t)condVar;
+    return status;
+}
+
+palStatus_t pal_osCondVarWait(palCondVarID_t condVarID, palMutexID_t mutexID, uint32_t millisec)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palWaitQueue_t* condVar = (palWaitQueue_t*)condVarID;
+    palWaiter_t* waiter = NULL;
+    uint32_t depth = 0;
+
+    if ((NULLPTR == condVarID) || (NULLPTR == mutexID))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+#if PAL_RTOS_CONTENTION_PROFILING
+    depth = palMutexDepth(((palLockProfile_t*)mutexID)->platID);
+#else
+    depth = palMutexDepth(mutexID);
+#endif
+    //! one release would leave the mutex held while the thread sleeps, so no thread could change the state and signal.
+    if (depth > 1)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    //! the waiter is queued before the mutex is released, so a signal sent after the state changed under the mutex finds it.
+    pal_osMutexWait(condVar->lock, PAL_RTOS_WAIT_FOREVER);
+    waiter = palWaiterGet(condVar);
+    if (NULL != waiter)
+    {
+        palWaitQueueAppend(condVar, waiter);
+    }
+    pal_osMutexRelease(condVar->lock);
+    if (NULL == waiter)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+
+    status = pal_osMutexRelease(mutexID);
+    if (PAL_SUCCESS != status)
+    {
+        //! the caller does not hold the mutex, the waiter leaves at once.
+        palWaiterSleep(condVar, waiter, 0, NULL);
+        return status;
+    }
+    status = palWaiterSleep(condVar, waiter, millisec, NULL);
+    pal_osMutexWait(mutexID, PAL_RTOS_WAIT_FOREVER);
+    return status;
+}
+
+palStatus_t pal_osCondVarSignal(palCondVarID_t condVarID)
+{
+    palWaitQueue_t* condVar = (palWaitQueue_t*)condVarID;
+
+    if (NULLPTR == condVarID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    pal_osMutexWait(condVar->lock, PAL_RTOS_WAIT_FOREVER);
+    if (NULL != condVar->head)
+    {
+        palWaiterWake(condVar, &condVar->head);
+    }
+    pal_osMutexRelease(condVar->lock);
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osCondVarBroadcast(palCondVarID_t condVarID)
+{
+    palWaitQueue_t* condVar = (palWaitQueue_t*)condVarID;
+
+    if (NULLPTR == condVarID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    pal_osMutexWait(condVar->lock, PAL_RTOS_WAIT_FOREVER);
+    while (NULL != condVar->head)
+    {
+        palWaiterWake(condVar, &condVar->head);
+    }
+    pal_osMutexRelease(condVar->lock);
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osCondVarDelete(palCondVarID_t* condVarID)
+{
+    if ((NULL == condVarID) || (NULLPTR == *condVarID))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    palWaitQueueDestroy((palWaitQueue_t*)*condVarID);
+    pal_osFree((palWaitQueue_t*)*condVarID);
+    *condVarID = NULLPTR;
+    return PAL_SUCCESS;
+}
+
+//! The head of the pool free list packs a change counter (tag) in the high 16 bits with the number of the first free block
+//! (block index + 1, 0 for an empty list) in the low 16 bits. It is swapped with a single 32 bit compare and swap, and the tag
+//! makes the swap fail when the list changed and changed back (ABA) between reading the head and swapping it.
+#define PAL_POOL_BLOCK_NUMBER_MASK  0xFFFFU
+#define PAL_POOL_TAG_INCREMENT      0x10000U
+#define PAL_POOL_ALIGNMENT          sizeof(uint64_t)
+#define PAL_POOL_ALIGN(size)        (((size) + PAL_POOL_ALIGNMENT - 1) & ~(PAL_POOL_ALIGNMENT - 1))
+
+#if PAL_RTOS_POOL_THREAD_CACHE_SIZE
+//! Blocks cached by one PAL thread, only the owner thread reads or writes its cache.
+typedef struct palMemoryPoolCache{
+    uint32_t count;
+    uint32_t hits;
+    uint32_t misses;
+    uint16_t blocks[PAL_RTOS_POOL_THREAD_CACHE_SIZE];
+} palMemoryPoolCache_t;
+#endif //PAL_RTOS_POOL_THREAD_CACHE_SIZE
+
+//! Lock free list of fixed size blocks, shared by the memory pools and the small allocation slab.
+typedef struct palPoolFreeList{
+    uint32_t                freeHead;       //! tagged free list head, see PAL_POOL_BLOCK_NUMBER_MASK.
+    uint32_t                nextUnused;     //! blocks from this index on were never allocated, so they are not in the free list yet.
+    uint32_t                blockSize;
+    uint32_t                blockCount;
+    uint8_t*                blocks;
+} palPoolFreeList_t;
+
+//! Memory pool structure, the blocks follow the structure in the same allocation.
+typedef struct palMemoryPool{
+    palPoolFreeList_t       freeList;
+    int32_t                 sharedMisses;   //! cache misses of callers which are not PAL threads (no cache).
+    int32_t                 failedAllocations;
+#if PAL_RTOS_POOL_THREAD_CACHE_SIZE
+    //! a cache per PAL thread ID, between the structure and the blocks. NULL for small pools, which are not cached so blocks
+    //! cached by idle threads can not exhaust them.
+    palMemoryPoolCache_t*   caches;
+#endif //PAL_RTOS_POOL_THREAD_CACHE_SIZE
+} palMemoryPool_t;
+
+PAL_PRIVATE uint32_t* palPoolBlockLink(palPoolFreeList_t* freeList, uint32_t blockNumber)
+{
+    return (uint32_t*)(freeList->blocks + ((size_t)(blockNumber - 1) * freeList->blockSize));
+}
+
+//! Returns the number of a block of the pool, 0 if the address is not a block of the pool.
+PAL_PRIVATE uint32_t palPoolBlockNumber(palPoolFreeList_t* freeList, void* block)
+{
+    size_t offset = (size_t)((uint8_t*)block - freeList->blocks);
+
+    if (((uint8_t*)block < freeList->blocks) || (offset >= ((size_t)freeList->blockSize * freeList->blockCount)) || (0 != (offset % freeList->blockSize)))
+    {
+        return 0;
+    }
+    return (uint32_t)(offset / freeList->blockSize) + 1;
+}
+
+PAL_PRIVATE uint32_t palPoolPop(palPoolFreeList_t* freeList)
+{
+    uint32_t head = 0;
+    uint32_t blockNumber = 0;
+    uint32_t next = 0;
+
+    do
+    {
+        head = *(volatile uint32_t*)&freeList->freeHead;
+        blockNumber = head & PAL_POOL_BLOCK_NUMBER_MASK;
+        if (0 == blockNumber)
+        {
+            break;
+        }
+        //! the block may be taken by another thread before the swap, then the value read is garbage but the swap fails on the tag.
+        next = *(volatile uint32_t*)palPoolBlockLink(freeList, blockNumber);
+    } while (!pal_plat_osAtomicCompareAndSwap32(&freeList->freeHead, &head, ((head & ~PAL_POOL_BLOCK_NUMBER_MASK) + PAL_POOL_TAG_INCREMENT) | next, PAL_MEMORY_ORDER_ACQUIRE));
+
+    while (0 == blockNumber)
+    {
+        next = *(volatile uint32_t*)&freeList->nextUnused;
+        if (next >= freeList->blockCount)
+        {
+            break;
+        }
+        if (pal_plat_osAtomicCompareAndSwap32(&freeList->nextUnused, &next, next + 1, PAL_MEMORY_ORDER_RELAXED))
+        {
+            blockNumber = next + 1;
+        }
+    }
+    return blockNumber;
+}
+
+//! Push a chain of blocks, already linked from first to last, to the free list with a single swap.
+PAL_PRIVATE void palPoolPushChain(palPoolFreeList_t* freeList, uint32_t first, uint32_t last)
+{
+    uint32_t head = 0;
+
+    do
+    {
+        head = *(volatile uint32_t*)&freeList->freeHead;
+        *palPoolBlockLink(freeList, last) = head & PAL_POOL_BLOCK_NUMBER_MASK;
+    } while (!pal_plat_osAtomicCompareAndSwap32(&freeList->freeHead, &head, ((head & ~PAL_POOL_BLOCK_NUMBER_MASK) + PAL_POOL_TAG_INCREMENT) | first, PAL_MEMORY_ORDER_RELEASE));
+}
+
+#if PAL_RTOS_POOL_THREAD_CACHE_SIZE
+//! Returns the cache of the calling thread, NULL for callers which are not PAL threads (including interrupts).
+PAL_PRIVATE palMemoryPoolCache_t* palPoolThreadCache(palMemoryPool_t* memoryPool)
+{
+    palThreadID_t threadID = PAL_INVALID_THREAD;
+
+    if (NULL == memoryPool->caches)
+    {
+        return NULL;
+    }
+    threadID = pal_plat_osThreadGetId();
+    if (threadID >= PAL_MAX_NUMBER_OF_THREADS)
+    {
+        return NULL;
+    }
+    return &memoryPool->caches[threadID];
+}
+#endif //PAL_RTOS_POOL_THREAD_CACHE_SIZE
+
+PAL_PRIVATE uint32_t palPoolAllocBlock(palMemoryPool_t* memoryPool)
+{
+    uint32_t blockNumber = 0;
+#if PAL_RTOS_POOL_THREAD_CACHE_SIZE
+    palMemoryPoolCache_t* cache = palPoolThreadCache(memoryPool);
+
+    if (NULL != cache)
+    {
+        if (cache->count > 0)
+        {
+            cache->hits++;
+            return cache->blocks[--cache->count];
+        }
+        cache->misses++;
+    }
+    else
+#endif //PAL_RTOS_POOL_THREAD_CACHE_SIZE
+    {
+        pal_osAtomicIncrement(&memoryPool->sharedMisses, 1);
+    }
+
+    blockNumber = palPoolPop(&memoryPool->freeList);
+    if (0 == blockNumber)
+    {
+        pal_osAtomicIncrement(&memoryPool->failedAllocations, 1);
+    }
+    return blockNumber;
+}
+
+//! Keep the block in the calling thread cache if there is room, returns false if the block has to go to the free list.
+PAL_PRIVATE bool palPoolCacheBlock(palMemoryPool_t* memoryPool, uint32_t blockNumber)
+{
+#if PAL_RTOS_POOL_THREAD_CACHE_SIZE
+    palMemoryPoolCache_t* cache = palPoolThreadCache(memoryPool);
+
+    if (NULL != cache)
+    {
+        if (cache->count < PAL_RTOS_POOL_THREAD_CACHE_SIZE)
+        {
+            cache->hits++;
+            cache->blocks[cache->count++] = (uint16_t)blockNumber;
+            return true;
+        }
+        cache->misses++;
+        return false;
+    }
+#endif //PAL_RTOS_POOL_THREAD_CACHE_SIZE
+    pal_osAtomicIncrement(&memoryPool->sharedMisses, 1);
+    return false;
+}
+
+palStatus_t pal_osPoolCreate(uint32_t blockSize, uint32_t blockCount, palMemoryPoolID_t* memoryPoolID)
+{
+    palMemoryPool_t* memoryPool = NULL;
+    size_t headerSize = PAL_POOL_ALIGN(sizeof(palMemoryPool_t));
+#if PAL_RTOS_POOL_THREAD_CACHE_SIZE
+    bool useCaches = false;
+#endif //PAL_RTOS_POOL_THREAD_CACHE_SIZE
+
+    if ((NULL == memoryPoolID) || (0 == blockSize) || (0 == blockCount) || (blockCount > PAL_RTOS_POOL_MAX_BLOCKS))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+#if PAL_RTOS_POOL_THREAD_CACHE_SIZE
+    useCaches = (blockCount >= (2 * PAL_MAX_NUMBER_OF_THREADS * PAL_RTOS_POOL_THREAD_CACHE_SIZE));
+    if (useCaches)
+    {
+        headerSize += PAL_POOL_ALIGN(PAL_MAX_NUMBER_OF_THREADS * sizeof(palMemoryPoolCache_t));
+    }
+#endif //PAL_RTOS_POOL_THREAD_CACHE_SIZE
+
+    //! the block holds the free list link while it is free.
+    blockSize = PAL_POOL_ALIGN((blockSize < sizeof(uint32_t)) ? sizeof(uint32_t) : blockSize);
+    if (((SIZE_MAX - headerSize) / blockSize) < blockCount)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+
+    //! the blocks are neither zeroed nor linked here, they join the free list when they are freed for the first time.
+    memoryPool = (palMemoryPool_t*)pal_plat_malloc(headerSize + ((size_t)blockSize * blockCount));
+    if (NULL == memoryPool)
+    {
+        *memoryPoolID = NULLPTR;
+        return PAL_ERR_NO_MEMORY;
+    }
+
+    memset(memoryPool, 0, headerSize);
+    memoryPool->freeList.blockSize = blockSize;
+    memoryPool->freeList.blockCount = blockCount;
+    memoryPool->freeList.blocks = (uint8_t*)memoryPool + headerSize;
+#if PAL_RTOS_POOL_THREAD_CACHE_SIZE
+    if (useCaches)
+    {
+        memoryPool->caches = (palMemoryPoolCache_t*)((uint8_t*)memoryPool + PAL_POOL_ALIGN(sizeof(palMemoryPool_t)));
+    }
+#endif //PAL_RTOS_POOL_THREAD_CACHE_SIZE
+    *memoryPoolID = (palMemoryPoolID_t)memoryPool;
+    return PAL_SUCCESS;
+}
+
+void* pal_osPoolAlloc(palMemoryPoolID_t memoryPoolID)
+{
+    palMemoryPool_t* memoryPool = (palMemoryPool_t*)memoryPoolID;
+    uint32_t blockNumber = 0;
+
+    if (NULLPTR == memoryPoolID)
+    {
+        return NULL;
+    }
+
+    blockNumber = palPoolAllocBlock(memoryPool);
+    if (0 == blockNumber)
+    {
+        return NULL;
+    }
+    return palPoolBlockLink(&memoryPool->freeList, blockNumber);
+}
+
+void* pal_osPoolCAlloc(palMemoryPoolID_t memoryPoolID)
+{
+    void* result;
+    //! a failed allocation is counted in the failedAllocations of pal_osPoolGetStats.
+    result = pal_osPoolAlloc(memoryPoolID);
+    if (NULL != result)
+    {
+        memset(result, 0, ((palMemoryPool_t*)memoryPoolID)->freeList.blockSize);
+    }
+    return result;
+}
+
+palStatus_t pal_osPoolFree(palMemoryPoolID_t memoryPoolID, void* block)
+{
+    palMemoryPool_t* memoryPool = (palMemoryPool_t*)memoryPoolID;
+    uint32_t blockNumber = 0;
+
+    if ((NULLPTR == memoryPoolID) || (NULL == block))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    blockNumber = palPoolBlockNumber(&memoryPool->freeList, block);
+    if (0 == blockNumber)
+    {
+        return PAL_ERR_RTOS_PARAMETER;
+    }
+
+    if (!palPoolCacheBlock(memoryPool, blockNumber))
+    {
+        palPoolPushChain(&memoryPool->freeList, blockNumber, blockNumber);
+    }
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osPoolAllocBulk(palMemoryPoolID_t memoryPoolID, void** blocks, uint32_t count, uint32_t* allocatedCount)
+{
+    palMemoryPool_t* memoryPool = (palMemoryPool_t*)memoryPoolID;
+    uint32_t blockNumber = 0;
+    uint32_t i = 0;
+
+    if ((NULLPTR == memoryPoolID) || (NULL == blocks) || (NULL == allocatedCount))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    for (i = 0; i < count; ++i)
+    {
+        blockNumber = palPoolAllocBlock(memoryPool);
+        if (0 == blockNumber)
+        {
+            break;
+        }
+        blocks[i] = palPoolBlockLink(&memoryPool->freeList, blockNumber);
+    }
+    *allocatedCount = i;
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osPoolFreeBulk(palMemoryPoolID_t memoryPoolID, void** blocks, uint32_t count)
+{
+    palMemoryPool_t* memoryPool = (palMemoryPool_t*)memoryPoolID;
+    uint32_t first = 0;
+    uint32_t last = 0;
+    uint32_t blockNumber = 0;
+    uint32_t i = 0;
+
+    if ((NULLPTR == memoryPoolID) || (NULL == blocks))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    for (i = 0; i < count; ++i)
+    {
+        if ((NULL == blocks[i]) || (0 == palPoolBlockNumber(&memoryPool->freeList, blocks[i])))
+        {
+            return PAL_ERR_RTOS_PARAMETER;
+        }
+    }
+
+    //! fill the thread cache first, the rest is linked into one chain and pushed to the free list with a single swap.
+    for (i = 0; i < count; ++i)
+    {
+        blockNumber = palPoolBlockNumber(&memoryPool->freeList, blocks[i]);
+        if (!palPoolCacheBlock(memoryPool, blockNumber))
+        {
+            if (0 == first)
+            {
+                first = blockNumber;
+            }
+            else
+            {
+                *palPoolBlockLink(&memoryPool->freeList, last) = blockNumber;
+            }
+            last = blockNumber;
+        }
+    }
+
+    if (0 != first)
+    {
+        palPoolPushChain(&memoryPool->freeList, first, last);
+    }
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osPoolGetStats(palMemoryPoolID_t memoryPoolID, palMemoryPoolStats_t* stats)
+{
+    palMemoryPool_t* memoryPool = (palMemoryPool_t*)memoryPoolID;
+#if PAL_RTOS_POOL_THREAD_CACHE_SIZE
+    uint32_t i = 0;
+#endif //PAL_RTOS_POOL_THREAD_CACHE_SIZE
+
+    if ((NULLPTR == memoryPoolID) || (NULL == stats))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    stats->blockSize = memoryPool->freeList.blockSize;
+    stats->blockCount = memoryPool->freeList.blockCount;
+    stats->cacheHits = 0;
+    stats->cacheMisses = (uint32_t)memoryPool->sharedMisses;
+    stats->failedAllocations = (uint32_t)memoryPool->failedAllocations;
+#if PAL_RTOS_POOL_THREAD_CACHE_SIZE
+    //! the caches are updated by their threads without synchronization, the sums are a snapshot.
+    for (i = 0; (NULL != memoryPool->caches) && (i < PAL_MAX_NUMBER_OF_THREADS); ++i)
+    {
+        stats->cacheHits += memoryPool->caches[i].hits;
+        stats->cacheMisses += memoryPool->caches[i].misses;
+    }
+#endif //PAL_RTOS_POOL_THREAD_CACHE_SIZE
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osPoolDestroy(palMemoryPoolID_t* memoryPoolID)
+{
+    if ((NULL == memoryPoolID) || (NULLPTR == *memoryPoolID))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    pal_plat_free((void*)*memoryPoolID);
+    *memoryPoolID = NULLPTR;
+    return PAL_SUCCESS;
+}
+
+//! The small allocation slab has one lock free block list per size class (see PAL_SLAB_SIZE_CLASSES), all carved from one static arena.
+#define PAL_SLAB_CLASS(blockSize, blockCount) + (PAL_POOL_ALIGN(blockSize) * (blockCount))
+PAL_PRIVATE uint64_t s_palSlabArena[(0 PAL_SLAB_SIZE_CLASSES) / sizeof(uint64_t)];
+#undef PAL_SLAB_CLASS
+
+typedef struct palSlabClass{
+    palPoolFreeList_t   freeList;
+    int32_t             inUse;
+    int32_t             peakInUse;
+    int32_t             allocations;
+    int32_t             heapFallbacks;
+} palSlabClass_t;
+
+#define PAL_SLAB_CLASS(blockSize, blockCount) { { 0, 0, PAL_POOL_ALIGN(blockSize), (blockCount), NULL }, 0, 0, 0, 0 },
+PAL_PRIVATE palSlabClass_t s_palSlabClasses[] = { PAL_SLAB_SIZE_CLASSES };
+#undef PAL_SLAB_CLASS
+
+#define PAL_SLAB_NUMBER_OF_CLASSES (sizeof(s_palSlabClasses) / sizeof(s_palSlabClasses[0]))
+
+PAL_PRIVATE uint32_t s_palSlabInitialized = 0;
+
+//! Point each class to its part of the arena. Every caller writes the same values, and the flag is published with release so
+//! a caller which sees it set also sees the class pointers.
+PAL_PRIVATE void palSlabInit(void)
+{
+    uint8_t* arena = (uint8_t*)s_palSlabArena;
+    uint32_t i = 0;
+
+    for (i = 0; i < PAL_SLAB_NUMBER_OF_CLASSES; ++i)
+    {
+        s_palSlabClasses[i].freeList.blocks = arena;
+        arena += (size_t)s_palSlabClasses[i].freeList.blockSize * s_palSlabClasses[i].freeList.blockCount;
+    }
+    pal_plat_osAtomicStore32(&s_palSlabInitialized, 1, PAL_MEMORY_ORDER_RELEASE);
+}
+
+void* pal_osMalloc(size_t len)
+{
+    palSlabClass_t* slabClass = NULL;
+    uint32_t blockNumber = 0;
+    int32_t inUse = 0;
+    int32_t peak = 0;
+    uint32_t i = 0;
+
+    if (0 == pal_plat_osAtomicLoad32(&s_palSlabInitialized, PAL_MEMORY_ORDER_ACQUIRE))
+    {
+        palSlabInit();
+    }
+
+    for (i = 0; i < PAL_SLAB_NUMBER_OF_CLASSES; ++i)
+    {
+        slabClass = &s_palSlabClasses[i];
+        if (len <= slabClass->freeList.blockSize)
+        {
+            blockNumber = palPoolPop(&slabClass->freeList);
+            if (0 == blockNumber)
+            {
+                pal_osAtomicIncrement(&slabClass->heapFallbacks, 1);
+                break; //! the class is exhausted, the platform heap serves the allocation.
+            }
+
+            pal_osAtomicIncrement(&slabClass->allocations, 1);
+            inUse = pal_osAtomicIncrement(&slabClass->inUse, 1);
+            do
+            {
+                peak = *(volatile int32_t*)&slabClass->peakInUse;
+            } while ((inUse > peak) && !pal_plat_osAtomicCompareAndSwap32((uint32_t*)&slabClass->peakInUse, (uint32_t*)&peak, (uint32_t)inUse, PAL_MEMORY_ORDER_RELAXED));
+            return palPoolBlockLink(&slabClass->freeList, blockNumber);
+        }
+    }
+    return pal_plat_malloc(len);
+}
+
+void pal_osFree(void* buffer)
+{
+    palSlabClass_t* slabClass = NULL;
+    uint32_t blockNumber = 0;
+    uint32_t i = 0;
+
+    if (NULL == buffer)
+    {
+        return;
+    }
+
+    if (((uint8_t*)buffer >= (uint8_t*)s_palSlabArena) && ((uint8_t*)buffer < ((uint8_t*)s_palSlabArena + sizeof(s_palSlabArena))))
+    {
+        for (i = 0; i < PAL_SLAB_NUMBER_OF_CLASSES; ++i)
+        {
+            slabClass = &s_palSlabClasses[i];
+            blockNumber = palPoolBlockNumber(&slabClass->freeList, buffer);
+            if (0 != blockNumber)
+            {
+                pal_osAtomicIncrement(&slabClass->inUse, -1);
+                palPoolPushChain(&slabClass->freeList, blockNumber, blockNumber);
+                return;
+            }
+        }
+    }
+    pal_plat_free(buffer);
+}
+
+palStatus_t pal_osMallocGetStats(uint32_t classIndex, palSlabClassStats_t* stats)
+{
+    palSlabClass_t* slabClass = NULL;
+
+    if ((NULL == stats) || (classIndex >= PAL_SLAB_NUMBER_OF_CLASSES))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    slabClass = &s_palSlabClasses[classIndex];
+    stats->blockSize = slabClass->freeList.blockSize;
+    stats->blockCount = slabClass->freeList.blockCount;
+    stats->inUse = (uint32_t)slabClass->inUse;
+    stats->peakInUse = (uint32_t)slabClass->peakInUse;
+    stats->allocations = (uint32_t)slabClass->allocations;
+    stats->heapFallbacks = (uint32_t)slabClass->heapFallbacks;
+    return PAL_SUCCESS;
+}
+
+//! Every stack of the thread stack pool follows a header, a thread which overflows its stack overwrites the magic first.
+typedef struct palThreadStackHeader{
+    uint32_t    magic;
+    uint32_t    stackSize;
+    uint32_t    classIndex;     //! PAL_THREAD_STACK_NO_CLASS for a stack larger than every class.
+    uint32_t    dirtyBytes;     //! the bytes from the top which may not hold the paint any more.
+} palThreadStackHeader_t;
+
+#define PAL_THREAD_STACK_MAGIC 0x4B415453 // "STAK"
+#define PAL_THREAD_STACK_NO_CLASS 0xFFFFFFFF
+
+//! The freed stacks each class keeps, PAL_THREAD_STACK_CLASS(stackSize, stackCount) reserves stackCount slots.
+#define PAL_THREAD_STACK_CLASS(stackSize, stackCount) + (stackCount)
+PAL_PRIVATE void* s_palThreadStackCache[0 PAL_THREAD_STACK_CLASSES];
+#undef PAL_THREAD_STACK_CLASS
+
+typedef struct palThreadStackClass{
+    uint32_t    stackSize;
+    uint32_t    stackCount;
+    void**      cache;          //! stackCount slots of s_palThreadStackCache, a slot holds a freed stack or NULL.
+    int32_t     inUse;
+    int32_t     allocations;
+    int32_t     heapAllocations;
+    uint32_t    highWaterMark;
+} palThreadStackClass_t;
+
+#define PAL_THREAD_STACK_CLASS(stackSize, stackCount) { PAL_POOL_ALIGN(stackSize), (stackCount), NULL, 0, 0, 0, 0 },
+PAL_PRIVATE palThreadStackClass_t s_palThreadStackClasses[] = { PAL_THREAD_STACK_CLASSES };
+#undef PAL_THREAD_STACK_CLASS
+
+#define PAL_THREAD_STACK_NUMBER_OF_CLASSES (sizeof(s_palThreadStackClasses) / sizeof(s_palThreadStackClasses[0]))
+
+PAL_PRIVATE uint32_t s_palThreadStackInitialized = 0;
+
+//! Point each class to its cache slots. Every caller writes the same values, and the flag is published with release so
+//! a caller which sees it set also sees the cache pointers.
+PAL_PRIVATE void palThreadStackInit(void)
+{
+    void** cache = s_palThreadStackCache;
+    uint32_t i = 0;
+
+    for (i = 0; i < PAL_THREAD_STACK_NUMBER_OF_CLASSES; ++i)
+    {
+        s_palThreadStackClasses[i].cache = cache;
+        cache += s_palThreadStackClasses[i].stackCount;
+    }
+    pal_plat_osAtomicStore32(&s_palThreadStackInitialized, 1, PAL_MEMORY_ORDER_RELEASE);
+}
+
+PAL_PRIVATE palThreadStackHeader_t* palThreadStackHeader(const uint32_t* stackPtr)
+{
+    palThreadStackHeader_t* header = NULL;
+
+    if (NULL != stackPtr)
+    {
+        header = (palThreadStackHeader_t*)stackPtr - 1;
+        if (PAL_THREAD_STACK_MAGIC != header->magic)
+        {
+            header = NULL;
+        }
+    }
+    return header;
+}
+
+#if PAL_THREAD_STACK_PAINT
+//! The stacks grow down, the paint left at the bottom of the stack was never reached.
+PAL_PRIVATE uint32_t palThreadStackUsed(const palThreadStackHeader_t* header)
+{
+    const uint32_t* word = (const uint32_t*)(header + 1);
+    const uint32_t* end = word + (header->stackSize / sizeof(uint32_t));
+
+    while ((word < end) && (PAL_THREAD_STACK_PAINT_PATTERN == *word))
+    {
+        ++word;
+    }
+    return (uint32_t)((end - word) * sizeof(uint32_t));
+}
+#endif //PAL_THREAD_STACK_PAINT
+
+palStatus_t pal_osThreadStackAlloc(uint32_t stackSize, uint32_t** stackPtr)
+{
+    palThreadStackClass_t* stackClass = NULL;
+    palThreadStackHeader_t* header = NULL;
+    uint32_t classIndex = PAL_THREAD_STACK_NO_CLASS;
+    uint32_t i = 0;
+
+    if ((NULL == stackPtr) || (0 == stackSize))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    if (0 == pal_plat_osAtomicLoad32(&s_palThreadStackInitialized, PAL_MEMORY_ORDER_ACQUIRE))
+    {
+        palThreadStackInit();
+    }
+
+    for (i = 0; i < PAL_THREAD_STACK_NUMBER_OF_CLASSES; ++i)
+    {
+        if (stackSize <= s_palThreadStackClasses[i].stackSize)
+        {
+            classIndex = i;
+            stackClass = &s_palThreadStackClasses[i];
+            break;
+        }
+    }
+
+    if (NULL != stackClass)
+    {
+        for (i = 0; (NULL == header) && (i < stackClass->stackCount); ++i)
+        {
+            if (NULL != pal_osAtomicLoadPointer(&stackClass->cache[i], PAL_MEMORY_ORDER_RELAXED))
+            {
+                header = (palThreadStackHeader_t*)pal_osAtomicExchangePointer(&stackClass->cache[i], NULL, PAL_MEMORY_ORDER_ACQUIRE);
+            }
+        }
+        pal_osAtomicIncrement(&stackClass->allocations, 1);
+        pal_osAtomicIncrement(&stackClass->inUse, 1);
+        stackSize = stackClass->stackSize;
+    }
+    else
+    {
+        stackSize = PAL_POOL_ALIGN(stackSize);
+    }
+
+    if (NULL == header)
+    {
+        header = (palThreadStackHeader_t*)pal_plat_malloc(sizeof(palThreadStackHeader_t) + stackSize);
+        if (NULL == header)
+        {
+            if (NULL != stackClass)
+            {
+                pal_osAtomicIncrement(&stackClass->allocations, -1);
+                pal_osAtomicIncrement(&stackClass->inUse, -1);
+            }
+            return PAL_ERR_NO_MEMORY;
+        }
+        if (NULL != stackClass)
+        {
+            pal_osAtomicIncrement(&stackClass->heapAllocations, 1);
+        }
+        header->magic = PAL_THREAD_STACK_MAGIC;
+        header->stackSize = stackSize;
+        header->classIndex = classIndex;
+        header->dirtyBytes = stackSize;
+    }
+
+#if PAL_THREAD_STACK_PAINT
+    //! a reused stack is painted again only as deep as its previous thread reached.
+    for (i = (stackSize - header->dirtyBytes) / sizeof(uint32_t); i < (stackSize / sizeof(uint32_t)); ++i)
+    {
+        ((uint32_t*)(header + 1))[i] = PAL_THREAD_STACK_PAINT_PATTERN;
+    }
+    header->dirtyBytes = 0;
+#endif //PAL_THREAD_STACK_PAINT
+
+    *stackPtr = (uint32_t*)(header + 1);
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osThreadStackFree(uint32_t** stackPtr)
+{
+    palThreadStackClass_t* stackClass = NULL;
+    palThreadStackHeader_t* header = NULL;
+    uint32_t highWaterMark = 0;
+    void* expected = NULL;
+    uint32_t i = 0;
+
+    if ((NULL == stackPtr) || (NULL == (header = palThreadStackHeader(*stackPtr))))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+#if PAL_THREAD_STACK_PAINT
+    header->dirtyBytes = palThreadStackUsed(header);
+#else
+    header->dirtyBytes = header->stackSize;
+#endif //PAL_THREAD_STACK_PAINT
+
+    if (header->classIndex < PAL_THREAD_STACK_NUMBER_OF_CLASSES)
+    {
+        stackClass = &s_palThreadStackClasses[header->classIndex];
+        highWaterMark = pal_osAtomicLoad32(&stackClass->highWaterMark, PAL_MEMORY_ORDER_RELAXED);
+        while ((header->dirtyBytes > highWaterMark) && !pal_osAtomicCompareAndSwap32(&stackClass->highWaterMark, &highWaterMark, header->dirtyBytes, PAL_MEMORY_ORDER_RELAXED));
+        pal_osAtomicIncrement(&stackClass->inUse, -1);
+
+        for (i = 0; i < stackClass->stackCount; ++i)
+        {
+            expected = NULL;
+            if (pal_osAtomicCompareAndSwapPointer(&stackClass->cache[i], &expected, header, PAL_MEMORY_ORDER_RELEASE))
+            {
+                header = NULL;
+                break;
+            }
+        }
+    }
+
+    pal_plat_free(header); //! NULL when the class kept the stack.
+    *stackPtr = NULL;
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osThreadStackHighWaterMark(const uint32_t* stackPtr, uint32_t* usedBytes)
+{
+    palThreadStackHeader_t* header = palThreadStackHeader(stackPtr);
+
+    if ((NULL == header) || (NULL == usedBytes))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+#if PAL_THREAD_STACK_PAINT
+    *usedBytes = palThreadStackUsed(header);
+    return PAL_SUCCESS;
+#else
+    return PAL_ERR_NOT_SUPPORTED;
+#endif //PAL_THREAD_STACK_PAINT
+}
+
+palStatus_t pal_osThreadStackGetStats(uint32_t classIndex, palThreadStackClassStats_t* stats)
+{
+    palThreadStackClass_t* stackClass = NULL;
+    uint32_t i = 0;
+
+    if ((NULL == stats) || (classIndex >= PAL_THREAD_STACK_NUMBER_OF_CLASSES))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    if (0 == pal_plat_osAtomicLoad32(&s_palThreadStackInitialized, PAL_MEMORY_ORDER_ACQUIRE))
+    {
+        palThreadStackInit();
+    }
+
+    stackClass = &s_palThreadStackClasses[classIndex];
+    stats->stackSize = stackClass->stackSize;
+    stats->stackCount = stackClass->stackCount;
+    stats->inUse = (uint32_t)stackClass->inUse;
+    stats->cached = 0;
+    for (i = 0; i < stackClass->stackCount; ++i)
+    {
+        stats->cached += (NULL != pal_osAtomicLoadPointer(&stackClass->cache[i], PAL_MEMORY_ORDER_RELAXED)) ? 1 : 0;
+    }
+    stats->allocations = (uint32_t)stackClass->allocations;
+    stats->heapAllocations = (uint32_t)stackClass->heapAllocations;
+    stats->highWaterMark = stackClass->highWaterMark;
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osMessageQueueCreate(uint32_t messageQSize, palMessageQID_t* messageQID)
+{
+    palStatus_t status;
+    status = pal_plat_osMessageQueueCreate(messageQSize, sizeof(uint32_t), messageQID);
+    return status;
+}
+
+palStatus_t pal_osMessagePut(palMessageQID_t messageQID, uint32_t info, uint32_t timeout)
+{
+    palStatus_t status;
+    status = pal_plat_osMessagePut(messageQID, &info, timeout);
+    return status;
+}
+
+palStatus_t pal_osMessageGet(palMessageQID_t messageQID, uint32_t timeout, uint32_t* messageValue)
+{
+    palStatus_t status;
+    status = pal_plat_osMessageGet(messageQID, timeout, messageValue);
+    return status;
+}
+
+palStatus_t pal_osMessageQueueCreateTyped(uint32_t messageQSize, uint32_t messageSize, palMessageQID_t* messageQID)
+{
+    palStatus_t status;
+    status = pal_plat_osMessageQueueCreate(messageQSize, messageSize, messageQID);
+    return status;
+}
+
+palStatus_t pal_osMessagePutTyped(palMessageQID_t messageQID, const void* message, uint32_t timeout)
+{
+    palStatus_t status;
+    status = pal_plat_osMessagePut(messageQID, message, timeout);
+    return status;
+}
+
+palStatus_t pal_osMessageGetTyped(palMessageQID_t messageQID, uint32_t timeout, void* message)
+{
+    palStatus_t status;
+    status = pal_plat_osMessageGet(messageQID, timeout, message);
+    return status;
+}
+
+palStatus_t pal_osMessagePutBatch(palMessageQID_t messageQID, const void* messages, uint32_t count, uint32_t timeout, uint32_t* putCount)
+{
+    palStatus_t status;
+    status = pal_plat_osMessagePutBatch(messageQID, messages, count, timeout, putCount);
+    return status;
+}
+
+palStatus_t pal_osMessageGetBatch(palMessageQID_t messageQID, uint32_t timeout, void* messages, uint32_t count, uint32_t* getCount)
+{
+    palStatus_t status;
+    status = pal_plat_osMessageGetBatch(messageQID, timeout, messages, count, getCount);
+    return status;
+}
+
+palStatus_t pal_osMessageQueueDestroy(palMessageQID_t* messageQID)
+{
+    palStatus_t status;
+    status = pal_plat_osMessageQueueDestroy(messageQID);
+    return status;
+}
+
+//! One side of a single producer single consumer ring, written only by its own thread except for the waiting flag.
+typedef struct palSpscRingSide{
+    uint32_t                position;       //! free running count of the elements this side moved.
+    uint32_t                otherPosition;  //! position of the other side when last read, saves reading its cache line on every call.
+    uint32_t                waiting;        //! set while this side waits on its semaphore, cleared by the side which posts it.
+    palSemaphoreID_t        semaphore;      //! NULLPTR in a non blocking ring.
+} palSpscRingSide_t;
+
+typedef struct palSpscRingLayout{
+    uint8_t*                elements;
+    void*                   allocation;     //! the address to free, the ring is aligned up from it to a cache line.
+    uint32_t                mask;           //! capacity - 1.
+    uint32_t                elementSize;
+} palSpscRingLayout_t;
+
+//! Each part of the ring is kept in its own cache line, so the producer and the consumer do not invalidate each other's lines.
+#define PAL_SPSC_RING_CACHE_LINE(type) union { type fields; uint8_t line[PAL_CACHE_LINE_SIZE]; }
+
+//! Single producer single consumer ring structure, the elements follow the structure in the same allocation.
+typedef struct palSpscRing{
+    PAL_SPSC_RING_CACHE_LINE(palSpscRingLayout_t)   layout;
+    PAL_SPSC_RING_CACHE_LINE(palSpscRingSide_t)     producer;
+    PAL_SPSC_RING_CACHE_LINE(palSpscRingSide_t)     consumer;
+} palSpscRing_t;
+
+/*! Get the number of elements a side can move without waiting.
+*   The producer can fill capacity - (producer - consumer) slots and the consumer can take consumer - producer elements,
+*   so both are capacityTerm + otherPosition - position (modulo 2^32).
+*/
+PAL_PRIVATE uint32_t palSpscRingAvailable(palSpscRingSide_t* self, palSpscRingSide_t* other, uint32_t capacityTerm)
+{
+    uint32_t available = capacityTerm + self->otherPosition - self->position;
+
+    if (0 == available)
+    {
+        self->otherPosition = pal_plat_osAtomicLoad32(&other->position, PAL_MEMORY_ORDER_ACQUIRE);
+        available = capacityTerm + self->otherPosition - self->position;
+    }
+    return available;
+}
+
+//! Wait on the side semaphore until the side can move an element or the timeout expires.
+PAL_PRIVATE palStatus_t palSpscRingWait(palSpscRingSide_t* self, palSpscRingSide_t* other, uint32_t capacityTerm, uint32_t timeout)
+{
+    palStatus_t status = PAL_SUCCESS;
+    uint64_t start = 0;
+    uint64_t elapsed = 0;
+    uint32_t waitTime = PAL_RTOS_WAIT_FOREVER;
+    int32_t countersAvailable = 0;
+
+    if ((0 == timeout) || (NULLPTR == self->semaphore))
+    {
+        return PAL_ERR_RTOS_RESOURCE;
+    }
+
+    start = pal_osKernelSysTick64();
+    while (0 == palSpscRingAvailable(self, other, capacityTerm))
+    {
+        if (PAL_RTOS_WAIT_FOREVER != timeout)
+        {
+            elapsed = pal_osKernelSysMilliSecTick(pal_osKernelSysTick64() - start);
+            if (elapsed >= timeout)
+            {
+                return PAL_ERR_RTOS_TIMEOUT;
+            }
+            waitTime = timeout - (uint32_t)elapsed;
+        }
+
+        //! the sequentially consistent exchange makes the flag visible before the position of the other side is read again. the other side
+        //! publishes its position before it reads the flag, so either this check sees the new position or the other side posts the semaphore.
+        pal_plat_osAtomicExchange32(&self->waiting, 1, PAL_MEMORY_ORDER_SEQ_CST);
+        if (0 == palSpscRingAvailable(self, other, capacityTerm))
+        {
+            status = pal_osSemaphoreWait(self->semaphore, waitTime, &countersAvailable);
+        }
+        pal_plat_osAtomicExchange32(&self->waiting, 0, PAL_MEMORY_ORDER_SEQ_CST);
+        if ((PAL_SUCCESS != status) && (PAL_ERR_RTOS_TIMEOUT != status))
+        {
+            return status;
+        }
+    }
+    return PAL_SUCCESS;
+}
+
+//! Post the semaphore of the other side if it waits, called after this side published its position.
+PAL_PRIVATE void palSpscRingWake(palSpscRingSide_t* other)
+{
+    pal_plat_osAtomicFence(PAL_MEMORY_ORDER_SEQ_CST);
+    if ((0 != pal_plat_osAtomicLoad32(&other->waiting, PAL_MEMORY_ORDER_ACQUIRE)) && (0 != pal_plat_osAtomicExchange32(&other->waiting, 0, PAL_MEMORY_ORDER_ACQ_REL)))
+    {
+        pal_osSemaphoreRelease(other->semaphore);
+    }
+}
+
+palStatus_t pal_osSpscRingCreate(uint32_t capacity, uint32_t elementSize, bool blocking, palSpscRingID_t* ringID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palSpscRing_t* ring = NULL;
+    void* allocation = NULL;
+    size_t headerSize = sizeof(palSpscRing_t) + PAL_CACHE_LINE_SIZE - 1;
+
+    if ((NULL == ringID) || (0 == elementSize) || (0 == capacity) || (0 != (capacity & (capacity - 1))) || (capacity > 0x80000000U))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    if (((SIZE_MAX - headerSize) / elementSize) < capacity)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+
+    allocation = pal_plat_malloc(headerSize + ((size_t)elementSize * capacity));
+    if (NULL == allocation)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+
+    ring = (palSpscRing_t*)(((uintptr_t)allocation + PAL_CACHE_LINE_SIZE - 1) & ~((uintptr_t)PAL_CACHE_LINE_SIZE - 1));
+    memset(ring, 0, sizeof(palSpscRing_t));
+    ring->layout.fields.elements = (uint8_t*)(ring + 1);
+    ring->layout.fields.allocation = allocation;
+    ring->layout.fields.mask = capacity - 1;
+    ring->layout.fields.elementSize = elementSize;
+
+    if (blocking)
+    {
+        status = pal_osSemaphoreCreate(0, &ring->producer.fields.semaphore);
+        if (PAL_SUCCESS == status)
+        {
+            status = pal_osSemaphoreCreate(0, &ring->consumer.fields.semaphore);
+            if (PAL_SUCCESS != status)
+            {
+                pal_osSemaphoreDelete(&ring->producer.fields.semaphore);
+            }
+        }
+        if (PAL_SUCCESS != status)
+        {
+            pal_plat_free(allocation);
+            return status;
+        }
+    }
+
+    *ringID = (palSpscRingID_t)ring;
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osSpscRingPush(palSpscRingID_t ringID, const void* element, uint32_t timeout)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palSpscRing_t* ring = (palSpscRing_t*)ringID;
+    palSpscRingSide_t* producer = NULL;
+    uint32_t capacity = 0;
+
+    if ((NULLPTR == ringID) || (NULL == element))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    producer = &ring->producer.fields;
+    capacity = ring->layout.fields.mask + 1;
+    if (0 == palSpscRingAvailable(producer, &ring->consumer.fields, capacity))
+    {
+        status = palSpscRingWait(producer, &ring->consumer.fields, capacity, timeout);
+        if (PAL_SUCCESS != status)
+        {
+            return status;
+        }
+    }
+
+    memcpy(ring->layout.fields.elements + ((size_t)(producer->position & ring->layout.fields.mask) * ring->layout.fields.elementSize), element, ring->layout.fields.elementSize);
+    pal_plat_osAtomicStore32(&producer->position, producer->position + 1, PAL_MEMORY_ORDER_RELEASE);
+    if (NULLPTR != producer->semaphore)
+    {
+        palSpscRingWake(&ring->consumer.fields);
+    }
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osSpscRingPop(palSpscRingID_t ringID, uint32_t timeout, void* element)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palSpscRing_t* ring = (palSpscRing_t*)ringID;
+    palSpscRingSide_t* consumer = NULL;
+
+    if ((NULLPTR == ringID) || (NULL == element))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    consumer = &ring->consumer.fields;
+    if (0 == palSpscRingAvailable(consumer, &ring->producer.fields, 0))
+    {
+        status = palSpscRingWait(consumer, &ring->producer.fields, 0, timeout);
+        if (PAL_SUCCESS != status)
+        {
+            return status;
+        }
+    }
+
+    memcpy(element, ring->layout.fields.elements + ((size_t)(consumer->position & ring->layout.fields.mask) * ring->layout.fields.elementSize), ring->layout.fields.elementSize);
+    pal_plat_osAtomicStore32(&consumer->position, consumer->position + 1, PAL_MEMORY_ORDER_RELEASE);
+    if (NULLPTR != consumer->semaphore)
+    {
+        palSpscRingWake(&ring->producer.fields);
+    }
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osSpscRingDestroy(palSpscRingID_t* ringID)
+{
+    palSpscRing_t* ring = NULL;
+
+    if ((NULL == ringID) || (NULLPTR == *ringID))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    ring = (palSpscRing_t*)*ringID;
+    if (NULLPTR != ring->producer.fields.semaphore)
+    {
+        pal_osSemaphoreDelete(&ring->producer.fields.semaphore);
+        pal_osSemaphoreDelete(&ring->consumer.fields.semaphore);
+    }
+    pal_plat_free(ring->layout.fields.allocation);
+    *ringID = NULLPTR;
+    return PAL_SUCCESS;
+}
+
+#define PAL_WORK_PRIORITY_LEVELS (PAL_WORK_PRIORITY_LOW + 1)
+
+//! A closure submitted to an executor.
+typedef struct palExecutorWork{
+    palWorkFuncPtr  function;
+    void*           funcArgument;
+    palWorkFuncPtr  completion;
+    void*           completionArgument;
+} palExecutorWork_t;
+
+typedef struct palExecutorCell{
+    uint32_t            sequence;   //! the queue position the cell can be written (position) or read (position + 1) at
+    palExecutorWork_t   work;
+} palExecutorCell_t;
+
+//! Bounded multiple producers multiple consumers queue, a producer and a consumer each claim a position with a swap.
+typedef struct palExecutorQueue{
+    PAL_SPSC_RING_CACHE_LINE(uint32_t)  enqueuePosition;
+    PAL_SPSC_RING_CACHE_LINE(uint32_t)  dequeuePosition;
+    palExecutorCell_t*                  cells;
+} palExecutorQueue_t;
+
+struct palExecutor;
+
+typedef struct palExecutorWorker{
+    palExecutorQueue_t  queues[PAL_WORK_PRIORITY_LEVELS];
+    uint32_t            waiting;    //! the worker waits (or is about to wait) on its semaphore
+    palSemaphoreID_t    semaphore;
+    palThreadID_t       threadID;
+    uint32_t*           stack;
+    struct palExecutor* executor;
+} palExecutorWorker_t;
+
+typedef struct palExecutor{
+    uint32_t                workerCount;
+    uint32_t                queueMask;
+    bool                    workStealing;
+    uint32_t                stopping;
+    uint32_t                nextWorker; //! the worker the next submission is queued to first, submissions are spread round robin
+    palSemaphoreID_t        stopped;
+    palExecutorWorker_t*    workers;
+} palExecutor_t;
+
+PAL_PRIVATE bool palExecutorQueuePush(palExecutorQueue_t* queue, uint32_t queueMask, const palExecutorWork_t* work)
+{
+    palExecutorCell_t* cell = NULL;
+    uint32_t position = pal_plat_osAtomicLoad32(&queue->enqueuePosition.fields, PAL_MEMORY_ORDER_RELAXED);
+    int32_t difference = 0;
+
+    while (true)
+    {
+        cell = &queue->cells[position & queueMask];
+        difference = (int32_t)(pal_plat_osAtomicLoad32(&cell->sequence, PAL_MEMORY_ORDER_ACQUIRE) - position);
+        if (difference < 0)
+        {
+            return false; //! the queue is full
+        }
+        if ((0 == difference) && pal_plat_osAtomicCompareAndSwap32(&queue->enqueuePosition.fields, &position, position + 1, PAL_MEMORY_ORDER_RELAXED))
+        {
+            break;
+        }
+        if (0 != difference)
+        {
+            position = pal_plat_osAtomicLoad32(&queue->enqueuePosition.fields, PAL_MEMORY_ORDER_RELAXED);
+        }
+    }
+    cell->work = *work;
+    pal_plat_osAtomicStore32(&cell->sequence, position + 1, PAL_MEMORY_ORDER_RELEASE);
+    return true;
+}
+
+PAL_PRIVATE bool palExecutorQueuePop(palExecutorQueue_t* queue, uint32_t queueMask, palExecutorWork_t* work)
+{
+    palExecutorCell_t* cell = NULL;
+    uint32_t position = pal_plat_osAtomicLoad32(&queue->dequeuePosition.fields, PAL_MEMORY_ORDER_RELAXED);
+    int32_t difference = 0;
+
+    while (true)
+    {
+        cell = &queue->cells[position & queueMask];
+        difference = (int32_t)(pal_plat_osAtomicLoad32(&cell->sequence, PAL_MEMORY_ORDER_ACQUIRE) - (position + 1));
+        if (difference < 0)
+        {
+            return false; //! the queue is empty (or its next cell is still being written)
+        }
+        if ((0 == difference) && pal_plat_osAtomicCompareAndSwap32(&queue->dequeuePosition.fields, &position, position + 1, PAL_MEMORY_ORDER_RELAXED))
+        {
+            break;
+        }
+        if (0 != difference)
+        {
+            position = pal_plat_osAtomicLoad32(&queue->dequeuePosition.fields, PAL_MEMORY_ORDER_RELAXED);
+        }
+    }
+    *work = cell->work;
+    pal_plat_osAtomicStore32(&cell->sequence, position + queueMask + 1, PAL_MEMORY_ORDER_RELEASE);
+    return true;
+}
+
+PAL_PRIVATE bool palExecutorQueueIsEmpty(palExecutorQueue_t* queue, uint32_t queueMask)
+{
+    uint32_t position = pal_plat_osAtomicLoad32(&queue->dequeuePosition.fields, PAL_MEMORY_ORDER_RELAXED);
+    return (pal_plat_osAtomicLoad32(&queue->cells[position & queueMask].sequence, PAL_MEMORY_ORDER_ACQUIRE) != (position + 1));
+}
+
+/*! Take the next work of a worker: the highest priority first, from its own queue before the queues of the other workers.
+*
+* @param[in] take false to only check whether there is work.
+*/
+PAL_PRIVATE bool palExecutorTake(palExecutorWorker_t* worker, palExecutorWork_t* work, bool take)
+{
+    palExecutor_t* executor = worker->executor;
+    palExecutorWorker_t* victim = NULL;
+    uint32_t self = (uint32_t)(worker - executor->workers);
+    uint32_t level = 0;
+    uint32_t i = 0;
+
+    for (level = 0; level < PAL_WORK_PRIORITY_LEVELS; ++level)
+    {
+        for (i = 0; i < (executor->workStealing ? executor->workerCount : 1); ++i)
+        {
+            victim = &executor->workers[(self + i) % executor->workerCount];
+            if (take ? palExecutorQueuePop(&victim->queues[level], executor->queueMask, work) : !palExecutorQueueIsEmpty(&victim->queues[level], executor->queueMask))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+//! Post the semaphore of a worker if it waits, called after work was published.
+PAL_PRIVATE bool palExecutorWake(palExecutorWorker_t* worker)
+{
+    if ((0 != pal_plat_osAtomicLoad32(&worker->waiting, PAL_MEMORY_ORDER_ACQUIRE)) && (0 != pal_plat_osAtomicExchange32(&worker->waiting, 0, PAL_MEMORY_ORDER_ACQ_REL)))
+    {
+        pal_osSemaphoreRelease(worker->semaphore);
+        return true;
+    }
+    return false;
+}
+
+PAL_PRIVATE void palExecutorWorkerThread(void const* argument)
+{
+    palExecutorWorker_t* worker = (palExecutorWorker_t*)argument;
+    palExecutor_t* executor = worker->executor;
+    palExecutorWork_t work;
+    int32_t countersAvailable = 0;
+
+    while (true)
+    {
+        if (palExecutorTake(worker, &work, true))
+        {
+            work.function(work.funcArgument);
+            if (NULL != work.completion)
+            {
+                work.completion(work.completionArgument);
+            }
+            continue;
+        }
+
+        if (0 != pal_plat_osAtomicLoad32(&executor->stopping, PAL_MEMORY_ORDER_ACQUIRE))
+        {
+            //! the queued work is done, the thread waits here to be terminated so its slot is not reused before that.
+            pal_osSemaphoreRelease(executor->stopped);
+            while (true)
+            {
+                pal_osSemaphoreWait(worker->semaphore, PAL_RTOS_WAIT_FOREVER, &countersAvailable);
+            }
+        }
+
+        //! the flag is visible before the queues are checked again, and a submitter publishes its work before it checks the flag.
+        pal_plat_osAtomicExchange32(&worker->waiting, 1, PAL_MEMORY_ORDER_SEQ_CST);
+        if (!palExecutorTake(worker, &work, false) && (0 == pal_plat_osAtomicLoad32(&executor->stopping, PAL_MEMORY_ORDER_ACQUIRE)))
+        {
+            pal_osSemaphoreWait(worker->semaphore, PAL_RTOS_WAIT_FOREVER, &countersAvailable);
+        }
+        pal_plat_osAtomicExchange32(&worker->waiting, 0, PAL_MEMORY_ORDER_SEQ_CST);
+    }
+}
+
+PAL_PRIVATE void palExecutorFree(palExecutor_t* executor)
+{
+    palExecutorWorker_t* worker = NULL;
+    uint32_t i = 0;
+    uint32_t level = 0;
+
+    for (i = 0; i < executor->workerCount; ++i)
+    {
+        worker = &executor->workers[i];
+        if (PAL_INVALID_THREAD != worker->threadID)
+        {
+            pal_osThreadTerminate(&worker->threadID);
+        }
+        if (NULLPTR != worker->semaphore)
+        {
+            pal_osSemaphoreDelete(&worker->semaphore);
+        }
+        for (level = 0; level < PAL_WORK_PRIORITY_LEVELS; ++level)
+        {
+            pal_plat_free(worker->queues[level].cells);
+        }
+        pal_osThreadStackFree(&worker->stack);
+    }
+    if (NULLPTR != executor->stopped)
+    {
+        pal_osSemaphoreDelete(&executor->stopped);
+    }
+    pal_plat_free(executor->workers);
+    pal_plat_free(executor);
+}
+
+palStatus_t pal_osExecutorCreate(uint32_t workers, palThreadPriority_t priority, uint32_t stackSize, uint32_t queueSize, bool workStealing, palExecutorID_t* executorID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palExecutor_t* executor = NULL;
+    palExecutorWorker_t* worker = NULL;
+    uint32_t i = 0;
+    uint32_t level = 0;
+    uint32_t position = 0;
+
+    if ((NULL == executorID) || (0 == workers) || (0 == queueSize) || (0 != (queueSize & (queueSize - 1))) || (PAL_osPriorityError == priority))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    executor = (palExecutor_t*)pal_plat_malloc(sizeof(palExecutor_t));
+    if (NULL == executor)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+    memset(executor, 0, sizeof(palExecutor_t));
+    executor->queueMask = queueSize - 1;
+    executor->workStealing = workStealing;
+    executor->workers = (palExecutorWorker_t*)pal_plat_malloc(workers * sizeof(palExecutorWorker_t));
+    if (NULL == executor->workers)
+    {
+        pal_plat_free(executor);
+        return PAL_ERR_NO_MEMORY;
+    }
+    memset(executor->workers, 0, workers * sizeof(palExecutorWorker_t));
+    executor->workerCount = workers;
+
+    status = pal_osSemaphoreCreate(0, &executor->stopped);
+    for (i = 0; i < workers; ++i)
+    {
+        worker = &executor->workers[i];
+        worker->executor = executor;
+        worker->threadID = PAL_INVALID_THREAD;
+        for (level = 0; (PAL_SUCCESS == status) && (level < PAL_WORK_PRIORITY_LEVELS); ++level)
+        {
+            worker->queues[level].cells = (palExecutorCell_t*)pal_plat_malloc(queueSize * sizeof(palExecutorCell_t));
+            if (NULL == worker->queues[level].cells)
+            {
+                status = PAL_ERR_NO_MEMORY;
+                break;
+            }
+            for (position = 0; position < queueSize; ++position)
+            {
+                worker->queues[level].cells[position].sequence = position;
+            }
+        }
+        if (PAL_SUCCESS == status)
+        {
+            status = pal_osSemaphoreCreate(0, &worker->semaphore);
+        }
+        if (PAL_SUCCESS == status)
+        {
+            status = pal_osThreadStackAlloc(stackSize, &worker->stack);
+        }
+    }
+
+    for (i = 0; (PAL_SUCCESS == status) && (i < workers); ++i)
+    {
+        worker = &executor->workers[i];
+        status = pal_osThreadCreate(palExecutorWorkerThread, worker, priority, stackSize, worker->stack, NULL, &worker->threadID);
+        if (PAL_SUCCESS != status)
+        {
+            worker->threadID = PAL_INVALID_THREAD;
+        }
+    }
+
+    if (PAL_SUCCESS != status)
+    {
+        palExecutorFree(executor);
+        return status;
+    }
+    *executorID = (palExecutorID_t)executor;
+    return status;
+}
+
+palStatus_t pal_osExecutorSubmit(palExecutorID_t executorID, palWorkFuncPtr function, void* funcArgument, palWorkPriority_t priority, palWorkFuncPtr completion, void* completionArgument)
+{
+    palExecutor_t* executor = (palExecutor_t*)executorID;
+    palExecutorWorker_t* worker = NULL;
+    palExecutorWork_t work;
+    uint32_t first = 0;
+    uint32_t i = 0;
+
+    if ((NULLPTR == executorID) || (NULL == function) || ((uint32_t)priority >= PAL_WORK_PRIORITY_LEVELS))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    work.function = function;
+    work.funcArgument = funcArgument;
+    work.completion = completion;
+    work.completionArgument = completionArgument;
+
+    first = pal_plat_osAtomicFetchAdd32(&executor->nextWorker, 1, PAL_MEMORY_ORDER_RELAXED);
+    for (i = 0; i < executor->workerCount; ++i)
+    {
+        worker = &executor->workers[(first + i) % executor->workerCount];
+        if (palExecutorQueuePush(&worker->queues[priority], executor->queueMask, &work))
+        {
+            break;
+        }
+    }
+    if (i == executor->workerCount)
+    {
+        return PAL_ERR_RTOS_RESOURCE;
+    }
+
+    pal_plat_osAtomicFence(PAL_MEMORY_ORDER_SEQ_CST);
+    if (!palExecutorWake(worker) && executor->workStealing)
+    {
+        //! the worker is busy, an idle worker steals the work instead.
+        for (i = 0; (i < executor->workerCount) && !palExecutorWake(&executor->workers[i]); ++i);
+    }
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_osExecutorDestroy(palExecutorID_t* executorID)
+{
+    palExecutor_t* executor = NULL;
+    int32_t countersAvailable = 0;
+    uint32_t i = 0;
+
+    if ((NULL == executorID) || (NULLPTR == *executorID))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+    executor = (palExecutor_t*)*executorID;
+
+    pal_plat_osAtomicStore32(&executor->stopping, 1, PAL_MEMORY_ORDER_SEQ_CST);
+    for (i = 0; i < executor->workerCount; ++i)
+    {
+        pal_osSemaphoreRelease(executor->workers[i].semaphore);
+    }
+    for (i = 0; i < executor->workerCount; ++i)
+    {
+        pal_osSemaphoreWait(executor->stopped, PAL_RTOS_WAIT_FOREVER, &countersAvailable);
+    }
+    palExecutorFree(executor);
+    *executorID = NULLPTR;
+    return PAL_SUCCESS;
+}
+
+int32_t pal_osAtomicIncrement(int32_t* valuePtr, int32_t increment)
+{
+    int32_t result;
+    //! two's complement addition, a negative increment is a subtraction of the same width.
+    result = (int32_t)(pal_plat_osAtomicFetchAdd32((uint32_t*)valuePtr, (uint32_t)increment, PAL_MEMORY_ORDER_SEQ_CST) + (uint32_t)increment);
+    return result;
+}
+
+uint32_t pal_osAtomicLoad32(const uint32_t* valuePtr, palMemoryOrder_t order)
+{
+    return pal_plat_osAtomicLoad32(valuePtr, order);
+}
+
+uint64_t pal_osAtomicLoad64(const uint64_t* valuePtr, palMemoryOrder_t order)
+{
+    return pal_plat_osAtomicLoad64(valuePtr, order);
+}
+
+void pal_osAtomicStore32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order)
+{
+    pal_plat_osAtomicStore32(valuePtr, value, order);
+}
+
+void pal_osAtomicStore64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order)
+{
+    pal_plat_osAtomicStore64(valuePtr, value, order);
+}
+
+uint32_t pal_osAtomicExchange32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order)
+{
+    return pal_plat_osAtomicExchange32(valuePtr, value, order);
+}
+
+uint64_t pal_osAtomicExchange64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order)
+{
+    return pal_plat_osAtomicExchange64(valuePtr, value, order);
+}
+
+bool pal_osAtomicCompareAndSwap32(uint32_t* valuePtr, uint32_t* expected, uint32_t desired, palMemoryOrder_t order)
+{
+    return pal_plat_osAtomicCompareAndSwap32(valuePtr, expected, desired, order);
+}
+
+bool pal_osAtomicCompareAndSwap64(uint64_t* valuePtr, uint64_t* expected, uint64_t desired, palMemoryOrder_t order)
+{
+    return pal_plat_osAtomicCompareAndSwap64(valuePtr, expected, desired, order);
+}
+
+uint32_t pal_osAtomicFetchAdd32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order)
+{
+    return pal_plat_osAtomicFetchAdd32(valuePtr, value, order);
+}
+
+uint64_t pal_osAtomicFetchAdd64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order)
+{
+    return pal_plat_osAtomicFetchAdd64(valuePtr, value, order);
+}
+
+uint32_t pal_osAtomicFetchSub32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order)
+{
+    return pal_plat_osAtomicFetchAdd32(valuePtr, (uint32_t)0 - value, order);
+}
+
+uint64_t pal_osAtomicFetchSub64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order)
+{
+    return pal_plat_osAtomicFetchAdd64(valuePtr, (uint64_t)0 - value, order);
+}
+
+uint32_t pal_osAtomicFetchAnd32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order)
+{
+    return pal_plat_osAtomicFetchAnd32(valuePtr, value, order);
+}
+
+uint64_t pal_osAtomicFetchAnd64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order)
+{
+    return pal_plat_osAtomicFetchAnd64(valuePtr, value, order);
+}
+
+uint32_t pal_osAtomicFetchOr32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order)
+{
+    return pal_plat_osAtomicFetchOr32(valuePtr, value, order);
+}
+
+uint64_t pal_osAtomicFetchOr64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order)
+{
+    return pal_plat_osAtomicFetchOr64(valuePtr, value, order);
+}
+
+//! Pointers are handled as unsigned integers of their width.
+#if (UINTPTR_MAX == UINT64_MAX)
+#define PAL_ATOMIC_POINTER_TYPE uint64_t
+#define PAL_ATOMIC_POINTER_OP(op) pal_plat_osAtomic##op##64
+#else
+#define PAL_ATOMIC_POINTER_TYPE uint32_t
+#define PAL_ATOMIC_POINTER_OP(op) pal_plat_osAtomic##op##32
+#endif
+
+void* pal_osAtomicLoadPointer(void* const* valuePtr, palMemoryOrder_t order)
+{
+    return (void*)(uintptr_t)PAL_ATOMIC_POINTER_OP(Load)((const PAL_ATOMIC_POINTER_TYPE*)valuePtr, order);
+}
+
+void pal_osAtomicStorePointer(void** valuePtr, void* value, palMemoryOrder_t order)
+{
+    PAL_ATOMIC_POINTER_OP(Store)((PAL_ATOMIC_POINTER_TYPE*)valuePtr, (PAL_ATOMIC_POINTER_TYPE)(uintptr_t)value, order);
+}
+
+void* pal_osAtomicExchangePointer(void** valuePtr, void* value, palMemoryOrder_t order)
+{
+    return (void*)(uintptr_t)PAL_ATOMIC_POINTER_OP(Exchange)((PAL_ATOMIC_POINTER_TYPE*)valuePtr, (PAL_ATOMIC_POINTER_TYPE)(uintptr_t)value, order);
+}
+
+bool pal_osAtomicCompareAndSwapPointer(void** valuePtr, void** expected, void* desired, palMemoryOrder_t order)
+{
+    return PAL_ATOMIC_POINTER_OP(CompareAndSwap)((PAL_ATOMIC_POINTER_TYPE*)valuePtr, (PAL_ATOMIC_POINTER_TYPE*)expected, (PAL_ATOMIC_POINTER_TYPE)(uintptr_t)desired, order);
+}
+
+void pal_osAtomicFence(palMemoryOrder_t order)
+{
+    pal_plat_osAtomicFence(order);
+}
+
+
+
+#include <stdarg.h>
+#include <stdio.h>
+
+//! The kinds of printf arguments, as the default argument promotions pass them.
+typedef enum palLogArgumentType{
+    PAL_LOG_ARGUMENT_NONE = 0,      //! %% and %n, no argument is kept
+    PAL_LOG_ARGUMENT_INT,
+    PAL_LOG_ARGUMENT_LONG,
+    PAL_LOG_ARGUMENT_LONG_LONG,
+    PAL_LOG_ARGUMENT_SIZE,
+    PAL_LOG_ARGUMENT_INTMAX,
+    PAL_LOG_ARGUMENT_PTRDIFF,
+    PAL_LOG_ARGUMENT_DOUBLE,
+    PAL_LOG_ARGUMENT_LONG_DOUBLE,   //! kept as a double
+    PAL_LOG_ARGUMENT_POINTER,
+    PAL_LOG_ARGUMENT_STRING,        //! kept as a copy in the strings of the record
+    PAL_LOG_ARGUMENT_INVALID        //! an unknown conversion, the rest of the format is not parsed
+} palLogArgumentType_t;
+
+//! A parsed conversion specification of a format.
+typedef struct palLogSpec{
+    const char*             start;  //! the '%'
+    const char*             end;    //! past the conversion character
+    uint32_t                stars;  //! '*' width and precision, each takes an int argument before the value
+    bool                    starPrecision;  //! the precision is the last '*' argument
+    int32_t                 precision;      //! -1 without a precision, capped at PAL_LOG_STRING_BYTES
+    palLogArgumentType_t    type;
+} palLogSpec_t;
+
+typedef union palLogArgument{
+    intmax_t    integer;
+    double      real;
+    const void* pointer;
+    uint32_t    string; //! the offset of the copy in the strings of the record
+} palLogArgument_t;
+
+typedef struct palLogRecord{
+    uint32_t            sequence;   //! the queue position the record can be written (position) or read (position + 1) at
+    uint32_t            line;
+    const char*         function;
+    const char*         format;
+    uint32_t            argumentCount;
+    bool                truncated;  //! the arguments after argumentCount were not kept
+    palLogArgument_t    arguments[PAL_LOG_MAX_ARGUMENTS];
+    char                strings[PAL_LOG_STRING_BYTES];
+} palLogRecord_t;
+
+#define PAL_LOG_QUEUE_MASK (PAL_LOG_QUEUE_SIZE - 1)
+#if (0 != (PAL_LOG_QUEUE_SIZE & PAL_LOG_QUEUE_MASK))
+#error PAL_LOG_QUEUE_SIZE must be a power of 2
+#endif
+
+/*! Bounded multiple producers single consumer queue: a producer claims a position with a swap, writes the record in place and
+*   publishes it by advancing its sequence, so callers never wait for each other or for the logger thread.
+*/
+typedef struct palLogger{
+    PAL_SPSC_RING_CACHE_LINE(uint32_t)  enqueuePosition;
+    uint32_t                            dequeuePosition;
+    uint32_t                            waiting;    //! the logger thread waits (or is about to wait) on the semaphore
+    uint32_t                            stopping;
+    uint32_t                            reportedDrops;
+    palLogSinkFuncPtr                   sink;
+    palSemaphoreID_t                    semaphore;
+    palSemaphoreID_t                    stopped;
+    palSemaphoreID_t                    drained;    //! released for pal_osLogStop by the last caller which may still use the logger
+    palThreadID_t                       threadID;
+    uint32_t*                           stack;
+    palLogRecord_t                      records[PAL_LOG_QUEUE_SIZE];
+} palLogger_t;
+
+PAL_PRIVATE palLogger_t* s_palLogger = NULL;
+//! callers which may use s_palLogger, it is released only when there are none.
+PAL_PRIVATE uint32_t s_palLoggerUsers = 0;
+//! set in s_palLoggerUsers while pal_osLogStop waits for the callers, the thread which clears it releases s_palLoggerDrained.
+#define PAL_LOGGER_USERS_STOPPING 0x80000000U
+PAL_PRIVATE palSemaphoreID_t s_palLoggerDrained = NULLPTR;
+//! serializes pal_osLogStop, so only one thread at a time sets PAL_LOGGER_USERS_STOPPING.
+PAL_PRIVATE void* s_palLoggerStopLock = NULL;
+PAL_PRIVATE palLogStats_t s_palLogStats = {0};
+
+//! Parse the conversion specification which starts at the '%' of spec.
+PAL_PRIVATE void palLogParseSpec(const char* spec, palLogSpec_t* parsed)
+{
+    const char* current = spec + 1;
+    char length = 0;
+    bool doubleLength = false;
+
+    parsed->start = spec;
+    parsed->stars = 0;
+    parsed->starPrecision = false;
+    parsed->precision = -1;
+    parsed->type = PAL_LOG_ARGUMENT_INVALID;
+
+    while (('\0' != *current) && (NULL != strchr("-+ #0", *current)))
+    {
+        ++current;
+    }
+    //! the width, then the precision
+    if ('*' == *current)
+    {
+        parsed->stars++;
+        ++current;
+    }
+    while ((*current >= '0') && (*current <= '9'))
+    {
+        ++current;
+    }
+    if ('.' == *current)
+    {
+        ++current;
+        parsed->precision = 0;
+        if ('*' == *current)
+        {
+            parsed->stars++;
+            parsed->starPrecision = true;
+            ++current;
+        }
+        while ((*current >= '0') && (*current <= '9'))
+        {
+            if (parsed->precision < PAL_LOG_STRING_BYTES)
+            {
+                parsed->precision = (parsed->precision * 10) + (*current - '0');
+            }
+            ++current;
+        }
+    }
+    if (('\0' != *current) && (NULL != strchr("hlLzjt", *current)))
+    {
+        length = *current++;
+        if (((('h' == length) || ('l' == length))) && (length == *current))
+        {
+            doubleLength = true;
+            ++current;
+        }
+    }
+
+    switch (*current)
+    {
+        case '%':
+            parsed->type = (current == spec + 1) ? PAL_LOG_ARGUMENT_NONE : PAL_LOG_ARGUMENT_INVALID;
+            break;
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+            switch (length)
+            {
+                case 'l':
+                    parsed->type = doubleLength ? PAL_LOG_ARGUMENT_LONG_LONG : PAL_LOG_ARGUMENT_LONG;
+                    break;
+                case 'z':
+                    parsed->type = PAL_LOG_ARGUMENT_SIZE;
+                    break;
+                case 'j':
+                    parsed->type = PAL_LOG_ARGUMENT_INTMAX;
+                    break;
+                case 't':
+                    parsed->type = PAL_LOG_ARGUMENT_PTRDIFF;
+                    break;
+                case 'L':
+                    parsed->type = PAL_LOG_ARGUMENT_INVALID;
+                    break;
+                default: //! char and short are promoted to int
+                    parsed->type = PAL_LOG_ARGUMENT_INT;
+                    break;
+            }
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            parsed->type = ('L' == length) ? PAL_LOG_ARGUMENT_LONG_DOUBLE : PAL_LOG_ARGUMENT_DOUBLE;
+            break;
+        case 's':
+            parsed->type = (0 == length) ? PAL_LOG_ARGUMENT_STRING : PAL_LOG_ARGUMENT_INVALID;
+            break;
+        case 'p':
+        case 'n':
+            parsed->type = ('p' == *current) ? PAL_LOG_ARGUMENT_POINTER : PAL_LOG_ARGUMENT_NONE;
+            break;
+        default:
+            parsed->type = PAL_LOG_ARGUMENT_INVALID;
+            break;
+    }
+    parsed->end = ('\0' == *current) ? current : current + 1;
+}
+
+//! Keep the arguments of format in record, as the conversion specifications of format read them from args.
+PAL_PRIVATE void palLogCapture(palLogRecord_t* record, const char* format, va_list args)
+{
+    const char* current = format;
+    palLogSpec_t spec;
+    const char* string = NULL;
+    uint32_t stringBytes = 0;
+    size_t length = 0;
+    size_t limit = 0;
+    bool bounded = false;
+    uint32_t i = 0;
+
+    record->argumentCount = 0;
+    record->truncated = false;
+    while (NULL != (current = strchr(current, '%')))
+    {
+        palLogParseSpec(current, &spec);
+        current = spec.end;
+        if (PAL_LOG_ARGUMENT_INVALID == spec.type)
+        {
+            break;
+        }
+        if ((record->argumentCount + spec.stars + ((PAL_LOG_ARGUMENT_NONE == spec.type) ? 0 : 1)) > PAL_LOG_MAX_ARGUMENTS)
+        {
+            record->truncated = true;
+            break;
+        }
+        for (i = 0; i < spec.stars; ++i)
+        {
+            record->arguments[record->argumentCount++].integer = va_arg(args, int);
+        }
+        if (spec.starPrecision)
+        {
+            //! a negative '*' precision is taken as if it was omitted.
+            spec.precision = (0 > record->arguments[record->argumentCount - 1].integer) ? -1 :
+                (int32_t)PAL_MIN(record->arguments[record->argumentCount - 1].integer, PAL_LOG_STRING_BYTES);
+        }
+
+        switch (spec.type)
+        {
+            case PAL_LOG_ARGUMENT_INT:
+                record->arguments[record->argumentCount++].integer = va_arg(args, int);
+                break;
+            case PAL_LOG_ARGUMENT_LONG:
+                record->arguments[record->argumentCount++].integer = va_arg(args, long);
+                break;
+            case PAL_LOG_ARGUMENT_LONG_LONG:
+                record->arguments[record->argumentCount++].integer = va_arg(args, long long);
+                break;
+            case PAL_LOG_ARGUMENT_SIZE:
+                record->arguments[record->argumentCount++].integer = (intmax_t)va_arg(args, size_t);
+                break;
+            case PAL_LOG_ARGUMENT_INTMAX:
+                record->arguments[record->argumentCount++].integer = va_arg(args, intmax_t);
+                break;
+            case PAL_LOG_ARGUMENT_PTRDIFF:
+                record->arguments[record->argumentCount++].integer = va_arg(args, ptrdiff_t);
+                break;
+            case PAL_LOG_ARGUMENT_DOUBLE:
+                record->arguments[record->argumentCount++].real = va_arg(args, double);
+                break;
+            case PAL_LOG_ARGUMENT_LONG_DOUBLE:
+                record->arguments[record->argumentCount++].real = (double)va_arg(args, long double);
+                break;
+            case PAL_LOG_ARGUMENT_POINTER:
+                record->arguments[record->argumentCount++].pointer = va_arg(args, void*);
+                break;
+            case PAL_LOG_ARGUMENT_STRING:
+                string = va_arg(args, const char*);
+                if (NULL == string)
+                {
+                    string = "(null)";
+                }
+                //! a string with a precision need not be terminated, so it is not scanned past the precision.
+                limit = PAL_LOG_STRING_BYTES - stringBytes - 1;
+                bounded = (0 <= spec.precision) && ((size_t)spec.precision <= limit);
+                if (bounded)
+                {
+                    limit = (size_t)spec.precision;
+                }
+                for (length = 0; (length < limit) && ('\0' != string[length]); ++length);
+                if (!bounded && (length == limit) && ('\0' != string[length]))
+                {
+                    record->truncated = true;
+                }
+                memcpy(&record->strings[stringBytes], string, length);
+                record->strings[stringBytes + length] = '\0';
+                record->arguments[record->argumentCount++].string = stringBytes;
+                stringBytes += (uint32_t)length + 1;
+                break;
+            default:
+                if ('n' == *(spec.end - 1))
+                {
+                    (void)va_arg(args, void*);
+                }
+                break;
+        }
+        if (stringBytes >= PAL_LOG_STRING_BYTES)
+        {
+            //! no room for another string, the format stops at the next one
+            stringBytes = PAL_LOG_STRING_BYTES - 1;
+        }
+    }
+}
+
+//! Format one conversion specification with its '*' arguments, the specification is copied to a NUL terminated buffer.
+#define PAL_LOG_FORMAT_VALUE(value) \
+    ((0 == spec.stars) ? snprintf(output, remaining, specText, (value)) : \
+     (1 == spec.stars) ? snprintf(output, remaining, specText, stars[0], (value)) : \
+                         snprintf(output, remaining, specText, stars[0], stars[1], (value)))
+
+/*! Format a record like printf would have formatted its format and arguments.
+*
+* \return the length of the line, which is truncated to size - 1 characters.
+*/
+PAL_PRIVATE size_t palLogFormat(const palLogRecord_t* record, char* line, size_t size)
+{
+    const char* current = record->format;
+    const char* percent = NULL;
+    char specText[32];
+    palLogSpec_t spec;
+    const palLogArgument_t* argument = record->arguments;
+    const palLogArgument_t* lastArgument = record->arguments + record->argumentCount;
+    char* output = line;
+    int stars[2] = {0};
+    size_t specLength = 0;
+    size_t remaining = 0;
+    size_t length = 0;
+    int written = 0;
+    uint32_t i = 0;
+
+    line[0] = '\0';
+#ifdef VERBOSE
+    written = snprintf(line, size, "%s:%lu\t", record->function, (unsigned long)record->line);
+    length = ((written < 0) || ((size_t)written >= size)) ? 0 : (size_t)written;
+#endif
+    while (('\0' != *current) && (length < size - 1))
+    {
+        percent = strchr(current, '%');
+        if (NULL == percent)
+        {
+            percent = current + strlen(current);
+        }
+        while ((current < percent) && (length < size - 1))
+        {
+            line[length++] = *current++;
+        }
+        line[length] = '\0';
+        if (('\0' == *current) || (length >= size - 1))
+        {
+            break;
+        }
+
+        palLogParseSpec(current, &spec);
+        if ((PAL_LOG_ARGUMENT_INVALID == spec.type) ||
+            ((lastArgument - argument) < (ptrdiff_t)(spec.stars + ((PAL_LOG_ARGUMENT_NONE == spec.type) ? 0 : 1))))
+        {
+            break; //! the arguments of the rest of the format were not kept
+        }
+        current = spec.end;
+        for (i = 0; i < spec.stars; ++i)
+        {
+            stars[i] = (int)(argument++)->integer;
+        }
+
+        //! the 'L' of long double is dropped, the value was kept as a double.
+        specLength = 0;
+        for (percent = spec.start; (percent < spec.end) && (specLength < sizeof(specText) - 1); ++percent)
+        {
+            if ('L' != *percent)
+            {
+                specText[specLength++] = *percent;
+            }
+        }
+        specText[specLength] = '\0';
+
+        output = line + length;
+        remaining = size - length;
+        written = 0;
+        switch (spec.type)
+        {
+            case PAL_LOG_ARGUMENT_INT:
+                written = PAL_LOG_FORMAT_VALUE((int)(argument++)->integer);
+                break;
+            case PAL_LOG_ARGUMENT_LONG:
+                written = PAL_LOG_FORMAT_VALUE((long)(argument++)->integer);
+                break;
+            case PAL_LOG_ARGUMENT_LONG_LONG:
+                written = PAL_LOG_FORMAT_VALUE((long long)(argument++)->integer);
+                break;
+            case PAL_LOG_ARGUMENT_SIZE:
+                written = PAL_LOG_FORMAT_VALUE((size_t)(argument++)->integer);
+                break;
+            case PAL_LOG_ARGUMENT_INTMAX:
+                written = PAL_LOG_FORMAT_VALUE((intmax_t)(argument++)->integer);
+                break;
+            case PAL_LOG_ARGUMENT_PTRDIFF:
+                written = PAL_LOG_FORMAT_VALUE((ptrdiff_t)(argument++)->integer);
+                break;
+            case PAL_LOG_ARGUMENT_DOUBLE:
+            case PAL_LOG_ARGUMENT_LONG_DOUBLE:
+                written = PAL_LOG_FORMAT_VALUE((argument++)->real);
+                break;
+            case PAL_LOG_ARGUMENT_POINTER:
+                written = PAL_LOG_FORMAT_VALUE((argument++)->pointer);
+                break;
+            case PAL_LOG_ARGUMENT_STRING:
+                written = PAL_LOG_FORMAT_VALUE(&record->strings[(argument++)->string]);
+                break;
+            default:
+                if ('%' == *(spec.end - 1))
+                {
+                    output[0] = '%';
+                    output[1] = '\0';
+                    written = 1;
+                }
+                break;
+        }
+        if (written > 0)
+        {
+            length += (((size_t)written < remaining) ? (size_t)written : (remaining - 1));
+        }
+    }
+    return length;
+}
+
+PAL_PRIVATE void palLogDefaultSink(const char* line)
+{
+    pal_plat_printf("%s", line);
+}
+
+//! The logger thread, it formats and writes the queued records in order and reports drops between them.
+PAL_PRIVATE void palLoggerThread(void const* argument)
+{
+    palLogger_t* logger = (palLogger_t*)argument;
+    palLogRecord_t* record = NULL;
+    char line[PAL_LOG_LINE_SIZE];
+    uint32_t dropped = 0;
+    int32_t countersAvailable = 0;
+
+    while (true)
+    {
+        record = &logger->records[logger->dequeuePosition & PAL_LOG_QUEUE_MASK];
+        if (pal_plat_osAtomicLoad32(&record->sequence, PAL_MEMORY_ORDER_ACQUIRE) == (logger->dequeuePosition + 1))
+        {
+            palLogFormat(record, line, sizeof(line));
+            //! the record is released before the (slow) write, so callers can reuse it meanwhile.
+            pal_plat_osAtomicStore32(&record->sequence, logger->dequeuePosition + PAL_LOG_QUEUE_SIZE, PAL_MEMORY_ORDER_RELEASE);
+            logger->dequeuePosition++;
+            logger->sink(line);
+            pal_plat_osAtomicFetchAdd32(&s_palLogStats.emitted, 1, PAL_MEMORY_ORDER_RELAXED);
+            continue;
+        }
+
+        dropped = pal_plat_osAtomicLoad32(&s_palLogStats.dropped, PAL_MEMORY_ORDER_RELAXED);
+        if (dropped != logger->reportedDrops)
+        {
+            snprintf(line, sizeof(line), "pal log: %lu messages dropped\r\n", (unsigned long)(dropped - logger->reportedDrops));
+            logger->reportedDrops = dropped;
+            logger->sink(line);
+            continue;
+        }
+
+        if (0 != pal_plat_osAtomicLoad32(&logger->stopping, PAL_MEMORY_ORDER_ACQUIRE))
+        {
+            //! the thread waits here to be terminated, so its slot is not released (and reused) before that.
+            pal_osSemaphoreRelease(logger->stopped);
+            pal_osSemaphoreWait(logger->semaphore, PAL_RTOS_WAIT_FOREVER, &countersAvailable);
+            continue;
+        }
+
+        //! the flag is visible before the record is checked again, and a caller publishes its record before it checks the flag.
+        pal_plat_osAtomicExchange32(&logger->waiting, 1, PAL_MEMORY_ORDER_SEQ_CST);
+        if (pal_plat_osAtomicLoad32(&record->sequence, PAL_MEMORY_ORDER_ACQUIRE) != (logger->dequeuePosition + 1))
+        {
+            pal_osSemaphoreWait(logger->semaphore, PAL_RTOS_WAIT_FOREVER, &countersAvailable);
+        }
+        pal_plat_osAtomicExchange32(&logger->waiting, 0, PAL_MEMORY_ORDER_SEQ_CST);
+    }
+}
+
+/*! Queue a message, or drop it if no record can be claimed within PAL_LOG_PUSH_ATTEMPTS attempts.
+*
+* \return false if the message was dropped.
+*/
+PAL_PRIVATE bool palLoggerPush(palLogger_t* logger, const char* function, uint32_t line, const char* format, va_list args)
+{
+    palLogRecord_t* record = NULL;
+    uint32_t position = pal_plat_osAtomicLoad32(&logger->enqueuePosition.fields, PAL_MEMORY_ORDER_RELAXED);
+    uint32_t attempts = 0;
+    int32_t difference = 0;
+
+    for (attempts = 0; attempts < PAL_LOG_PUSH_ATTEMPTS; ++attempts)
+    {
+        record = &logger->records[position & PAL_LOG_QUEUE_MASK];
+        difference = (int32_t)(pal_plat_osAtomicLoad32(&record->sequence, PAL_MEMORY_ORDER_ACQUIRE) - position);
+        if (difference < 0)
+        {
+            return false; //! the queue is full
+        }
+        if (0 == difference)
+        {
+            if (pal_plat_osAtomicCompareAndSwap32(&logger->enqueuePosition.fields, &position, position + 1, PAL_MEMORY_ORDER_RELAXED))
+            {
+                break;
+            }
+        }
+        else
+        {
+            position = pal_plat_osAtomicLoad32(&logger->enqueuePosition.fields, PAL_MEMORY_ORDER_RELAXED);
+        }
+    }
+    if (attempts >= PAL_LOG_PUSH_ATTEMPTS)
+    {
+        return false;
+    }
+
+    record->function = function;
+    record->line = line;
+    record->format = format;
+    palLogCapture(record, format, args);
+    if (record->truncated)
+    {
+        pal_plat_osAtomicFetchAdd32(&s_palLogStats.truncated, 1, PAL_MEMORY_ORDER_RELAXED);
+    }
+    pal_plat_osAtomicStore32(&record->sequence, position + 1, PAL_MEMORY_ORDER_RELEASE);
+
+    pal_plat_osAtomicFence(PAL_MEMORY_ORDER_SEQ_CST);
+    if ((0 != pal_plat_osAtomicLoad32(&logger->waiting, PAL_MEMORY_ORDER_ACQUIRE)) && (0 != pal_plat_osAtomicExchange32(&logger->waiting, 0, PAL_MEMORY_ORDER_ACQ_REL)))
+    {
+        pal_osSemaphoreRelease(logger->semaphore);
+    }
+    return true;
+}
+
+//! Clear PAL_LOGGER_USERS_STOPPING once no callers are left, true for the single thread which clears it.
+PAL_PRIVATE bool palLoggerUsersDrained(uint32_t users)
+{
+    uint32_t expected = PAL_LOGGER_USERS_STOPPING;
+
+    return (PAL_LOGGER_USERS_STOPPING == users) && pal_plat_osAtomicCompareAndSwap32(&s_palLoggerUsers, &expected, 0, PAL_MEMORY_ORDER_ACQ_REL);
+}
+
+PAL_PRIVATE void palLogWrite(const char* function, uint32_t line, const char* format, va_list args)
+{
+    palLogger_t* logger = NULL;
+    char text[PAL_LOG_LINE_SIZE];
+    size_t length = 0;
+    int written = 0;
+    uint32_t users = 0;
+
+    pal_plat_osAtomicFetchAdd32(&s_palLoggerUsers, 1, PAL_MEMORY_ORDER_SEQ_CST);
+    logger = (palLogger_t*)pal_osAtomicLoadPointer((void* const*)&s_palLogger, PAL_MEMORY_ORDER_ACQUIRE);
+    if (NULL != logger)
+    {
+        if (palLoggerPush(logger, function, line, format, args))
+        {
+            pal_plat_osAtomicFetchAdd32(&s_palLogStats.logged, 1, PAL_MEMORY_ORDER_RELAXED);
+        }
+        else
+        {
+            pal_plat_osAtomicFetchAdd32(&s_palLogStats.dropped, 1, PAL_MEMORY_ORDER_RELAXED);
+        }
+    }
+    users = pal_plat_osAtomicFetchAdd32(&s_palLoggerUsers, (uint32_t)-1, PAL_MEMORY_ORDER_ACQ_REL) - 1;
+    if (palLoggerUsersDrained(users))
+    {
+        pal_osSemaphoreRelease(s_palLoggerDrained);
+    }
+
+    if (NULL == logger)
+    {
+        //! no logger thread: the caller writes the whole line with a single call, so lines of different threads do not mix.
+#ifdef VERBOSE
+        written = snprintf(text, sizeof(text), "%s:%lu\t", function, (unsigned long)line);
+        length = ((written < 0) || ((size_t)written >= sizeof(text))) ? 0 : (size_t)written;
+#else
+        (void)function;
+        (void)line;
+#endif
+        written = vsnprintf(text + length, sizeof(text) - length, format, args);
+        (void)written;
+        palLogDefaultSink(text);
+    }
+}
+
+PAL_PRIVATE void palLoggerDestroy(palLogger_t* logger)
+{
+    int32_t countersAvailable = 0;
+
+    if (PAL_INVALID_THREAD != logger->threadID)
+    {
+        pal_plat_osAtomicStore32(&logger->stopping, 1, PAL_MEMORY_ORDER_SEQ_CST);
+        pal_osSemaphoreRelease(logger->semaphore);
+        pal_osSemaphoreWait(logger->stopped, PAL_RTOS_WAIT_FOREVER, &countersAvailable);
+        pal_osThreadTerminate(&logger->threadID);
+    }
+    if (NULLPTR != logger->stopped)
+    {
+        pal_osSemaphoreDelete(&logger->stopped);
+    }
+    if (NULLPTR != logger->drained)
+    {
+        pal_osSemaphoreDelete(&logger->drained);
+    }
+    if (NULLPTR != logger->semaphore)
+    {
+        pal_osSemaphoreDelete(&logger->semaphore);
+    }
+    pal_osThreadStackFree(&logger->stack);
+    pal_plat_free(logger);
+}
+
+palStatus_t pal_osLogStart(palLogSinkFuncPtr sink)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palLogger_t* logger = NULL;
+    void* expected = NULL;
+    uint32_t i = 0;
+
+    if (NULL != pal_osAtomicLoadPointer((void* const*)&s_palLogger, PAL_MEMORY_ORDER_ACQUIRE))
+    {
+        return PAL_SUCCESS;
+    }
+
+    logger = (palLogger_t*)pal_plat_malloc(sizeof(palLogger_t));
+    if (NULL == logger)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+    memset(logger, 0, sizeof(palLogger_t));
+    for (i = 0; i < PAL_LOG_QUEUE_SIZE; ++i)
+    {
+        logger->records[i].sequence = i;
+    }
+    logger->sink = (NULL != sink) ? sink : palLogDefaultSink;
+    logger->reportedDrops = s_palLogStats.dropped;
+    logger->threadID = PAL_INVALID_THREAD;
+
+    status = pal_osSemaphoreCreate(0, &logger->semaphore);
+    if (PAL_SUCCESS == status)
+    {
+        status = pal_osSemaphoreCreate(0, &logger->stopped);
+    }
+    if (PAL_SUCCESS == status)
+    {
+        status = pal_osSemaphoreCreate(0, &logger->drained);
+    }
+    if (PAL_SUCCESS == status)
+    {
+        status = pal_osThreadStackAlloc(PAL_LOG_THREAD_STACK_SIZE, &logger->stack);
+    }
+    if (PAL_SUCCESS == status)
+    {
+        status = pal_osThreadCreate(palLoggerThread, logger, PAL_LOG_THREAD_PRIORITY, PAL_LOG_THREAD_STACK_SIZE, logger->stack, NULL, &logger->threadID);
+        if (PAL_SUCCESS != status)
+        {
+            logger->threadID = PAL_INVALID_THREAD;
+        }
+    }
+
+    if (PAL_SUCCESS != status)
+    {
+        palLoggerDestroy(logger);
+        return status;
+    }
+    //! callers which start the logger at the same time each make one, the first to publish it wins and the others destroy theirs.
+    if (!pal_osAtomicCompareAndSwapPointer((void**)&s_palLogger, &expected, logger, PAL_MEMORY_ORDER_ACQ_REL))
+    {
+        palLoggerDestroy(logger);
+    }
+    return status;
+}
+
+palStatus_t pal_osLogStop(void)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palLogger_t* logger = NULL;
+    uint32_t users = 0;
+    int32_t countersAvailable = 0;
+
+    status = palLazyLockAcquire(&s_palLoggerStopLock);
+    if (PAL_SUCCESS != status)
+    {
+        return status;
+    }
+    logger = (palLogger_t*)pal_osAtomicExchangePointer((void**)&s_palLogger, NULL, PAL_MEMORY_ORDER_SEQ_CST);
+    if (NULL != logger)
+    {
+        //! callers which loaded the logger before it was cleared finish their push, later callers write their messages themselves.
+        s_palLoggerDrained = logger->drained;
+        users = pal_plat_osAtomicFetchAdd32(&s_palLoggerUsers, PAL_LOGGER_USERS_STOPPING, PAL_MEMORY_ORDER_SEQ_CST) + PAL_LOGGER_USERS_STOPPING;
+        if (!palLoggerUsersDrained(users))
+        {
+            pal_osSemaphoreWait(logger->drained, PAL_RTOS_WAIT_FOREVER, &countersAvailable);
+        }
+        palLoggerDestroy(logger);
+    }
+    palLazyLockRelease(&s_palLoggerStopLock);
+    return status;
+}
+
+void pal_osLogPrintf(const char* function, uint32_t line, const char* format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    palLogWrite(function, line, format, args);
+    va_end(args);
+}
+
+palStatus_t pal_osLogGetStats(palLogStats_t* stats)
+{
+    if (NULL == stats)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+    stats->logged = pal_plat_osAtomicLoad32(&s_palLogStats.logged, PAL_MEMORY_ORDER_RELAXED);
+    stats->dropped = pal_plat_osAtomicLoad32(&s_palLogStats.dropped, PAL_MEMORY_ORDER_RELAXED);
+    stats->truncated = pal_plat_osAtomicLoad32(&s_palLogStats.truncated, PAL_MEMORY_ORDER_RELAXED);
+    stats->emitted = pal_plat_osAtomicLoad32(&s_palLogStats.emitted, PAL_MEMORY_ORDER_RELAXED);
+    return PAL_SUCCESS;
+}
+
+#if PAL_TRACE_ENABLED
+#define PAL_TRACE_BUFFER_MASK (PAL_TRACE_BUFFER_ENTRIES - 1)
+#if (0 != (PAL_TRACE_BUFFER_ENTRIES & PAL_TRACE_BUFFER_MASK))
+#error PAL_TRACE_BUFFER_ENTRIES must be a power of 2
+#endif
+
+//! the bounds of the format strings section, defined by the linker.
+extern const char __start_pal_trace_fmt[];
+extern const char __stop_pal_trace_fmt[];
+//! keeps the section (and so its bounds) defined when no PAL_TRACE is used.
+PAL_PRIVATE const char s_palTraceSectionAnchor[] __attribute__((section(PAL_TRACE_SECTION_NAME), used, aligned(1))) = "";
+
+PAL_PRIVATE palTraceEntry_t s_palTraceBuffer[PAL_TRACE_BUFFER_ENTRIES];
+PAL_PRIVATE uint32_t s_palTracePosition = 0;
+
+void pal_osTraceRecord(const char* format, uint32_t argumentCount, ...)
+{
+    palTraceEntry_t* entry = NULL;
+    uint32_t position = 0;
+    uint32_t i = 0;
+    uint64_t tick = 0;
+    va_list args;
+
+    //! every record claims its own entry, so writers (including interrupts) never wait for each other.
+    position = pal_plat_osAtomicFetchAdd32(&s_palTracePosition, 1, PAL_MEMORY_ORDER_RELAXED);
+    entry = &s_palTraceBuffer[position & PAL_TRACE_BUFFER_MASK];
+    //! the entry is invalid while it is written, a snapshot taken meanwhile leaves it out.
+    pal_plat_osAtomicStore32(&entry->sequence, 0, PAL_MEMORY_ORDER_RELAXED);
+    pal_plat_osAtomicFence(PAL_MEMORY_ORDER_RELEASE);
+
+    entry->id = (uint32_t)(format - __start_pal_trace_fmt);
+    tick = pal_osKernelSysTick64();
+    entry->timestamp = (uint32_t)tick;
+    entry->timestampHigh = (uint32_t)(tick >> 32);
+    entry->argumentCount = (argumentCount < PAL_TRACE_MAX_ARGUMENTS) ? argumentCount : PAL_TRACE_MAX_ARGUMENTS;
+    va_start(args, argumentCount);
+    for (i = 0; i < entry->argumentCount; ++i)
+    {
+        entry->arguments[i] = va_arg(args, uint32_t);
+    }
+    va_end(args);
+
+    pal_plat_osAtomicStore32(&entry->sequence, position + 1, PAL_MEMORY_ORDER_RELEASE);
+}
+
+const char* pal_osTraceFormat(uint32_t id)
+{
+    const char* format = __start_pal_trace_fmt + id;
+
+    //! an ID is the start of a string: the first byte of the section or the byte after a terminating NUL.
+    if ((format >= __stop_pal_trace_fmt) || ((0 != id) && ('\0' != format[-1])))
+    {
+        return NULL;
+    }
+    return format;
+}
+
+palStatus_t pal_osTraceSnapshot(void* buffer, uint32_t size, uint32_t* length)
+{
+    palTraceSnapshotHeader_t* header = (palTraceSnapshotHeader_t*)buffer;
+    palTraceEntry_t* entries = (palTraceEntry_t*)(header + 1);
+    palTraceEntry_t* entry = NULL;
+    uint32_t capacity = 0;
+    uint32_t start = 0;
+    uint32_t end = 0;
+    uint32_t sequence = 0;
+    uint32_t position = 0;
+
+    if ((NULL == buffer) || (NULL == length) || (size < sizeof(palTraceSnapshotHeader_t)))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    capacity = (size - sizeof(palTraceSnapshotHeader_t)) / sizeof(palTraceEntry_t);
+    end = pal_plat_osAtomicLoad32(&s_palTracePosition, PAL_MEMORY_ORDER_ACQUIRE);
+    start = (end > PAL_TRACE_BUFFER_ENTRIES) ? (end - PAL_TRACE_BUFFER_ENTRIES) : 0;
+    if ((end - start) > capacity)
+    {
+        start = end - capacity;
+    }
+
+    header->magic = PAL_TRACE_SNAPSHOT_MAGIC;
+    header->version = PAL_TRACE_SNAPSHOT_VERSION;
+    header->entrySize = sizeof(palTraceEntry_t);
+    header->entryCount = 0;
+    header->lost = start;
+    header->tickFrequency = (uint32_t)pal_osKernelSysTickFrequency();
+
+    for (position = start; position != end; ++position)
+    {
+        entry = &s_palTraceBuffer[position & PAL_TRACE_BUFFER_MASK];
+        sequence = pal_plat_osAtomicLoad32(&entry->sequence, PAL_MEMORY_ORDER_ACQUIRE);
+        if (sequence == (position + 1))
+        {
+            memcpy(&entries[header->entryCount], entry, sizeof(palTraceEntry_t));
+            //! the copy is kept only if the entry was not rewritten during it.
+            pal_plat_osAtomicFence(PAL_MEMORY_ORDER_ACQUIRE);
+            if (pal_plat_osAtomicLoad32(&entry->sequence, PAL_MEMORY_ORDER_RELAXED) == sequence)
+            {
+                entries[header->entryCount].sequence = sequence;
+                header->entryCount++;
+                continue;
+            }
+        }
+        header->lost++;
+    }
+
+    *length = sizeof(palTraceSnapshotHeader_t) + (header->entryCount * sizeof(palTraceEntry_t));
+    return PAL_SUCCESS;
+}
+#else
+void pal_osTraceRecord(const char* format, uint32_t argumentCount, ...)
+{
+    (void)format;
+    (void)argumentCount;
+}
+
+const char* pal_osTraceFormat(uint32_t id)
+{
+    (void)id;
+    return NULL;
+}
+
+palStatus_t pal_osTraceSnapshot(void* buffer, uint32_t size, uint32_t* length)
+{
+    palTraceSnapshotHeader_t* header = (palTraceSnapshotHeader_t*)buffer;
+
+    if ((NULL == buffer) || (NULL == length) || (size < sizeof(palTraceSnapshotHeader_t)))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+    memset(header, 0, sizeof(palTraceSnapshotHeader_t));
+    header->magic = PAL_TRACE_SNAPSHOT_MAGIC;
+    header->version = PAL_TRACE_SNAPSHOT_VERSION;
+    header->entrySize = sizeof(palTraceEntry_t);
+    header->tickFrequency = (uint32_t)pal_osKernelSysTickFrequency();
+    *length = sizeof(palTraceSnapshotHeader_t);
+    return PAL_SUCCESS;
+}
+#endif //PAL_TRACE_ENABLED
+
+void dbgPrintf( const char* function, uint32_t line, const char * format, ... )
+{
+#ifdef DEBUG
+    va_list args;
+
     va_start (args, format);
-    pal_plat_vprintf (format, args);
+    palLogWrite(function, line, format, args);
     va_end (args);
-    pal_osMutexRelease(printfMutex);
 #endif
 }
 
@@ -14,7 +14,7 @@
 * limitations under the License.
 */
 
-#if (defined(TARGET_K64F))
+#if (defined(TARGET_K64F) || defined(__LINUX__))
 
 #include "pal_plat_update.h"
 #include "pal_update.h"
@@ -124,5 +124,5 @@ palStatus_t pal_imageWriteDataToMemory(palImagePlatformData_t dataId, const palC
     }
     return status;
 }
-#endif /* defined (defined(TARGET_K64F)) */
+#endif /* (defined(TARGET_K64F) || defined(__LINUX__)) */
 
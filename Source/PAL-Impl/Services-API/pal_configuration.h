@@ -27,14 +27,148 @@ extern "C" {
 #define PAL_NET_ASYNCHRONOUS_SOCKET_API     true/* add pal support for asynchronous sockets */
 #define PAL_NET_DNS_SUPPORT                 true/* add pal support for DNS lookup */
 
-#define PAL_RTOS_64BIT_TICK_SUPPORTED       false /* add pal support for asynchronous sockets */
-#define PAL_UNIQUE_THREAD_PRIORITY          (!defined(PAL_IGNORE_UNIQUE_THREAD_PRIORITY))/* if defined code skips the uniqueness priority check */
+//! if false, pal_osKernelSysTick64 extends the 32 bit kernel tick and must be called at least once per wraparound of it.
+#ifndef PAL_RTOS_64BIT_TICK_SUPPORTED
+    #if defined(__LINUX__)
+        #define PAL_RTOS_64BIT_TICK_SUPPORTED   true /* the Linux tick is a 64 bit nanosecond count */
+    #else
+        #define PAL_RTOS_64BIT_TICK_SUPPORTED   false
+    #endif
+#endif
 
 //! This define is used to determine the size of the initial random buffer (in bytes) held by PAL for random the algorithm.
 #define PAL_INITIAL_RANDOM_SIZE 48
 
-//! number of valid priorities limits the number of threads- if priorities are added this value should be increased
-#define PAL_MAX_NUMBER_OF_THREADS 7 
+//! the most PAL threads that exist at the same time, the implicit PAL main thread included.
+#ifndef PAL_MAX_NUMBER_OF_THREADS
+    #define PAL_MAX_NUMBER_OF_THREADS 64
+#endif
+
+//! the thread registry is allocated in steps of this many threads as threads are created, up to PAL_MAX_NUMBER_OF_THREADS.
+#ifndef PAL_THREADS_REGISTRY_GROWTH
+    #define PAL_THREADS_REGISTRY_GROWTH 8
+#endif
+
+//! the number of blocks each PAL thread keeps cached per memory pool (0 disables the thread caches).
+#ifndef PAL_RTOS_POOL_THREAD_CACHE_SIZE
+    #define PAL_RTOS_POOL_THREAD_CACHE_SIZE 4
+#endif
+
+//! the data cache line size, shared data written by different threads is kept this far apart to avoid false sharing.
+#ifndef PAL_CACHE_LINE_SIZE
+    #define PAL_CACHE_LINE_SIZE 64
+#endif
+
+//! the size classes of the PAL slab used by pal_osMalloc, as PAL_SLAB_CLASS(blockSize, blockCount) entries in increasing block size.
+//! the blocks of all the classes are allocated statically, at least one class must be defined.
+#ifndef PAL_SLAB_SIZE_CLASSES
+    #define PAL_SLAB_SIZE_CLASSES \
+        PAL_SLAB_CLASS(16, 16) \
+        PAL_SLAB_CLASS(32, 16) \
+        PAL_SLAB_CLASS(64, 16) \
+        PAL_SLAB_CLASS(128, 8) \
+        PAL_SLAB_CLASS(256, 4)
+#endif
+
+//! the size classes of the thread stack pool used by pal_osThreadStackAlloc, as PAL_THREAD_STACK_CLASS(stackSize, stackCount) entries
+//! in increasing stack size. A stack is allocated from the heap when it is first needed, and up to stackCount freed stacks
+//! of a class are kept for the next threads. Larger stacks are allocated from the heap and freed to it.
+#ifndef PAL_THREAD_STACK_CLASSES
+    #define PAL_THREAD_STACK_CLASSES \
+        PAL_THREAD_STACK_CLASS(2048, 4) \
+        PAL_THREAD_STACK_CLASS(4096, 4) \
+        PAL_THREAD_STACK_CLASS(16384, 2) \
+        PAL_THREAD_STACK_CLASS(65536, 2)
+#endif
+
+//! if true, thread stacks are painted so pal_osThreadStackHighWaterMark and pal_osThreadGetStats can measure how much of them was used.
+#ifndef PAL_THREAD_STACK_PAINT
+    #define PAL_THREAD_STACK_PAINT true
+#endif
+
+//! the resolution in milliseconds of the PAL timer wheel (pal_osWheelTimer*), its OS timer ticks at this period while wheel timers run.
+#ifndef PAL_TIMER_WHEEL_TICK_MS
+    #define PAL_TIMER_WHEEL_TICK_MS 10
+#endif
+
+//! the timer wheel has PAL_TIMER_WHEEL_LEVELS levels of 2^PAL_TIMER_WHEEL_SLOT_BITS slots, it spans 2^(bits * levels) ticks.
+//! longer timers are supported, they are cascaded through the top level until they are in range.
+#ifndef PAL_TIMER_WHEEL_SLOT_BITS
+    #define PAL_TIMER_WHEEL_SLOT_BITS 6
+#endif
+#ifndef PAL_TIMER_WHEEL_LEVELS
+    #define PAL_TIMER_WHEEL_LEVELS 4
+#endif
+
+//! the thread which runs the wheel timer callbacks, it exists while at least one wheel timer exists.
+#ifndef PAL_TIMER_WHEEL_THREAD_PRIORITY
+    #define PAL_TIMER_WHEEL_THREAD_PRIORITY PAL_osPriorityHigh
+#endif
+#ifndef PAL_TIMER_WHEEL_THREAD_STACK_SIZE
+    #define PAL_TIMER_WHEEL_THREAD_STACK_SIZE 2048
+#endif
+
+//! the deferred logger (pal_osLogStart) queues up to PAL_LOG_QUEUE_SIZE messages (a power of 2), further messages are dropped and counted.
+#ifndef PAL_LOG_QUEUE_SIZE
+    #define PAL_LOG_QUEUE_SIZE 32
+#endif
+//! the arguments (including '*' widths and precisions) and the bytes of %s strings a queued message keeps, the rest is truncated.
+#ifndef PAL_LOG_MAX_ARGUMENTS
+    #define PAL_LOG_MAX_ARGUMENTS 8
+#endif
+#ifndef PAL_LOG_STRING_BYTES
+    #define PAL_LOG_STRING_BYTES 64
+#endif
+//! the longest formatted line, longer lines are truncated.
+#ifndef PAL_LOG_LINE_SIZE
+    #define PAL_LOG_LINE_SIZE 256
+#endif
+//! a caller which loses this many races for a queue slot drops its message, so logging never takes more than a bounded time.
+#ifndef PAL_LOG_PUSH_ATTEMPTS
+    #define PAL_LOG_PUSH_ATTEMPTS 4
+#endif
+#ifndef PAL_LOG_THREAD_PRIORITY
+    #define PAL_LOG_THREAD_PRIORITY PAL_osPriorityIdle
+#endif
+#ifndef PAL_LOG_THREAD_STACK_SIZE
+    #define PAL_LOG_THREAD_STACK_SIZE 4096
+#endif
+
+//! if true, every PAL mutex and semaphore counts its acquisitions and times the waits which block, see pal_osLockStatsIterate.
+//! the IDs of the mutexes and semaphores then refer to a record of PAL which holds the ID of the platform.
+#ifndef PAL_RTOS_CONTENTION_PROFILING
+    #define PAL_RTOS_CONTENTION_PROFILING false
+#endif
+
+//! if true, PAL takes and releases a free mutex with an atomic operation on an owner word, and uses a semaphore of the platform only
+//! for the threads which wait, so an uncontended pal_osMutexWait and pal_osMutexRelease do not call the kernel. The mutexes
+//! then have no priority inheritance, and the waits are not counted in the mutex waits of pal_osThreadGetStats.
+#ifndef PAL_RTOS_MUTEX_FAST_PATH
+    #define PAL_RTOS_MUTEX_FAST_PATH false
+#endif
+
+//! the times a pal_osMutexWait which finds the mutex held tries it again before it waits, when PAL_RTOS_MUTEX_FAST_PATH is true.
+//! only a target with more than one core, where the holder runs while the thread spins, gains from it.
+#ifndef PAL_RTOS_MUTEX_SPIN_COUNT
+    #define PAL_RTOS_MUTEX_SPIN_COUNT 0
+#endif
+
+//! PAL_TRACE keeps its format strings in a linker section and only records their IDs and arguments, it needs GCC (or a compatible compiler).
+//! it is on by default in DEBUG builds only, define PAL_TRACE_ENABLED as true to trace a release build.
+#ifndef PAL_TRACE_ENABLED
+    #if defined(__GNUC__) && defined(DEBUG)
+        #define PAL_TRACE_ENABLED true
+    #else
+        #define PAL_TRACE_ENABLED false
+    #endif
+#endif
+//! the trace buffer keeps the last PAL_TRACE_BUFFER_ENTRIES (a power of 2) records, each of up to PAL_TRACE_MAX_ARGUMENTS 32 bit arguments.
+#ifndef PAL_TRACE_BUFFER_ENTRIES
+    #define PAL_TRACE_BUFFER_ENTRIES 32
+#endif
+#ifndef PAL_TRACE_MAX_ARGUMENTS
+    #define PAL_TRACE_MAX_ARGUMENTS 4
+#endif
 
 //! the maximal number of interfaces that can be supported at once.
 #define PAL_MAX_SUPORTED_NET_INTEFACES 5
@@ -49,7 +183,14 @@ extern "C" {
         #else
             #error missing endiantiy defintion for GCC
         #endif
-
+    #elif defined(__BYTE_ORDER__) // predefined by GCC when <endian.h> is not included (e.g. Linux hosts)
+        #if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            #define PAL_COMPILATION_ENDIANITY 1 //define pal compilation endianity (0 is little endian, 1 is big endian)
+        #elif __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            #define PAL_COMPILATION_ENDIANITY 0//define pal compilation endianity (0 is little endian, 1 is big endian)
+        #else
+            #error missing endiantiy defintion for GCC
+        #endif
     #endif
 #else
     #ifdef __arm__ // we are compiling using the ARM compiler
@@ -192,6 +192,156 @@ palStatus_t pal_receiveFrom(palSocket_t socket, void* buffer, size_t length, pal
 */
 palStatus_t pal_sendTo(palSocket_t socket, const void* buffer, size_t length, const palSocketAddress_t* to, palSocketLength_t toLength, size_t* bytesSent);
 
+/*! one datagram of pal_sendToMulti or pal_receiveFromMulti*/
+typedef struct palDatagram{
+    void* buffer;                       /*! the payload data, the buffer for it when receiving*/
+    size_t length;                      /*! the length of the payload data, the size of the buffer when receiving*/
+    palSocketAddress_t* address;        /*! the address to send the payload to, the address which sent it when receiving (may be NULL)*/
+    palSocketLength_t addressLength;    /*! the length of the address, set after receiving*/
+    size_t bytes;                       /*! after the call: the amount of payload data sent or received*/
+    palStatus_t status;                 /*! after the call: the status of this datagram*/
+} palDatagram_t;
+
+/*! send several payloads with one call, each to its own address, in the order of the array.
+* On platforms which support it the datagrams are passed to the stack in batches (sendmmsg on Linux), elsewhere they are sent one by one.
+* @param[in] socket the socket to use for sending the payloads [we expect sockets passed to this function to be of type PAL_SOCK_DGRAM]
+* @param[in,out] datagrams the datagrams to send, the bytes and status of each datagram which was tried are set.
+* @param[in] count the number of datagrams in the array.
+* @param[out] datagramsSent the number of datagrams sent, the datagram at this index (if any) holds the error which stopped the call.
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) if at least one datagram was sent or a specific negative error code (also set to the status of the first datagram) in case of failure
+*/
+palStatus_t pal_sendToMulti(palSocket_t socket, palDatagram_t* datagrams, uint32_t count, uint32_t* datagramsSent);
+
+/*! receive several payloads with one call. The call waits (unless the socket is non blocking) for the first datagram only,
+* the following datagrams are received as long as they are already available.
+* On platforms which support it the datagrams are taken from the stack in batches (recvmmsg on Linux), elsewhere they are received one by one.
+* @param[in] socket the socket to receive from [we expect sockets passed to this function to be of type PAL_SOCK_DGRAM]
+* @param[in,out] datagrams the buffers for the payloads, the bytes, status and sender address of each datagram received are set.
+* @param[in] count the number of datagrams in the array.
+* @param[out] datagramsReceived the number of datagrams received.
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) if at least one datagram was received or a specific negative error code in case of failure
+*/
+palStatus_t pal_receiveFromMulti(palSocket_t socket, palDatagram_t* datagrams, uint32_t count, uint32_t* datagramsReceived);
+
+#define PAL_NET_MAX_SEGMENTS 8 /*! the most buffer segments one scatter / gather call takes*/
+
+/*! send one datagram gathered from several buffer segments, so a header and a payload need not be copied together first.
+* @param[in] socket the socket to use for sending the payload [we expect sockets passed to this function to be of type PAL_SOCK_DGRAM]
+* @param[in] segments the segments of the payload in order, bufferLength bytes of each are sent.
+* @param[in] segmentCount the number of segments, 1 to PAL_NET_MAX_SEGMENTS.
+* @param[in] to the address to which to payload should be sent
+* @param[in] toLength the length of the 'to' address
+* @param[out] bytesSent after the call will contain the actual amount of payload data sent
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_sendTov(palSocket_t socket, const palConstBuffer_t* segments, uint32_t segmentCount, const palSocketAddress_t* to, palSocketLength_t toLength, size_t* bytesSent);
+
+/*! receive one datagram scattered over several buffer segments, which are filled in order.
+* @param[in] socket the socket to receive from [we expect sockets passed to this function to be of type PAL_SOCK_DGRAM]
+* @param[in,out] segments the segments to fill, up to maxBufferLength bytes each, the bufferLength of each is set to the amount of data it received.
+* @param[in] segmentCount the number of segments, 1 to PAL_NET_MAX_SEGMENTS.
+* @param[out] from the address which sent the payload, may be NULL.
+* @param[in, out] fromLength the length of the 'from' address, after completion will contain the amount of data actually written to the from address
+* @param[out] bytesReceived after the call will contain the actual amount of payload data received
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_receiveFromv(palSocket_t socket, palBuffer_t* segments, uint32_t segmentCount, palSocketAddress_t* from, palSocketLength_t* fromLength, size_t* bytesReceived);
+
+//! A network buffer: a header at the start of a memory pool block, followed by the data area of the block.
+//! Buffers are reference counted and chain into one payload through next, like the pbufs of lwIP.
+//! The fields are maintained by the pal_netBuf functions, read them but do not change them.
+typedef struct palNetBuf{
+    struct palNetBuf* next;     /*! the next buffer of the chain, NULL for the last one*/
+    palMemoryPoolID_t pool;     /*! the pool the buffer returns to when its last reference is freed*/
+    uint32_t refCount;          /*! the number of owners, a chained buffer is owned by its predecessor*/
+    uint32_t size;              /*! the size of the data area*/
+    uint32_t offset;            /*! the start of the data in the data area, the bytes before it are headroom for headers*/
+    uint32_t length;            /*! the length of the data of this buffer only*/
+} palNetBuf_t;
+
+#define PAL_NET_BUF_HEADER_SIZE ((sizeof(palNetBuf_t) + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1)) /*! the part of a pool block taken by the header, blocks should be larger*/
+
+/*! allocate an empty network buffer from a memory pool (see pal_osPoolCreate), with one reference held by the caller.
+* @param[in] pool the pool to allocate the buffer from, the data area is the rest of the block after PAL_NET_BUF_HEADER_SIZE.
+* @param[in] headroom the bytes reserved in front of the data for headers added later by pal_netBufPrepend.
+* @param[out] netBuf the allocated buffer.
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success, PAL_ERR_NO_MEMORY if the pool is exhausted or another negative error code in case of failure
+*/
+palStatus_t pal_netBufAlloc(palMemoryPoolID_t pool, uint32_t headroom, palNetBuf_t** netBuf);
+
+/*! take one more reference to a network buffer (and so to the rest of its chain), each reference is released by pal_netBufFree.
+* @param[in] netBuf the buffer.
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_netBufRef(palNetBuf_t* netBuf);
+
+/*! release a reference to a network buffer, a buffer whose last reference is released returns to its pool and releases the next buffer of the chain in turn.
+* @param[in,out] netBuf the buffer, set to NULL.
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_netBufFree(palNetBuf_t** netBuf);
+
+/*! append a chain to the end of another one, the reference of the caller to tail passes to the chain.
+* @param[in] head the chain to append to.
+* @param[in] tail the chain to append, the caller may not use it anymore unless it took another reference.
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_netBufChain(palNetBuf_t* head, palNetBuf_t* tail);
+
+/*! \return the data of a network buffer (of this buffer only, not of the rest of its chain).
+* @param[in] netBuf the buffer.
+*/
+uint8_t* pal_netBufData(const palNetBuf_t* netBuf);
+
+/*! \return the length of the data of a whole chain of network buffers.
+* @param[in] netBuf the first buffer of the chain.
+*/
+size_t pal_netBufChainLength(const palNetBuf_t* netBuf);
+
+/*! grow the data of a network buffer into its headroom, for adding a header in front of the data in place.
+* @param[in] netBuf the buffer.
+* @param[in] length the length of the header.
+* @param[out] header the start of the header (the new start of the data) to be filled in by the caller.
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or PAL_ERR_BUFFER_TOO_SMALL if the headroom is smaller than length
+*/
+palStatus_t pal_netBufPrepend(palNetBuf_t* netBuf, uint32_t length, uint8_t** header);
+
+/*! grow the data of a network buffer at its end.
+* @param[in] netBuf the buffer.
+* @param[in] length the length to add.
+* @param[out] data the start of the added bytes, to be filled in by the caller.
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or PAL_ERR_BUFFER_TOO_SMALL if the rest of the data area is smaller than length
+*/
+palStatus_t pal_netBufAppend(palNetBuf_t* netBuf, uint32_t length, uint8_t** data);
+
+/*! drop bytes from the start of the data of a network buffer, for stripping a parsed header without moving the rest, the bytes become headroom.
+* @param[in] netBuf the buffer.
+* @param[in] length the length to drop, at most the length of the data.
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_netBufConsume(palNetBuf_t* netBuf, uint32_t length);
+
+/*! receive a datagram directly into a new network buffer, so the data does not have to be copied out of a caller buffer.
+* @param[in] socket the socket to receive from [we expect sockets passed to this function to be of type PAL_SOCK_DGRAM]
+* @param[in] pool the pool to allocate the buffer from, the rest of a datagram which does not fit into the block is lost.
+* @param[in] headroom the bytes reserved in front of the data, for passing the data on with a header added.
+* @param[out] from the address which sent the payload, may be NULL.
+* @param[in, out] fromLength the length of the 'from' address, after completion will contain the amount of data actually written to the from address
+* @param[out] netBuf the buffer holding the datagram with one reference held by the caller, only set in case of success.
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_netBufReceiveFrom(palSocket_t socket, palMemoryPoolID_t pool, uint32_t headroom, palSocketAddress_t* from, palSocketLength_t* fromLength, palNetBuf_t** netBuf);
+
+/*! send a chain of network buffers as one datagram without copying it together first.
+* @param[in] socket the socket to use for sending the payload [we expect sockets passed to this function to be of type PAL_SOCK_DGRAM]
+* @param[in] netBuf the chain to send, of up to PAL_NET_MAX_SEGMENTS buffers, the caller keeps its reference.
+* @param[in] to the address to which to payload should be sent
+* @param[in] toLength the length of the 'to' address
+* @param[out] bytesSent after the call will contain the actual amount of payload data sent
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_netBufSendTo(palSocket_t socket, const palNetBuf_t* netBuf, const palSocketAddress_t* to, palSocketLength_t toLength, size_t* bytesSent);
+
 /*! close a network socket
 * @param[in,out] socket release and zero socket pointed to by given pointer.
 \return the function returns the status as in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
@@ -218,9 +368,9 @@ palStatus_t pal_getNetInterfaceInfo(uint32_t interfaceNum, palNetInterfaceInfo_t
 #define PAL_NET_SOCKET_SELECT_TX_BIT (2)
 #define PAL_NET_SOCKET_SELECT_ERR_BIT (4)
 
-#define PAL_NET_SELECT_IS_RX(socketStatus, index)   ((socketStatus[index] | PAL_NET_SOCKET_SELECT_RX_BIT) != 0) /*! check if RX bit is set in select result for a given socket index*/
-#define PAL_NET_SELECT_IS_TX(socketStatus, index)   ((socketStatus[index] | PAL_NET_SOCKET_SELECT_TX_BIT) != 0) /*! check if TX bit is set in select result for a given socket index*/
-#define PAL_NET_SELECT_IS_ERR(socketStatus, index)  ((socketStatus[index] | PAL_NET_SOCKET_SELECT_ERR_BIT) != 0) /*! check if ERR bit is set in select result for a given socket index*/
+#define PAL_NET_SELECT_IS_RX(socketStatus, index)   ((socketStatus[index] & PAL_NET_SOCKET_SELECT_RX_BIT) != 0) /*! check if RX bit is set in select result for a given socket index*/
+#define PAL_NET_SELECT_IS_TX(socketStatus, index)   ((socketStatus[index] & PAL_NET_SOCKET_SELECT_TX_BIT) != 0) /*! check if TX bit is set in select result for a given socket index*/
+#define PAL_NET_SELECT_IS_ERR(socketStatus, index)  ((socketStatus[index] & PAL_NET_SOCKET_SELECT_ERR_BIT) != 0) /*! check if ERR bit is set in select result for a given socket index*/
 
 /*! check if one or more (up to PAL_NET_SOCKET_SELECT_MAX_SOCKETS) sockets given has data available for reading/writing/error, the function will block until data is available for one of the given sockets or the timeout expires.
 To use the function: set the sockets you want to check in the socketsToCheck array and set a timeout, when it returns the socketStatus output will indicate the status of each socket passed in.
@@ -231,10 +381,80 @@ To use the function: set the sockets you want to check in the socketsToCheck arr
 * @param[out] numberOfSocketsSet is the total number of sockets set in all three data sets (tx, rx, err)after the function completes
 \return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
 \note the entry in index x in the socketStatus array corresponds to the socket at index x in the sockets to check array.
+\note RX is set for a socket with data pending (or a closed peer, the receive then reports it), TX for a socket with room to send and ERR for a socket in error.
+       On mbedOS, whose socket events do not say which event happened, a socket is ready from its last event until a call on it would block, so the bits are exact for non-blocking sockets.
+\note timeout must not be NULL, a zero timeout checks the sockets without blocking. A negative timeout, or microseconds out of [0, 999999], is rejected;
+       a timeout of PAL_RTOS_WAIT_FOREVER milliseconds or more waits forever.
 */
 palStatus_t pal_socketMiniSelect(const palSocket_t socketsToCheck[PAL_NET_SOCKET_SELECT_MAX_SOCKETS], uint32_t numberOfSockets, pal_timeVal_t* timeout,
                                 uint8_t palSocketStatus[PAL_NET_SOCKET_SELECT_MAX_SOCKETS], uint32_t* numberOfSocketsSet);
 
+/*! same as pal_socketMiniSelect, for the given events only: a socket which waits for data only is not set (nor wakes the call up) because it has room to send.
+* @param[in] socketsToCheck on input: the array of up to 8 sockets handles to check.
+* @param[in] numberOfSockets the number of sockets set in the input socketsToCheck array.
+* @param[in] timeout the amount of time till timeout if no socket activity is detected
+* @param[in] interestMask the events to check for, a mask of PAL_NET_SOCKET_SELECT_XX_BIT values (errors are always reported).
+* @param[out] socketStatus will provide information on each socket in the input array indicating which event was set (none, rx, tx, err) check for desired event using macros.
+* @param[out] numberOfSocketsSet is the total number of sockets set in all three data sets (tx, rx, err)after the function completes
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_socketMiniSelectInterest(const palSocket_t socketsToCheck[PAL_NET_SOCKET_SELECT_MAX_SOCKETS], uint32_t numberOfSockets, pal_timeVal_t* timeout, uint8_t interestMask,
+                                         uint8_t palSocketStatus[PAL_NET_SOCKET_SELECT_MAX_SOCKETS], uint32_t* numberOfSocketsSet);
+
+
+typedef uintptr_t palSocketPollerID_t; /*! PAL socket poller handle type */
+
+typedef struct palSocketPollEvent{
+    palSocket_t socket; /*! the socket the event happened on*/
+    uint8_t events;     /*! the events that happened, a mask of PAL_NET_SOCKET_SELECT_XX_BIT values*/
+} palSocketPollEvent_t;
+
+/*! create a socket poller. A poller keeps a set of sockets and the events of interest for each of them between calls,
+* so waiting for events does not depend on the number of sockets in the set. Each poller has its own state, so several threads can wait on different pollers at the same time.
+* @param[out] poller the poller handle is returned through this output parameter.
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_socketPollerCreate(palSocketPollerID_t* poller);
+
+/*! destroy a socket poller, sockets in the poller are removed from it but not closed.
+* @param[in,out] poller the poller to destroy, set to NULLPTR on success.
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_socketPollerDestroy(palSocketPollerID_t* poller);
+
+/*! add a socket to a poller.
+* @param[in] poller the poller.
+* @param[in] socket the socket to add, a socket can be added to a poller once.
+* @param[in] interestMask the events to report for this socket, a mask of PAL_NET_SOCKET_SELECT_XX_BIT values (errors are always reported).
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_socketPollerAdd(palSocketPollerID_t poller, palSocket_t socket, uint8_t interestMask);
+
+/*! change the events of interest of a socket in a poller.
+* @param[in] poller the poller.
+* @param[in] socket a socket previously added to the poller.
+* @param[in] interestMask the events to report for this socket, a mask of PAL_NET_SOCKET_SELECT_XX_BIT values (errors are always reported).
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_socketPollerModify(palSocketPollerID_t poller, palSocket_t socket, uint8_t interestMask);
+
+/*! remove a socket from a poller, a socket must be removed from its poller before it is closed.
+* @param[in] poller the poller.
+* @param[in] socket a socket previously added to the poller.
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_socketPollerRemove(palSocketPollerID_t poller, palSocket_t socket);
+
+/*! wait until events happen on sockets of a poller or the timeout expires.
+* @param[in] poller the poller.
+* @param[out] events the array the events are returned in, one entry per socket with events.
+* @param[in] maxEvents the number of entries in the events array, events of other sockets are returned by the following calls.
+* @param[in] timeout the time to wait in milliseconds, 0 to check without blocking or PAL_RTOS_WAIT_FOREVER to block until an event happens.
+* @param[out] numberOfEvents the number of entries set in the events array, 0 if the timeout expired.
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success (also when the timeout expired) or a specific negative error code in case of failure
+*/
+palStatus_t pal_socketPollerWait(palSocketPollerID_t poller, palSocketPollEvent_t* events, uint32_t maxEvents, uint32_t timeout, uint32_t* numberOfEvents);
+
 
 #if PAL_NET_TCP_AND_TLS_SUPPORT // functionality below supported only in case TCP is supported.
 
@@ -282,6 +502,41 @@ palStatus_t pal_recv(palSocket_t socket, void* buf, size_t len, size_t* recieved
 */
 palStatus_t pal_send(palSocket_t socket, const void* buf, size_t len, size_t* sentDataSize);
 
+/*! send data gathered from several buffer segments via the given connected socket.
+* @param[in] socket the connected socket on which to send data [we expect sockets passed to this function to be of type PAL_SOCK_STREAM ( the implementation may support other types as well) ]
+* @param[in] segments the segments of the data in order, bufferLength bytes of each are sent.
+* @param[in] segmentCount the number of segments, 1 to PAL_NET_MAX_SEGMENTS.
+* @param[out] sentDataSize the length of the data sent, it may end within any segment.
+\return the function returns the status as in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_sendv(palSocket_t socket, const palConstBuffer_t* segments, uint32_t segmentCount, size_t* sentDataSize);
+
+/*! receive data from the given connected socket scattered over several buffer segments, which are filled in order.
+* @param[in] socket the connected socket on which to receive data [we expect sockets passed to this function to be of type PAL_SOCK_STREAM ( the implementation may support other types as well) ]
+* @param[in,out] segments the segments to fill, up to maxBufferLength bytes each, the bufferLength of each is set to the amount of data it received.
+* @param[in] segmentCount the number of segments, 1 to PAL_NET_MAX_SEGMENTS.
+* @param[out] recievedDataSize the length of the data actually received
+\return the function returns the status as in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_recvv(palSocket_t socket, palBuffer_t* segments, uint32_t segmentCount, size_t* recievedDataSize);
+
+/*! receive data from the given connected socket directly into a new network buffer.
+* @param[in] socket the connected socket on which to receive data [we expect sockets passed to this function to be of type PAL_SOCK_STREAM ( the implementation may support other types as well) ]
+* @param[in] pool the pool to allocate the buffer from, at most the data area of a block is received.
+* @param[in] headroom the bytes reserved in front of the data.
+* @param[out] netBuf the buffer holding the data with one reference held by the caller, only set in case of success.
+\return the function returns the status as in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_netBufRecv(palSocket_t socket, palMemoryPoolID_t pool, uint32_t headroom, palNetBuf_t** netBuf);
+
+/*! send a chain of network buffers via the given connected socket without copying it together first.
+* @param[in] socket the connected socket on which to send data [we expect sockets passed to this function to be of type PAL_SOCK_STREAM ( the implementation may support other types as well) ]
+* @param[in] netBuf the chain to send, the caller keeps its reference.
+* @param[out] sentDataSize the length of the data sent, less than the chain on a partial send.
+\return the function returns the status as in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+*/
+palStatus_t pal_netBufSend(palSocket_t socket, const palNetBuf_t* netBuf, size_t* sentDataSize);
+
 
 #endif //PAL_NET_TCP_AND_TLS_SUPPORT
 
@@ -303,6 +558,37 @@ typedef void(*palAsyncSocketCallback_t)();
 */
 palStatus_t pal_asynchronousSocket(palSocketDomain_t domain, palSocketType_t type, bool nonBlockingSocket, uint32_t interfaceNum, palAsyncSocketCallback_t callback, palSocket_t* socket);
 
+/*! callback function called when an event happens on an asynchronous socket for which it was set using pal_asynchronousSocketWithContext.
+* @param[in] socket the socket the event happened on.
+* @param[in] events the events which happened, a mask of PAL_NET_SOCKET_SELECT_XX_BIT values. A platform which can not tell the events apart reports RX and TX together.
+* @param[in] context the context given when the socket was created.
+*/
+typedef void(*palAsyncSocketContextCallback_t)(palSocket_t socket, uint8_t events, void* context);
+
+//! An event of an asynchronous socket posted to a deferral queue, see pal_asynchronousSocketWithContext.
+typedef struct palAsyncSocketEvent{
+    palSocket_t socket;                         /*! the socket the event happened on*/
+    palAsyncSocketContextCallback_t callback;   /*! call it with the socket, the events and the context, a platform may post a function of its own which calls the callback of the socket*/
+    void* context;                              /*! the context of the socket*/
+    uint8_t events;                             /*! the events which happened, a mask of PAL_NET_SOCKET_SELECT_XX_BIT values*/
+} palAsyncSocketEvent_t;
+
+/*! get an asynchronous network socket whose callback is told the socket, the events and a context of its own, so one callback can serve many sockets.
+* @param[in] domain the domain for the created socket (see enum palSocketDomain_t for supported types)
+* @param[in] type the type for the created socket (see enum palSocketType_t for supported types)
+* @param[in] nonBlockingSocket if true the socket created is created as non-blocking (i.e. with O_NONBLOCK set)
+* @param[in] interfaceNum the number of the network interface used for this socket (info in interfaces supported via pal_getNumberOfNetInterfaces and pal_getNetInterfaceInfo ), choose PAL_NET_DEFAULT_INTERFACE for default interface.
+* @param[in] callback a callback function that will be called when any supported event happens to the given asynchronous socket
+* @param[in] context passed to the callback as is.
+* @param[in] deferralQueue NULLPTR to call the callback in the callback context of the network stack, or a queue created by pal_osMessageQueueCreateTyped with messages of sizeof(palAsyncSocketEvent_t):
+*            the events are then posted to the queue and a thread of the application takes them with pal_osMessageGetTyped (or pal_osMessageGetBatch) and calls their callback.
+* @param[out] socket socket is returned through this output parameter
+\return the function returns the status in the form of PalStatus_t which will be PAL_SUCCESS (0) in case of success or a specific negative error code in case of failure
+\note the events are posted without waiting, the events which find the queue full are kept and posted once the queue has room. The queue should only carry socket events.
+*/
+palStatus_t pal_asynchronousSocketWithContext(palSocketDomain_t domain, palSocketType_t type, bool nonBlockingSocket, uint32_t interfaceNum, palAsyncSocketContextCallback_t callback, void* context,
+                                              palMessageQID_t deferralQueue, palSocket_t* socket);
+
 #endif
 
 #if PAL_NET_DNS_SUPPORT
@@ -26,19 +26,35 @@ extern "C" {
 
 #include "pal_macros.h"
 #include "pal_types.h"
-
-#define PRIORITY_INDEX_OFFSET 3
+#include "pal_configuration.h"
 
 //! Wait forever define. used for Semaphores and Mutexes
 #define PAL_RTOS_WAIT_FOREVER PAL_MAX_UINT32
 
+//! The most readers which hold a reader-writer lock together.
+#define PAL_RTOS_RWLOCK_MAX_READERS 0xFFFF
+
+//! Options of pal_osEventFlagsWait, they can be combined with |.
+#define PAL_OS_FLAGS_WAIT_ANY 0x0   //! the wait ends when any of the flags is set.
+#define PAL_OS_FLAGS_WAIT_ALL 0x1   //! the wait ends when all of the flags are set.
+#define PAL_OS_FLAGS_NO_CLEAR 0x2   //! the flags waited for are not cleared when the wait ends.
+
+//! the maximal number of blocks in a memory pool.
+#define PAL_RTOS_POOL_MAX_BLOCKS 0xFFFF
+
 //! Primitives IDs types declarations
 typedef uintptr_t palThreadID_t;
 typedef uintptr_t palTimerID_t;
+typedef uintptr_t palWheelTimerID_t;
 typedef uintptr_t palMutexID_t;
 typedef uintptr_t palSemaphoreID_t;
+typedef uintptr_t palRwLockID_t;
+typedef uintptr_t palEventFlagsID_t;
+typedef uintptr_t palCondVarID_t;
 typedef uintptr_t palMemoryPoolID_t;
 typedef uintptr_t palMessageQID_t;
+typedef uintptr_t palSpscRingID_t;
+typedef uintptr_t palExecutorID_t;
 
 //! Timers types supported in PAL
 typedef enum  palTimerType {
@@ -46,23 +62,111 @@ typedef enum  palTimerType {
     palOsTimerPeriodic = 1 /*! Periodic (repeating) timer*/
 } palTimerType_t;
 
+//! Memory orders of the atomic operations, with the meaning of the C11 memory_order values.
+typedef enum palMemoryOrder {
+    PAL_MEMORY_ORDER_RELAXED = 0, /*! Atomicity only, no ordering of other memory accesses*/
+    PAL_MEMORY_ORDER_ACQUIRE = 1, /*! Later accesses are not moved before the operation (loads and read-modify-writes)*/
+    PAL_MEMORY_ORDER_RELEASE = 2, /*! Earlier accesses are not moved after the operation (stores and read-modify-writes)*/
+    PAL_MEMORY_ORDER_ACQ_REL = 3, /*! Both acquire and release (read-modify-writes)*/
+    PAL_MEMORY_ORDER_SEQ_CST = 4 /*! Acquire and release, plus a single total order of all such operations*/
+} palMemoryOrder_t;
+
+//! Priorities of the work submitted to an executor, a worker takes the work of the highest priority first.
+typedef enum palWorkPriority {
+    PAL_WORK_PRIORITY_HIGH = 0,
+    PAL_WORK_PRIORITY_NORMAL = 1,
+    PAL_WORK_PRIORITY_LOW = 2
+} palWorkPriority_t;
+
+//! PAL executor work (and completion) function prototype
+typedef void(*palWorkFuncPtr)(void* funcArgument);
+
 //! PAL timer function prototype
 typedef void(*palTimerFuncPtr)(void const *funcArgument);
 
 //! PAL thread function prototype
 typedef void(*palThreadFuncPtr)(void const *funcArgument); 
 
-//! Available priorities in PAL implementation, each priority can appear only once.
+//! 32 bit tick source prototype, see pal_osKernelSysTickExtend
+typedef uint32_t(*palTickFuncPtr)(void);
+
+//! The priority levels from one named priority to the next, for example (PAL_osPriorityNormal + 1) is a bit above normal.
+#define PAL_THREAD_PRIORITY_LEVELS 8
+
+//! Available priorities in PAL implementation, any number of threads can have the same priority.
 typedef enum    pal_osPriority {
-    PAL_osPriorityIdle = -3,
-    PAL_osPriorityLow = -2,
-    PAL_osPriorityBelowNormal = -1,
+    PAL_osPriorityIdle = -3 * PAL_THREAD_PRIORITY_LEVELS,
+    PAL_osPriorityLow = -2 * PAL_THREAD_PRIORITY_LEVELS,
+    PAL_osPriorityBelowNormal = -1 * PAL_THREAD_PRIORITY_LEVELS,
     PAL_osPriorityNormal = 0,
-    PAL_osPriorityAboveNormal = +1,
-    PAL_osPriorityHigh = +2,
-    PAL_osPriorityRealtime = +3,
+    PAL_osPriorityAboveNormal = +1 * PAL_THREAD_PRIORITY_LEVELS,
+    PAL_osPriorityHigh = +2 * PAL_THREAD_PRIORITY_LEVELS,
+    PAL_osPriorityRealtime = +3 * PAL_THREAD_PRIORITY_LEVELS,
     PAL_osPriorityError = 0x84
-} palThreadPriority_t; /*! Thread priority levels for PAL threads - each thread must have a different priority*/
+} palThreadPriority_t; /*! Thread priority levels for PAL threads, every value from PAL_osPriorityIdle to PAL_osPriorityRealtime is valid*/
+
+//! Memory pool statistics, see pal_osPoolGetStats.
+typedef struct palMemoryPoolStats{
+    uint32_t blockSize;         /*! the size of a block in bytes (rounded up to the pool alignment)*/
+    uint32_t blockCount;        /*! the number of blocks in the pool*/
+    uint32_t cacheHits;         /*! allocations and frees served by the calling thread cache*/
+    uint32_t cacheMisses;       /*! allocations and frees which had to use the shared free list*/
+    uint32_t failedAllocations; /*! allocations which failed because the pool was exhausted*/
+} palMemoryPoolStats_t;
+
+//! Usage of a size class of the small allocation slab, see pal_osMallocGetStats.
+typedef struct palSlabClassStats{
+    uint32_t blockSize;     /*! the largest allocation served by the class*/
+    uint32_t blockCount;    /*! the number of blocks in the class*/
+    uint32_t inUse;         /*! the number of blocks allocated now*/
+    uint32_t peakInUse;     /*! the highest number of blocks allocated at once*/
+    uint32_t allocations;   /*! the number of allocations served by the class*/
+    uint32_t heapFallbacks; /*! the number of allocations of the class size served by the heap because the class was exhausted*/
+} palSlabClassStats_t;
+
+//! Usage of a size class of the thread stack pool, see pal_osThreadStackGetStats.
+typedef struct palThreadStackClassStats{
+    uint32_t stackSize;         /*! the largest stack served by the class*/
+    uint32_t stackCount;        /*! the number of freed stacks the class keeps for reuse*/
+    uint32_t inUse;             /*! the number of stacks allocated now*/
+    uint32_t cached;            /*! the number of freed stacks kept now*/
+    uint32_t allocations;       /*! the number of stacks allocated from the class*/
+    uint32_t heapAllocations;   /*! the number of those allocations which had to use the heap because no stack was kept*/
+    uint32_t highWaterMark;     /*! the most bytes used by a freed stack of the class, 0 if PAL_THREAD_STACK_PAINT is false*/
+} palThreadStackClassStats_t;
+
+//! Run time statistics of a thread, see pal_osThreadGetStats.
+typedef struct palThreadStats{
+    uint32_t stackSize;             /*! the size of the stack the thread runs on, 0 if it is not a stack given to pal_osThreadCreate*/
+    uint32_t stackHighWaterMark;    /*! the most bytes of its stack the thread used so far, 0 if the stack is not measured*/
+    uint64_t runTimeMicroSec;       /*! the CPU time the thread ran, 0 if the platform does not measure it*/
+    uint32_t contextSwitches;       /*! the times the thread was switched out, 0 if the platform does not count them*/
+    uint32_t mutexWaits;            /*! the times the thread blocked on a PAL mutex*/
+    uint64_t mutexWaitMicroSec;     /*! the time the thread was blocked on PAL mutexes*/
+} palThreadStats_t;
+
+//! The value of the stack words no thread wrote yet, when PAL_THREAD_STACK_PAINT is true.
+#define PAL_THREAD_STACK_PAINT_PATTERN 0xA5A5A5A5
+
+//! The kinds of PAL objects whose contention is profiled.
+typedef enum palLockType{
+    PAL_LOCK_TYPE_MUTEX = 0,
+    PAL_LOCK_TYPE_SEMAPHORE = 1
+} palLockType_t;
+
+//! Contention statistics of a mutex or a semaphore, see pal_osLockStatsIterate. Wait times are in ticks of pal_osKernelSysTick64.
+typedef struct palLockStats{
+    uintptr_t id;                       /*! the palMutexID_t or palSemaphoreID_t of the object*/
+    palLockType_t type;
+    uint32_t acquisitions;              /*! the successful waits*/
+    uint32_t contendedAcquisitions;     /*! the successful waits which blocked*/
+    uint64_t totalWaitTicks;            /*! the time of all the waits which blocked, including the ones which timed out*/
+    uint64_t maxWaitTicks;              /*! the longest wait which blocked*/
+    palThreadID_t holder;               /*! the thread which holds the mutex (the last one which took the semaphore), PAL_INVALID_THREAD if none*/
+} palLockStats_t;
+
+//! Function called by pal_osLockStatsIterate for each mutex and semaphore.
+typedef void(*palLockStatsFuncPtr)(const palLockStats_t* stats, void* funcArgument);
 
 //! Thread Local Store struct.
 //! Can be used to hold: State, configurations and etc inside the thread.
@@ -84,9 +188,22 @@ uint32_t pal_osKernelSysTick(void);
 
 /*! Get the RTOS kernel system timer counter.
 * \return the RTOS kernel system timer counter
+* \note safe to call from any thread and from interrupt context.
+* \note if PAL_RTOS_64BIT_TICK_SUPPORTED is false it is extended from the 32 bit kernel tick, and must be called at least once per wraparound of pal_osKernelSysTick.
 */
 uint64_t pal_osKernelSysTick64(void);
 
+/*! Extend a 32 bit tick to 64 bits, this is how pal_osKernelSysTick64 is made from pal_osKernelSysTick if PAL_RTOS_64BIT_TICK_SUPPORTED is false.
+*   The state word holds the wraparounds seen and the top bits of the last tick, it may be shared by any threads and interrupts.
+*
+* @param[in,out] state the state word of the extended tick, 0 for a tick which starts at 0.
+* @param[in] tickFunction reads the 32 bit tick, it is called after the state is read (and again if another caller updated the state).
+* eturn the 64 bit tick.
+* 
+ote a wraparound is only seen if the state is updated at least once every 15/16 of the wraparound period of the 32 bit tick.
+*/
+uint64_t pal_osKernelSysTickExtend(uint32_t* state, palTickFuncPtr tickFunction);
+
 /*! Converts value from microseconds to kernel sys tick
 *
 * @param[in] microseconds the amount of microseconds to convert into system ticks
@@ -112,16 +229,20 @@ uint64_t pal_osKernelSysTickFrequency(void);
 *
 * @param[in] function: function pointer to the thread callback function.
 * @param[in] funcArgument: argument for the thread function.
-* @param[in] priority: priotity of the thread.
+* @param[in] priority: priotity of the thread, from PAL_osPriorityIdle to PAL_osPriorityRealtime.
 * @param[in] stackSize: the stack size of the thread can NOT be 0.
-* @param[in] stackPtr: pointer to the thread's stack can NOT be NULL.
+* @param[in] stackPtr: pointer to the thread's stack can NOT be NULL, 8 bytes aligned. pal_osThreadStackAlloc provides reusable stacks.
 * @param[in] store: pointer to thread's local sotre, can be NULL.
 * @param[out] threadID: holds the created thread ID handle - zero value indecates an error.
 *
 * \return PAL_SUCCESS when thread created successfully.
-*         PAL_ERR_RTOS_PRIORITY : the given priority already used before in the system.
+*         PAL_ERR_RTOS_RESOURCE : PAL_MAX_NUMBER_OF_THREADS threads already exist.
+*
+* \note The thread runs on the given stack, which belongs to the caller and must stay valid until the thread was
+*       terminated or has ended. A platform whose threads need a larger minimal stack (Linux: PTHREAD_STACK_MIN) uses
+*       a stack of its own instead of a smaller given stack.
 *
-* \note Each thread MUST be with unique priority.
+* \note Threads may share a priority, a platform with fewer priority levels maps close priorities to the same level.
 * \note When the priority of the created thread function is higher than the current running thread, the 
 *       created thread function starts instantly and becomes the new running thread. 
 */
@@ -147,6 +268,38 @@ palThreadID_t pal_osThreadGetId(void);
 * \return the storage of the current thread */
 palThreadLocalStore_t* pal_osThreadGetLocalStore(void);
 
+/*! Get the run time statistics of a thread, to size its stack and to find which threads use the CPU or wait for mutexes.
+*
+* @param[in] threadID the ID of the thread, the PAL main thread (the one which called pal_init) has the ID 0.
+* @param[out] stats the statistics of the thread since it was created.
+*
+* \return PAL_SUCCESS(0) in case of success and PAL_ERR_INVALID_ARGUMENT if there is no such thread.
+*
+* \note The stack is measured when PAL_THREAD_STACK_PAINT is true: pal_osThreadCreate paints the stack, and the high water mark
+*       is the paint the thread overwrote. Linux measures the run time and counts the context switches, mbed OS does not.
+*/
+palStatus_t pal_osThreadGetStats(palThreadID_t threadID, palThreadStats_t* stats);
+
+/*! Log the statistics of every PAL thread with pal_osLogPrintf, one line per thread in the form
+*   "pal thread stats: id=<ID> stack=<high water mark>/<size> run_us=<run time> switches=<context switches> mutex_waits=<waits> mutex_wait_us=<wait time>".
+*/
+void pal_osThreadStatsDump(void);
+
+/*! Log the statistics of every PAL thread periodically (see pal_osThreadStatsDump), from a wheel timer.
+*
+* @param[in] millisec the period of the dump in milliseconds, a dump which runs already continues with the new period.
+*
+* \return PAL_SUCCESS(0) in case of success and another negative value indicating a specific error code in case of failure.
+* \note pal_osThreadStatsDumpStart and pal_osThreadStatsDumpStop must not be called concurrently, pal_destroy stops the dump.
+*/
+palStatus_t pal_osThreadStatsDumpStart(uint32_t millisec);
+
+/*! Stop the periodic dump of the thread statistics.
+*
+* \return PAL_SUCCESS(0), also when the dump was not running.
+*/
+palStatus_t pal_osThreadStatsDumpStop(void);
+
 /*! Wait for a specified time period in milliseconds.
 *
 * @param[in] milliseconds the amount of milliseconds to wait before proceeding.
@@ -193,6 +346,48 @@ palStatus_t pal_osTimerStop(palTimerID_t timerID);
 */
 palStatus_t pal_osTimerDelete(palTimerID_t* timerID);
 
+/*! Creates a timer of the PAL timer wheel.
+*   Wheel timers do not use RTOS timers, all of them are driven by a single OS timer and start/stop take constant time,
+*   so they suit many fine grained timers (e.g. retransmissions). Their resolution is PAL_TIMER_WHEEL_TICK_MS and
+*   their callbacks run one after the other on the PAL timer wheel thread, so they should be short.
+*
+* @param[in] function: function pointer to the timer callback function.
+* @param[in] funcArgument: funcArgument for the timer callback function.
+* @param[in] timerType: timer type to be created - (periodic or oneShot).
+* @param[out] timerID: holds the created timer ID handle - zero value indecates an error.
+*
+* \return PAL_SUCCESS when timer created successfully.
+*         PAL_ERR_NO_MEMORY: no memory resource available to create timer object.
+* \note the first wheel timer starts the timer wheel thread (PAL_TIMER_WHEEL_THREAD_PRIORITY) and deleting the last one stops it.
+*/
+palStatus_t pal_osWheelTimerCreate(palTimerFuncPtr function, void* funcArgument, palTimerType_t timerType, palWheelTimerID_t* timerID);
+
+/*! Start or restart a wheel timer.
+*
+* @param[in] timerID: the handle for the timer to start
+* @param[in] millisec: the time in milliseconds to set the timer to, the callback runs no earlier than that and
+*                      at most two wheel ticks (PAL_TIMER_WHEEL_TICK_MS) later.
+*
+* \return the function returns the status in the form of palStatus_t which will be PAL_SUCCESS(0) in case of success and another negative value indicating a specific error code in case of failure
+*/
+palStatus_t pal_osWheelTimerStart(palWheelTimerID_t timerID, uint32_t millisec);
+
+/*! Stop a wheel timer, stopping a timer which is not running is not an error.
+*
+* @param[in] timerID: the handle for the timer to stop
+* \return the function returns the status in the form of palStatus_t which will be PAL_SUCCESS(0) in case of success and another negative value indicating a specific error code in case of failure
+*/
+palStatus_t pal_osWheelTimerStop(palWheelTimerID_t timerID);
+
+/*! Delete a wheel timer.
+*
+* @param[inout] timerID: the handle for the timer to delete, in success:(*timerID = NULL).
+*
+* \return the function returns the status in the form of palStatus_t which will be PAL_SUCCESS(0) in case of success and another negative value indicating a specific error code in case of failure
+* \note when the last wheel timer is deleted from one of the wheel timer callbacks the wheel thread keeps running until a wheel timer is created and deleted again.
+*/
+palStatus_t pal_osWheelTimerDelete(palWheelTimerID_t* timerID);
+
 /*! Create and initialize Mutex object
 *
 * @param[out] mutexID: holds the created mutex ID handle - zero value indecates an error.
@@ -214,6 +409,7 @@ palStatus_t pal_osMutexCreate(palMutexID_t* mutexID);
 *         PAL_ERR_RTOS_TIMEOUT - mutex was not available until timeout expired.
 *         PAL_ERR_RTOS_PARAMETER - mutex id is invalid
 *         PAL_ERR_RTOS_ISR - cannot be called from interrupt service routines
+* \note With PAL_RTOS_MUTEX_FAST_PATH a free mutex is taken without a call to the kernel.
 */
 palStatus_t pal_osMutexWait(palMutexID_t mutexID, uint32_t millisec);
 
@@ -278,10 +474,173 @@ palStatus_t pal_osSemaphoreRelease(palSemaphoreID_t semaphoreID);
 */
 palStatus_t pal_osSemaphoreDelete(palSemaphoreID_t* semaphoreID);
 
+/*! Call a function with the contention statistics of every existing mutex and semaphore (PAL_RTOS_CONTENTION_PROFILING).
+*
+* @param[in] function the function, it must not create or delete mutexes or semaphores.
+* @param[in] funcArgument the argument for the function.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_INVALID_ARGUMENT if function is NULL,
+*         PAL_ERR_NOT_SUPPORTED if PAL_RTOS_CONTENTION_PROFILING is false.
+*/
+palStatus_t pal_osLockStatsIterate(palLockStatsFuncPtr function, void* funcArgument);
+
+/*! Log the contention statistics of every mutex and semaphore which was contended with pal_osLogPrintf, one line per object in the form
+*   "pal lock stats: mutex|semaphore=<ID> acquisitions=<count> contended=<count> wait_us=<total> max_wait_us=<max> holder=<thread ID>".
+*   Nothing is logged if PAL_RTOS_CONTENTION_PROFILING is false.
+*/
+void pal_osLockStatsReport(void);
+
+/*! Create a reader-writer lock: any number of readers hold it together, and a writer holds it alone.
+* Writers are preferred, a reader waits while a writer holds the lock or waits for it, so readers can not starve the writers.
+* Taking and releasing an uncontended lock is a single atomic operation, semaphores are used only to wait.
+*
+* @param[out] rwLockID the ID of the created lock.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_INVALID_ARGUMENT or PAL_ERR_NO_MEMORY in case of failure.
+*/
+palStatus_t pal_osRwLockCreate(palRwLockID_t* rwLockID);
+
+/*! Take a reader-writer lock for reading.
+*
+* @param[in] rwLockID the ID of the lock.
+* @param[in] millisec the longest time to wait in milliseconds, 0 to try without waiting, PAL_RTOS_WAIT_FOREVER can be used.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_RTOS_TIMEOUT if a writer held or waited for the lock until the timeout expired,
+*         PAL_ERR_RTOS_RESOURCE if PAL_RTOS_RWLOCK_MAX_READERS readers hold the lock.
+* \note A reader must not take the lock again while it holds it, a writer waiting between the two would wait for it forever.
+*/
+palStatus_t pal_osRwLockReadLock(palRwLockID_t rwLockID, uint32_t millisec);
+
+/*! Take a reader-writer lock for writing.
+*
+* @param[in] rwLockID the ID of the lock.
+* @param[in] millisec the longest time to wait in milliseconds, 0 to try without waiting, PAL_RTOS_WAIT_FOREVER can be used.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_RTOS_TIMEOUT if the lock was held until the timeout expired.
+* \note The lock is not recursive, a writer must not take it again.
+*/
+palStatus_t pal_osRwLockWriteLock(palRwLockID_t rwLockID, uint32_t millisec);
+
+/*! Release a reader-writer lock taken for reading or for writing.
+*
+* @param[in] rwLockID the ID of the lock.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_INVALID_ARGUMENT if the lock is not held.
+*/
+palStatus_t pal_osRwLockUnlock(palRwLockID_t rwLockID);
+
+/*! Delete a reader-writer lock, nobody may hold it or wait for it.
+*
+* @param[in,out] rwLockID the ID of the lock, NULLPTR after the call.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_INVALID_ARGUMENT in case of failure.
+*/
+palStatus_t pal_osRwLockDelete(palRwLockID_t* rwLockID);
+
+/*! Create event flags: 32 flags which threads set and clear, and for which other threads wait.
+*
+* @param[out] eventFlagsID the ID of the created event flags, all flags are clear.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_INVALID_ARGUMENT or PAL_ERR_NO_MEMORY in case of failure.
+*/
+palStatus_t pal_osEventFlagsCreate(palEventFlagsID_t* eventFlagsID);
+
+/*! Set event flags. Only the threads whose wait the flags end are woken, the oldest first.
+*
+* @param[in] eventFlagsID the ID of the event flags.
+* @param[in] flags the flags to set.
+* @param[out] flagsAfter the flags after the woken threads cleared theirs, may be NULL.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_INVALID_ARGUMENT in case of failure.
+* \note Event flags can not be set from an interrupt.
+*/
+palStatus_t pal_osEventFlagsSet(palEventFlagsID_t eventFlagsID, uint32_t flags, uint32_t* flagsAfter);
+
+/*! Clear event flags.
+*
+* @param[in] eventFlagsID the ID of the event flags.
+* @param[in] flags the flags to clear.
+* @param[out] flagsBefore the flags before they were cleared, may be NULL.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_INVALID_ARGUMENT in case of failure.
+*/
+palStatus_t pal_osEventFlagsClear(palEventFlagsID_t eventFlagsID, uint32_t flags, uint32_t* flagsBefore);
+
+/*! Wait for any or all of the given event flags. Unless PAL_OS_FLAGS_NO_CLEAR is given the flags waited for are cleared when the wait ends.
+*
+* @param[in] eventFlagsID the ID of the event flags.
+* @param[in] flags the flags to wait for, not 0.
+* @param[in] options PAL_OS_FLAGS_WAIT_ANY or PAL_OS_FLAGS_WAIT_ALL, with PAL_OS_FLAGS_NO_CLEAR.
+* @param[in] millisec the longest time to wait in milliseconds, 0 to check without waiting, PAL_RTOS_WAIT_FOREVER can be used.
+* @param[out] flagsOut the flags which ended the wait, before they were cleared, may be NULL.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_RTOS_TIMEOUT if the flags were not set until the timeout expired,
+*         PAL_ERR_INVALID_ARGUMENT or PAL_ERR_NO_MEMORY in case of failure.
+*/
+palStatus_t pal_osEventFlagsWait(palEventFlagsID_t eventFlagsID, uint32_t flags, uint32_t options, uint32_t millisec, uint32_t* flagsOut);
+
+/*! Delete event flags, no thread may wait for them.
+*
+* @param[in,out] eventFlagsID the ID of the event flags, NULLPTR after the call.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_INVALID_ARGUMENT in case of failure.
+*/
+palStatus_t pal_osEventFlagsDelete(palEventFlagsID_t* eventFlagsID);
+
+/*! Create a condition variable, which threads wait on while they hold a PAL mutex.
+*
+* @param[out] condVarID the ID of the created condition variable.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_INVALID_ARGUMENT or PAL_ERR_NO_MEMORY in case of failure.
+*/
+palStatus_t pal_osCondVarCreate(palCondVarID_t* condVarID);
+
+/*! Release a mutex and wait until the condition variable is signaled, then take the mutex again.
+* The caller checks its condition again after the call, another thread may have changed the state before the mutex was taken.
+*
+* @param[in] condVarID the ID of the condition variable.
+* @param[in] mutexID the mutex, which the caller holds exactly once.
+* @param[in] millisec the longest time to wait in milliseconds, PAL_RTOS_WAIT_FOREVER can be used.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_RTOS_TIMEOUT if the condition variable was not signaled until the timeout expired.
+*         The mutex is held again in both cases. PAL_ERR_INVALID_ARGUMENT (also when the caller holds the mutex more than once)
+*         or PAL_ERR_NO_MEMORY in case of failure.
+*/
+palStatus_t pal_osCondVarWait(palCondVarID_t condVarID, palMutexID_t mutexID, uint32_t millisec);
+
+/*! Wake the thread which waits on a condition variable the longest, if any thread waits.
+*
+* @param[in] condVarID the ID of the condition variable.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_INVALID_ARGUMENT in case of failure.
+*/
+palStatus_t pal_osCondVarSignal(palCondVarID_t condVarID);
+
+/*! Wake all the threads which wait on a condition variable.
+*
+* @param[in] condVarID the ID of the condition variable.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_INVALID_ARGUMENT in case of failure.
+*/
+palStatus_t pal_osCondVarBroadcast(palCondVarID_t condVarID);
+
+/*! Delete a condition variable, no thread may wait on it.
+*
+* @param[in,out] condVarID the ID of the condition variable, NULLPTR after the call.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_INVALID_ARGUMENT in case of failure.
+*/
+palStatus_t pal_osCondVarDelete(palCondVarID_t* condVarID);
+
 /*! Create and initialize a memory pool.
+* The pool is managed by PAL: allocation and free are lock free and may be called from interrupts, and each PAL thread
+* keeps a small cache of blocks (see PAL_RTOS_POOL_THREAD_CACHE_SIZE) so most calls do not touch the shared free list.
+* Pools with less than 2 * PAL_MAX_NUMBER_OF_THREADS * PAL_RTOS_POOL_THREAD_CACHE_SIZE blocks are not cached, larger pools
+* should be sized for the blocks held in the caches of threads which are not allocating.
+* Blocks are not zeroed when the pool is created, use pal_osPoolCAlloc to get a zeroed block.
 *
 * @param[in] blockSize: size of single block in bytes.
-* @param[in] blockCount: maximum number of blocks in memory pool.
+* @param[in] blockCount: maximum number of blocks in memory pool (up to PAL_RTOS_POOL_MAX_BLOCKS).
 * @param[out] memoryPoolID: holds the created memory pool ID handle - zero value indecates an error.
 *
 * \return PAL_SUCCESS when memory pool created successfully.
@@ -322,6 +681,103 @@ palStatus_t pal_osPoolFree(palMemoryPoolID_t memoryPoolID, void* block);
 */
 palStatus_t pal_osPoolDestroy(palMemoryPoolID_t* memoryPoolID);
 
+/*! Allocate several memory blocks from a memory pool.
+*
+* @param[in] memoryPoolID the handle for the memory pool
+* @param[out] blocks the array the allocated blocks are returned in.
+* @param[in] count the number of blocks to allocate.
+* @param[out] allocatedCount the number of blocks allocated, less than count if the pool ran out of blocks.
+*
+* \return the function returns the status in the form of palStatus_t which will be PAL_SUCCESS(0) in case of success (also when less than count blocks were allocated) and another negative value indicating a specific error code in case of failure
+*/
+palStatus_t pal_osPoolAllocBulk(palMemoryPoolID_t memoryPoolID, void** blocks, uint32_t count, uint32_t* allocatedCount);
+
+/*! Return several memory blocks back to a memory pool.
+*
+* @param[in] memoryPoolID the handle for the memory pool
+* @param[in] blocks the blocks to free.
+* @param[in] count the number of blocks in the blocks array.
+*
+* \return the function returns the status in the form of palStatus_t which will be PAL_SUCCESS(0) in case of success and another negative value indicating a specific error code in case of failure,
+*         no block is freed if one of the blocks does not belong to the pool.
+*/
+palStatus_t pal_osPoolFreeBulk(palMemoryPoolID_t memoryPoolID, void** blocks, uint32_t count);
+
+/*! Get the statistics of a memory pool.
+*
+* @param[in] memoryPoolID the handle for the memory pool
+* @param[out] stats the pool statistics.
+*
+* \return the function returns the status in the form of palStatus_t which will be PAL_SUCCESS(0) in case of success and another negative value indicating a specific error code in case of failure
+*/
+palStatus_t pal_osPoolGetStats(palMemoryPoolID_t memoryPoolID, palMemoryPoolStats_t* stats);
+
+
+/*! Allocate memory. Small allocations are served by the size classes of the PAL slab (see PAL_SLAB_SIZE_CLASSES)
+* in constant time and without heap fragmentation, larger allocations and allocations made when their class is exhausted are served by the platform heap.
+* PAL uses it for its own control blocks (mutexes, semaphores, timers etc.).
+*
+* @param[in] len the number of bytes to allocate.
+*
+* \return the function returns a pointer to the allocated memory or NULL in case of failure.
+*/
+void* pal_osMalloc(size_t len);
+
+/*! Free memory allocated by pal_osMalloc.
+*
+* @param[in] buffer the memory to free, NULL is ignored.
+*/
+void pal_osFree(void* buffer);
+
+/*! Get the usage of a size class of the PAL slab.
+*
+* @param[in] classIndex the index of the size class, in the order of PAL_SLAB_SIZE_CLASSES.
+* @param[out] stats the usage of the size class.
+*
+* \return the function returns the status in the form of palStatus_t which will be PAL_SUCCESS(0) in case of success and PAL_ERR_INVALID_ARGUMENT if there is no such class.
+*/
+palStatus_t pal_osMallocGetStats(uint32_t classIndex, palSlabClassStats_t* stats);
+
+/*! Allocate a thread stack from the thread stack pool, for pal_osThreadCreate.
+* The stack comes from the smallest size class of PAL_THREAD_STACK_CLASSES which fits, a stack freed to the class before is
+* reused so creating short lived threads does not allocate from the heap.
+*
+* @param[in] stackSize the size of the stack in bytes.
+* @param[out] stackPtr the stack, 8 bytes aligned.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_INVALID_ARGUMENT or PAL_ERR_NO_MEMORY in case of failure.
+*/
+palStatus_t pal_osThreadStackAlloc(uint32_t stackSize, uint32_t** stackPtr);
+
+/*! Free a stack of the thread stack pool, the thread which used it must have been terminated or have ended.
+* The high water mark of the stack is recorded in the statistics of its class.
+*
+* @param[in,out] stackPtr the stack from pal_osThreadStackAlloc, NULL after the call.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_INVALID_ARGUMENT if the stack is not from the pool or the thread overflowed it
+*         (the guard in front of the stack was overwritten, the stack is then not freed).
+*/
+palStatus_t pal_osThreadStackFree(uint32_t** stackPtr);
+
+/*! Measure how many bytes of a stack of the thread stack pool were used so far, to size the stacks of threads from real runs.
+*
+* @param[in] stackPtr the stack from pal_osThreadStackAlloc, its thread may still run.
+* @param[out] usedBytes the bytes from the top of the stack down to the deepest one written.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_INVALID_ARGUMENT if the stack is not from the pool,
+*         PAL_ERR_NOT_SUPPORTED if PAL_THREAD_STACK_PAINT is false.
+*/
+palStatus_t pal_osThreadStackHighWaterMark(const uint32_t* stackPtr, uint32_t* usedBytes);
+
+/*! Get the usage of a size class of the thread stack pool.
+*
+* @param[in] classIndex the index of the size class, in the order of PAL_THREAD_STACK_CLASSES.
+* @param[out] stats the usage of the size class.
+*
+* \return PAL_SUCCESS(0) in case of success and PAL_ERR_INVALID_ARGUMENT if there is no such class.
+*/
+palStatus_t pal_osThreadStackGetStats(uint32_t classIndex, palThreadStackClassStats_t* stats);
+
 
 /*! Create and initialize a message queue.
 *
@@ -356,6 +812,62 @@ palStatus_t pal_osMessagePut(palMessageQID_t messageQID, uint32_t info, uint32_t
 */
 palStatus_t pal_osMessageGet(palMessageQID_t messageQID, uint32_t timeout, uint32_t* messageValue);
 
+/*! Create and initialize a message queue of fixed size messages, e.g. structs or pointers carried by value.
+*
+* @param[in] messageQSize: size of the message queue.
+* @param[in] messageSize: the size in bytes of every message, e.g. sizeof(void*) for a queue of pointers.
+* @param[out] messageQID: holds the created message queue ID handle - zero value indecates an error.
+*
+* \return PAL_SUCCESS when message queue created successfully.
+*         PAL_ERR_NO_MEMORY: no memory resource available to create message queue object.
+* \note messages are copied in and out of the queue, use pal_osMessagePutTyped/pal_osMessageGetTyped or the batch functions with such a queue.
+*/
+palStatus_t pal_osMessageQueueCreateTyped(uint32_t messageQSize, uint32_t messageSize, palMessageQID_t* messageQID);
+
+/*! Put a fixed size message to a queue.
+*
+* @param[in] messageQID the handle for the message queue
+* @param[in] message the message to send, messageSize bytes are copied
+* @param[in] timeout timeout in milliseconds
+*
+* \return the function returns the status in the form of palStatus_t which will be PAL_SUCCESS(0) in case of success and another negative value indicating a specific error code in case of failure
+*/
+palStatus_t pal_osMessagePutTyped(palMessageQID_t messageQID, const void* message, uint32_t timeout);
+
+/*! Get a fixed size message or wait for a message from a queue.
+*
+* @param[in] messageQID the handle for the message queue
+* @param[in] timeout timeout in milliseconds
+* @param[out] message the buffer for the message, at least messageSize bytes
+*
+* \return the function returns the status in the form of palStatus_t, the error codes are those of pal_osMessageGet.
+*/
+palStatus_t pal_osMessageGetTyped(palMessageQID_t messageQID, uint32_t timeout, void* message);
+
+/*! Put up to count messages to a queue in a single call.
+*
+* @param[in] messageQID the handle for the message queue
+* @param[in] messages an array of count consecutive messages
+* @param[in] count the number of messages in the array
+* @param[in] timeout timeout in milliseconds to wait for space for the first message, the rest are put only if there is room
+* @param[out] putCount the number of messages which were put (optional, may be NULL)
+*
+* \return PAL_SUCCESS(0) when at least one message was put, otherwise the error codes are those of pal_osMessagePut.
+*/
+palStatus_t pal_osMessagePutBatch(palMessageQID_t messageQID, const void* messages, uint32_t count, uint32_t timeout, uint32_t* putCount);
+
+/*! Get up to count messages from a queue in a single call.
+*
+* @param[in] messageQID the handle for the message queue
+* @param[in] timeout timeout in milliseconds to wait for the first message, the rest are taken only if already queued
+* @param[out] messages a buffer for count consecutive messages
+* @param[in] count the maximal number of messages to get
+* @param[out] getCount the number of messages which were received (optional, may be NULL)
+*
+* \return PAL_SUCCESS(0) when at least one message was received, otherwise the error codes are those of pal_osMessageGet.
+*/
+palStatus_t pal_osMessageGetBatch(palMessageQID_t messageQID, uint32_t timeout, void* messages, uint32_t count, uint32_t* getCount);
+
 /*! Delete a message queue object.
 *
 * @param[inout] messageQID the handle for the message queue, in success:(*messageQID = NULL).
@@ -364,6 +876,92 @@ palStatus_t pal_osMessageGet(palMessageQID_t messageQID, uint32_t timeout, uint3
 */
 palStatus_t pal_osMessageQueueDestroy(palMessageQID_t* messageQID);
 
+/*! Create a single producer single consumer ring of fixed size elements.
+*   The ring uses only atomic operations, it is much cheaper than a message queue when exactly one thread puts and exactly one thread gets.
+*
+* @param[in] capacity: the number of elements in the ring, must be a power of two.
+* @param[in] elementSize: the size in bytes of every element, elements are copied in and out of the ring.
+* @param[in] blocking: true to allow pal_osSpscRingPush/Pop to wait on a full/empty ring, false for a ring which never waits.
+* @param[out] ringID: holds the created ring ID handle - zero value indecates an error.
+*
+* \return PAL_SUCCESS when the ring created successfully.
+*         PAL_ERR_INVALID_ARGUMENT: the capacity is not a power of two or the element size is zero.
+*         PAL_ERR_NO_MEMORY: no memory resource available to create the ring.
+* \note a blocking ring posts a semaphore only when the other side is waiting, but it pays a memory barrier on every push and pop.
+*/
+palStatus_t pal_osSpscRingCreate(uint32_t capacity, uint32_t elementSize, bool blocking, palSpscRingID_t* ringID);
+
+/*! Push an element to a ring, may only be called by the single producer thread.
+*
+* @param[in] ringID: the handle for the ring.
+* @param[in] element: the element to copy into the ring.
+* @param[in] timeout: timeout in milliseconds to wait while the ring is full, ignored by a non blocking ring.
+*
+* \return PAL_SUCCESS(0) in case of success.
+*         PAL_ERR_RTOS_RESOURCE: the ring is full and the timeout is zero or the ring is non blocking.
+*         PAL_ERR_RTOS_TIMEOUT: the ring stayed full during the timeout period.
+*/
+palStatus_t pal_osSpscRingPush(palSpscRingID_t ringID, const void* element, uint32_t timeout);
+
+/*! Pop an element from a ring, may only be called by the single consumer thread.
+*
+* @param[in] ringID: the handle for the ring.
+* @param[in] timeout: timeout in milliseconds to wait while the ring is empty, ignored by a non blocking ring.
+* @param[out] element: the buffer for the element, at least elementSize bytes.
+*
+* \return PAL_SUCCESS(0) in case of success.
+*         PAL_ERR_RTOS_RESOURCE: the ring is empty and the timeout is zero or the ring is non blocking.
+*         PAL_ERR_RTOS_TIMEOUT: the ring stayed empty during the timeout period.
+*/
+palStatus_t pal_osSpscRingPop(palSpscRingID_t ringID, uint32_t timeout, void* element);
+
+/*! Delete a ring, no thread may use it during or after this call.
+*
+* @param[inout] ringID: the handle for the ring, in success:(*ringID = NULL).
+*
+* \return the function returns the status in the form of palStatus_t which will be PAL_SUCCESS(0) in case of success and another negative value indicating a specific error code in case of failure
+*/
+palStatus_t pal_osSpscRingDestroy(palSpscRingID_t* ringID);
+
+/*! Create an executor: a fixed pool of worker threads which run submitted work, so consumers share threads instead of creating their own.
+*
+* @param[in] workers the number of worker threads, they all run at the given thread priority.
+* @param[in] priority the thread priority of the workers.
+* @param[in] stackSize the stack size of every worker.
+* @param[in] queueSize the work every worker queues per work priority, a power of 2.
+* @param[in] workStealing if true, an idle worker takes work queued to the other workers.
+* @param[out] executorID the handle of the created executor.
+*
+* \return PAL_SUCCESS(0) in case of success.
+*         PAL_ERR_INVALID_ARGUMENT: no workers, or queueSize is not a power of 2.
+*         PAL_ERR_NO_MEMORY: no memory for the executor.
+*         PAL_ERR_RTOS_RESOURCE: not enough PAL threads for the workers.
+*/
+palStatus_t pal_osExecutorCreate(uint32_t workers, palThreadPriority_t priority, uint32_t stackSize, uint32_t queueSize, bool workStealing, palExecutorID_t* executorID);
+
+/*! Submit work to an executor, the call never blocks.
+*
+* @param[in] executorID the handle of the executor.
+* @param[in] function the work, called on a worker thread with funcArgument.
+* @param[in] funcArgument the argument of the work.
+* @param[in] priority the priority of the work.
+* @param[in] completion called on the worker thread with completionArgument after the work returns, may be NULL.
+* @param[in] completionArgument the argument of the completion.
+*
+* \return PAL_SUCCESS(0) in case of success.
+*         PAL_ERR_RTOS_RESOURCE: the queues of all the workers are full for this priority.
+*/
+palStatus_t pal_osExecutorSubmit(palExecutorID_t executorID, palWorkFuncPtr function, void* funcArgument, palWorkPriority_t priority, palWorkFuncPtr completion, void* completionArgument);
+
+/*! Destroy an executor, the queued work runs before the workers stop. No work may be submitted during or after this call,
+*   and it may not be called from a worker.
+*
+* @param[inout] executorID the handle of the executor, in success:(*executorID = NULL).
+*
+* \return the function returns the status in the form of palStatus_t which will be PAL_SUCCESS(0) in case of success and another negative value indicating a specific error code in case of failure
+*/
+palStatus_t pal_osExecutorDestroy(palExecutorID_t* executorID);
+
 /*! Perform an atomic increment for a signed32 bit value
 *
 * @param[in,out] valuePtr the address of the value to increment
@@ -373,8 +971,222 @@ palStatus_t pal_osMessageQueueDestroy(palMessageQID_t* messageQID);
 */
 int32_t pal_osAtomicIncrement(int32_t* valuePtr, int32_t increment);
 
+/*! Atomically read a value.
+*
+* @param[in] valuePtr the address of the value, naturally aligned.
+* @param[in] order the memory order, PAL_MEMORY_ORDER_RELAXED, PAL_MEMORY_ORDER_ACQUIRE or PAL_MEMORY_ORDER_SEQ_CST.
+*
+* \returns the value read.
+* \note all the pal_osAtomic functions may be called from interrupt context, the 64 bit ones may be implemented with a critical section.
+*/
+uint32_t pal_osAtomicLoad32(const uint32_t* valuePtr, palMemoryOrder_t order);
+uint64_t pal_osAtomicLoad64(const uint64_t* valuePtr, palMemoryOrder_t order);
+void* pal_osAtomicLoadPointer(void* const* valuePtr, palMemoryOrder_t order);
 
+/*! Atomically write a value.
+*
+* @param[out] valuePtr the address of the value, naturally aligned.
+* @param[in] value the value to write.
+* @param[in] order the memory order, PAL_MEMORY_ORDER_RELAXED, PAL_MEMORY_ORDER_RELEASE or PAL_MEMORY_ORDER_SEQ_CST.
+*/
+void pal_osAtomicStore32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order);
+void pal_osAtomicStore64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order);
+void pal_osAtomicStorePointer(void** valuePtr, void* value, palMemoryOrder_t order);
 
+/*! Atomically replace a value.
+*
+* @param[in,out] valuePtr the address of the value, naturally aligned.
+* @param[in] value the new value.
+* @param[in] order the memory order.
+*
+* \returns the value before the operation.
+*/
+uint32_t pal_osAtomicExchange32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order);
+uint64_t pal_osAtomicExchange64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order);
+void* pal_osAtomicExchangePointer(void** valuePtr, void* value, palMemoryOrder_t order);
+
+/*! Atomically replace a value only if it holds the expected value (strong compare and swap).
+*
+* @param[in,out] valuePtr the address of the value, naturally aligned.
+* @param[in,out] expected the value valuePtr must hold, on failure it is set to the value valuePtr held.
+* @param[in] desired the new value.
+* @param[in] order the memory order of a successful operation, a failed operation has the order without its release part.
+*
+* \returns true if the value was replaced, false otherwise.
+*/
+bool pal_osAtomicCompareAndSwap32(uint32_t* valuePtr, uint32_t* expected, uint32_t desired, palMemoryOrder_t order);
+bool pal_osAtomicCompareAndSwap64(uint64_t* valuePtr, uint64_t* expected, uint64_t desired, palMemoryOrder_t order);
+bool pal_osAtomicCompareAndSwapPointer(void** valuePtr, void** expected, void* desired, palMemoryOrder_t order);
+
+/*! Atomically add to or subtract from a value, wrapping around on overflow.
+*
+* @param[in,out] valuePtr the address of the value, naturally aligned.
+* @param[in] value the amount to add or subtract.
+* @param[in] order the memory order.
+*
+* \returns the value before the operation.
+*/
+uint32_t pal_osAtomicFetchAdd32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order);
+uint64_t pal_osAtomicFetchAdd64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order);
+uint32_t pal_osAtomicFetchSub32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order);
+uint64_t pal_osAtomicFetchSub64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order);
+
+/*! Atomically clear (AND) or set (OR) bits of a value.
+*
+* @param[in,out] valuePtr the address of the value, naturally aligned.
+* @param[in] value the mask to AND or OR with.
+* @param[in] order the memory order.
+*
+* \returns the value before the operation.
+*/
+uint32_t pal_osAtomicFetchAnd32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order);
+uint64_t pal_osAtomicFetchAnd64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order);
+uint32_t pal_osAtomicFetchOr32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order);
+uint64_t pal_osAtomicFetchOr64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order);
+
+/*! Memory fence, orders the memory accesses before and after it like an atomic operation with the given order would.
+*
+* @param[in] order the memory order, PAL_MEMORY_ORDER_SEQ_CST is needed to order a store before a later load.
+*/
+void pal_osAtomicFence(palMemoryOrder_t order);
+
+
+
+
+//! PAL log output function prototype, it receives a formatted and NUL terminated line.
+typedef void(*palLogSinkFuncPtr)(const char* line);
+
+//! Counters of the PAL logger, since the program started.
+typedef struct palLogStats{
+    uint32_t logged;    /*! messages queued to the deferred logger*/
+    uint32_t dropped;   /*! messages dropped because the queue was full or contended*/
+    uint32_t truncated; /*! messages which had more arguments or string bytes than a queue entry keeps*/
+    uint32_t emitted;   /*! messages formatted and written by the logger thread*/
+} palLogStats_t;
+
+/*! Start the deferred logger: dbgPrintf and pal_osLogPrintf only queue the format pointer and the raw arguments, and a thread of
+*   PAL_LOG_THREAD_PRIORITY formats and writes them. Before the logger starts and after it stops, messages are written by the caller.
+*
+* @param[in] sink the function which writes the lines, NULL writes them with printf.
+*
+* \return the function returns the status in the form of palStatus_t which will be PAL_SUCCESS(0) in case of success and another negative value indicating a specific error code in case of failure
+* \note the format strings and the function names must be string literals (or otherwise outlive the logger), %s arguments are copied.
+* \note pal_osLogStart and pal_osLogStop must not be called concurrently, pal_destroy stops the logger.
+*/
+palStatus_t pal_osLogStart(palLogSinkFuncPtr sink);
+
+/*! Stop the deferred logger, the queued messages are written before the call returns.
+*
+* \return PAL_SUCCESS(0), also when the logger was not running.
+*/
+palStatus_t pal_osLogStop(void);
+
+/*! Log a message through the PAL logger whether DEBUG is defined or not. While the logger runs the call never blocks: a message
+*   which finds the queue full is dropped and counted.
+*
+* @param[in] function name of the current function
+* @param[in] line line number to be printed
+* @param[in] format print format (just like printf), %n is not supported
+*/
+void pal_osLogPrintf(const char* function, uint32_t line, const char* format, ...);
+
+/*! Get the counters of the PAL logger.
+*
+* @param[out] stats the counters.
+*
+* \return PAL_SUCCESS(0) in case of success and PAL_ERR_INVALID_ARGUMENT if stats is NULL.
+*/
+palStatus_t pal_osLogGetStats(palLogStats_t* stats);
+
+//! The linker section of the PAL_TRACE format strings, a trace ID is the offset of its format string in the section.
+#define PAL_TRACE_SECTION_NAME "pal_trace_fmt"
+//! "PALT" in a little endian word, the first word of a trace snapshot.
+#define PAL_TRACE_SNAPSHOT_MAGIC 0x544C4150
+#define PAL_TRACE_SNAPSHOT_VERSION 2
+
+//! A trace record, a record is valid when its sequence (the position it was written at + 1) is not zero.
+typedef struct palTraceEntry{
+    uint32_t sequence;
+    uint32_t id;
+    uint32_t timestamp;     /*! the low 32 bits of the 64 bit kernel tick (pal_osKernelSysTick64)*/
+    uint32_t timestampHigh; /*! the high 32 bits of the 64 bit kernel tick*/
+    uint32_t argumentCount;
+    uint32_t arguments[PAL_TRACE_MAX_ARGUMENTS];
+} palTraceEntry_t;
+
+//! The header of a trace snapshot, the entries follow it in the order they were written (all fields in the target byte order).
+typedef struct palTraceSnapshotHeader{
+    uint32_t magic;         /*! PAL_TRACE_SNAPSHOT_MAGIC*/
+    uint16_t version;       /*! PAL_TRACE_SNAPSHOT_VERSION*/
+    uint16_t entrySize;     /*! sizeof(palTraceEntry_t)*/
+    uint32_t entryCount;    /*! the entries in the snapshot*/
+    uint32_t lost;          /*! records overwritten (or being written) before the snapshot was taken*/
+    uint32_t tickFrequency; /*! the frequency of the timestamps in Hz*/
+} palTraceSnapshotHeader_t;
+
+#if PAL_TRACE_ENABLED
+/*! Record a trace: the format string is interned in the PAL_TRACE_SECTION_NAME section at compile time, and only its ID and the
+*   arguments are written to the trace buffer. The buffer keeps the last PAL_TRACE_BUFFER_ENTRIES records, a snapshot of it
+*   (pal_osTraceSnapshot) is decoded on the host by Test/Scripts/pal_trace_decode.py with the ELF file of the program.
+*
+* @param[in] format printf format, a string literal.
+* @param[in] ARGS up to PAL_TRACE_MAX_ARGUMENTS (at most 8) integer arguments of at most 32 bits, they are passed as uint32_t; %s is not supported.
+*                  A wider argument (a pointer on a 64 bit host) or a ninth argument does not compile, cast it to uint32_t.
+*
+* \note PAL_TRACE never blocks and may be called from interrupt context.
+*/
+#define PAL_TRACE(format, ARGS...) \
+    do { \
+        static const char palTraceFormat[] __attribute__((section(PAL_TRACE_SECTION_NAME), used, aligned(1))) = format; \
+        pal_osTraceRecord(palTraceFormat, PAL_TRACE_COUNT_ARGUMENTS(ARGS) PAL_TRACE_ARGUMENTS(ARGS)); \
+    } while (0)
+#else
+#define PAL_TRACE(format, ARGS...)
+#endif
+
+#define PAL_TRACE_COUNT_ARGUMENTS(ARGS...) PAL_TRACE_COUNT_ARGUMENTS_(0, ##ARGS, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define PAL_TRACE_COUNT_ARGUMENTS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, count, ...) count
+
+//! An argument which fits 32 bits converted to uint32_t, the type pal_osTraceRecord reads it as; a wider one is a negative array size.
+#define PAL_TRACE_ARGUMENT(argument) ((void)sizeof(char[(sizeof(argument) <= sizeof(uint32_t)) ? 1 : -1]), (uint32_t)(argument))
+//! The arguments, each after a comma and converted by PAL_TRACE_ARGUMENT.
+#define PAL_TRACE_ARGUMENTS(ARGS...) PAL_TRACE_ARGUMENTS_(PAL_TRACE_COUNT_ARGUMENTS(ARGS), ##ARGS)
+#define PAL_TRACE_ARGUMENTS_(count, ARGS...) PAL_TRACE_ARGUMENTS_N(count, ##ARGS)
+#define PAL_TRACE_ARGUMENTS_N(count, ARGS...) PAL_TRACE_ARGUMENTS_##count(ARGS)
+#define PAL_TRACE_ARGUMENTS_0()
+#define PAL_TRACE_ARGUMENTS_1(a) , PAL_TRACE_ARGUMENT(a)
+#define PAL_TRACE_ARGUMENTS_2(a, ARGS...) , PAL_TRACE_ARGUMENT(a) PAL_TRACE_ARGUMENTS_1(ARGS)
+#define PAL_TRACE_ARGUMENTS_3(a, ARGS...) , PAL_TRACE_ARGUMENT(a) PAL_TRACE_ARGUMENTS_2(ARGS)
+#define PAL_TRACE_ARGUMENTS_4(a, ARGS...) , PAL_TRACE_ARGUMENT(a) PAL_TRACE_ARGUMENTS_3(ARGS)
+#define PAL_TRACE_ARGUMENTS_5(a, ARGS...) , PAL_TRACE_ARGUMENT(a) PAL_TRACE_ARGUMENTS_4(ARGS)
+#define PAL_TRACE_ARGUMENTS_6(a, ARGS...) , PAL_TRACE_ARGUMENT(a) PAL_TRACE_ARGUMENTS_5(ARGS)
+#define PAL_TRACE_ARGUMENTS_7(a, ARGS...) , PAL_TRACE_ARGUMENT(a) PAL_TRACE_ARGUMENTS_6(ARGS)
+#define PAL_TRACE_ARGUMENTS_8(a, ARGS...) , PAL_TRACE_ARGUMENT(a) PAL_TRACE_ARGUMENTS_7(ARGS)
+
+/*! Write a trace record, used by PAL_TRACE.
+*
+* @param[in] format the interned format string.
+* @param[in] argumentCount the number of uint32_t arguments which follow, arguments after PAL_TRACE_MAX_ARGUMENTS are not recorded.
+*/
+void pal_osTraceRecord(const char* format, uint32_t argumentCount, ...);
+
+/*! Get the format string of a trace ID, to decode traces on the target.
+*
+* @param[in] id the ID of the trace record.
+*
+* \return the format string, NULL if the ID is not the ID of a format string.
+*/
+const char* pal_osTraceFormat(uint32_t id);
+
+/*! Copy the trace buffer as a header and the valid entries from the oldest to the newest, records keep being written meanwhile.
+*
+* @param[out] buffer the buffer for the snapshot, suitably aligned for palTraceSnapshotHeader_t.
+* @param[in] size the size of the buffer in bytes, the oldest entries are left out if it is too small.
+* @param[out] length the length of the snapshot in bytes.
+*
+* \return PAL_SUCCESS(0) in case of success and PAL_ERR_INVALID_ARGUMENT if the buffer can not hold the header.
+*/
+palStatus_t pal_osTraceSnapshot(void* buffer, uint32_t size, uint32_t* length);
 
 /*! Printf like function with prefix of function and line.
 *
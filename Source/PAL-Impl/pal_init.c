@@ -69,6 +69,8 @@ void pal_destroy()
     if (0 == currentInitValue)
     {
         DEBUG_PRINT("Destroying modules\r\n");
+        pal_osThreadStatsDumpStop();
+        pal_osLogStop();
         pal_plat_RTOSDestroy();
         pal_plat_socketsTerminate(NULL);
     }
@@ -108,6 +108,46 @@ palStatus_t pal_plat_receiveFrom(palSocket_t socket, void* buffer, size_t length
 */
 palStatus_t pal_plat_sendTo(palSocket_t socket, const void* buffer, size_t length, const palSocketAddress_t* to, palSocketLength_t toLength, size_t* bytesSent);
 
+/*! Send several payloads, each to its own address, in the order of the array. The arguments are checked by the caller.
+* @param[in] socket The socket to use for sending the payloads.
+* @param[in,out] datagrams The datagrams to send. Set the bytes and status of each datagram sent, and the status of the datagram which failed.
+* @param[in] count The number of datagrams in the array, at least 1.
+* @param[out] datagramsSent The number of datagrams sent.
+\return The status in the form of PalStatus_t; PAL_SUCCESS (0) if at least one datagram was sent, the error of the first datagram otherwise.
+*/
+palStatus_t pal_plat_sendToMulti(palSocket_t socket, palDatagram_t* datagrams, uint32_t count, uint32_t* datagramsSent);
+
+/*! Receive several payloads, waiting (on a blocking socket) for the first one only. The arguments are checked by the caller.
+* @param[in] socket The socket to receive from.
+* @param[in,out] datagrams The buffers for the payloads. Set the bytes, status and address of each datagram received.
+* @param[in] count The number of datagrams in the array, at least 1.
+* @param[out] datagramsReceived The number of datagrams received, a platform without batching may receive one datagram per call.
+\return The status in the form of PalStatus_t; PAL_SUCCESS (0) if at least one datagram was received, a specific negative error code otherwise.
+*/
+palStatus_t pal_plat_receiveFromMulti(palSocket_t socket, palDatagram_t* datagrams, uint32_t count, uint32_t* datagramsReceived);
+
+/*! Send one datagram gathered from several buffer segments. The arguments are checked by the caller.
+* @param[in] socket The socket to use for sending the payload.
+* @param[in] segments The segments of the payload in order, bufferLength bytes of each are sent.
+* @param[in] segmentCount The number of segments, 1 to PAL_NET_MAX_SEGMENTS.
+* @param[in] to The address to which the payload should be sent.
+* @param[in] toLength The length of the 'to' address.
+* @param[out] bytesSent The actual amount of payload data sent.
+\return The status in the form of PalStatus_t; PAL_SUCCESS (0) in case of success, a specific negative error code in case of failure.
+*/
+palStatus_t pal_plat_sendTov(palSocket_t socket, const palConstBuffer_t* segments, uint32_t segmentCount, const palSocketAddress_t* to, palSocketLength_t toLength, size_t* bytesSent);
+
+/*! Receive one datagram scattered over several buffer segments, filled in order up to their maxBufferLength. The arguments are checked by the caller.
+* @param[in] socket The socket to receive from.
+* @param[in] segments The segments to fill, the caller sets their bufferLength from bytesReceived.
+* @param[in] segmentCount The number of segments, 1 to PAL_NET_MAX_SEGMENTS.
+* @param[out] from The address that sent the payload [optional - if not required pass NULL].
+* @param[in, out] fromLength The length of the 'from' address [optional - if not required pass NULL].
+* @param[out] bytesReceived The actual amount of payload data received.
+\return The status in the form of PalStatus_t; PAL_SUCCESS (0) in case of success, a specific negative error code in case of failure.
+*/
+palStatus_t pal_plat_receiveFromv(palSocket_t socket, palBuffer_t* segments, uint32_t segmentCount, palSocketAddress_t* from, palSocketLength_t* fromLength, size_t* bytesReceived);
+
 /*! Close a network socket. 
 * NOTE: recieves palSocket_t* and not palSocket_t so that it can zero the socket to avoid re-use.
 * @param[in,out] socket Release and zero socket pointed to by given pointer.
@@ -129,19 +169,65 @@ palStatus_t pal_plat_getNumberOfNetInterfaces(uint32_t* numInterfaces);
 palStatus_t pal_plat_getNetInterfaceInfo(uint32_t interfaceNum, palNetInterfaceInfo_t* interfaceInfo);
 
 
-/*! Check if one or more (up to PAL_NET_SOCKET_SELECT_MAX_SOCKETS) sockets has data available for reading/writing/error. The function blocks until data is available for one of the given sockets or the timeout expires.
-To use the function, set the sockets you want to check in the socketsToCheck array and set a timeout. When it returns the socketStatus output inidcates the status of each socket passed in.
-Note: The entry in index x in the socketStatus array corresponds to the socket at index x in the sockets to check array.
+/*! Check if one or more (up to PAL_NET_SOCKET_SELECT_MAX_SOCKETS) sockets has data available for reading/writing/error. The function blocks until one of the given sockets
+has an event of interest or the timeout expires.
+Note: The entry in index x in the socketStatus array corresponds to the socket at index x in the sockets to check array, a socket may be given more than once.
 * @param[in] socketsToCheck The array of up to 8 socket handles to check.
 * @param[in] numberOfSockets The number of sockets set in the input socketsToCheck array.
-* @param[in] timeout The time until timeout if no socket activity is detected.
+* @param[in] timeout The time in milliseconds until timeout if no socket activity is detected, 0 to check without blocking.
+* @param[in] interestMask The events to check for, a mask of PAL_NET_SOCKET_SELECT_XX_BIT values (errors are always reported).
 * @param[out] palSocketStatus Information on each socket in the input array indicating which event was set (none, rx, tx, err). Check for a desired event using macros.
-* @param[out] numberOfSocketsSet The total number of sockets set in all three data sets (tx, rx, err) after a completed function.
+* @param[out] numberOfSocketsSet The number of entries set in palSocketStatus after a completed function.
 \return The status in the form of PalStatus_t; PAL_SUCCESS (0) in case of success, a specific negative error code in case of failure.
 */
-palStatus_t pal_plat_socketMiniSelect(const palSocket_t socketsToCheck[PAL_NET_SOCKET_SELECT_MAX_SOCKETS], uint32_t numberOfSockets, pal_timeVal_t* timeout,
+palStatus_t pal_plat_socketMiniSelect(const palSocket_t socketsToCheck[PAL_NET_SOCKET_SELECT_MAX_SOCKETS], uint32_t numberOfSockets, uint32_t timeout, uint8_t interestMask,
                                         uint8_t palSocketStatus[PAL_NET_SOCKET_SELECT_MAX_SOCKETS], uint32_t * numberOfSocketsSet);
 
+/*! Create a socket poller. The poller keeps the set of sockets and the events of interest for each of them between calls to pal_plat_socketPollerWait.
+* @param[out] poller The created poller handle.
+\return The status in the form of PalStatus_t; PAL_SUCCESS (0) in case of success, a specific negative error code in case of failure.
+*/
+palStatus_t pal_plat_socketPollerCreate(palSocketPollerID_t* poller);
+
+/*! Destroy a socket poller. Sockets still in the poller are removed from it but not closed.
+* @param[in,out] poller The poller to destroy, set to NULLPTR on success.
+\return The status in the form of PalStatus_t; PAL_SUCCESS (0) in case of success, a specific negative error code in case of failure.
+*/
+palStatus_t pal_plat_socketPollerDestroy(palSocketPollerID_t* poller);
+
+/*! Add a socket to a poller.
+* @param[in] poller The poller.
+* @param[in] socket The socket to add.
+* @param[in] interestMask The events to report for the socket, a mask of PAL_NET_SOCKET_SELECT_XX_BIT values. Errors are always reported.
+\return The status in the form of PalStatus_t; PAL_SUCCESS (0) in case of success, a specific negative error code in case of failure.
+*/
+palStatus_t pal_plat_socketPollerAdd(palSocketPollerID_t poller, palSocket_t socket, uint8_t interestMask);
+
+/*! Change the events of interest of a socket in a poller.
+* @param[in] poller The poller.
+* @param[in] socket A socket previously added to the poller.
+* @param[in] interestMask The events to report for the socket, a mask of PAL_NET_SOCKET_SELECT_XX_BIT values. Errors are always reported.
+\return The status in the form of PalStatus_t; PAL_SUCCESS (0) in case of success, a specific negative error code in case of failure.
+*/
+palStatus_t pal_plat_socketPollerModify(palSocketPollerID_t poller, palSocket_t socket, uint8_t interestMask);
+
+/*! Remove a socket from a poller.
+* @param[in] poller The poller.
+* @param[in] socket A socket previously added to the poller.
+\return The status in the form of PalStatus_t; PAL_SUCCESS (0) in case of success, a specific negative error code in case of failure.
+*/
+palStatus_t pal_plat_socketPollerRemove(palSocketPollerID_t poller, palSocket_t socket);
+
+/*! Wait until events happen on sockets of the poller or the timeout expires.
+* @param[in] poller The poller.
+* @param[out] events The array of events, one entry per socket with events.
+* @param[in] maxEvents The number of entries in the events array.
+* @param[in] timeout The time to wait in milliseconds, 0 to return immediately or PAL_RTOS_WAIT_FOREVER to wait without a timeout.
+* @param[out] numberOfEvents The number of entries set in the events array, 0 if the timeout expired.
+\return The status in the form of PalStatus_t; PAL_SUCCESS (0) in case of success (also when the timeout expired), a specific negative error code in case of failure.
+*/
+palStatus_t pal_plat_socketPollerWait(palSocketPollerID_t poller, palSocketPollEvent_t* events, uint32_t maxEvents, uint32_t timeout, uint32_t* numberOfEvents);
+
 
 #if PAL_NET_TCP_AND_TLS_SUPPORT // functionality below supported only in case TCP is supported.
 
@@ -188,6 +274,25 @@ palStatus_t pal_plat_recv(palSocket_t socket, void* buf, size_t len, size_t* rec
 */
 palStatus_t pal_plat_send(palSocket_t socket, const void* buf, size_t len, size_t* sentDataSize);
 
+/*! Send data gathered from several buffer segments via the given connected socket. The arguments are checked by the caller.
+* @param[in] socket The connected socket on which to send data.
+* @param[in] segments The segments of the data in order, bufferLength bytes of each are sent.
+* @param[in] segmentCount The number of segments, 1 to PAL_NET_MAX_SEGMENTS.
+* @param[out] sentDataSize The length of the data sent.
+\return The status in the form of PalStatus_t; PAL_SUCCESS (0) in case of success, a specific negative error code in case of failure.
+*/
+palStatus_t pal_plat_sendv(palSocket_t socket, const palConstBuffer_t* segments, uint32_t segmentCount, size_t* sentDataSize);
+
+/*! Receive data from the given connected socket scattered over several buffer segments, filled in order up to their maxBufferLength.
+* The arguments are checked by the caller.
+* @param[in] socket The connected socket on which to receive data.
+* @param[in] segments The segments to fill, the caller sets their bufferLength from recievedDataSize.
+* @param[in] segmentCount The number of segments, 1 to PAL_NET_MAX_SEGMENTS.
+* @param[out] recievedDataSize The length of the data actually received.
+\return The status in the form of PalStatus_t; PAL_SUCCESS (0) in case of success, a specific negative error code in case of failure.
+*/
+palStatus_t pal_plat_recvv(palSocket_t socket, palBuffer_t* segments, uint32_t segmentCount, size_t* recievedDataSize);
+
 
 #endif //PAL_NET_TCP_AND_TLS_SUPPORT
 
@@ -203,6 +308,19 @@ palStatus_t pal_plat_send(palSocket_t socket, const void* buf, size_t len, size_
 */
 palStatus_t pal_plat_asynchronousSocket(palSocketDomain_t domain, palSocketType_t type, bool nonBlockingSocket, uint32_t interfaceNum, palAsyncSocketCallback_t callback, palSocket_t* socket);
 
+/*! Get an asynchronous network socket whose callback gets the socket, the events and a context. The arguments are checked by the caller.
+* @param[in] domain The domain of the created socket (see enum palSocketDomain_t for supported types).
+* @param[in] type The type of the created socket (see enum palSocketType_t for supported types).
+* @param[in] callback A callback function that is called with the socket, a mask of PAL_NET_SOCKET_SELECT_XX_BIT events and the context.
+* @param[in] context Passed to the callback as is.
+* @param[in] deferralQueue NULLPTR to call the callback in the callback context of the stack, otherwise a typed message queue of palAsyncSocketEvent_t messages to post the events to.
+*            Posting may not wait, the events which do not fit into the queue must be kept and posted once the queue has room.
+* @param[out] socket This output parameter returns the socket.
+\return The status in the form of PalStatus_t; PAL_SUCCESS (0) in case of success, a specific negative error code in case of failure.
+*/
+palStatus_t pal_plat_asynchronousSocketWithContext(palSocketDomain_t domain, palSocketType_t type, bool nonBlockingSocket, uint32_t interfaceNum, palAsyncSocketContextCallback_t callback, void* context,
+                                                   palMessageQID_t deferralQueue, palSocket_t* socket);
+
 #endif
 
 #if PAL_NET_DNS_SUPPORT
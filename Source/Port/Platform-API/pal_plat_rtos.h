@@ -26,27 +26,6 @@ extern "C" {
 #include "pal_configuration.h"
 #include "pal_types.h"
 
-#if PAL_UNIQUE_THREAD_PRIORITY
-//! This array holds a counter for each thread priority.
-//! If the counter is more than 1, it means that more than 
-//! one thread has the same priority and this is a forbidden
-//! situation. The mapping between the priorities and the index
-//! in the array is as follow:
-//!
-//! PAL_osPriorityIdle --> g_palThreadPriorities[0]
-//! PAL_osPriorityLow --> g_palThreadPriorities[1]
-//! PAL_osPriorityBelowNormal --> g_palThreadPriorities[2]
-//! PAL_osPriorityNormal --> g_palThreadPriorities[3]
-//! PAL_osPriorityAboveNormal --> g_palThreadPriorities[4]
-//! PAL_osPriorityHigh --> g_palThreadPriorities[5]
-//! PAL_osPriorityRealtime --> g_palThreadPriorities[6]
-
-//! An array of PAL thread priorities. The size of the array is defined in the Service API (pal_rtos.h) by "PAL_MAX_NUMBER_OF_THREADS"
-extern uint8_t g_palThreadPriorities[PAL_MAX_NUMBER_OF_THREADS];
-
-#define PRIORITY_INDEX_OFFSET 3
-#endif //PAL_UNIQUE_THREAD_PRIORITY
-
 /*! Initiate a system reboot.
 */
 void pal_plat_osReboot(void);
@@ -101,14 +80,15 @@ uint64_t pal_plat_osKernelSysTickFrequency(void);
 *
 * @param[in] function A function pointer to the thread callback function.
 * @param[in] funcArgument An argument for the thread function.
-* @param[in] priority The priority of the thread.
+* @param[in] priority The priority of the thread, any value from PAL_osPriorityIdle to PAL_osPriorityRealtime.
 * @param[in] stackSize The stack size of the thread.
-* @param[in] stackPtr A pointer to the thread's stack.
+* @param[in] stackPtr A pointer to the thread's stack, owned by the caller. The thread runs on it unless the platform needs a larger stack.
 * @param[in] store A pointer to thread's local store, can be NULL.
 * @param[out] threadID The created thread ID handle, zero indicates an error.
 *
 * \return The ID of the created thread, in case of error return zero.
-* \note Each thread MUST have a unique priority.
+* \note Several threads may have the same priority, and the platform maps the PAL priority to its closest level.
+* \note The platform keeps up to PAL_MAX_NUMBER_OF_THREADS threads, and returns "PAL_ERR_RTOS_RESOURCE" when that many exist.
 * \note When the priority of the created thread function is higher than the current running thread, the 
 *       created thread function starts instantly and becomes the new running thread. 
 * \note the create function MUST not wait for platform resources and it should return "PAL_ERR_RTOS_RESOURCE", unless the platform API is blocking.
@@ -129,11 +109,27 @@ palStatus_t pal_plat_osThreadTerminate(palThreadID_t* threadID);
 */
 palThreadID_t pal_plat_osThreadGetId(void);
 
+/*! Get a value which tells the running thread from every other running thread, whether PAL created it or not.
+* \return The value of the running thread, never 0.
+*/
+uintptr_t pal_plat_osThreadSelf(void);
+
 /*! Get the storage of the current thread.
 * \return The storage of the current thread.
 */
 palThreadLocalStore_t* pal_plat_osThreadGetLocalStore(void);
 
+/*! Get the run time statistics of a thread.
+*
+* @param[in] threadID The ID of the thread.
+* @param[out] stats The statistics of the thread, the counters the platform does not keep are 0.
+*
+* \return PAL_SUCCESS(0) in case of success, PAL_ERR_INVALID_ARGUMENT if there is no such thread.
+* \note The stack high water mark is the part of the stack which does not hold PAL_THREAD_STACK_PAINT_PATTERN any more,
+*       pal_osThreadCreate paints the stack before it calls pal_plat_osThreadCreate.
+*/
+palStatus_t pal_plat_osThreadGetStats(palThreadID_t threadID, palThreadStats_t* stats);
+
 /*! Wait for a specified period of time in milliseconds.
 *
 * @param[in] milliseconds The number of milliseconds to wait before proceeding.
@@ -213,6 +209,14 @@ palStatus_t pal_plat_osMutexWait(palMutexID_t mutexID, uint32_t millisec);
 */
 palStatus_t pal_plat_osMutexRelease(palMutexID_t mutexID);
 
+/*! Get the times the calling thread holds a mutex, which is recursive.
+*
+* @param[in] mutexID The handle for the mutex.
+*
+* \return The times the calling thread took the mutex and did not release it yet, 0 if it does not hold the mutex.
+*/
+uint32_t pal_plat_osMutexDepth(palMutexID_t mutexID);
+
 /*!Delete a mutex object.
 *
 * @param[inout] mutexID The ID of the mutex to delete. In success, *mutexID = NULL.
@@ -266,108 +270,173 @@ palStatus_t pal_plat_osSemaphoreRelease(palSemaphoreID_t semaphoreID);
 */
 palStatus_t pal_plat_osSemaphoreDelete(palSemaphoreID_t* semaphoreID);
 
-/*! Create and initialize a memory pool.
+/*! Create and initialize a message queue.
 *
-* @param[in] blockSize The size of a single block in bytes.
-* @param[in] blockCount The maximum number of blocks in the memory pool.
-* @param[out] memoryPoolID The ID of the created memory pool, zero value indicates an error.
+* @param[in] messageQSize The size of the message queue.
+* @param[in] messageSize The size in bytes of every message in the queue.
+* @param[out] messageQID The ID of the created message queue, zero value indicates an error.
 *
-* \return PAL_SUCCESS when the memory pool was created successfully, a specific error in case of failure.
-*         PAL_ERR_NO_MEMORY: no memory resource available to create memory pool object.
+* \return PAL_SUCCESS when the message queue was created successfully, a specific error in case of failure.
+*         PAL_ERR_NO_MEMORY: no memory resource available to create message queue object.
 * \note the create function MUST not wait for platform resources and it should return "PAL_ERR_RTOS_RESOURCE", unless the platform API is blocking.
 */
-palStatus_t pal_plat_osPoolCreate(uint32_t blockSize, uint32_t blockCount, palMemoryPoolID_t* memoryPoolID);
+palStatus_t pal_plat_osMessageQueueCreate(uint32_t messageQSize, uint32_t messageSize, palMessageQID_t* messageQID);
 
-/*! Allocate a single memory block from a memory pool.
+/*! Put a message to a queue.
 *
-* @param[in] memoryPoolID The handle for the memory pool.
+* @param[in] messageQID The handle for the message queue.
+* @param[in] message The data to send, the message size given at creation is copied.
+* @param[in] timeout The timeout in milliseconds.
 *
-* \return A pointer to a single allocated memory from the pool, NULL in case of failure.
+* \return The status in the form of palStatus_t; PAL_SUCCESS(0) in case of success, a negative value indicating a specific error code in case of failure.
 */
-void* pal_plat_osPoolAlloc(palMemoryPoolID_t memoryPoolID);
+palStatus_t pal_plat_osMessagePut(palMessageQID_t messageQID, const void* message, uint32_t timeout);
 
-/*! Allocate a single memory block from a memory pool and set memory block to zero.
+/*! Get a message or wait for a message from a queue.
 *
-* @param[in] memoryPoolID The handle for the memory pool.
+* @param[in] messageQID The handle for the message queue.
+* @param[in] timeout The timeout in milliseconds.
+* @param[out] message The buffer for the received data, at least the message size given at creation.
 *
-* \return A pointer to a single allocated memory from the pool, NULL in case of failure.
+* \return The status in the form of palStatus_t; PAL_SUCCESS(0) in case of success, one of the following error codes in case of failure:
+* PAL_ERR_RTOS_RESOURCE - Semaphore was not available but not due to timeout.
+* PAL_ERR_RTOS_TIMEOUT -  No message arrived during the timeout period.
+* PAL_ERR_RTOS_RESOURCE -  No message received and there was no timeout.
 */
-void* pal_plat_osPoolCAlloc(palMemoryPoolID_t memoryPoolID);
+palStatus_t pal_plat_osMessageGet(palMessageQID_t messageQID, uint32_t timeout, void* message);
 
-/*! Return the memoryPoolID of the memory block back to a specific memory pool.
+/*! Put up to count messages to a queue, waiting only for the first one.
 *
-* @param[in] memoryPoolID The handle for the memory pool.
-* @param[in] block The block to be freed.
+* @param[in] messageQID The handle for the message queue.
+* @param[in] messages The consecutive messages to send.
+* @param[in] count The number of messages in messages.
+* @param[in] timeout The timeout in milliseconds for space for the first message.
+* @param[out] putCount The number of messages actually put, may be NULL.
 *
-* \return The status in the form of palStatus_t; PAL_SUCCESS(0) in case of success, a negative value indicating a specific error code in case of failure.
+* \return PAL_SUCCESS(0) when at least one message was put, otherwise the error of pal_plat_osMessagePut.
 */
-palStatus_t pal_plat_osPoolFree(palMemoryPoolID_t memoryPoolID, void* block);
+palStatus_t pal_plat_osMessagePutBatch(palMessageQID_t messageQID, const void* messages, uint32_t count, uint32_t timeout, uint32_t* putCount);
 
-/*! Delete a memory pool object.
+/*! Get up to count messages from a queue, waiting only for the first one.
 *
-* @param[inout] memoryPoolID The handle for the memory pool. In success, *memoryPoolID = NULL.
+* @param[in] messageQID The handle for the message queue.
+* @param[in] timeout The timeout in milliseconds for the first message.
+* @param[out] messages The buffer for count consecutive messages.
+* @param[in] count The maximal number of messages to get.
+* @param[out] getCount The number of messages actually received, may be NULL.
+*
+* \return PAL_SUCCESS(0) when at least one message was received, otherwise the error of pal_plat_osMessageGet.
+*/
+palStatus_t pal_plat_osMessageGetBatch(palMessageQID_t messageQID, uint32_t timeout, void* messages, uint32_t count, uint32_t* getCount);
+
+/*! Delete a message queue object.
+*
+* @param[inout] messageQID The handle for the message queue. In success, *messageQID = NULL.
 *
 * \return The status in the form of palStatus_t; PAL_SUCCESS(0) in case of success, a negative value indicating a specific error code in case of failure.
 */
-palStatus_t pal_plat_osPoolDestroy(palMemoryPoolID_t* memoryPoolID);
+palStatus_t pal_plat_osMessageQueueDestroy(palMessageQID_t* messageQID);
 
-/*! Create and initialize a message queue.
+/*! Atomically read a value.
 *
-* @param[in] messageQSize The size of the message queue.
-* @param[out] messageQID The ID of the created message queue, zero value indicates an error.
+* @param[in] valuePtr The address of the value to read.
+* @param[in] order The memory order of the operation, PAL_MEMORY_ORDER_RELEASE and PAL_MEMORY_ORDER_ACQ_REL are not valid for a load.
 *
-* \return PAL_SUCCESS when the message queue was created successfully, a specific error in case of failure.
-*         PAL_ERR_NO_MEMORY: no memory resource available to create message queue object.
-* \note the create function MUST not wait for platform resources and it should return "PAL_ERR_RTOS_RESOURCE", unless the platform API is blocking.
+* \returns The value read.
+* \note All the atomic operations may be called from interrupt context.
 */
-palStatus_t pal_plat_osMessageQueueCreate(uint32_t messageQSize, palMessageQID_t* messageQID);
+uint32_t pal_plat_osAtomicLoad32(const uint32_t* valuePtr, palMemoryOrder_t order);
+uint64_t pal_plat_osAtomicLoad64(const uint64_t* valuePtr, palMemoryOrder_t order);
 
-/*! Put a message to a queue.
+/*! Atomically write a value.
 *
-* @param[in] messageQID The handle for the message queue.
-* @param[in] info The data to send.
-* @param[in] timeout The timeout in milliseconds.
+* @param[out] valuePtr The address of the value to write.
+* @param[in] value The value to write.
+* @param[in] order The memory order of the operation, PAL_MEMORY_ORDER_ACQUIRE and PAL_MEMORY_ORDER_ACQ_REL are not valid for a store.
+*/
+void pal_plat_osAtomicStore32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order);
+void pal_plat_osAtomicStore64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order);
+
+/*! Atomically replace a value.
 *
-* \return The status in the form of palStatus_t; PAL_SUCCESS(0) in case of success, a negative value indicating a specific error code in case of failure.
+* @param[in,out] valuePtr The address of the value to replace.
+* @param[in] value The new value.
+* @param[in] order The memory order of the operation.
+*
+* \returns The value before the operation.
 */
-palStatus_t pal_plat_osMessagePut(palMessageQID_t messageQID, uint32_t info, uint32_t timeout);
+uint32_t pal_plat_osAtomicExchange32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order);
+uint64_t pal_plat_osAtomicExchange64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order);
 
-/*! Get a message or wait for a message from a queue.
+/*! Atomically replace a value if it holds the expected value (compare and swap). The operation does not fail spuriously.
 *
-* @param[in] messageQID The handle for the message queue.
-* @param[in] timeout The timeout in milliseconds.
-* @param[out] messageValue The data to send.
+* @param[in,out] valuePtr The address of the value to replace.
+* @param[in,out] expected The value valuePtr must hold for the replace to happen, set to the value valuePtr held if it did not.
+* @param[in] desired The new value.
+* @param[in] order The memory order of a successful operation, a failed one is only a load.
 *
-* \return The status in the form of palStatus_t; PAL_SUCCESS(0) in case of success, one of the following error codes in case of failure:
-* PAL_ERR_RTOS_RESOURCE - Semaphore was not available but not due to timeout.
-* PAL_ERR_RTOS_TIMEOUT -  No message arrived during the timeout period.
-* PAL_ERR_RTOS_RESOURCE -  No message received and there was no timeout.
+* \returns true if the value was replaced, false if valuePtr did not hold the expected value.
 */
-palStatus_t pal_plat_osMessageGet(palMessageQID_t messageQID, uint32_t timeout, uint32_t* messageValue);
+bool pal_plat_osAtomicCompareAndSwap32(uint32_t* valuePtr, uint32_t* expected, uint32_t desired, palMemoryOrder_t order);
+bool pal_plat_osAtomicCompareAndSwap64(uint64_t* valuePtr, uint64_t* expected, uint64_t desired, palMemoryOrder_t order);
 
-/*! Delete a message queue object.
+/*! Atomically add to a value, wrapping around on overflow (subtraction is the addition of the two's complement).
 *
-* @param[inout] messageQID The handle for the message queue. In success, *messageQID = NULL.
+* @param[in,out] valuePtr The address of the value to add to.
+* @param[in] value The value to add.
+* @param[in] order The memory order of the operation.
 *
-* \return The status in the form of palStatus_t; PAL_SUCCESS(0) in case of success, a negative value indicating a specific error code in case of failure.
+* \returns The value before the operation.
 */
-palStatus_t pal_plat_osMessageQueueDestroy(palMessageQID_t* messageQID);
+uint32_t pal_plat_osAtomicFetchAdd32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order);
+uint64_t pal_plat_osAtomicFetchAdd64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order);
+
+/*! Atomically AND a value with a mask.
+*
+* @param[in,out] valuePtr The address of the value.
+* @param[in] value The mask.
+* @param[in] order The memory order of the operation.
+*
+* \returns The value before the operation.
+*/
+uint32_t pal_plat_osAtomicFetchAnd32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order);
+uint64_t pal_plat_osAtomicFetchAnd64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order);
 
-/*! Perform an atomic increment for a signed32 bit value.
+/*! Atomically OR a value with a mask.
 *
-* @param[in,out] valuePtr The address of the value to increment.
-* @param[in] increment The number by which to increment.
+* @param[in,out] valuePtr The address of the value.
+* @param[in] value The mask.
+* @param[in] order The memory order of the operation.
 *
-* \returns The value of the valuePtr after the increment operation.
+* \returns The value before the operation.
 */
-int32_t pal_plat_osAtomicIncrement(int32_t* valuePtr, int32_t increment);
+uint32_t pal_plat_osAtomicFetchOr32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order);
+uint64_t pal_plat_osAtomicFetchOr64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order);
+
+/*! Memory fence, PAL_MEMORY_ORDER_SEQ_CST also orders a store followed by a load.
+*
+* @param[in] order The memory order of the fence, PAL_MEMORY_ORDER_RELAXED is no fence.
+*/
+void pal_plat_osAtomicFence(palMemoryOrder_t order);
+
+/*! Allocate memory from the platform heap.
+*
+* @param[in] len The number of bytes to allocate.
+*
+* \returns A pointer to the allocated memory, NULL in case of failure.
+*/
+void* pal_plat_malloc(size_t len);
+
+/*! Free memory allocated by pal_plat_malloc.
+*
+* @param[in] buffer The memory to free, NULL is ignored.
+*/
+void pal_plat_free(void* buffer);
 
-#ifdef DEBUG
 #include "stdio.h"
 #define pal_plat_printf(ARGS...) printf(ARGS)
 #define pal_plat_vprintf(FORMAT,LIST) vprintf(FORMAT,LIST)  
 
-#endif
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,24 @@
+/*
+* Copyright (c) 2016 ARM Limited. All rights reserved.
+* SPDX-License-Identifier: Apache-2.0
+* Licensed under the Apache License, Version 2.0 (the License); you may
+* not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an AS IS BASIS, WITHOUT
+* WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "pal_cfstore.h"
+
+
+// Erase any storage that is required to be erased when the device is factory reset.
+int pal_cfstore_factory_reset(struct pal_cstore_context_t *CStoreContext)
+{
+	// TBD - Not implemented!!!
+	return 0;
+}
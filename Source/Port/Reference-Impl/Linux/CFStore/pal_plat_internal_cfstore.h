@@ -0,0 +1,22 @@
+/*
+* Copyright (c) 2016 ARM Limited. All rights reserved.
+* SPDX-License-Identifier: Apache-2.0
+* Licensed under the Apache License, Version 2.0 (the License); you may
+* not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an AS IS BASIS, WITHOUT
+* WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef __PAL_PLAT_CFSTORE_INTERNAL_H
+#define __PAL_PLAT_CFSTORE_INTERNAL_H
+
+// There is no configuration store driver on Linux hosts, the PAL_CFSTORE_* driver
+// mapping of the mbedOS port is not available. Only pal_cfstore_factory_reset is provided.
+
+#endif //__PAL_PLAT_CFSTORE_INTERNAL_H
@@ -0,0 +1,1381 @@
+/*
+* Copyright (c) 2016 ARM Limited. All rights reserved.
+* SPDX-License-Identifier: Apache-2.0
+* Licensed under the Apache License, Version 2.0 (the License); you may
+* not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an AS IS BASIS, WITHOUT
+* WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "pal.h"
+#include "pal_plat_network.h"
+#include "pal_rtos.h"
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <poll.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+#include <stdlib.h>
+
+
+#define PAL_SOCKET_OPTION_ERROR (-1)
+#define PAL_INVALID_SOCKET_FD (-1)
+
+//! sockets are plain file descriptors, carried inside the PAL handle.
+#define PAL_SOCKET_TO_FD(socket) ((int)(intptr_t)(socket))
+#define PAL_FD_TO_SOCKET(fd) ((palSocket_t)(intptr_t)(fd))
+
+#define PAL_MAX_ASYNC_SOCKETS 256
+#define PAL_ASYNC_SOCKET_MAX_EVENTS 8
+#define PAL_ASYNC_SOCKET_RETRY_MS 10 // how often the events which found a deferral queue full are posted again
+#define PAL_SOCKET_POLLER_MAX_EVENTS 16
+#define PAL_DATAGRAM_BATCH 16 // datagrams passed to sendmmsg / recvmmsg at once
+
+//! On Linux a network interface is identified by its name (e.g. "eth0"), the registered context is that name.
+static char s_pal_networkInterfacesSupported[PAL_MAX_SUPORTED_NET_INTEFACES][IF_NAMESIZE] = { { 0 } };
+
+static  uint32_t s_pal_numberOFInterfaces = 0;
+
+static  uint32_t s_pal_network_initialized = 0;
+
+//! Asynchronous sockets are served by a single thread waiting on an epoll set.
+//! A socket has either a callback or a context callback, a slot with neither is free.
+typedef struct palAsyncSocket{
+    int                             fd;
+    palAsyncSocketCallback_t        callback;
+    palAsyncSocketContextCallback_t contextCallback;
+    void*                           context;
+    palMessageQID_t                 deferralQueue;
+    uint8_t                         lostEvents;     //! events which found the deferral queue full.
+} palAsyncSocket_t;
+
+#define PAL_ASYNC_SOCKET_IN_USE(asyncSocket) ((NULL != (asyncSocket).callback) || (NULL != (asyncSocket).contextCallback))
+
+static palAsyncSocket_t s_pal_asyncSockets[PAL_MAX_ASYNC_SOCKETS];
+static pthread_mutex_t s_pal_asyncSocketsLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t s_pal_asyncThreadOnce = PTHREAD_ONCE_INIT;
+static int s_pal_asyncEpollFd = PAL_INVALID_SOCKET_FD;
+
+static palStatus_t translateErrorToPALError(int errnoValue)
+{
+    palStatus_t status;
+    switch (errnoValue)
+    {
+    case ENOMEM:
+        status = PAL_ERR_NO_MEMORY;
+        break;
+    case ENOBUFS:
+        status = PAL_ERR_SOCKET_NO_BUFFERS;
+        break;
+    case EHOSTUNREACH:
+        status = PAL_ERR_SOCKET_HOST_UNREACHABLE;
+        break;
+    case EINPROGRESS:
+        status = PAL_ERR_SOCKET_IN_PROGRES;
+        break;
+    case EINVAL:
+        status = PAL_ERR_SOCKET_INVALID_VALUE;
+        break;
+#if EAGAIN != EWOULDBLOCK
+    case EAGAIN:
+#endif
+    case EWOULDBLOCK:
+        status = PAL_ERR_SOCKET_WOULD_BLOCK;
+        break;
+    case EADDRINUSE:
+        status = PAL_ERR_SOCKET_ADDRESS_IN_USE;
+        break;
+    case EALREADY:
+    case EISCONN:
+        status = PAL_ERR_SOCKET_ALREADY_CONNECTED;
+        break;
+    case ECONNABORTED:
+        status = PAL_ERR_SOCKET_CONNECTION_ABORTED;
+        break;
+    case ECONNRESET:
+    case EPIPE:
+        status = PAL_ERR_SOCKET_CONNECTION_RESET;
+        break;
+    case ENOTCONN:
+        status = PAL_ERR_SOCKET_NOT_CONNECTED;
+        break;
+    case EIO:
+        status = PAL_ERR_SOCKET_INPUT_OUTPUT_ERROR;
+        break;
+    case EAFNOSUPPORT:
+        status = PAL_ERR_SOCKET_INVALID_ADDRESS_FAMILY;
+        break;
+    case EADDRNOTAVAIL:
+    case EDESTADDRREQ:
+        status = PAL_ERR_SOCKET_INVALID_ADDRESS;
+        break;
+    case ENOPROTOOPT:
+        status = PAL_ERR_SOCKET_OPTION_NOT_SUPPORTED;
+        break;
+    case EOPNOTSUPP:
+        status = PAL_ERR_NOT_SUPPORTED;
+        break;
+
+    default:
+        status = PAL_ERR_SOCKET_GENERIC;
+        break;
+    }
+    return status;
+}
+
+palStatus_t pal_plat_socketsInit(void* context)
+{
+    (void)context; // replace with macro
+    int result = PAL_SUCCESS;
+    if (s_pal_network_initialized == 1)
+    {
+        return PAL_SUCCESS; // already initialized.
+    }
+
+    s_pal_network_initialized = 1;
+
+    return result;
+}
+
+palStatus_t pal_plat_RegisterNetworkInterface(void* context, uint32_t* interfaceIndex)
+{
+    palStatus_t result = PAL_SUCCESS;
+    uint32_t index = 0;
+    uint32_t found = 0;
+    const char* interfaceName = (const char*)context;
+
+    if ((NULL == context) || (strlen(interfaceName) >= IF_NAMESIZE))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    for (index = 0; index < s_pal_numberOFInterfaces; index++) // if specific context already registered return exisitng index instead of registering again.
+    {
+        if (0 == strcmp(s_pal_networkInterfacesSupported[index], interfaceName))
+        {
+            found = 1;
+            if (interfaceIndex != NULL)
+            {
+                *interfaceIndex = index;
+            }
+        }
+    }
+    if (0 == found)
+    {
+        if (s_pal_numberOFInterfaces >= PAL_MAX_SUPORTED_NET_INTEFACES)
+        {
+            return PAL_ERR_SOCKET_GENERIC;
+        }
+        strcpy(s_pal_networkInterfacesSupported[s_pal_numberOFInterfaces], interfaceName);
+        if (interfaceIndex != NULL)
+        {
+            *interfaceIndex = s_pal_numberOFInterfaces;
+        }
+        s_pal_numberOFInterfaces = s_pal_numberOFInterfaces + 1;
+    }
+    return result;
+}
+
+palStatus_t pal_plat_socketsTerminate(void* context)
+{
+    (void)context; // replace with macro
+    return PAL_SUCCESS;
+}
+
+static int translatePALtoPOSIXSocketOption(int option)
+{
+    int optionVal = PAL_SOCKET_OPTION_ERROR;
+    switch (option)
+    {
+    case PAL_SO_REUSEADDR:
+        optionVal = SO_REUSEADDR;
+        break;
+#if PAL_NET_TCP_AND_TLS_SUPPORT // socket options below supported only if TCP is supported.
+    case PAL_SO_KEEPALIVE:
+        optionVal = SO_KEEPALIVE;
+        break;
+#endif //PAL_NET_TCP_AND_TLS_SUPPORT
+    case PAL_SO_SNDTIMEO:
+        optionVal = SO_SNDTIMEO;
+        break;
+    case PAL_SO_RCVTIMEO:
+        optionVal = SO_RCVTIMEO;
+        break;
+    default:
+        optionVal = PAL_SOCKET_OPTION_ERROR;
+    }
+    return optionVal;
+}
+
+
+static palStatus_t palSockAddrToSocketAddress(const palSocketAddress_t* palAddr, struct sockaddr_storage* output, socklen_t* outputLength)
+{
+    palStatus_t result = PAL_SUCCESS;
+    uint16_t port = 0;
+
+    result = pal_getSockAddrPort(palAddr, &port);
+    if (result != PAL_SUCCESS)
+    {
+        return result;
+    }
+
+    memset(output, 0, sizeof(*output));
+    if (PAL_AF_INET == palAddr->addressType)
+    {
+        struct sockaddr_in* ipV4 = (struct sockaddr_in*)output;
+        palIpV4Addr_t ipV4Addr;
+        result = pal_getSockAddrIPV4Addr(palAddr, ipV4Addr);
+        if (result == PAL_SUCCESS)
+        {
+            ipV4->sin_family = AF_INET;
+            ipV4->sin_port = htons(port);
+            memcpy(&ipV4->sin_addr, ipV4Addr, PAL_IPV4_ADDRESS_SIZE);
+            *outputLength = sizeof(struct sockaddr_in);
+        }
+    }
+    else if (PAL_AF_INET6 == palAddr->addressType)
+    {
+        struct sockaddr_in6* ipV6 = (struct sockaddr_in6*)output;
+        palIpV6Addr_t ipV6Addr;
+        result = pal_getSockAddrIPV6Addr(palAddr, ipV6Addr);
+        if (result == PAL_SUCCESS)
+        {
+            ipV6->sin6_family = AF_INET6;
+            ipV6->sin6_port = htons(port);
+            memcpy(&ipV6->sin6_addr, ipV6Addr, PAL_IPV6_ADDRESS_SIZE);
+            *outputLength = sizeof(struct sockaddr_in6);
+        }
+    }
+    else
+    {
+        result = PAL_ERR_SOCKET_INVALID_ADDRESS_FAMILY;
+    }
+
+    return result;
+}
+
+static palStatus_t socketAddressToPalSockAddr(const struct sockaddr* input, palSocketAddress_t* out, palSocketLength_t* length)
+{
+    palStatus_t result = PAL_SUCCESS;
+
+    if (AF_INET == input->sa_family)
+    {
+        const struct sockaddr_in* ipV4 = (const struct sockaddr_in*)input;
+        palIpV4Addr_t ipV4Addr;
+        memcpy(ipV4Addr, &ipV4->sin_addr, PAL_IPV4_ADDRESS_SIZE);
+        result = pal_setSockAddrIPV4Addr(out, ipV4Addr);
+        if (PAL_SUCCESS == result)
+        {
+            result = pal_setSockAddrPort(out, ntohs(ipV4->sin_port));
+        }
+        if ((PAL_SUCCESS == result) && (NULL != length))
+        {
+            *length = sizeof(struct sockaddr_in);
+        }
+    }
+    else if (AF_INET6 == input->sa_family)
+    {
+        const struct sockaddr_in6* ipV6 = (const struct sockaddr_in6*)input;
+        palIpV6Addr_t ipV6Addr;
+        memcpy(ipV6Addr, &ipV6->sin6_addr, PAL_IPV6_ADDRESS_SIZE);
+        result = pal_setSockAddrIPV6Addr(out, ipV6Addr);
+        if (PAL_SUCCESS == result)
+        {
+            result = pal_setSockAddrPort(out, ntohs(ipV6->sin6_port));
+        }
+        if ((PAL_SUCCESS == result) && (NULL != length))
+        {
+            *length = sizeof(struct sockaddr_in6);
+        }
+    }
+    else
+    {
+        result = PAL_ERR_SOCKET_INVALID_ADDRESS_FAMILY;
+    }
+
+    return result;
+}
+
+palStatus_t pal_plat_socket(palSocketDomain_t domain, palSocketType_t type, bool nonBlockingSocket, uint32_t interfaceNum, palSocket_t* palSocket)
+{
+    int result = PAL_SUCCESS;
+    int fd = PAL_INVALID_SOCKET_FD;
+    int osDomain = AF_INET;
+    int osType = SOCK_DGRAM;
+
+    if (PAL_NET_DEFAULT_INTERFACE == interfaceNum)
+    {
+        interfaceNum = 0;
+    }
+
+    if ((s_pal_numberOFInterfaces <= interfaceNum) || ((PAL_AF_INET != domain) && (PAL_AF_INET6 != domain) && (PAL_AF_UNSPEC != domain)))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+    osDomain = (PAL_AF_INET6 == domain) ? AF_INET6 : AF_INET;
+
+    if (PAL_SOCK_DGRAM == type)
+    {
+        osType = SOCK_DGRAM;
+    }
+#if PAL_NET_TCP_AND_TLS_SUPPORT // functionality below supported only in case TCP is supported.
+    else if ((PAL_SOCK_STREAM == type) || (PAL_SOCK_STREAM_SERVER == type))
+    {
+        osType = SOCK_STREAM;
+    }
+#endif
+    else
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    if (true == nonBlockingSocket)
+    {
+        osType |= SOCK_NONBLOCK;
+    }
+
+    fd = socket(osDomain, osType | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        result = translateErrorToPALError(errno);
+    }
+    else
+    {
+        *palSocket = PAL_FD_TO_SOCKET(fd);
+    }
+    return result;
+}
+
+palStatus_t pal_plat_getSocketOptions(palSocket_t socket, palSocketOptionName_t optionName, void* optionValue, palSocketLength_t* optionLength)
+{
+    int result = PAL_SUCCESS;
+    int socketOption = translatePALtoPOSIXSocketOption(optionName);
+    socklen_t length = *optionLength;
+    struct timeval timeout;
+
+    if (PAL_SOCKET_OPTION_ERROR == socketOption)
+    {
+        return PAL_ERR_SOCKET_OPTION_NOT_SUPPORTED;
+    }
+
+    if ((SO_SNDTIMEO == socketOption) || (SO_RCVTIMEO == socketOption))
+    {
+        //! PAL socket timeouts are given as an int of milliseconds, like in the mbedOS port.
+        if (*optionLength < sizeof(int))
+        {
+            return PAL_ERR_SOCKET_INVALID_VALUE;
+        }
+        length = sizeof(timeout);
+        if (0 != getsockopt(PAL_SOCKET_TO_FD(socket), SOL_SOCKET, socketOption, &timeout, &length))
+        {
+            result = translateErrorToPALError(errno);
+        }
+        else
+        {
+            *((int*)optionValue) = (int)((timeout.tv_sec * 1000) + (timeout.tv_usec / 1000));
+            *optionLength = sizeof(int);
+        }
+    }
+    else
+    {
+        if (0 != getsockopt(PAL_SOCKET_TO_FD(socket), SOL_SOCKET, socketOption, optionValue, &length))
+        {
+            result = translateErrorToPALError(errno);
+        }
+        else
+        {
+            *optionLength = length;
+        }
+    }
+
+    return result;
+}
+
+palStatus_t pal_plat_setSocketOptions(palSocket_t socket, int optionName, const void* optionValue, palSocketLength_t optionLength)
+{
+    int result = PAL_SUCCESS;
+    int socketOption = translatePALtoPOSIXSocketOption(optionName);
+    struct timeval timeout;
+    int timeoutMilliSec = 0;
+
+    if (PAL_SOCKET_OPTION_ERROR == socketOption)
+    {
+        return PAL_ERR_SOCKET_OPTION_NOT_SUPPORTED;
+    }
+
+    if ((SO_SNDTIMEO == socketOption) || (SO_RCVTIMEO == socketOption))
+    {
+        timeoutMilliSec = *((const int*)optionValue);
+        timeout.tv_sec = timeoutMilliSec / 1000;
+        timeout.tv_usec = (timeoutMilliSec % 1000) * 1000;
+        optionValue = &timeout;
+        optionLength = sizeof(timeout);
+    }
+
+    if (0 != setsockopt(PAL_SOCKET_TO_FD(socket), SOL_SOCKET, socketOption, optionValue, optionLength))
+    {
+        result = translateErrorToPALError(errno);
+    }
+
+    return result;
+}
+
+palStatus_t pal_plat_bind(palSocket_t socket, palSocketAddress_t* myAddress, palSocketLength_t addressLength)
+{
+    int result = PAL_SUCCESS;
+    struct sockaddr_storage internalAddr;
+    socklen_t internalAddrLength = 0;
+
+    (void)addressLength;
+    result = palSockAddrToSocketAddress(myAddress, &internalAddr, &internalAddrLength);
+    if (result == PAL_SUCCESS)
+    {
+        if (0 != bind(PAL_SOCKET_TO_FD(socket), (struct sockaddr*)&internalAddr, internalAddrLength))
+        {
+            result = translateErrorToPALError(errno);
+        }
+    }
+
+    return result;
+}
+
+palStatus_t pal_plat_receiveFrom(palSocket_t socket, void* buffer, size_t length, palSocketAddress_t* from, palSocketLength_t* fromLength, size_t* bytesReceived)
+{
+    int result = PAL_SUCCESS;
+    ssize_t status = 0;
+    struct sockaddr_storage senderAddr;
+    socklen_t senderAddrLength = sizeof(senderAddr);
+
+    status = recvfrom(PAL_SOCKET_TO_FD(socket), buffer, length, 0, (struct sockaddr*)&senderAddr, &senderAddrLength);
+    if (status < 0)
+    {
+        result = translateErrorToPALError(errno);
+    }
+    else if (status == 0)
+    {
+        result = PAL_ERR_SOCKET_CONNECTION_CLOSED;
+    }
+    else // only return address / bytes received in case of success
+    {
+        if ((NULL != from) && (NULL != fromLength))
+        {
+            result = socketAddressToPalSockAddr((struct sockaddr*)&senderAddr, from, fromLength);
+        }
+        *bytesReceived = (size_t)status;
+    }
+
+    return result;
+}
+
+palStatus_t pal_plat_sendTo(palSocket_t socket, const void* buffer, size_t length, const palSocketAddress_t* to, palSocketLength_t toLength, size_t* bytesSent)
+{
+    int result = PAL_SUCCESS;
+    ssize_t status = 0;
+    struct sockaddr_storage internalAddr;
+    socklen_t internalAddrLength = 0;
+
+    (void)toLength;
+    result = palSockAddrToSocketAddress(to, &internalAddr, &internalAddrLength);
+    if (result == PAL_SUCCESS)
+    {
+        status = sendto(PAL_SOCKET_TO_FD(socket), buffer, length, MSG_NOSIGNAL, (struct sockaddr*)&internalAddr, internalAddrLength);
+        if (status < 0)
+        {
+            result = translateErrorToPALError(errno);
+        }
+        else
+        {
+            *bytesSent = (size_t)status;
+        }
+    }
+
+    return result;
+}
+
+palStatus_t pal_plat_sendToMulti(palSocket_t socket, palDatagram_t* datagrams, uint32_t count, uint32_t* datagramsSent)
+{
+    palStatus_t result = PAL_SUCCESS;
+    struct mmsghdr messages[PAL_DATAGRAM_BATCH];
+    struct iovec vectors[PAL_DATAGRAM_BATCH];
+    struct sockaddr_storage addresses[PAL_DATAGRAM_BATCH];
+    socklen_t addressLength = 0;
+    uint32_t sent = 0;
+    uint32_t batch = 0;
+    uint32_t index = 0;
+    int status = 0;
+
+    while ((PAL_SUCCESS == result) && (sent < count))
+    {
+        batch = ((count - sent) < PAL_DATAGRAM_BATCH) ? (count - sent) : PAL_DATAGRAM_BATCH;
+        memset(messages, 0, sizeof(messages));
+        for (index = 0; index < batch; ++index)
+        {
+            //! a datagram with a bad address ends the batch, the datagrams before it are still sent.
+            result = palSockAddrToSocketAddress(datagrams[sent + index].address, &addresses[index], &addressLength);
+            if (PAL_SUCCESS != result)
+            {
+                datagrams[sent + index].status = result;
+                break;
+            }
+            vectors[index].iov_base = datagrams[sent + index].buffer;
+            vectors[index].iov_len = datagrams[sent + index].length;
+            messages[index].msg_hdr.msg_name = &addresses[index];
+            messages[index].msg_hdr.msg_namelen = addressLength;
+            messages[index].msg_hdr.msg_iov = &vectors[index];
+            messages[index].msg_hdr.msg_iovlen = 1;
+        }
+        if (0 == index)
+        {
+            break;
+        }
+
+        status = sendmmsg(PAL_SOCKET_TO_FD(socket), messages, index, MSG_NOSIGNAL);
+        if (status < 0)
+        {
+            result = translateErrorToPALError(errno);
+            datagrams[sent].status = result;
+            break;
+        }
+        for (batch = 0; batch < (uint32_t)status; ++batch)
+        {
+            datagrams[sent + batch].bytes = messages[batch].msg_len;
+            datagrams[sent + batch].status = PAL_SUCCESS;
+        }
+        sent += (uint32_t)status;
+        if ((uint32_t)status < index)
+        {
+            //! the stack stopped before the end of the batch, the next call reports why.
+            result = PAL_SUCCESS;
+        }
+    }
+
+    *datagramsSent = sent;
+    return (0 < sent) ? PAL_SUCCESS : result;
+}
+
+palStatus_t pal_plat_receiveFromMulti(palSocket_t socket, palDatagram_t* datagrams, uint32_t count, uint32_t* datagramsReceived)
+{
+    palStatus_t result = PAL_SUCCESS;
+    struct mmsghdr messages[PAL_DATAGRAM_BATCH];
+    struct iovec vectors[PAL_DATAGRAM_BATCH];
+    struct sockaddr_storage addresses[PAL_DATAGRAM_BATCH];
+    uint32_t received = 0;
+    uint32_t batch = 0;
+    uint32_t index = 0;
+    int flags = MSG_WAITFORONE;
+    int status = 0;
+
+    while (received < count)
+    {
+        batch = ((count - received) < PAL_DATAGRAM_BATCH) ? (count - received) : PAL_DATAGRAM_BATCH;
+        memset(messages, 0, sizeof(messages));
+        for (index = 0; index < batch; ++index)
+        {
+            vectors[index].iov_base = datagrams[received + index].buffer;
+            vectors[index].iov_len = datagrams[received + index].length;
+            messages[index].msg_hdr.msg_name = &addresses[index];
+            messages[index].msg_hdr.msg_namelen = sizeof(addresses[index]);
+            messages[index].msg_hdr.msg_iov = &vectors[index];
+            messages[index].msg_hdr.msg_iovlen = 1;
+        }
+
+        status = recvmmsg(PAL_SOCKET_TO_FD(socket), messages, batch, flags, NULL);
+        if (status < 0)
+        {
+            //! only the first batch may wait, a later one which finds nothing ends the call.
+            if (0 == received)
+            {
+                result = translateErrorToPALError(errno);
+            }
+            break;
+        }
+        for (index = 0; index < (uint32_t)status; ++index)
+        {
+            datagrams[received + index].bytes = messages[index].msg_len;
+            datagrams[received + index].status = PAL_SUCCESS;
+            if (NULL != datagrams[received + index].address)
+            {
+                datagrams[received + index].status = socketAddressToPalSockAddr((struct sockaddr*)&addresses[index], datagrams[received + index].address, &datagrams[received + index].addressLength);
+            }
+        }
+        received += (uint32_t)status;
+        if ((uint32_t)status < batch)
+        {
+            break;
+        }
+        flags = MSG_DONTWAIT;
+    }
+
+    *datagramsReceived = received;
+    return result;
+}
+
+//! Points an iovec array at the bufferLength bytes of each send segment.
+static void palSendSegmentsToIovec(const palConstBuffer_t* segments, uint32_t segmentCount, struct iovec* vectors)
+{
+    uint32_t index = 0;
+
+    for (index = 0; index < segmentCount; ++index)
+    {
+        vectors[index].iov_base = (void*)segments[index].buffer;
+        vectors[index].iov_len = segments[index].bufferLength;
+    }
+}
+
+//! Points an iovec array at the maxBufferLength bytes of each receive segment.
+static void palReceiveSegmentsToIovec(palBuffer_t* segments, uint32_t segmentCount, struct iovec* vectors)
+{
+    uint32_t index = 0;
+
+    for (index = 0; index < segmentCount; ++index)
+    {
+        vectors[index].iov_base = segments[index].buffer;
+        vectors[index].iov_len = segments[index].maxBufferLength;
+    }
+}
+
+//! sendmsg / recvmsg shared by the datagram and the stream calls, the address is optional.
+static palStatus_t palSendSegments(palSocket_t socket, const palConstBuffer_t* segments, uint32_t segmentCount, const palSocketAddress_t* to, size_t* bytesSent)
+{
+    palStatus_t result = PAL_SUCCESS;
+    ssize_t status = 0;
+    struct iovec vectors[PAL_NET_MAX_SEGMENTS];
+    struct sockaddr_storage internalAddr;
+    socklen_t internalAddrLength = 0;
+    struct msghdr message;
+
+    memset(&message, 0, sizeof(message));
+    if (NULL != to)
+    {
+        result = palSockAddrToSocketAddress(to, &internalAddr, &internalAddrLength);
+        if (PAL_SUCCESS != result)
+        {
+            return result;
+        }
+        message.msg_name = &internalAddr;
+        message.msg_namelen = internalAddrLength;
+    }
+    palSendSegmentsToIovec(segments, segmentCount, vectors);
+    message.msg_iov = vectors;
+    message.msg_iovlen = segmentCount;
+
+    status = sendmsg(PAL_SOCKET_TO_FD(socket), &message, MSG_NOSIGNAL);
+    if (status < 0)
+    {
+        result = translateErrorToPALError(errno);
+    }
+    else
+    {
+        *bytesSent = (size_t)status;
+    }
+    return result;
+}
+
+static palStatus_t palReceiveSegments(palSocket_t socket, palBuffer_t* segments, uint32_t segmentCount, palSocketAddress_t* from, palSocketLength_t* fromLength, size_t* bytesReceived)
+{
+    palStatus_t result = PAL_SUCCESS;
+    ssize_t status = 0;
+    struct iovec vectors[PAL_NET_MAX_SEGMENTS];
+    struct sockaddr_storage senderAddr;
+    struct msghdr message;
+
+    memset(&message, 0, sizeof(message));
+    message.msg_name = &senderAddr;
+    message.msg_namelen = sizeof(senderAddr);
+    palReceiveSegmentsToIovec(segments, segmentCount, vectors);
+    message.msg_iov = vectors;
+    message.msg_iovlen = segmentCount;
+
+    status = recvmsg(PAL_SOCKET_TO_FD(socket), &message, 0);
+    if (status < 0)
+    {
+        result = translateErrorToPALError(errno);
+    }
+    else if (status == 0)
+    {
+        result = PAL_ERR_SOCKET_CONNECTION_CLOSED;
+    }
+    else // only return address / bytes received in case of success
+    {
+        if ((NULL != from) && (NULL != fromLength))
+        {
+            result = socketAddressToPalSockAddr((struct sockaddr*)&senderAddr, from, fromLength);
+        }
+        *bytesReceived = (size_t)status;
+    }
+    return result;
+}
+
+palStatus_t pal_plat_sendTov(palSocket_t socket, const palConstBuffer_t* segments, uint32_t segmentCount, const palSocketAddress_t* to, palSocketLength_t toLength, size_t* bytesSent)
+{
+    (void)toLength;
+    return palSendSegments(socket, segments, segmentCount, to, bytesSent);
+}
+
+palStatus_t pal_plat_receiveFromv(palSocket_t socket, palBuffer_t* segments, uint32_t segmentCount, palSocketAddress_t* from, palSocketLength_t* fromLength, size_t* bytesReceived)
+{
+    return palReceiveSegments(socket, segments, segmentCount, from, fromLength, bytesReceived);
+}
+
+/*! Stop reporting events of an asynchronous socket, a no-op for sockets which are not asynchronous.
+*
+* @param[in] fd: the socket file descriptor.
+*/
+static void asyncSocketRemove(int fd)
+{
+    uint32_t index;
+
+    pthread_mutex_lock(&s_pal_asyncSocketsLock);
+    for (index = 0; index < PAL_MAX_ASYNC_SOCKETS; index++)
+    {
+        if (PAL_ASYNC_SOCKET_IN_USE(s_pal_asyncSockets[index]) && (fd == s_pal_asyncSockets[index].fd))
+        {
+            epoll_ctl(s_pal_asyncEpollFd, EPOLL_CTL_DEL, fd, NULL);
+            memset(&s_pal_asyncSockets[index], 0, sizeof(s_pal_asyncSockets[index]));
+            s_pal_asyncSockets[index].fd = PAL_INVALID_SOCKET_FD;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&s_pal_asyncSocketsLock);
+}
+
+palStatus_t pal_plat_close(palSocket_t* socket)
+{
+    int result = PAL_SUCCESS;
+    int fd = PAL_SOCKET_TO_FD(*socket);
+
+    asyncSocketRemove(fd);
+    if (0 != close(fd))
+    {
+        result = translateErrorToPALError(errno);
+    }
+    *socket = NULL;
+    return result;
+}
+
+palStatus_t pal_plat_getNumberOfNetInterfaces( uint32_t* numInterfaces)
+{
+    *numInterfaces = s_pal_numberOFInterfaces;
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_plat_getNetInterfaceInfo(uint32_t interfaceNum, palNetInterfaceInfo_t * interfaceInfo)
+{
+    palStatus_t result = PAL_ERR_SOCKET_INVALID_ADDRESS;
+    struct ifaddrs* interfaces = NULL;
+    struct ifaddrs* current = NULL;
+
+    if ((interfaceNum >= s_pal_numberOFInterfaces) || (NULL == interfaceInfo))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    if (0 != getifaddrs(&interfaces))
+    {
+        return translateErrorToPALError(errno);
+    }
+
+    for (current = interfaces; NULL != current; current = current->ifa_next)
+    {
+        if ((NULL != current->ifa_addr) &&
+            ((AF_INET == current->ifa_addr->sa_family) || (AF_INET6 == current->ifa_addr->sa_family)) &&
+            (0 == strcmp(current->ifa_name, s_pal_networkInterfacesSupported[interfaceNum])))
+        {
+            strncpy(interfaceInfo->interfaceName, current->ifa_name, sizeof(interfaceInfo->interfaceName) - 1);
+            interfaceInfo->interfaceName[sizeof(interfaceInfo->interfaceName) - 1] = '\0';
+            result = socketAddressToPalSockAddr(current->ifa_addr, &interfaceInfo->address, &interfaceInfo->addressSize);
+            if (AF_INET == current->ifa_addr->sa_family)
+            {
+                break; // prefer the IPv4 address, like the mbedOS port which reports the interface IP address.
+            }
+        }
+    }
+    freeifaddrs(interfaces);
+
+    return result;
+}
+
+
+//! The sockets are checked with a single poll call, no state is kept between calls.
+palStatus_t pal_plat_socketMiniSelect(const palSocket_t socketsToCheck[PAL_NET_SOCKET_SELECT_MAX_SOCKETS], uint32_t numberOfSockets, uint32_t timeout, uint8_t interestMask,
+    uint8_t palSocketStatus[PAL_NET_SOCKET_SELECT_MAX_SOCKETS], uint32_t * numberOfSocketsSet)
+{
+    struct pollfd pollFds[PAL_NET_SOCKET_SELECT_MAX_SOCKETS];
+    short pollEvents = 0;
+    int timeoutMilliSec = (PAL_RTOS_WAIT_FOREVER == timeout) ? -1 : (int)timeout;
+    int status = 0;
+    uint32_t index = 0;
+
+    if ((NULL == socketsToCheck) || (NULL == palSocketStatus) || (NULL == numberOfSocketsSet) || (PAL_NET_SOCKET_SELECT_MAX_SOCKETS < numberOfSockets))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    if (interestMask & PAL_NET_SOCKET_SELECT_RX_BIT)
+    {
+        pollEvents |= POLLIN;
+    }
+    if (interestMask & PAL_NET_SOCKET_SELECT_TX_BIT)
+    {
+        pollEvents |= POLLOUT;
+    }
+    for (index = 0; index < numberOfSockets; index++)
+    {
+        pollFds[index].fd = PAL_SOCKET_TO_FD(socketsToCheck[index]);
+        pollFds[index].events = pollEvents; // errors are always reported by the kernel.
+        pollFds[index].revents = 0;
+        palSocketStatus[index] = 0;
+    }
+
+    *numberOfSocketsSet = 0;
+    do
+    {
+        status = poll(pollFds, (nfds_t)numberOfSockets, timeoutMilliSec);
+    } while ((status < 0) && (EINTR == errno));
+
+    if (status < 0)
+    {
+        return translateErrorToPALError(errno);
+    }
+
+    for (index = 0; index < numberOfSockets; index++) // a timeout (no events) is not an error
+    {
+        if (pollFds[index].revents & POLLIN)
+        {
+            palSocketStatus[index] |= PAL_NET_SOCKET_SELECT_RX_BIT;
+        }
+        if (pollFds[index].revents & POLLOUT)
+        {
+            palSocketStatus[index] |= PAL_NET_SOCKET_SELECT_TX_BIT;
+        }
+        if (pollFds[index].revents & (POLLERR | POLLHUP | POLLNVAL))
+        {
+            palSocketStatus[index] |= PAL_NET_SOCKET_SELECT_ERR_BIT;
+        }
+        if (0 != palSocketStatus[index])
+        {
+            ++(*numberOfSocketsSet);
+        }
+    }
+
+    return PAL_SUCCESS;
+}
+
+
+//! A socket poller is a level triggered epoll set, the kernel keeps the registered sockets between waits.
+typedef struct palSocketPoller{
+    int epollFd;
+} palSocketPoller_t;
+
+static uint32_t palPollerInterestToEpollEvents(uint8_t interestMask)
+{
+    uint32_t epollEvents = EPOLLERR | EPOLLHUP; // errors are always reported (and always set by the kernel anyway).
+
+    if (interestMask & PAL_NET_SOCKET_SELECT_RX_BIT)
+    {
+        epollEvents |= EPOLLIN;
+    }
+    if (interestMask & PAL_NET_SOCKET_SELECT_TX_BIT)
+    {
+        epollEvents |= EPOLLOUT;
+    }
+    return epollEvents;
+}
+
+static uint8_t palEpollEventsToPollerEvents(uint32_t epollEvents)
+{
+    uint8_t events = 0;
+
+    if (epollEvents & (EPOLLIN | EPOLLRDHUP)) // a closed peer (asynchronous sockets only) is read as end of data.
+    {
+        events |= PAL_NET_SOCKET_SELECT_RX_BIT;
+    }
+    if (epollEvents & EPOLLOUT)
+    {
+        events |= PAL_NET_SOCKET_SELECT_TX_BIT;
+    }
+    if (epollEvents & (EPOLLERR | EPOLLHUP))
+    {
+        events |= PAL_NET_SOCKET_SELECT_ERR_BIT;
+    }
+    return events;
+}
+
+static palStatus_t palSocketPollerControl(palSocketPollerID_t poller, int operation, palSocket_t socket, uint8_t interestMask)
+{
+    palSocketPoller_t* socketPoller = (palSocketPoller_t*)poller;
+    struct epoll_event event;
+
+    if (NULLPTR == poller)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    memset(&event, 0, sizeof(event));
+    event.events = palPollerInterestToEpollEvents(interestMask);
+    event.data.fd = PAL_SOCKET_TO_FD(socket);
+    if (0 != epoll_ctl(socketPoller->epollFd, operation, PAL_SOCKET_TO_FD(socket), &event))
+    {
+        return translateErrorToPALError(errno);
+    }
+    return PAL_SUCCESS;
+}
+
+
+palStatus_t pal_plat_socketPollerCreate(palSocketPollerID_t* poller)
+{
+    palSocketPoller_t* socketPoller = NULL;
+
+    if (NULL == poller)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    socketPoller = (palSocketPoller_t*)pal_osMalloc(sizeof(palSocketPoller_t));
+    if (NULL == socketPoller)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+
+    socketPoller->epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (socketPoller->epollFd < 0)
+    {
+        palStatus_t result = translateErrorToPALError(errno);
+        pal_osFree(socketPoller);
+        return result;
+    }
+
+    *poller = (palSocketPollerID_t)socketPoller;
+    return PAL_SUCCESS;
+}
+
+
+palStatus_t pal_plat_socketPollerDestroy(palSocketPollerID_t* poller)
+{
+    palSocketPoller_t* socketPoller = NULL;
+
+    if ((NULL == poller) || (NULLPTR == *poller))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    socketPoller = (palSocketPoller_t*)*poller;
+    close(socketPoller->epollFd); // closing the epoll set drops its registrations, the sockets stay open.
+    pal_osFree(socketPoller);
+    *poller = NULLPTR;
+    return PAL_SUCCESS;
+}
+
+
+palStatus_t pal_plat_socketPollerAdd(palSocketPollerID_t poller, palSocket_t socket, uint8_t interestMask)
+{
+    return palSocketPollerControl(poller, EPOLL_CTL_ADD, socket, interestMask);
+}
+
+
+palStatus_t pal_plat_socketPollerModify(palSocketPollerID_t poller, palSocket_t socket, uint8_t interestMask)
+{
+    return palSocketPollerControl(poller, EPOLL_CTL_MOD, socket, interestMask);
+}
+
+
+palStatus_t pal_plat_socketPollerRemove(palSocketPollerID_t poller, palSocket_t socket)
+{
+    return palSocketPollerControl(poller, EPOLL_CTL_DEL, socket, 0);
+}
+
+
+palStatus_t pal_plat_socketPollerWait(palSocketPollerID_t poller, palSocketPollEvent_t* events, uint32_t maxEvents, uint32_t timeout, uint32_t* numberOfEvents)
+{
+    palSocketPoller_t* socketPoller = (palSocketPoller_t*)poller;
+    struct epoll_event epollEvents[PAL_SOCKET_POLLER_MAX_EVENTS];
+    int timeoutMilliSec = (PAL_RTOS_WAIT_FOREVER == timeout) ? -1 : (int)timeout;
+    int status = 0;
+    int index = 0;
+
+    if ((NULLPTR == poller) || (NULL == events) || (0 == maxEvents) || (NULL == numberOfEvents))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    if (maxEvents > PAL_SOCKET_POLLER_MAX_EVENTS)
+    {
+        maxEvents = PAL_SOCKET_POLLER_MAX_EVENTS; // the rest are level triggered and will be returned by the next wait.
+    }
+
+    *numberOfEvents = 0;
+    do
+    {
+        status = epoll_wait(socketPoller->epollFd, epollEvents, (int)maxEvents, timeoutMilliSec);
+    } while ((status < 0) && (EINTR == errno));
+
+    if (status < 0)
+    {
+        return translateErrorToPALError(errno);
+    }
+
+    for (index = 0; index < status; index++) // a timeout (0 events) is not an error
+    {
+        events[index].socket = PAL_FD_TO_SOCKET(epollEvents[index].data.fd);
+        events[index].events = palEpollEventsToPollerEvents(epollEvents[index].events);
+    }
+    *numberOfEvents = (uint32_t)status;
+
+    return PAL_SUCCESS;
+}
+
+#if PAL_NET_TCP_AND_TLS_SUPPORT // functionality below supported only in case TCP is supported.
+
+palStatus_t pal_plat_listen(palSocket_t socket, int backlog)
+{
+    int result = PAL_SUCCESS;
+
+    if (0 != listen(PAL_SOCKET_TO_FD(socket), backlog))
+    {
+        result = translateErrorToPALError(errno);
+    }
+    return result;
+}
+
+
+palStatus_t pal_plat_accept(palSocket_t socket, palSocketAddress_t * address, palSocketLength_t* addressLen, palSocket_t* acceptedSocket)
+{
+    int result = PAL_SUCCESS;
+    int fd = PAL_INVALID_SOCKET_FD;
+    struct sockaddr_storage incomingAddr;
+    socklen_t incomingAddrLength = sizeof(incomingAddr);
+
+    fd = accept4(PAL_SOCKET_TO_FD(socket), (struct sockaddr*)&incomingAddr, &incomingAddrLength, SOCK_CLOEXEC);
+    if (fd < 0)
+    {
+        return translateErrorToPALError(errno);
+    }
+
+    //! PAL callers create the socket to accept into up front (see pal_accept), reuse its handle for the new connection.
+    if (NULL != *acceptedSocket)
+    {
+        if (dup2(fd, PAL_SOCKET_TO_FD(*acceptedSocket)) < 0)
+        {
+            result = translateErrorToPALError(errno);
+        }
+        close(fd);
+    }
+    else
+    {
+        *acceptedSocket = PAL_FD_TO_SOCKET(fd);
+    }
+
+    if (PAL_SUCCESS == result)
+    {
+        result = socketAddressToPalSockAddr((struct sockaddr*)&incomingAddr, address, addressLen);
+    }
+    return result;
+}
+
+
+palStatus_t pal_plat_connect(palSocket_t socket, const palSocketAddress_t* address, palSocketLength_t addressLen)
+{
+    int result = PAL_SUCCESS;
+    struct sockaddr_storage internalAddr;
+    socklen_t internalAddrLength = 0;
+
+    (void)addressLen;
+    result = palSockAddrToSocketAddress(address, &internalAddr, &internalAddrLength);
+    if (result == PAL_SUCCESS)
+    {
+        if (0 != connect(PAL_SOCKET_TO_FD(socket), (struct sockaddr*)&internalAddr, internalAddrLength))
+        {
+            result = translateErrorToPALError(errno);
+        }
+    }
+
+    return result;
+}
+
+palStatus_t pal_plat_recv(palSocket_t socket, void *buf, size_t len, size_t* recievedDataSize)
+{
+    int result = PAL_SUCCESS;
+    ssize_t status = 0;
+
+    status = recv(PAL_SOCKET_TO_FD(socket), buf, len, 0);
+    if (status < 0)
+    {
+        result = translateErrorToPALError(errno);
+    }
+    else if (status == 0)
+    {
+        return PAL_ERR_SOCKET_CONNECTION_CLOSED;
+    }
+    else
+    {
+        *recievedDataSize = (size_t)status;
+    }
+    return result;
+}
+
+palStatus_t pal_plat_send(palSocket_t socket, const void *buf, size_t len, size_t* sentDataSize)
+{
+    palStatus_t result = PAL_SUCCESS;
+    ssize_t status = 0;
+
+    status = send(PAL_SOCKET_TO_FD(socket), buf, len, MSG_NOSIGNAL);
+    if (status < 0)
+    {
+        result = translateErrorToPALError(errno);
+    }
+    else
+    {
+        *sentDataSize = (size_t)status;
+    }
+
+    return result;
+}
+
+palStatus_t pal_plat_sendv(palSocket_t socket, const palConstBuffer_t* segments, uint32_t segmentCount, size_t* sentDataSize)
+{
+    return palSendSegments(socket, segments, segmentCount, NULL, sentDataSize);
+}
+
+palStatus_t pal_plat_recvv(palSocket_t socket, palBuffer_t* segments, uint32_t segmentCount, size_t* recievedDataSize)
+{
+    return palReceiveSegments(socket, segments, segmentCount, NULL, NULL, recievedDataSize);
+}
+
+#endif //PAL_NET_TCP_AND_TLS_SUPPORT
+
+
+//! post the events which found a deferral queue full again, called with the lock held. Returns whether some still do not fit.
+static bool asyncSocketPostLost(void)
+{
+    palAsyncSocketEvent_t socketEvent;
+    bool lost = false;
+    uint32_t index = 0;
+
+    for (index = 0; index < PAL_MAX_ASYNC_SOCKETS; index++)
+    {
+        if (0 == s_pal_asyncSockets[index].lostEvents)
+        {
+            continue;
+        }
+        memset(&socketEvent, 0, sizeof(socketEvent));
+        socketEvent.socket = PAL_FD_TO_SOCKET(s_pal_asyncSockets[index].fd);
+        socketEvent.callback = s_pal_asyncSockets[index].contextCallback;
+        socketEvent.context = s_pal_asyncSockets[index].context;
+        socketEvent.events = s_pal_asyncSockets[index].lostEvents;
+        if (PAL_SUCCESS == pal_osMessagePutTyped(s_pal_asyncSockets[index].deferralQueue, &socketEvent, 0))
+        {
+            s_pal_asyncSockets[index].lostEvents = 0;
+        }
+        else
+        {
+            lost = true;
+        }
+    }
+    return lost;
+}
+
+static void* asyncSocketThread(void* arg)
+{
+    struct epoll_event events[PAL_ASYNC_SOCKET_MAX_EVENTS];
+    palAsyncSocket_t asyncSocket;
+    palAsyncSocketEvent_t socketEvent;
+    bool lost = false;
+    int count = 0;
+    int i = 0;
+    uint32_t index = 0;
+
+    (void)arg;
+    while (true)
+    {
+        //! the events are edge triggered, so the events which found a deferral queue full are posted again until the queue has room.
+        count = epoll_wait(s_pal_asyncEpollFd, events, PAL_ASYNC_SOCKET_MAX_EVENTS, lost ? PAL_ASYNC_SOCKET_RETRY_MS : -1);
+        if (lost)
+        {
+            pthread_mutex_lock(&s_pal_asyncSocketsLock);
+            lost = asyncSocketPostLost();
+            pthread_mutex_unlock(&s_pal_asyncSocketsLock);
+        }
+        for (i = 0; i < count; i++)
+        {
+            //! the socket may have been closed since the event was queued, look it up again under the lock.
+            memset(&asyncSocket, 0, sizeof(asyncSocket));
+            memset(&socketEvent, 0, sizeof(socketEvent));
+            pthread_mutex_lock(&s_pal_asyncSocketsLock);
+            index = events[i].data.u32;
+            if (index < PAL_MAX_ASYNC_SOCKETS)
+            {
+                asyncSocket = s_pal_asyncSockets[index];
+                socketEvent.socket = PAL_FD_TO_SOCKET(asyncSocket.fd);
+                socketEvent.callback = asyncSocket.contextCallback;
+                socketEvent.context = asyncSocket.context;
+                socketEvent.events = palEpollEventsToPollerEvents(events[i].events) | asyncSocket.lostEvents;
+                if ((NULL != asyncSocket.contextCallback) && (NULLPTR != asyncSocket.deferralQueue))
+                {
+                    //! posted under the lock, so a closed socket gets no more events and the lost events stay consistent.
+                    s_pal_asyncSockets[index].lostEvents = 0;
+                    if (PAL_SUCCESS != pal_osMessagePutTyped(asyncSocket.deferralQueue, &socketEvent, 0))
+                    {
+                        s_pal_asyncSockets[index].lostEvents = socketEvent.events;
+                        lost = true;
+                    }
+                }
+            }
+            pthread_mutex_unlock(&s_pal_asyncSocketsLock);
+            if (NULL != asyncSocket.callback)
+            {
+                asyncSocket.callback();
+            }
+            else if ((NULL != asyncSocket.contextCallback) && (NULLPTR == asyncSocket.deferralQueue))
+            {
+                asyncSocket.contextCallback(socketEvent.socket, socketEvent.events, socketEvent.context);
+            }
+        }
+    }
+    return NULL;
+}
+
+static void asyncSocketThreadStart(void)
+{
+    pthread_t thread;
+
+    s_pal_asyncEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (s_pal_asyncEpollFd >= 0)
+    {
+        if (0 == pthread_create(&thread, NULL, asyncSocketThread, NULL))
+        {
+            pthread_detach(thread);
+        }
+        else
+        {
+            close(s_pal_asyncEpollFd);
+            s_pal_asyncEpollFd = PAL_INVALID_SOCKET_FD;
+        }
+    }
+}
+
+//! Creates a socket and registers it with the asynchronous socket thread, the settings are copied to a free slot.
+static palStatus_t asyncSocketCreate(palSocketDomain_t domain, palSocketType_t type, bool nonBlockingSocket, uint32_t interfaceNum, const palAsyncSocket_t* settings, palSocket_t* socket)
+{
+    int result = PAL_SUCCESS;
+    uint32_t index = 0;
+    int fd = PAL_INVALID_SOCKET_FD;
+    struct epoll_event event;
+
+    pthread_once(&s_pal_asyncThreadOnce, asyncSocketThreadStart);
+    if (s_pal_asyncEpollFd < 0)
+    {
+        return PAL_ERR_SOCKET_GENERIC;
+    }
+
+    result = pal_plat_socket(domain, type, nonBlockingSocket, interfaceNum, socket);
+    if (result == PAL_SUCCESS)
+    {
+        fd = PAL_SOCKET_TO_FD(*socket);
+        pthread_mutex_lock(&s_pal_asyncSocketsLock);
+        for (index = 0; index < PAL_MAX_ASYNC_SOCKETS; index++)
+        {
+            if (!PAL_ASYNC_SOCKET_IN_USE(s_pal_asyncSockets[index]))
+            {
+                break;
+            }
+        }
+
+        if (index < PAL_MAX_ASYNC_SOCKETS)
+        {
+            //! edge triggered to behave like the mbedOS sigio callback - called once per state change.
+            memset(&event, 0, sizeof(event));
+            event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+            event.data.u32 = index;
+            s_pal_asyncSockets[index] = *settings;
+            s_pal_asyncSockets[index].fd = fd;
+            s_pal_asyncSockets[index].lostEvents = 0;
+            if (0 != epoll_ctl(s_pal_asyncEpollFd, EPOLL_CTL_ADD, fd, &event))
+            {
+                memset(&s_pal_asyncSockets[index], 0, sizeof(s_pal_asyncSockets[index]));
+                s_pal_asyncSockets[index].fd = PAL_INVALID_SOCKET_FD;
+                result = translateErrorToPALError(errno);
+            }
+        }
+        else
+        {
+            result = PAL_ERR_NO_MEMORY;
+        }
+        pthread_mutex_unlock(&s_pal_asyncSocketsLock);
+
+        if (PAL_SUCCESS != result)
+        {
+            close(fd);
+            *socket = NULL;
+        }
+    }
+
+    return result;
+}
+
+palStatus_t pal_plat_asynchronousSocket(palSocketDomain_t domain, palSocketType_t type, bool nonBlockingSocket, uint32_t interfaceNum, palAsyncSocketCallback_t callback, palSocket_t* socket)
+{
+    palAsyncSocket_t settings;
+
+    memset(&settings, 0, sizeof(settings));
+    settings.callback = callback;
+    return asyncSocketCreate(domain, type, nonBlockingSocket, interfaceNum, &settings, socket);
+}
+
+palStatus_t pal_plat_asynchronousSocketWithContext(palSocketDomain_t domain, palSocketType_t type, bool nonBlockingSocket, uint32_t interfaceNum, palAsyncSocketContextCallback_t callback, void* context,
+                                                   palMessageQID_t deferralQueue, palSocket_t* socket)
+{
+    palAsyncSocket_t settings;
+
+    memset(&settings, 0, sizeof(settings));
+    settings.contextCallback = callback;
+    settings.context = context;
+    settings.deferralQueue = deferralQueue;
+    return asyncSocketCreate(domain, type, nonBlockingSocket, interfaceNum, &settings, socket);
+}
+
+#if PAL_NET_DNS_SUPPORT
+
+palStatus_t pal_plat_getAddressInfo(const char *url, palSocketAddress_t *address, palSocketLength_t* length)
+{
+    palStatus_t result = PAL_SUCCESS;
+    struct addrinfo hints;
+    struct addrinfo* info = NULL;
+    int status = 0;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM; // one entry per address is enough
+
+    status = getaddrinfo(url, NULL, &hints, &info);
+    if ((0 == status) && (NULL != info))
+    {
+        result = socketAddressToPalSockAddr(info->ai_addr, address, length);
+        freeaddrinfo(info);
+    }
+    else // error happened
+    {
+        result = (EAI_SYSTEM == status) ? translateErrorToPALError(errno) : PAL_ERR_SOCKET_DNS_ERROR;
+    }
+    return result;
+}
+
+#endif
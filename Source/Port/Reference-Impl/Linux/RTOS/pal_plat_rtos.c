@@ -0,0 +1,1416 @@
+/*
+* Copyright (c) 2016 ARM Limited. All rights reserved.
+* SPDX-License-Identifier: Apache-2.0
+* Licensed under the Apache License, Version 2.0 (the License); you may
+* not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an AS IS BASIS, WITHOUT
+* WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "pal_types.h"
+#include "pal_rtos.h"
+#include "pal_plat_rtos.h"
+#include "pal_errors.h"
+#include "stdlib.h"
+#include "string.h"
+#include "stdio.h"
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <time.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/asan_interface.h>
+#endif
+
+
+#define PAL_TICK_TO_MILLI_FACTOR 1000
+#define PAL_NANO_PER_MILLI 1000000ULL
+#define PAL_NANO_PER_MICRO 1000ULL
+#define PAL_NANO_PER_SECOND 1000000000ULL
+#define PAL_MICRO_PER_SECOND 1000000ULL
+
+//! Ticks are nanoseconds since the process started, to behave like the kernel tick of an RTOS
+//! which starts counting at boot.
+static uint64_t s_palTickEpoch = 0;
+
+//! Protects the thread registry against concurrent creation, termination and self clean up of threads.
+static pthread_mutex_t s_palThreadsLock = PTHREAD_MUTEX_INITIALIZER;
+
+typedef struct palThreadFuncWrapper{
+    palTimerFuncPtr         realThreadFunc;
+    void*                   realThreadArgs;
+    uint32_t                threadIndex;
+}palThreadFuncWrapper_t;
+
+//! Thread structure
+typedef struct palThread{
+    palThreadID_t              threadID;
+    bool                       initialized;
+    palThreadLocalStore_t*     threadStore; //! please see pal_rtos.h for documentation
+    palThreadFuncWrapper_t     threadFuncWrapper;
+    palThreadPriority_t        priority;
+    bool                       joinable;
+    uint32_t                   nextFree;    //! the next free slot while the slot is in the free list.
+    uint32_t*                  stackPtr;    //! the stack the thread runs on, NULL if pthreads provided it.
+    uint32_t                   stackSize;
+    pid_t                      tid;         //! the kernel ID of the thread, which names its /proc entry.
+    uint32_t                   mutexWaits;  //! the waits for a PAL mutex which blocked, only the thread itself adds to them.
+    uint64_t                   mutexWaitNanoSec;
+} palThread_t;
+
+#define PAL_THREADS_REGISTRY_CHUNKS ((PAL_MAX_NUMBER_OF_THREADS + PAL_THREADS_REGISTRY_GROWTH - 1) / PAL_THREADS_REGISTRY_GROWTH)
+#define PAL_THREADS_NO_FREE_SLOT PAL_MAX_NUMBER_OF_THREADS
+
+//! The thread registry grows by chunks of PAL_THREADS_REGISTRY_GROWTH slots up to PAL_MAX_NUMBER_OF_THREADS.
+//! A chunk never moves once allocated, so a slot can be read by its thread index without taking the lock.
+static palThread_t* s_palThreadChunks[PAL_THREADS_REGISTRY_CHUNKS] = {NULL};
+static uint32_t s_palThreadsCapacity = 0;
+//! The free slots are a stack linked through nextFree, so a slot is found without searching the registry.
+static uint32_t s_palThreadsFree = PAL_THREADS_NO_FREE_SLOT;
+
+#define PAL_THREAD_SLOT(index) (&s_palThreadChunks[(index) / PAL_THREADS_REGISTRY_GROWTH][(index) % PAL_THREADS_REGISTRY_GROWTH])
+
+//! The registry index of the calling thread, so pal_plat_osThreadGetId does not have to search the registry.
+static __thread palThreadID_t s_palThreadIndex = PAL_INVALID_THREAD;
+
+//! Timer structure
+typedef struct palTimer{
+    timer_t                   osTimer;
+    palTimerFuncPtr           function;
+    void*                     funcArgument;
+    palTimerType_t            timerType;
+} palTimer_t;
+
+//! Mutex structure
+typedef struct palMutex{
+    pthread_mutex_t           osMutex;
+    uintptr_t                 owner;      //! pal_plat_osThreadSelf of the holder, 0 if none, for pal_plat_osMutexDepth.
+    uint32_t                  depth;      //! the times the holder took the mutex, only the holder changes it.
+}palMutex_t;
+
+//! Semaphore structure
+typedef struct palSemaphore{
+    sem_t                     osSemaphore;
+}palSemaphore_t;
+
+//! Message Queue structure
+typedef struct palMessageQ{
+    pthread_mutex_t           lock;
+    pthread_cond_t            notEmpty;
+    pthread_cond_t            notFull;
+    uint8_t*                  messages;
+    uint32_t                  messageSize;
+    uint32_t                  messageQCount;
+    uint32_t                  head;
+    uint32_t                  count;
+}palMessageQ_t;
+
+
+PAL_PRIVATE palStatus_t translateErrnoToPALError(int errnoValue)
+{
+    palStatus_t status;
+    switch (errnoValue)
+    {
+    case 0:
+        status = PAL_SUCCESS;
+        break;
+    case ETIMEDOUT:
+        status = PAL_ERR_RTOS_TIMEOUT;
+        break;
+    case EAGAIN:
+    case EBUSY:
+    case EPERM:
+        status = PAL_ERR_RTOS_RESOURCE;
+        break;
+    case EINVAL:
+        status = PAL_ERR_RTOS_PARAMETER;
+        break;
+    case ENOMEM:
+        status = PAL_ERR_RTOS_NO_MEMORY;
+        break;
+    case EOVERFLOW:
+        status = PAL_ERR_RTOS_VALUE;
+        break;
+    default:
+        status = PAL_ERR_RTOS_OS;
+        break;
+    }
+    return status;
+}
+
+//! Convert a relative timeout in milliseconds into an absolute deadline on the given clock.
+PAL_PRIVATE void palMilliSecToDeadline(clockid_t clock, uint32_t millisec, struct timespec* deadline)
+{
+    clock_gettime(clock, deadline);
+    deadline->tv_sec += millisec / PAL_TICK_TO_MILLI_FACTOR;
+    deadline->tv_nsec += (long)((millisec % PAL_TICK_TO_MILLI_FACTOR) * PAL_NANO_PER_MILLI);
+    if (deadline->tv_nsec >= (long)PAL_NANO_PER_SECOND)
+    {
+        deadline->tv_sec += 1;
+        deadline->tv_nsec -= (long)PAL_NANO_PER_SECOND;
+    }
+}
+
+PAL_PRIVATE uint64_t palMonotonicNanoSec(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * PAL_NANO_PER_SECOND) + (uint64_t)now.tv_nsec;
+}
+
+__attribute__((constructor)) PAL_PRIVATE void palTickEpochInit(void)
+{
+    s_palTickEpoch = palMonotonicNanoSec();
+}
+
+
+inline PAL_PRIVATE void setDefaultThreadValues(palThread_t* thread)
+{
+    thread->threadStore = NULL;
+    thread->threadFuncWrapper.realThreadArgs = NULL;
+    thread->threadFuncWrapper.realThreadFunc = NULL;
+    thread->threadFuncWrapper.threadIndex = 0;
+    thread->priority = PAL_osPriorityError;
+    thread->joinable = false;
+    thread->stackPtr = NULL;
+    thread->stackSize = 0;
+    thread->tid = 0;
+    thread->mutexWaits = 0;
+    thread->mutexWaitNanoSec = 0;
+
+    thread->threadID = NULLPTR;
+    //! This line should be last thing to be done in this function.
+    //! in order to prevent double accessing the same index between
+    //! this function and the threadCreate function.
+    thread->initialized = false;
+}
+
+/*! Clean thread data from the thread registry and return its slot to the free slots. Called with s_palThreadsLock taken.
+*
+* @param[in] index: the index in the registry to be cleaned.
+*/
+static void threadCleanUp(uint32_t index)
+{
+    palThread_t* thread = NULL;
+
+    if (index >= s_palThreadsCapacity)
+    {
+        return;
+    }
+    thread = PAL_THREAD_SLOT(index);
+    setDefaultThreadValues(thread);
+    thread->nextFree = s_palThreadsFree;
+    s_palThreadsFree = index;
+}
+
+/*! Take a free slot of the thread registry, the registry grows by a chunk when no slot is free. Called with s_palThreadsLock taken.
+*
+* \return the index of the slot, PAL_THREADS_NO_FREE_SLOT when the registry is full or out of memory.
+*/
+static uint32_t threadSlotAlloc(void)
+{
+    palThread_t* chunk = NULL;
+    uint32_t index = PAL_THREADS_NO_FREE_SLOT;
+    uint32_t i = 0;
+
+    if ((PAL_THREADS_NO_FREE_SLOT == s_palThreadsFree) && (s_palThreadsCapacity < PAL_MAX_NUMBER_OF_THREADS))
+    {
+        chunk = (palThread_t*)calloc(PAL_THREADS_REGISTRY_GROWTH, sizeof(palThread_t));
+        if (NULL != chunk)
+        {
+            s_palThreadChunks[s_palThreadsCapacity / PAL_THREADS_REGISTRY_GROWTH] = chunk;
+            //! pushed from the last slot so the lowest indices are taken first.
+            for (i = PAL_THREADS_REGISTRY_GROWTH; i > 0; --i)
+            {
+                if ((s_palThreadsCapacity + i - 1) < PAL_MAX_NUMBER_OF_THREADS)
+                {
+                    chunk[i - 1].priority = PAL_osPriorityError;
+                    chunk[i - 1].nextFree = s_palThreadsFree;
+                    s_palThreadsFree = s_palThreadsCapacity + i - 1;
+                }
+            }
+            s_palThreadsCapacity += PAL_THREADS_REGISTRY_GROWTH;
+            if (s_palThreadsCapacity > PAL_MAX_NUMBER_OF_THREADS)
+            {
+                s_palThreadsCapacity = PAL_MAX_NUMBER_OF_THREADS;
+            }
+        }
+    }
+
+    if (PAL_THREADS_NO_FREE_SLOT != s_palThreadsFree)
+    {
+        index = s_palThreadsFree;
+        s_palThreadsFree = PAL_THREAD_SLOT(index)->nextFree;
+        PAL_THREAD_SLOT(index)->initialized = true;
+    }
+    return index;
+}
+
+#if defined(__SANITIZE_ADDRESS__)
+//! A cancelled thread is unwound without AddressSanitizer knowing, so the frames below the one running this clean up
+//! would stay poisoned for the code which runs on the stack at thread exit.
+static void threadCancelCleanUp(void* arg)
+{
+    pthread_attr_t attr;
+    void* stackAddress = NULL;
+    size_t stackSize = 0;
+
+    (void)arg;
+    if (0 == pthread_getattr_np(pthread_self(), &attr))
+    {
+        pthread_attr_getstack(&attr, &stackAddress, &stackSize);
+        ASAN_UNPOISON_MEMORY_REGION(stackAddress, (size_t)((uint8_t*)&attr - (uint8_t*)stackAddress));
+        pthread_attr_destroy(&attr);
+    }
+}
+#endif
+
+/*! Entry point of every PAL thread. pthreads expects a different signature than PAL thread functions,
+*   and a thread that returns from its function releases its slot so the index and priority can be reused.
+*/
+static void* threadFunctionWrapper(void* arg)
+{
+    palThreadFuncWrapper_t* wrapper = (palThreadFuncWrapper_t*)arg;
+    uint32_t index = wrapper->threadIndex;
+    palThread_t* thread = PAL_THREAD_SLOT(index);
+    pthread_t self = pthread_self();
+
+    thread->threadID = (palThreadID_t)self;
+    thread->tid = (pid_t)syscall(SYS_gettid);
+    s_palThreadIndex = index;
+#if defined(__SANITIZE_ADDRESS__)
+    pthread_cleanup_push(threadCancelCleanUp, NULL);
+    wrapper->realThreadFunc(wrapper->realThreadArgs);
+    pthread_cleanup_pop(0);
+#else
+    wrapper->realThreadFunc(wrapper->realThreadArgs);
+#endif
+
+    pthread_mutex_lock(&s_palThreadsLock);
+    if (thread->initialized && ((palThreadID_t)self == thread->threadID))
+    {
+        //! nobody is going to join this thread any more.
+        pthread_detach(self);
+        threadCleanUp(index);
+    }
+    pthread_mutex_unlock(&s_palThreadsLock);
+    return NULL;
+}
+
+
+void pal_plat_osReboot()
+{
+    //! A host process has no device to reset, end the process and let whoever started it (test runner, init system) restart it.
+    exit(EXIT_SUCCESS);
+}
+
+
+palStatus_t pal_plat_RTOSInitialize(void* opaqueContext)
+{
+    //Clean thread tables
+    palStatus_t status = PAL_SUCCESS;
+    uint32_t i;
+
+    pthread_mutex_lock(&s_palThreadsLock);
+    //! the registry keeps the chunks it grew, all their slots become free.
+    s_palThreadsFree = PAL_THREADS_NO_FREE_SLOT;
+    for (i = s_palThreadsCapacity; i > 0; --i)
+    {
+        memset(PAL_THREAD_SLOT(i - 1), 0, sizeof(palThread_t));
+        PAL_THREAD_SLOT(i - 1)->priority = PAL_osPriorityError;
+        PAL_THREAD_SLOT(i - 1)->nextFree = s_palThreadsFree;
+        s_palThreadsFree = i - 1;
+    }
+
+    //Add implicit the running task as PAL main
+    i = threadSlotAlloc();
+    if (0 != i)
+    {
+        status = PAL_ERR_CREATION_FAILED;
+    }
+    else
+    {
+        PAL_THREAD_SLOT(0)->threadID = (palThreadID_t)pthread_self();
+        PAL_THREAD_SLOT(0)->tid = (pid_t)syscall(SYS_gettid);
+        s_palThreadIndex = 0;
+    }
+    pthread_mutex_unlock(&s_palThreadsLock);
+
+    return status;
+}
+
+
+palStatus_t pal_plat_RTOSDestroy(void)
+{
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_plat_osDelay(uint32_t milliseconds)
+{
+    palStatus_t status = PAL_SUCCESS;
+    struct timespec remaining;
+    int platStatus;
+
+    remaining.tv_sec = milliseconds / PAL_TICK_TO_MILLI_FACTOR;
+    remaining.tv_nsec = (long)((milliseconds % PAL_TICK_TO_MILLI_FACTOR) * PAL_NANO_PER_MILLI);
+    do
+    {
+        platStatus = clock_nanosleep(CLOCK_MONOTONIC, 0, &remaining, &remaining);
+    } while (EINTR == platStatus);
+
+    if (0 != platStatus)
+    {
+        status = translateErrnoToPALError(platStatus);
+    }
+    return status;
+}
+
+uint64_t pal_plat_osKernelSysTick(void)
+{
+    uint64_t result;
+    result = palMonotonicNanoSec() - s_palTickEpoch;
+    return result;
+}
+
+uint64_t pal_plat_osKernelSysTick64(void)
+{
+    uint64_t result;
+    result = palMonotonicNanoSec() - s_palTickEpoch;
+    return result;
+}
+
+uint64_t pal_plat_osKernelSysTickMicroSec(uint64_t microseconds)
+{
+    uint64_t result;
+    result = microseconds * PAL_NANO_PER_MICRO;
+    return result;
+}
+
+uint64_t pal_plat_osKernelSysTickFrequency()
+{
+    return PAL_NANO_PER_SECOND;
+}
+
+uint64_t pal_plat_osKernelSysMilliSecTick(uint64_t sysTicks)
+{
+    uint64_t millisec = sysTicks / PAL_NANO_PER_MILLI;
+    return millisec;
+}
+
+palStatus_t pal_plat_osThreadCreate(palThreadFuncPtr function, void* funcArgument, palThreadPriority_t priority, uint32_t stackSize, uint32_t* stackPtr, palThreadLocalStore_t* store, palThreadID_t* threadID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    uint32_t firstAvailableThreadIndex = PAL_THREADS_NO_FREE_SLOT;
+    palThread_t* thread = NULL;
+    pthread_t osThread;
+    pthread_attr_t attr;
+    int platStatus = 0;
+
+    if (NULL == threadID || NULL == function || 0 == stackSize || NULL == stackPtr || priority < PAL_osPriorityIdle || priority > PAL_osPriorityRealtime)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    pthread_mutex_lock(&s_palThreadsLock);
+    firstAvailableThreadIndex = threadSlotAlloc();
+    if (PAL_THREADS_NO_FREE_SLOT == firstAvailableThreadIndex)
+    {
+        status = PAL_ERR_RTOS_RESOURCE;
+    }
+
+    if (PAL_SUCCESS == status)
+    {
+        thread = PAL_THREAD_SLOT(firstAvailableThreadIndex);
+        thread->threadStore = store;
+        thread->threadFuncWrapper.realThreadArgs = funcArgument;
+        thread->threadFuncWrapper.realThreadFunc = function;
+        thread->threadFuncWrapper.threadIndex = firstAvailableThreadIndex;
+        thread->priority = priority;
+        thread->joinable = true;
+
+        //! The default Linux scheduler (SCHED_OTHER) has no static priorities, so the PAL priority is only
+        //! book kept. A thread can not run on a stack smaller than PTHREAD_STACK_MIN, pthreads provides one instead.
+        pthread_attr_init(&attr);
+        if (stackSize >= PTHREAD_STACK_MIN)
+        {
+            pthread_attr_setstack(&attr, stackPtr, stackSize);
+            thread->stackPtr = stackPtr;
+            thread->stackSize = stackSize;
+        }
+        else
+        {
+            pthread_attr_setstacksize(&attr, PTHREAD_STACK_MIN);
+        }
+        platStatus = pthread_create(&osThread, &attr, threadFunctionWrapper, &thread->threadFuncWrapper);
+        pthread_attr_destroy(&attr);
+        if (0 != platStatus)
+        {
+            //! in case of error in the thread creation, reset the data of the given index in the registry.
+            threadCleanUp(firstAvailableThreadIndex);
+            status = PAL_ERR_GENERIC_FAILURE;
+            *threadID = PAL_INVALID_THREAD;
+        }
+        else
+        {
+            thread->threadID = (palThreadID_t)osThread;
+            *threadID = firstAvailableThreadIndex;
+        }
+    }
+    pthread_mutex_unlock(&s_palThreadsLock);
+    return status;
+}
+
+palThreadID_t pal_plat_osThreadGetId(void)
+{
+    palThreadID_t ret = s_palThreadIndex;
+
+    //! the slot is checked to still belong to this thread, the index of a thread not created by PAL (or of a slot
+    //! which was re-initialized) is not valid.
+    if ((ret >= s_palThreadsCapacity) || !PAL_THREAD_SLOT(ret)->initialized || ((palThreadID_t)pthread_self() != PAL_THREAD_SLOT(ret)->threadID))
+    {
+        ret = PAL_INVALID_THREAD;
+    }
+    return ret;
+}
+
+uintptr_t pal_plat_osThreadSelf(void)
+{
+    return (uintptr_t)pthread_self();
+}
+
+palStatus_t pal_plat_osThreadTerminate(palThreadID_t* threadID)
+{
+    palStatus_t status = PAL_ERR_INVALID_ARGUMENT;
+    palThread_t* thread = NULL;
+    pthread_t osThread;
+    bool joinable = false;
+
+    if (NULL == threadID || *threadID >= PAL_MAX_NUMBER_OF_THREADS)
+    {
+        return status;
+    }
+
+    pthread_mutex_lock(&s_palThreadsLock);
+    if (*threadID >= s_palThreadsCapacity)
+    {
+        pthread_mutex_unlock(&s_palThreadsLock);
+        return status;
+    }
+    thread = PAL_THREAD_SLOT(*threadID);
+    if ((palThreadID_t)pthread_self() != thread->threadID)
+    {//Kill only if not trying to kill from running task
+        if (thread->initialized)
+        {
+            osThread = (pthread_t)thread->threadID;
+            joinable = thread->joinable;
+            threadCleanUp(*threadID);
+        }
+        *threadID = PAL_INVALID_THREAD;
+        status = PAL_SUCCESS;
+    }
+    else
+    {
+        status = PAL_ERR_RTOS_TASK;
+    }
+    pthread_mutex_unlock(&s_palThreadsLock);
+
+    //! cancel outside the lock: the thread may be on its way out and need the lock to check its slot.
+    if (joinable)
+    {
+        pthread_cancel(osThread);
+        pthread_join(osThread, NULL);
+    }
+
+    return status;
+}
+
+palThreadLocalStore_t* pal_plat_osThreadGetLocalStore(void)
+{
+    palThreadLocalStore_t* localStore = NULL;
+    palThreadID_t id = pal_plat_osThreadGetId();
+
+    if (PAL_INVALID_THREAD != id)
+    {
+        localStore = PAL_THREAD_SLOT(id)->threadStore;
+    }
+    return localStore;
+}
+
+#if PAL_THREAD_STACK_PAINT
+//! The stacks grow down, the paint left at the bottom of the stack was never reached.
+PAL_PRIVATE uint32_t threadStackUsed(const uint32_t* stackPtr, uint32_t stackSize)
+{
+    const uint32_t* word = stackPtr;
+    const uint32_t* end = stackPtr + (stackSize / sizeof(uint32_t));
+
+    if (NULL == stackPtr)
+    {
+        return 0;
+    }
+    while ((word < end) && (PAL_THREAD_STACK_PAINT_PATTERN == *word))
+    {
+        ++word;
+    }
+    return (uint32_t)((end - word) * sizeof(uint32_t));
+}
+#endif //PAL_THREAD_STACK_PAINT
+
+//! The kernel counts the times a thread gave up the CPU (voluntary) and was preempted (nonvoluntary) in its /proc status.
+PAL_PRIVATE uint32_t threadContextSwitches(pid_t tid)
+{
+    char line[128];
+    unsigned long count = 0;
+    uint32_t switches = 0;
+    FILE* status = NULL;
+
+    if (0 == tid)
+    {
+        return 0; //! the thread did not start yet.
+    }
+    snprintf(line, sizeof(line), "/proc/self/task/%d/status", (int)tid);
+    status = fopen(line, "r");
+    if (NULL != status)
+    {
+        while (NULL != fgets(line, sizeof(line), status))
+        {
+            if ((1 == sscanf(line, "voluntary_ctxt_switches: %lu", &count)) || (1 == sscanf(line, "nonvoluntary_ctxt_switches: %lu", &count)))
+            {
+                switches += (uint32_t)count;
+            }
+        }
+        fclose(status);
+    }
+    return switches;
+}
+
+palStatus_t pal_plat_osThreadGetStats(palThreadID_t threadID, palThreadStats_t* stats)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palThread_t* thread = NULL;
+    clockid_t clock;
+    struct timespec runTime;
+    pid_t tid = 0;
+
+    if ((NULL == stats) || (threadID >= PAL_MAX_NUMBER_OF_THREADS))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    memset(stats, 0, sizeof(palThreadStats_t));
+    //! under the lock the thread can neither end nor be terminated, so its pthread and its stack stay valid.
+    pthread_mutex_lock(&s_palThreadsLock);
+    if ((threadID >= s_palThreadsCapacity) || !PAL_THREAD_SLOT(threadID)->initialized)
+    {
+        status = PAL_ERR_INVALID_ARGUMENT;
+    }
+    else
+    {
+        thread = PAL_THREAD_SLOT(threadID);
+        stats->stackSize = thread->stackSize;
+#if PAL_THREAD_STACK_PAINT
+        stats->stackHighWaterMark = threadStackUsed(thread->stackPtr, thread->stackSize);
+#endif //PAL_THREAD_STACK_PAINT
+        if ((0 == pthread_getcpuclockid((pthread_t)thread->threadID, &clock)) && (0 == clock_gettime(clock, &runTime)))
+        {
+            stats->runTimeMicroSec = ((uint64_t)runTime.tv_sec * PAL_MICRO_PER_SECOND) + ((uint64_t)runTime.tv_nsec / PAL_NANO_PER_MICRO);
+        }
+        tid = thread->tid;
+        stats->mutexWaits = __atomic_load_n(&thread->mutexWaits, __ATOMIC_RELAXED);
+        stats->mutexWaitMicroSec = __atomic_load_n(&thread->mutexWaitNanoSec, __ATOMIC_RELAXED) / PAL_NANO_PER_MICRO;
+    }
+    pthread_mutex_unlock(&s_palThreadsLock);
+
+    //! /proc is read after the lock is released, a thread which ended meanwhile no longer has its entry and counts no switches.
+    if (PAL_SUCCESS == status)
+    {
+        stats->contextSwitches = threadContextSwitches(tid);
+    }
+    return status;
+}
+
+//! Add a blocking mutex wait to the statistics of the calling thread.
+PAL_PRIVATE void threadMutexWaited(uint64_t nanoSec)
+{
+    palThreadID_t id = pal_plat_osThreadGetId();
+
+    if (PAL_INVALID_THREAD != id)
+    {
+        __atomic_fetch_add(&PAL_THREAD_SLOT(id)->mutexWaits, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&PAL_THREAD_SLOT(id)->mutexWaitNanoSec, nanoSec, __ATOMIC_RELAXED);
+    }
+}
+
+
+static void timerFunctionWrapper(union sigval arg)
+{
+    palTimer_t* timer = (palTimer_t*)arg.sival_ptr;
+    timer->function(timer->funcArgument);
+}
+
+palStatus_t pal_plat_osTimerCreate(palTimerFuncPtr function, void* funcArgument, palTimerType_t timerType, palTimerID_t* timerID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palTimer_t* timer = NULL;
+    struct sigevent event;
+
+    if(NULL == timerID || NULL == function)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    timer = (palTimer_t*)pal_osMalloc(sizeof(palTimer_t));
+    if (NULL == timer)
+    {
+        status = PAL_ERR_NO_MEMORY;
+    }
+
+    if (PAL_SUCCESS == status)
+    {
+        timer->function = function;
+        timer->funcArgument = funcArgument;
+        timer->timerType = timerType;
+
+        memset(&event, 0, sizeof(event));
+        event.sigev_notify = SIGEV_THREAD;
+        event.sigev_value.sival_ptr = timer;
+        event.sigev_notify_function = timerFunctionWrapper;
+        if (0 != timer_create(CLOCK_MONOTONIC, &event, &timer->osTimer))
+        {
+            pal_osFree(timer);
+            timer = NULL;
+            status = PAL_ERR_GENERIC_FAILURE;
+        }
+        else
+        {
+            *timerID = (palTimerID_t)timer;
+        }
+    }
+    return status;
+}
+
+palStatus_t pal_plat_osTimerStart(palTimerID_t timerID, uint32_t millisec)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palTimer_t* timer = NULL;
+    struct itimerspec period;
+
+    if (NULLPTR == timerID || 0 == millisec)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    timer = (palTimer_t*)timerID;
+    memset(&period, 0, sizeof(period));
+    period.it_value.tv_sec = millisec / PAL_TICK_TO_MILLI_FACTOR;
+    period.it_value.tv_nsec = (long)((millisec % PAL_TICK_TO_MILLI_FACTOR) * PAL_NANO_PER_MILLI);
+    if (palOsTimerPeriodic == timer->timerType)
+    {
+        period.it_interval = period.it_value;
+    }
+
+    if (0 != timer_settime(timer->osTimer, 0, &period, NULL))
+    {
+        status = translateErrnoToPALError(errno);
+    }
+
+    return status;
+}
+
+palStatus_t pal_plat_osTimerStop(palTimerID_t timerID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palTimer_t* timer = NULL;
+    struct itimerspec disarm;
+
+    if(NULLPTR == timerID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    timer = (palTimer_t*)timerID;
+    memset(&disarm, 0, sizeof(disarm));
+    if (0 != timer_settime(timer->osTimer, 0, &disarm, NULL))
+    {
+        status = translateErrnoToPALError(errno);
+    }
+
+    return status;
+}
+
+palStatus_t pal_plat_osTimerDelete(palTimerID_t* timerID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palTimer_t* timer = NULL;
+
+    if(NULL == timerID || NULLPTR == *timerID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    timer = (palTimer_t*)*timerID;
+    if (0 == timer_delete(timer->osTimer))
+    {
+        pal_osFree(timer);
+        *timerID = NULLPTR;
+        status = PAL_SUCCESS;
+    }
+    else
+    {
+        status = translateErrnoToPALError(errno);
+    }
+
+    return status;
+}
+
+
+palStatus_t pal_plat_osMutexCreate(palMutexID_t* mutexID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palMutex_t* mutex = NULL;
+    pthread_mutexattr_t attr;
+
+    if(NULL == mutexID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    mutex = (palMutex_t*)pal_osMalloc(sizeof(palMutex_t));
+    if (NULL == mutex)
+    {
+        status = PAL_ERR_NO_MEMORY;
+    }
+
+    if (PAL_SUCCESS == status)
+    {
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+        mutex->owner = 0;
+        mutex->depth = 0;
+        if (0 != pthread_mutex_init(&mutex->osMutex, &attr))
+        {
+            pal_osFree(mutex);
+            mutex = NULL;
+            status = PAL_ERR_GENERIC_FAILURE;
+        }
+        else
+        {
+            *mutexID = (palMutexID_t)mutex;
+        }
+        pthread_mutexattr_destroy(&attr);
+    }
+    return status;
+}
+
+
+palStatus_t pal_plat_osMutexWait(palMutexID_t mutexID, uint32_t millisec)
+{
+    palStatus_t status = PAL_SUCCESS;
+    int platStatus = 0;
+    palMutex_t* mutex = NULL;
+    struct timespec deadline;
+    uint64_t waitStart = 0;
+
+    if(NULLPTR == mutexID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    mutex = (palMutex_t*)mutexID;
+    //! only a wait which blocks is timed for the statistics of the thread, a free mutex costs the try alone.
+    platStatus = pthread_mutex_trylock(&mutex->osMutex);
+    if ((EBUSY == platStatus) && (0 != millisec))
+    {
+        waitStart = palMonotonicNanoSec();
+        if (PAL_RTOS_WAIT_FOREVER == millisec)
+        {
+            platStatus = pthread_mutex_lock(&mutex->osMutex);
+        }
+        else
+        {
+            palMilliSecToDeadline(CLOCK_REALTIME, millisec, &deadline);
+            platStatus = pthread_mutex_timedlock(&mutex->osMutex, &deadline);
+        }
+        threadMutexWaited(palMonotonicNanoSec() - waitStart);
+    }
+
+    if (0 != platStatus)
+    {
+        status = translateErrnoToPALError(platStatus);
+    }
+    else
+    {
+        mutex->depth++;
+        __atomic_store_n(&mutex->owner, pal_plat_osThreadSelf(), __ATOMIC_RELAXED);
+    }
+
+    return status;
+}
+
+
+palStatus_t pal_plat_osMutexRelease(palMutexID_t mutexID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    int platStatus = 0;
+    palMutex_t* mutex = NULL;
+
+    if(NULLPTR == mutexID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    mutex = (palMutex_t*)mutexID;
+    //! a thread which does not hold the mutex leaves the depth alone, the unlock fails for it.
+    if (pal_plat_osThreadSelf() == __atomic_load_n(&mutex->owner, __ATOMIC_RELAXED))
+    {
+        mutex->depth--;
+        if (0 == mutex->depth)
+        {
+            __atomic_store_n(&mutex->owner, 0, __ATOMIC_RELAXED);
+        }
+    }
+    platStatus = pthread_mutex_unlock(&mutex->osMutex);
+    if (0 != platStatus)
+    {
+        status = translateErrnoToPALError(platStatus);
+    }
+
+    return status;
+}
+
+uint32_t pal_plat_osMutexDepth(palMutexID_t mutexID)
+{
+    palMutex_t* mutex = (palMutex_t*)mutexID;
+
+    if ((NULLPTR == mutexID) || (pal_plat_osThreadSelf() != __atomic_load_n(&mutex->owner, __ATOMIC_RELAXED)))
+    {
+        return 0;
+    }
+    return mutex->depth;
+}
+
+palStatus_t pal_plat_osMutexDelete(palMutexID_t* mutexID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    int platStatus = 0;
+    palMutex_t* mutex = NULL;
+
+    if(NULL == mutexID || NULLPTR == *mutexID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    mutex = (palMutex_t*)*mutexID;
+    platStatus = pthread_mutex_destroy(&mutex->osMutex);
+    if (0 == platStatus)
+    {
+        pal_osFree(mutex);
+        *mutexID = NULLPTR;
+        status = PAL_SUCCESS;
+    }
+    else
+    {
+        status = translateErrnoToPALError(platStatus);
+    }
+
+    return status;
+}
+
+palStatus_t pal_plat_osSemaphoreCreate(uint32_t count, palSemaphoreID_t* semaphoreID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palSemaphore_t* semaphore = NULL;
+    if(NULL == semaphoreID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    semaphore = (palSemaphore_t*)pal_osMalloc(sizeof(palSemaphore_t));
+    if (NULL == semaphore)
+    {
+        status = PAL_ERR_NO_MEMORY;
+    }
+
+    if(PAL_SUCCESS == status)
+    {
+        if (0 != sem_init(&semaphore->osSemaphore, 0, count))
+        {
+            pal_osFree(semaphore);
+            semaphore = NULL;
+            status = PAL_ERR_GENERIC_FAILURE;
+        }
+        else
+        {
+            *semaphoreID = (palSemaphoreID_t)semaphore;
+        }
+    }
+    return status;
+}
+
+palStatus_t pal_plat_osSemaphoreWait(palSemaphoreID_t semaphoreID, uint32_t millisec, int32_t* countersAvailable)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palSemaphore_t* semaphore = NULL;
+    struct timespec deadline;
+    int platStatus = 0;
+    int count = 0;
+
+    if(NULLPTR == semaphoreID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    semaphore = (palSemaphore_t*)semaphoreID;
+    if (PAL_RTOS_WAIT_FOREVER == millisec)
+    {
+        do
+        {
+            platStatus = sem_wait(&semaphore->osSemaphore);
+        } while ((0 != platStatus) && (EINTR == errno));
+    }
+    else if (0 == millisec)
+    {
+        platStatus = sem_trywait(&semaphore->osSemaphore);
+    }
+    else
+    {
+        palMilliSecToDeadline(CLOCK_REALTIME, millisec, &deadline);
+        do
+        {
+            platStatus = sem_timedwait(&semaphore->osSemaphore, &deadline);
+        } while ((0 != platStatus) && (EINTR == errno));
+    }
+
+    if (0 != platStatus)
+    {
+        //! an empty semaphore polled with a zero timeout is a timeout as well.
+        status = ((ETIMEDOUT == errno) || (EAGAIN == errno)) ? PAL_ERR_RTOS_TIMEOUT : PAL_ERR_RTOS_PARAMETER;
+    }
+
+    if (NULL != countersAvailable)
+    {
+        sem_getvalue(&semaphore->osSemaphore, &count);
+        *countersAvailable = count;
+    }
+    return status;
+}
+
+palStatus_t pal_plat_osSemaphoreRelease(palSemaphoreID_t semaphoreID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palSemaphore_t* semaphore = NULL;
+
+    if(NULLPTR == semaphoreID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    semaphore = (palSemaphore_t*)semaphoreID;
+    if (0 != sem_post(&semaphore->osSemaphore))
+    {
+        status = translateErrnoToPALError(errno);
+    }
+
+    return status;
+}
+
+palStatus_t pal_plat_osSemaphoreDelete(palSemaphoreID_t* semaphoreID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palSemaphore_t* semaphore = NULL;
+
+    if(NULL == semaphoreID || NULLPTR == *semaphoreID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    semaphore = (palSemaphore_t*)*semaphoreID;
+    if (0 == sem_destroy(&semaphore->osSemaphore))
+    {
+        pal_osFree(semaphore);
+        *semaphoreID = NULLPTR;
+        status = PAL_SUCCESS;
+    }
+    else
+    {
+        status = translateErrnoToPALError(errno);
+    }
+
+    return status;
+}
+
+palStatus_t pal_plat_osMessageQueueCreate(uint32_t messageQCount, uint32_t messageSize, palMessageQID_t* messageQID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palMessageQ_t* messageQ = NULL;
+    pthread_condattr_t condAttr;
+
+    if(NULL == messageQID || 0 == messageQCount || 0 == messageSize)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    //! allocate the message queue structure
+    messageQ = (palMessageQ_t*)pal_osMalloc(sizeof(palMessageQ_t));
+    if (NULL == messageQ)
+    {
+        status = PAL_ERR_NO_MEMORY;
+    }
+
+    if (PAL_SUCCESS == status)
+    {
+        messageQ->messages = (uint8_t*)pal_osMalloc((size_t)messageSize * messageQCount);
+        if (NULL == messageQ->messages)
+        {
+            pal_osFree(messageQ);
+            messageQ = NULL;
+            status = PAL_ERR_NO_MEMORY;
+        }
+        else
+        {
+            messageQ->messageSize = messageSize;
+            messageQ->messageQCount = messageQCount;
+            messageQ->head = 0;
+            messageQ->count = 0;
+            pthread_mutex_init(&messageQ->lock, NULL);
+            pthread_condattr_init(&condAttr);
+            pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+            pthread_cond_init(&messageQ->notEmpty, &condAttr);
+            pthread_cond_init(&messageQ->notFull, &condAttr);
+            pthread_condattr_destroy(&condAttr);
+            *messageQID = (palMessageQID_t)messageQ;
+        }
+    }
+    return status;
+}
+
+/*! Wait on a message queue condition until it holds or the timeout expires. Must be called with the queue lock held.
+*
+* @param[in] messageQ: the queue.
+* @param[in] condition: the condition variable to wait on.
+* @param[in] waitForSpace: true to wait for a free slot, false to wait for a message.
+* @param[in] timeout: timeout in milliseconds, PAL_RTOS_WAIT_FOREVER to block.
+*/
+PAL_PRIVATE palStatus_t messageQueueWait(palMessageQ_t* messageQ, pthread_cond_t* condition, bool waitForSpace, uint32_t timeout)
+{
+    struct timespec deadline;
+    int platStatus = 0;
+
+    if (PAL_RTOS_WAIT_FOREVER != timeout)
+    {
+        palMilliSecToDeadline(CLOCK_MONOTONIC, timeout, &deadline);
+    }
+
+    while (waitForSpace ? (messageQ->count == messageQ->messageQCount) : (0 == messageQ->count))
+    {
+        if (0 == timeout)
+        {
+            return PAL_ERR_RTOS_RESOURCE;
+        }
+        if (ETIMEDOUT == platStatus)
+        {
+            return PAL_ERR_RTOS_TIMEOUT;
+        }
+        if (PAL_RTOS_WAIT_FOREVER == timeout)
+        {
+            platStatus = pthread_cond_wait(condition, &messageQ->lock);
+        }
+        else
+        {
+            platStatus = pthread_cond_timedwait(condition, &messageQ->lock, &deadline);
+        }
+    }
+    return PAL_SUCCESS;
+}
+
+/*! Copy messages into the tail of a message queue, as many as fit. Must be called with the queue lock held.
+*
+* @param[in] messageQ: the queue.
+* @param[in] messages: the messages to copy, messageQ->messageSize bytes each.
+* @param[in] count: the number of messages to copy.
+*
+* \return the number of messages copied.
+*/
+PAL_PRIVATE uint32_t messageQueueCopyIn(palMessageQ_t* messageQ, const uint8_t* messages, uint32_t count)
+{
+    uint32_t copied = 0;
+    uint32_t slot;
+
+    while ((copied < count) && (messageQ->count < messageQ->messageQCount))
+    {
+        slot = (messageQ->head + messageQ->count) % messageQ->messageQCount;
+        memcpy(messageQ->messages + ((size_t)slot * messageQ->messageSize), messages + ((size_t)copied * messageQ->messageSize), messageQ->messageSize);
+        messageQ->count++;
+        copied++;
+    }
+    return copied;
+}
+
+/*! Copy messages out of the head of a message queue, as many as are available. Must be called with the queue lock held.
+*
+* @param[in] messageQ: the queue.
+* @param[out] messages: the buffer for the messages, messageQ->messageSize bytes each.
+* @param[in] count: the maximal number of messages to copy.
+*
+* \return the number of messages copied.
+*/
+PAL_PRIVATE uint32_t messageQueueCopyOut(palMessageQ_t* messageQ, uint8_t* messages, uint32_t count)
+{
+    uint32_t copied = 0;
+
+    while ((copied < count) && (messageQ->count > 0))
+    {
+        memcpy(messages + ((size_t)copied * messageQ->messageSize), messageQ->messages + ((size_t)messageQ->head * messageQ->messageSize), messageQ->messageSize);
+        messageQ->head = (messageQ->head + 1) % messageQ->messageQCount;
+        messageQ->count--;
+        copied++;
+    }
+    return copied;
+}
+
+palStatus_t pal_plat_osMessagePutBatch(palMessageQID_t messageQID, const void* messages, uint32_t count, uint32_t timeout, uint32_t* putCount)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palMessageQ_t* messageQ = NULL;
+    uint32_t copied = 0;
+
+    if (NULLPTR == messageQID || NULL == messages || 0 == count)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    messageQ = (palMessageQ_t*)messageQID;
+    pthread_mutex_lock(&messageQ->lock);
+    status = messageQueueWait(messageQ, &messageQ->notFull, true, timeout);
+    if (PAL_SUCCESS == status)
+    {
+        copied = messageQueueCopyIn(messageQ, (const uint8_t*)messages, count);
+        if (1 == copied)
+        {
+            pthread_cond_signal(&messageQ->notEmpty);
+        }
+        else
+        {
+            pthread_cond_broadcast(&messageQ->notEmpty);
+        }
+    }
+    pthread_mutex_unlock(&messageQ->lock);
+
+    if (NULL != putCount)
+    {
+        *putCount = copied;
+    }
+    return status;
+}
+
+palStatus_t pal_plat_osMessageGetBatch(palMessageQID_t messageQID, uint32_t timeout, void* messages, uint32_t count, uint32_t* getCount)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palMessageQ_t* messageQ = NULL;
+    uint32_t copied = 0;
+
+    if (NULLPTR == messageQID || NULL == messages || 0 == count)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    messageQ = (palMessageQ_t*)messageQID;
+    pthread_mutex_lock(&messageQ->lock);
+    status = messageQueueWait(messageQ, &messageQ->notEmpty, false, timeout);
+    if (PAL_SUCCESS == status)
+    {
+        copied = messageQueueCopyOut(messageQ, (uint8_t*)messages, count);
+        if (1 == copied)
+        {
+            pthread_cond_signal(&messageQ->notFull);
+        }
+        else
+        {
+            pthread_cond_broadcast(&messageQ->notFull);
+        }
+    }
+    pthread_mutex_unlock(&messageQ->lock);
+
+    if (NULL != getCount)
+    {
+        *getCount = copied;
+    }
+    return status;
+}
+
+palStatus_t pal_plat_osMessagePut(palMessageQID_t messageQID, const void* message, uint32_t timeout)
+{
+    return pal_plat_osMessagePutBatch(messageQID, message, 1, timeout, NULL);
+}
+
+palStatus_t pal_plat_osMessageGet(palMessageQID_t messageQID, uint32_t timeout, void* message)
+{
+    return pal_plat_osMessageGetBatch(messageQID, timeout, message, 1, NULL);
+}
+
+
+palStatus_t pal_plat_osMessageQueueDestroy(palMessageQID_t* messageQID)
+{
+    palStatus_t status = PAL_SUCCESS;
+    palMessageQ_t* messageQ = NULL;
+
+    if(NULL == messageQID || NULLPTR == *messageQID)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    messageQ = (palMessageQ_t*)*messageQID;
+    pthread_cond_destroy(&messageQ->notEmpty);
+    pthread_cond_destroy(&messageQ->notFull);
+    pthread_mutex_destroy(&messageQ->lock);
+    pal_osFree(messageQ->messages);
+    pal_osFree(messageQ);
+    *messageQID = NULLPTR;
+    return status;
+}
+
+
+//! Convert a PAL memory order to the memory order of the GCC __atomic builtins.
+static int palMemoryOrderToGcc(palMemoryOrder_t order)
+{
+    int gccOrder = __ATOMIC_SEQ_CST;
+
+    switch (order)
+    {
+        case PAL_MEMORY_ORDER_RELAXED:
+            gccOrder = __ATOMIC_RELAXED;
+            break;
+        case PAL_MEMORY_ORDER_ACQUIRE:
+            gccOrder = __ATOMIC_ACQUIRE;
+            break;
+        case PAL_MEMORY_ORDER_RELEASE:
+            gccOrder = __ATOMIC_RELEASE;
+            break;
+        case PAL_MEMORY_ORDER_ACQ_REL:
+            gccOrder = __ATOMIC_ACQ_REL;
+            break;
+        default:
+            gccOrder = __ATOMIC_SEQ_CST;
+            break;
+    }
+    return gccOrder;
+}
+
+//! The failure order of a compare and swap is a load, it can not have release semantics.
+static int palMemoryOrderToGccFailure(palMemoryOrder_t order)
+{
+    int gccOrder = palMemoryOrderToGcc(order);
+
+    if (__ATOMIC_RELEASE == gccOrder)
+    {
+        gccOrder = __ATOMIC_RELAXED;
+    }
+    else if (__ATOMIC_ACQ_REL == gccOrder)
+    {
+        gccOrder = __ATOMIC_ACQUIRE;
+    }
+    return gccOrder;
+}
+
+uint32_t pal_plat_osAtomicLoad32(const uint32_t* valuePtr, palMemoryOrder_t order)
+{
+    return __atomic_load_n(valuePtr, palMemoryOrderToGccFailure(order));
+}
+
+uint64_t pal_plat_osAtomicLoad64(const uint64_t* valuePtr, palMemoryOrder_t order)
+{
+    return __atomic_load_n(valuePtr, palMemoryOrderToGccFailure(order));
+}
+
+void pal_plat_osAtomicStore32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order)
+{
+    int gccOrder = palMemoryOrderToGcc(order);
+    __atomic_store_n(valuePtr, value, ((__ATOMIC_ACQUIRE == gccOrder) || (__ATOMIC_ACQ_REL == gccOrder)) ? __ATOMIC_RELEASE : gccOrder);
+}
+
+void pal_plat_osAtomicStore64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order)
+{
+    int gccOrder = palMemoryOrderToGcc(order);
+    __atomic_store_n(valuePtr, value, ((__ATOMIC_ACQUIRE == gccOrder) || (__ATOMIC_ACQ_REL == gccOrder)) ? __ATOMIC_RELEASE : gccOrder);
+}
+
+uint32_t pal_plat_osAtomicExchange32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order)
+{
+    return __atomic_exchange_n(valuePtr, value, palMemoryOrderToGcc(order));
+}
+
+uint64_t pal_plat_osAtomicExchange64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order)
+{
+    return __atomic_exchange_n(valuePtr, value, palMemoryOrderToGcc(order));
+}
+
+bool pal_plat_osAtomicCompareAndSwap32(uint32_t* valuePtr, uint32_t* expected, uint32_t desired, palMemoryOrder_t order)
+{
+    return __atomic_compare_exchange_n(valuePtr, expected, desired, false, palMemoryOrderToGcc(order), palMemoryOrderToGccFailure(order));
+}
+
+bool pal_plat_osAtomicCompareAndSwap64(uint64_t* valuePtr, uint64_t* expected, uint64_t desired, palMemoryOrder_t order)
+{
+    return __atomic_compare_exchange_n(valuePtr, expected, desired, false, palMemoryOrderToGcc(order), palMemoryOrderToGccFailure(order));
+}
+
+uint32_t pal_plat_osAtomicFetchAdd32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order)
+{
+    return __atomic_fetch_add(valuePtr, value, palMemoryOrderToGcc(order));
+}
+
+uint64_t pal_plat_osAtomicFetchAdd64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order)
+{
+    return __atomic_fetch_add(valuePtr, value, palMemoryOrderToGcc(order));
+}
+
+uint32_t pal_plat_osAtomicFetchAnd32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order)
+{
+    return __atomic_fetch_and(valuePtr, value, palMemoryOrderToGcc(order));
+}
+
+uint64_t pal_plat_osAtomicFetchAnd64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order)
+{
+    return __atomic_fetch_and(valuePtr, value, palMemoryOrderToGcc(order));
+}
+
+uint32_t pal_plat_osAtomicFetchOr32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order)
+{
+    return __atomic_fetch_or(valuePtr, value, palMemoryOrderToGcc(order));
+}
+
+uint64_t pal_plat_osAtomicFetchOr64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order)
+{
+    return __atomic_fetch_or(valuePtr, value, palMemoryOrderToGcc(order));
+}
+
+void pal_plat_osAtomicFence(palMemoryOrder_t order)
+{
+    if (PAL_MEMORY_ORDER_RELAXED != order)
+    {
+        __atomic_thread_fence(palMemoryOrderToGcc(order));
+    }
+}
+
+
+void *pal_plat_malloc(size_t len)
+{
+    return malloc(len);
+}
+
+
+void pal_plat_free(void * buffer)
+{
+    free(buffer);
+}
@@ -0,0 +1,497 @@
+/*
+* Copyright (c) 2016 ARM Limited. All rights reserved.
+* SPDX-License-Identifier: Apache-2.0
+* Licensed under the Apache License, Version 2.0 (the License); you may
+* not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an AS IS BASIS, WITHOUT
+* WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "pal_plat_update.h"
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+ * A file backed image store for hosts: every image has a header file (FirmwareHeader_t, same layout as
+ * the metadata header of the mbedOS port) and a data file under PAL_UPDATE_IMAGE_LOCATION.
+ * The "active" image is described by its own header file, written by pal_plat_imageActivate.
+ * All operations are synchronous, the service callback is called before returning.
+ */
+
+#if (!defined(PAL_UPDATE_IMAGE_LOCATION))
+#define PAL_UPDATE_IMAGE_LOCATION "/tmp/pal_update"
+#endif
+
+#if (!defined(PAL_UPDATE_MAX_NUMBER_OF_IMAGES))
+#define PAL_UPDATE_MAX_NUMBER_OF_IMAGES 2
+#endif
+
+#define PAL_UPDATE_MAX_PATH_LENGTH 256
+#define PAL_UPDATE_HEADER_FILE_SUFFIX "header"
+#define PAL_UPDATE_DATA_FILE_SUFFIX "bin"
+#define PAL_UPDATE_ACTIVE_HEADER_FILE_NAME "active_header"
+
+#define SIZEOF_SHA256 256/8
+#define FIRMWARE_HEADER_MAGIC   0x5a51b3d4UL
+#define FIRMWARE_HEADER_VERSION 1
+
+
+typedef struct FirmwareHeader {
+    uint32_t magic;                         /** Metadata-header specific magic code */
+    uint32_t version;                       /** Revision number for this generic metadata header. */
+    uint32_t checksum;                      /** A checksum of this header. This field should be considered to be zeroed out for
+                                             *  the sake of computing the checksum. */
+    uint32_t totalSize;                     /** Total space (in bytes) occupied by the firmware BLOB, including headers and any padding. */
+    uint64_t firmwareVersion;               /** Version number for the accompanying firmware. Larger numbers imply more preferred (recent)
+                                             *  versions. This defines the selection order when multiple versions are available. */
+    uint8_t  firmwareSHA256[SIZEOF_SHA256]; /** A SHA-2 using a block-size of 256-bits of the firmware, including any firmware-padding. */
+} FirmwareHeader_t;
+
+
+static palImageSignalEvent_t g_palUpdateServiceCBfunc;
+static FirmwareHeader_t pal_pi_linux_firmware_header;
+//! Consecutive reads continue where the previous one stopped, like the sequential journal reads of the mbedOS port.
+//! Any other operation ends the read sequence.
+static bool pal_pi_linux_read_active = false;
+static size_t pal_pi_linux_read_position = 0;
+
+
+static palStatus_t palTranslateErrnoErr(int platErr)
+{
+    palStatus_t palErr = PAL_SUCCESS;
+    switch (platErr)
+    {
+    case 0:
+        palErr = PAL_SUCCESS;
+        break;
+    case ENOENT:
+        palErr = PAL_ERR_UPDATE_END_OF_IMAGE;
+        break;
+    case ENOSPC:
+    case EFBIG:
+        palErr = PAL_ERR_UPDATE_OUT_OF_BOUNDS;
+        break;
+    case EBUSY:
+        palErr = PAL_ERR_UPDATE_BUSY;
+        break;
+    case EINVAL:
+        palErr = PAL_ERR_INVALID_ARGUMENT;
+        break;
+    case EIO:
+        palErr = PAL_ERR_UPDATE_PALFROM_IO;
+        break;
+    default:
+        palErr = PAL_ERR_UPDATE_ERROR;
+        break;
+    }
+    return palErr;
+}
+
+/*! Call the service callback with the event of a completed operation, or PAL_IMAGE_EVENT_ERROR if it failed.
+*/
+static palStatus_t palSignalEvent(palStatus_t status, palImageEvents_t event)
+{
+    if (PAL_IMAGE_EVENT_READTOBUFFER != event)
+    {
+        pal_pi_linux_read_active = false;
+    }
+    if (NULL != g_palUpdateServiceCBfunc)
+    {
+        g_palUpdateServiceCBfunc((PAL_SUCCESS == status) ? event : PAL_IMAGE_EVENT_ERROR);
+    }
+    return status;
+}
+
+static void palImageFileName(palImageId_t imageId, const char* suffix, char* path)
+{
+    snprintf(path, PAL_UPDATE_MAX_PATH_LENGTH, "%s/image_%u.%s", PAL_UPDATE_IMAGE_LOCATION, (unsigned int)imageId, suffix);
+}
+
+//! CRC32 (IEEE 802.3), the checksum the mbedOS port stores in the header through the flash journal CRC.
+static uint32_t palHeaderChecksum(const FirmwareHeader_t* header)
+{
+    const uint8_t* data = (const uint8_t*)header;
+    uint32_t crc = 0xFFFFFFFFUL;
+    size_t i;
+    int bit;
+
+    for (i = 0; i < sizeof(FirmwareHeader_t); i++)
+    {
+        crc ^= data[i];
+        for (bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static palStatus_t palWriteFile(const char* path, size_t offset, const void* data, size_t length, int flags)
+{
+    palStatus_t status = PAL_SUCCESS;
+    ssize_t written = 0;
+    int fd = open(path, O_WRONLY | O_CREAT | O_CLOEXEC | flags, 0644);
+
+    if (fd < 0)
+    {
+        return palTranslateErrnoErr(errno);
+    }
+
+    while ((PAL_SUCCESS == status) && (length > 0))
+    {
+        written = pwrite(fd, data, length, (off_t)offset);
+        if (written < 0)
+        {
+            if (EINTR != errno)
+            {
+                status = palTranslateErrnoErr(errno);
+            }
+        }
+        else
+        {
+            data = (const uint8_t*)data + written;
+            offset += (size_t)written;
+            length -= (size_t)written;
+        }
+    }
+
+    if ((0 != close(fd)) && (PAL_SUCCESS == status))
+    {
+        status = palTranslateErrnoErr(errno);
+    }
+    return status;
+}
+
+/*! Read up to length bytes from offset. bytesRead is set to the number of bytes actually read (short at end of file).
+*/
+static palStatus_t palReadFile(const char* path, size_t offset, void* data, size_t length, size_t* bytesRead)
+{
+    palStatus_t status = PAL_SUCCESS;
+    ssize_t count = 0;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    *bytesRead = 0;
+    if (fd < 0)
+    {
+        return palTranslateErrnoErr(errno);
+    }
+
+    while ((PAL_SUCCESS == status) && (length > 0))
+    {
+        count = pread(fd, data, length, (off_t)offset);
+        if (count < 0)
+        {
+            if (EINTR != errno)
+            {
+                status = palTranslateErrnoErr(errno);
+            }
+        }
+        else if (0 == count)
+        {
+            break; // end of image
+        }
+        else
+        {
+            data = (uint8_t*)data + count;
+            offset += (size_t)count;
+            length -= (size_t)count;
+            *bytesRead += (size_t)count;
+        }
+    }
+
+    close(fd);
+    return status;
+}
+
+static palStatus_t palReadHeader(const char* path, FirmwareHeader_t* header)
+{
+    palStatus_t status = PAL_SUCCESS;
+    size_t bytesRead = 0;
+
+    status = palReadFile(path, 0, header, sizeof(FirmwareHeader_t), &bytesRead);
+    if ((PAL_SUCCESS == status) && ((sizeof(FirmwareHeader_t) != bytesRead) || (FIRMWARE_HEADER_MAGIC != header->magic)))
+    {
+        status = PAL_ERR_UPDATE_ERROR;
+    }
+    return status;
+}
+
+
+/*
+ * WARNING: please do not change this function!
+ * this function loads a call back function received from the upper layer (service).
+ * the call back should be called at the end of each function (except pal_plat_imageGetDirectMemAccess)
+ * the call back receives the event type that just happened defined by the ENUM  palImageEvents_t.
+ *
+ * if you will not call the call back at the end the service behaver will be undefined
+ */
+palStatus_t pal_plat_imageInitAPI(palImageSignalEvent_t CBfunction)
+{
+    palStatus_t status = PAL_SUCCESS;
+
+    if ((0 != mkdir(PAL_UPDATE_IMAGE_LOCATION, 0755)) && (EEXIST != errno))
+    {
+        return palTranslateErrnoErr(errno);
+    }
+
+    g_palUpdateServiceCBfunc = CBfunction;
+    g_palUpdateServiceCBfunc(PAL_IMAGE_EVENT_INIT);
+    return status;
+}
+
+palStatus_t pal_plat_imageDeInit(void)
+{
+    palStatus_t status = PAL_SUCCESS;
+    g_palUpdateServiceCBfunc = NULL;
+    return status;
+}
+
+palStatus_t pal_plat_imageGetMaxNumberOfImages(uint8_t *imageNumber)
+{
+    *imageNumber = PAL_UPDATE_MAX_NUMBER_OF_IMAGES;
+    return PAL_SUCCESS;
+}
+
+palStatus_t pal_plat_imageSetHeader(palImageId_t imageId, palImageHeaderDeails_t *details)
+{
+    palStatus_t status = PAL_SUCCESS;
+    size_t hashLength = details->hash.bufferLength;
+
+    if (imageId >= PAL_UPDATE_MAX_NUMBER_OF_IMAGES)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    memset(&pal_pi_linux_firmware_header, 0, sizeof(pal_pi_linux_firmware_header));
+    pal_pi_linux_firmware_header.totalSize = details->imageSize + sizeof(FirmwareHeader_t);
+    pal_pi_linux_firmware_header.magic = FIRMWARE_HEADER_MAGIC;
+    pal_pi_linux_firmware_header.version = FIRMWARE_HEADER_VERSION;
+    pal_pi_linux_firmware_header.firmwareVersion = details->version;
+
+    if (hashLength > SIZEOF_SHA256)
+    {
+        hashLength = SIZEOF_SHA256;
+    }
+    memcpy(pal_pi_linux_firmware_header.firmwareSHA256, details->hash.buffer, hashLength);
+    pal_pi_linux_firmware_header.checksum = palHeaderChecksum(&pal_pi_linux_firmware_header);
+
+    return status;
+}
+
+palStatus_t pal_plat_imageReserveSpace(palImageId_t imageId, size_t imageSize)
+{
+    palStatus_t status = PAL_SUCCESS;
+    char path[PAL_UPDATE_MAX_PATH_LENGTH];
+
+    if (imageId >= PAL_UPDATE_MAX_NUMBER_OF_IMAGES)
+    {
+        return palSignalEvent(PAL_ERR_INVALID_ARGUMENT, PAL_IMAGE_EVENT_PREPARE);
+    }
+
+    //! start from an empty image of the right size, so a read past written data returns zeroes and not an old image.
+    palImageFileName(imageId, PAL_UPDATE_DATA_FILE_SUFFIX, path);
+    status = palWriteFile(path, 0, NULL, 0, O_TRUNC);
+    if ((PAL_SUCCESS == status) && (0 != truncate(path, (off_t)imageSize)))
+    {
+        status = palTranslateErrnoErr(errno);
+    }
+
+    if (PAL_SUCCESS == status)
+    {
+        palImageFileName(imageId, PAL_UPDATE_HEADER_FILE_SUFFIX, path);
+        status = palWriteFile(path, 0, &pal_pi_linux_firmware_header, sizeof(pal_pi_linux_firmware_header), O_TRUNC);
+    }
+
+    return palSignalEvent(status, PAL_IMAGE_EVENT_PREPARE);
+}
+
+palStatus_t pal_plat_imageWrite(palImageId_t imageId, size_t offset, palConstBuffer_t *chunk)
+{
+    palStatus_t status = PAL_SUCCESS;
+    char path[PAL_UPDATE_MAX_PATH_LENGTH];
+
+    if ((imageId >= PAL_UPDATE_MAX_NUMBER_OF_IMAGES) || (NULL == chunk) || (NULL == chunk->buffer))
+    {
+        return palSignalEvent(PAL_ERR_INVALID_ARGUMENT, PAL_IMAGE_EVENT_WRITE);
+    }
+
+    palImageFileName(imageId, PAL_UPDATE_DATA_FILE_SUFFIX, path);
+    status = palWriteFile(path, offset, chunk->buffer, chunk->bufferLength, 0);
+
+    return palSignalEvent(status, PAL_IMAGE_EVENT_WRITE);
+}
+
+palStatus_t pal_plat_imageSetVersion(palImageId_t imageId, const palConstBuffer_t* version)
+{
+    return PAL_ERR_NOT_IMPLEMENTED;
+}
+
+palStatus_t pal_plat_imageFlush(palImageId_t imageId)
+{
+    palStatus_t status = PAL_SUCCESS;
+    char path[PAL_UPDATE_MAX_PATH_LENGTH];
+    int fd = -1;
+
+    if (imageId >= PAL_UPDATE_MAX_NUMBER_OF_IMAGES)
+    {
+        return palSignalEvent(PAL_ERR_INVALID_ARGUMENT, PAL_IMAGE_EVENT_FINALIZE);
+    }
+
+    palImageFileName(imageId, PAL_UPDATE_DATA_FILE_SUFFIX, path);
+    fd = open(path, O_WRONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        status = palTranslateErrnoErr(errno);
+    }
+    else
+    {
+        if (0 != fsync(fd))
+        {
+            status = palTranslateErrnoErr(errno);
+        }
+        close(fd);
+    }
+
+    return palSignalEvent(status, PAL_IMAGE_EVENT_FINALIZE);
+}
+
+palStatus_t pal_plat_imageGetDirectMemAccess(palImageId_t imageId, void** imagePtr, size_t *imageSizeInBytes)
+{
+    return PAL_ERR_NOT_IMPLEMENTED;
+}
+
+palStatus_t pal_plat_imageReadToBuffer(palImageId_t imageId, size_t offset, palBuffer_t *chunk)
+{
+    palStatus_t status = PAL_SUCCESS;
+    char path[PAL_UPDATE_MAX_PATH_LENGTH];
+    size_t bytesRead = 0;
+
+    if ((imageId >= PAL_UPDATE_MAX_NUMBER_OF_IMAGES) || (NULL == chunk) || (NULL == chunk->buffer))
+    {
+        return palSignalEvent(PAL_ERR_INVALID_ARGUMENT, PAL_IMAGE_EVENT_READTOBUFFER);
+    }
+
+    if (!pal_pi_linux_read_active || (offset > pal_pi_linux_read_position))
+    {
+        pal_pi_linux_read_position = offset;
+    }
+
+    //! reading past the end of the image succeeds with 0 bytes, this is how callers detect the end of the image.
+    palImageFileName(imageId, PAL_UPDATE_DATA_FILE_SUFFIX, path);
+    status = palReadFile(path, pal_pi_linux_read_position, chunk->buffer, chunk->maxBufferLength, &bytesRead);
+    chunk->bufferLength = (uint32_t)bytesRead;
+    pal_pi_linux_read_position += bytesRead;
+    pal_pi_linux_read_active = (PAL_SUCCESS == status);
+
+    return palSignalEvent(status, PAL_IMAGE_EVENT_READTOBUFFER);
+}
+
+palStatus_t pal_plat_imageActivate(palImageId_t imageId)
+{
+    palStatus_t status = PAL_SUCCESS;
+    char path[PAL_UPDATE_MAX_PATH_LENGTH];
+    FirmwareHeader_t header;
+
+    if (imageId >= PAL_UPDATE_MAX_NUMBER_OF_IMAGES)
+    {
+        return palSignalEvent(PAL_ERR_INVALID_ARGUMENT, PAL_IMAGE_EVENT_ACTIVATE);
+    }
+
+    palImageFileName(imageId, PAL_UPDATE_HEADER_FILE_SUFFIX, path);
+    status = palReadHeader(path, &header);
+    if (PAL_SUCCESS == status)
+    {
+        snprintf(path, sizeof(path), "%s/%s", PAL_UPDATE_IMAGE_LOCATION, PAL_UPDATE_ACTIVE_HEADER_FILE_NAME);
+        status = palWriteFile(path, 0, &header, sizeof(header), O_TRUNC);
+    }
+
+    return palSignalEvent(status, PAL_IMAGE_EVENT_ACTIVATE);
+}
+
+palStatus_t pal_plat_imageGetActiveHash(palBuffer_t *hash)
+{
+    palStatus_t status = PAL_SUCCESS;
+    char path[PAL_UPDATE_MAX_PATH_LENGTH];
+    FirmwareHeader_t header;
+
+    if ((NULL == hash) || (NULL == hash->buffer) || (hash->maxBufferLength < SIZEOF_SHA256))
+    {
+        return palSignalEvent(PAL_ERR_INVALID_ARGUMENT, PAL_IMAGE_EVENT_GETACTIVEHASH);
+    }
+
+    snprintf(path, sizeof(path), "%s/%s", PAL_UPDATE_IMAGE_LOCATION, PAL_UPDATE_ACTIVE_HEADER_FILE_NAME);
+    status = palReadHeader(path, &header);
+    if (PAL_SUCCESS == status)
+    {
+        memcpy(hash->buffer, header.firmwareSHA256, SIZEOF_SHA256);
+        hash->bufferLength = SIZEOF_SHA256;
+    }
+
+    return palSignalEvent(status, PAL_IMAGE_EVENT_GETACTIVEHASH);
+}
+
+palStatus_t pal_plat_imageGetActiveVersion(palBuffer_t* version)
+{
+    palStatus_t status = PAL_SUCCESS;
+    char path[PAL_UPDATE_MAX_PATH_LENGTH];
+    FirmwareHeader_t header;
+
+    if ((NULL == version) || (NULL == version->buffer) || (version->maxBufferLength < sizeof(header.firmwareVersion)))
+    {
+        return palSignalEvent(PAL_ERR_INVALID_ARGUMENT, PAL_IMAGE_EVENT_GETACTIVEVERSION);
+    }
+
+    snprintf(path, sizeof(path), "%s/%s", PAL_UPDATE_IMAGE_LOCATION, PAL_UPDATE_ACTIVE_HEADER_FILE_NAME);
+    status = palReadHeader(path, &header);
+    if (PAL_SUCCESS == status)
+    {
+        memcpy(version->buffer, &header.firmwareVersion, sizeof(header.firmwareVersion));
+        version->bufferLength = sizeof(header.firmwareVersion);
+    }
+
+    return palSignalEvent(status, PAL_IMAGE_EVENT_GETACTIVEVERSION);
+}
+
+palStatus_t pal_plat_imageWriteHashToMemory(const palConstBuffer_t* const hashValue)
+{
+    palStatus_t status = PAL_SUCCESS;
+    char path[PAL_UPDATE_MAX_PATH_LENGTH];
+    FirmwareHeader_t header;
+    size_t hashLength = 0;
+
+    if ((NULL == hashValue) || (NULL == hashValue->buffer))
+    {
+        return palSignalEvent(PAL_ERR_INVALID_ARGUMENT, PAL_IMAGE_EVENT_WRITEDATATOMEMORY);
+    }
+
+    //! the bootloader reads the hash from the active header.
+    snprintf(path, sizeof(path), "%s/%s", PAL_UPDATE_IMAGE_LOCATION, PAL_UPDATE_ACTIVE_HEADER_FILE_NAME);
+    status = palReadHeader(path, &header);
+    if (PAL_SUCCESS == status)
+    {
+        hashLength = (hashValue->bufferLength > SIZEOF_SHA256) ? SIZEOF_SHA256 : hashValue->bufferLength;
+        memset(header.firmwareSHA256, 0, SIZEOF_SHA256);
+        memcpy(header.firmwareSHA256, hashValue->buffer, hashLength);
+        header.checksum = 0;
+        header.checksum = palHeaderChecksum(&header);
+        status = palWriteFile(path, 0, &header, sizeof(header), O_TRUNC);
+    }
+
+    return palSignalEvent(status, PAL_IMAGE_EVENT_WRITEDATATOMEMORY);
+}
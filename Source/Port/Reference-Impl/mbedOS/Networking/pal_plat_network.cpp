@@ -40,6 +40,7 @@ void palSelectCallbackNull()
 
 
 #define PAL_SOCKET_OPTION_ERROR (-1)
+#define PAL_SEGMENT_COALESCE_SIZE 256 // stack buffer for scatter / gather calls, the stack takes one contiguous buffer per call
 
 static NetworkInterface* s_pal_networkInterfacesSupported[PAL_MAX_SUPORTED_NET_INTEFACES] = { 0 };
 
@@ -248,10 +249,199 @@ static palStatus_t socketAddressToPalSockAddr(SocketAddress& input, palSocketAdd
 
 
 
+/*! A socket handle is the record of the socket. mbedOS sockets have a single event callback (sigio) which does not say which event happened,
+* it is attached to the record for the life of the socket and marks the socket ready for RX and TX. A call which would block marks its
+* direction not ready again, unless an event came while it ran, and a call which fails marks the socket in error until a call succeeds.
+* So the readiness is exact for non-blocking sockets, a blocking socket stays ready from an event until a call on it would block.
+* Records are never freed, a closed socket puts its record on a free list for the next socket. So a callback which was already on its way
+* when its socket was closed only finds the record closed (or, at worst, gives the socket which reuses it a spurious event, which sigio may
+* do anyway), and checking a record takes constant time. Closing a socket marks its record closed, closes the socket and then blocks until
+* the callbacks which still use the record return, so a socket can not be closed from its own direct asynchronous callback.
+*/
+typedef struct palSocketPollerEntry palSocketPollerEntry_t;
+typedef struct palSocketRecord palSocketRecord_t;
+
+struct palSocketRecord{
+    Socket* socketObj;
+    bool open; // the record belongs to an open socket.
+    int timeout; // the timeout of the socket calls in milliseconds as last set on the socket, -1 blocks and 0 does not.
+    uint32_t events; // sigio callbacks so far.
+    uint32_t running; // callbacks using the record.
+    uint32_t waiters; // threads waiting for the running callbacks to return.
+    palSemaphoreID_t idle; // released once for each waiter when the last running callback returns.
+    uint8_t readyMask; // PAL_NET_SOCKET_SELECT_XX_BIT values.
+    palSocketPollerEntry_t* pollerEntries; // the entries of the pollers the socket is in.
+#if PAL_NET_ASYNCHRONOUS_SOCKET_API
+    palAsyncSocketCallback_t asyncCallback;
+    palAsyncSocketContextCallback_t contextCallback;
+    void* context;
+    palMessageQID_t deferralQueue;
+    uint8_t pendingEvents; // events of a deferred socket its callback was not told yet.
+    bool posted; // an event of the record is in a deferral queue, kept when the record is reused.
+    bool overflowed; // the record is in the overflow list, kept when the record is reused.
+    palSocketRecord_t* nextOverflow;
+#endif //PAL_NET_ASYNCHRONOUS_SOCKET_API
+    palSocketRecord_t* nextFree;
+};
+
+#define PAL_SOCKET_RECORD(socket) ((palSocketRecord_t*)(socket))
+
+static palSocketRecord_t* s_pal_freeSocketRecords = NULL;
+
+static void palSocketPollerNotify(palSocketPollerEntry_t* entries);
+#if PAL_NET_ASYNCHRONOUS_SOCKET_API
+static void palAsyncSocketNotify(palSocketRecord_t* record, uint8_t events);
+#endif //PAL_NET_ASYNCHRONOUS_SOCKET_API
+
+//! a callback which used a record returns, the threads waiting for the callbacks of the record are released after the last one.
+static void palSocketRecordRelease(palSocketRecord_t* record)
+{
+    uint32_t waiters = 0;
+
+    core_util_critical_section_enter();
+    record->running--;
+    if (0 == record->running)
+    {
+        waiters = record->waiters;
+        record->waiters = 0;
+    }
+    core_util_critical_section_exit();
+
+    for (; 0 < waiters; --waiters)
+    {
+        pal_osSemaphoreRelease(record->idle);
+    }
+}
+
+static void palSocketRecordCallback(palSocketRecord_t* record)
+{
+    palSocketPollerEntry_t* entry = NULL;
+    uint8_t events = 0;
+    bool open = false;
+
+    core_util_critical_section_enter();
+    open = record->open;
+    if (open)
+    {
+        record->running++;
+        record->events++;
+        record->readyMask |= PAL_NET_SOCKET_SELECT_RX_BIT | PAL_NET_SOCKET_SELECT_TX_BIT;
+        events = record->readyMask;
+        entry = record->pollerEntries;
+    }
+    core_util_critical_section_exit();
+    if (!open)
+    {
+        return;
+    }
+
+    palSocketPollerNotify(entry);
+#if PAL_NET_ASYNCHRONOUS_SOCKET_API
+    palAsyncSocketNotify(record, events);
+#else
+    (void)events;
+#endif //PAL_NET_ASYNCHRONOUS_SOCKET_API
+
+    palSocketRecordRelease(record);
+}
+
+//! block until no callback uses a record, the record is closed (or the entry of a poller left it) before.
+static void palSocketRecordWaitCallbacks(palSocketRecord_t* record)
+{
+    int32_t count = 0;
+    bool wait = false;
+
+    core_util_critical_section_enter();
+    wait = (0 != record->running);
+    if (wait)
+    {
+        record->waiters++;
+    }
+    core_util_critical_section_exit();
+
+    if (wait)
+    {
+        pal_osSemaphoreWait(record->idle, PAL_RTOS_WAIT_FOREVER, &count);
+    }
+}
+
+//! take a record from the free list, or allocate one, the fields which outlive a socket are kept.
+static palSocketRecord_t* palSocketRecordAlloc(void)
+{
+    palSocketRecord_t* record = NULL;
+
+    core_util_critical_section_enter();
+    record = s_pal_freeSocketRecords;
+    if (NULL != record)
+    {
+        s_pal_freeSocketRecords = record->nextFree;
+    }
+    core_util_critical_section_exit();
+    if (NULL != record)
+    {
+        return record;
+    }
+
+    record = (palSocketRecord_t*)pal_osMalloc(sizeof(palSocketRecord_t));
+    if (NULL != record)
+    {
+        memset(record, 0, sizeof(palSocketRecord_t));
+        if (PAL_SUCCESS != pal_osSemaphoreCreate(0, &record->idle))
+        {
+            pal_osFree(record);
+            record = NULL;
+        }
+    }
+    return record;
+}
+
+//! the events of a socket so far, read before a call whose result updates the readiness.
+static uint32_t palSocketRecordEvents(palSocketRecord_t* record)
+{
+    uint32_t events = 0;
+
+    core_util_critical_section_enter();
+    events = record->events;
+    core_util_critical_section_exit();
+    return events;
+}
+
+//! update the readiness after a call in one direction: a call which blocked (would block or sent part of the data) marks the direction not ready,
+//! unless an event came since the call started, and a call which failed marks an error.
+static void palSocketRecordUpdate(palSocketRecord_t* record, uint32_t events, uint8_t direction, bool blocked, bool failed)
+{
+    core_util_critical_section_enter();
+    if (blocked && (events == record->events))
+    {
+        record->readyMask &= (uint8_t)~direction;
+    }
+    if (failed)
+    {
+        record->readyMask |= PAL_NET_SOCKET_SELECT_ERR_BIT;
+    }
+    else
+    {
+        record->readyMask &= (uint8_t)~PAL_NET_SOCKET_SELECT_ERR_BIT;
+    }
+    core_util_critical_section_exit();
+}
+
+//! the events of interest a socket is ready for, errors are always reported.
+static uint8_t palSocketRecordReady(palSocketRecord_t* record, uint8_t interestMask)
+{
+    uint8_t ready = 0;
+
+    core_util_critical_section_enter();
+    ready = record->readyMask & (interestMask | PAL_NET_SOCKET_SELECT_ERR_BIT);
+    core_util_critical_section_exit();
+    return ready;
+}
+
 palStatus_t pal_plat_socket(palSocketDomain_t domain, palSocketType_t type, bool nonBlockingSocket, uint32_t interfaceNum, palSocket_t* socket)
 {
     int result = PAL_SUCCESS;
     Socket* socketObj = NULL;
+    palSocketRecord_t* record = NULL;
 
     if (PAL_NET_DEFAULT_INTERFACE == interfaceNum)
     {
@@ -281,6 +471,16 @@ palStatus_t pal_plat_socket(palSocketDomain_t domain, palSocketType_t type, bool
     {
         result = PAL_ERR_NO_MEMORY;
     }
+
+    if (PAL_SUCCESS == result)
+    {
+        record = palSocketRecordAlloc();
+        if (NULL == record)
+        {
+            delete socketObj;
+            result = PAL_ERR_NO_MEMORY;
+        }
+    }
     
     if (PAL_SUCCESS == result)
     {
@@ -292,7 +492,23 @@ palStatus_t pal_plat_socket(palSocketDomain_t domain, palSocketType_t type, bool
         {
             socketObj->set_blocking(true);
         }
-        *socket = (palSocket_t)socketObj;
+        core_util_critical_section_enter();
+        record->socketObj = socketObj;
+        record->timeout = nonBlockingSocket ? 0 : -1;
+        record->events = 0;
+        record->readyMask = (PAL_SOCK_STREAM_SERVER == type) ? 0 : PAL_NET_SOCKET_SELECT_TX_BIT; // a new socket has room to send.
+        record->pollerEntries = NULL;
+#if PAL_NET_ASYNCHRONOUS_SOCKET_API
+        record->asyncCallback = NULL;
+        record->contextCallback = NULL;
+        record->context = NULL;
+        record->deferralQueue = NULLPTR;
+        record->pendingEvents = 0;
+#endif //PAL_NET_ASYNCHRONOUS_SOCKET_API
+        record->open = true;
+        core_util_critical_section_exit();
+        socketObj->attach(mbed::callback(palSocketRecordCallback, record));
+        *socket = (palSocket_t)record;
     }
     return result; // TODO(nirson01) ADD debug print for error propagation(once debug print infrastructure is finalized)
 }
@@ -302,7 +518,7 @@ palStatus_t pal_plat_getSocketOptions(palSocket_t socket, palSocketOptionName_t
 {
     int result = PAL_SUCCESS;
     unsigned int length = *optionLength;
-    Socket* socketObj = (Socket*)socket;
+    Socket* socketObj = PAL_SOCKET_RECORD(socket)->socketObj;
 
     int socketOption = translateNSAPItoPALSocketOption(optionName);
     
@@ -332,7 +548,7 @@ palStatus_t pal_plat_getSocketOptions(palSocket_t socket, palSocketOptionName_t
 palStatus_t pal_plat_setSocketOptions(palSocket_t socket, int optionName, const void* optionValue, palSocketLength_t optionLength)
 {
     int result = PAL_SUCCESS;
-    Socket* socketObj = (Socket*)socket;
+    Socket* socketObj = PAL_SOCKET_RECORD(socket)->socketObj;
     int socketOption = PAL_SOCKET_OPTION_ERROR;
     
     socketOption = translateNSAPItoPALSocketOption(optionName);
@@ -350,6 +566,7 @@ palStatus_t pal_plat_setSocketOptions(palSocket_t socket, int optionName, const
         {
             int timeout = *((int*)optionValue);
             socketObj->set_timeout(timeout);
+            PAL_SOCKET_RECORD(socket)->timeout = timeout;
         }
         else
         {
@@ -366,7 +583,7 @@ palStatus_t pal_plat_setSocketOptions(palSocket_t socket, int optionName, const
 palStatus_t pal_plat_bind(palSocket_t socket, palSocketAddress_t* myAddress, palSocketLength_t addressLength)
 {
     int result = PAL_SUCCESS;
-    Socket* socketObj = (Socket*)socket;
+    Socket* socketObj = PAL_SOCKET_RECORD(socket)->socketObj;
     SocketAddress internalAddr;
 
     result = palSockAddrToSocketAddress(myAddress, addressLength, internalAddr);
@@ -389,11 +606,15 @@ palStatus_t pal_plat_receiveFrom(palSocket_t socket, void* buffer, size_t length
     int status = 0;
     *bytesReceived = 0;
     SocketAddress sockAddr;
+    palSocketRecord_t* record = PAL_SOCKET_RECORD(socket);
     UDPSocket* socketObj;
+    uint32_t events = 0;
 
-    socketObj = (UDPSocket*)socket;
+    socketObj = (UDPSocket*)record->socketObj;
 
+    events = palSocketRecordEvents(record);
     status = socketObj->recvfrom(&sockAddr, buffer, length);
+    palSocketRecordUpdate(record, events, PAL_NET_SOCKET_SELECT_RX_BIT, (NSAPI_ERROR_WOULD_BLOCK == status), ((status < 0) && (NSAPI_ERROR_WOULD_BLOCK != status)));
     if (status < 0)
     {   
         result = translateErrorToPALError(status);
@@ -420,14 +641,17 @@ palStatus_t pal_plat_sendTo(palSocket_t socket, const void* buffer, size_t lengt
     int result = PAL_SUCCESS;
     int status = 0;
     SocketAddress sockAddr;
-
-    UDPSocket* socketObj = (UDPSocket*)socket;
+    palSocketRecord_t* record = PAL_SOCKET_RECORD(socket);
+    UDPSocket* socketObj = (UDPSocket*)record->socketObj;
+    uint32_t events = 0;
 
     *bytesSent = 0;
     result = palSockAddrToSocketAddress(to, toLength, sockAddr);
     if (result == 0)
     {
+        events = palSocketRecordEvents(record);
         status = socketObj->sendto(sockAddr, buffer, length);
+        palSocketRecordUpdate(record, events, PAL_NET_SOCKET_SELECT_TX_BIT, (NSAPI_ERROR_WOULD_BLOCK == status), ((status < 0) && (NSAPI_ERROR_WOULD_BLOCK != status)));
         if (status < 0)
         {
             result = translateErrorToPALError(status);
@@ -441,16 +665,188 @@ palStatus_t pal_plat_sendTo(palSocket_t socket, const void* buffer, size_t lengt
     return result;
 }
 
+palStatus_t pal_plat_sendToMulti(palSocket_t socket, palDatagram_t* datagrams, uint32_t count, uint32_t* datagramsSent)
+{
+    palStatus_t result = PAL_SUCCESS;
+    uint32_t sent = 0;
+
+    //! the stack takes one datagram per call, the loop saves the checks of the PAL wrapper only.
+    for (sent = 0; sent < count; ++sent)
+    {
+        result = pal_plat_sendTo(socket, datagrams[sent].buffer, datagrams[sent].length, datagrams[sent].address, datagrams[sent].addressLength, &datagrams[sent].bytes);
+        datagrams[sent].status = result;
+        if (PAL_SUCCESS != result)
+        {
+            break;
+        }
+    }
+
+    *datagramsSent = sent;
+    return (0 < sent) ? PAL_SUCCESS : result;
+}
+
+palStatus_t pal_plat_receiveFromMulti(palSocket_t socket, palDatagram_t* datagrams, uint32_t count, uint32_t* datagramsReceived)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palSocketRecord_t* record = PAL_SOCKET_RECORD(socket);
+    bool waits = (0 != record->timeout);
+    uint32_t received = 0;
+
+    //! only the first receive may wait: a socket which waits is switched to non-blocking for the following receives, until one would block,
+    //! and switched back after them.
+    for (received = 0; received < count; ++received)
+    {
+        if (waits && (1 == received))
+        {
+            record->socketObj->set_timeout(0);
+        }
+        datagrams[received].addressLength = sizeof(palSocketAddress_t);
+        result = pal_plat_receiveFrom(socket, datagrams[received].buffer, datagrams[received].length, datagrams[received].address, &datagrams[received].addressLength, &datagrams[received].bytes);
+        datagrams[received].status = result;
+        if (PAL_SUCCESS != result)
+        {
+            break;
+        }
+    }
+    if (waits && (1 <= received) && (1 < count))
+    {
+        record->socketObj->set_timeout(record->timeout);
+    }
+
+    *datagramsReceived = received;
+    return (0 < received) ? PAL_SUCCESS : result;
+}
+
+static size_t palSegmentsLength(const palConstBuffer_t* segments, uint32_t segmentCount, bool receive)
+{
+    size_t length = 0;
+    uint32_t index = 0;
+
+    for (index = 0; index < segmentCount; ++index)
+    {
+        length += receive ? segments[index].maxBufferLength : segments[index].bufferLength;
+    }
+    return length;
+}
+
+static void palGatherSegments(const palConstBuffer_t* segments, uint32_t segmentCount, uint8_t* output)
+{
+    uint32_t index = 0;
+
+    for (index = 0; index < segmentCount; ++index)
+    {
+        memcpy(output, segments[index].buffer, segments[index].bufferLength);
+        output += segments[index].bufferLength;
+    }
+}
+
+static void palScatterSegments(palBuffer_t* segments, uint32_t segmentCount, const uint8_t* input, size_t length)
+{
+    uint32_t index = 0;
+    size_t chunk = 0;
+
+    for (index = 0; (index < segmentCount) && (0 < length); ++index)
+    {
+        chunk = (length < segments[index].maxBufferLength) ? length : segments[index].maxBufferLength;
+        memcpy(segments[index].buffer, input, chunk);
+        input += chunk;
+        length -= chunk;
+    }
+}
+
+palStatus_t pal_plat_sendTov(palSocket_t socket, const palConstBuffer_t* segments, uint32_t segmentCount, const palSocketAddress_t* to, palSocketLength_t toLength, size_t* bytesSent)
+{
+    palStatus_t result = PAL_SUCCESS;
+    uint8_t stackBuffer[PAL_SEGMENT_COALESCE_SIZE];
+    uint8_t* buffer = stackBuffer;
+    size_t length = 0;
+
+    if (1 == segmentCount)
+    {
+        return pal_plat_sendTo(socket, segments[0].buffer, segments[0].bufferLength, to, toLength, bytesSent);
+    }
+
+    //! a datagram has to leave in one call, so the segments are always coalesced.
+    length = palSegmentsLength(segments, segmentCount, false);
+    if (PAL_SEGMENT_COALESCE_SIZE < length)
+    {
+        buffer = (uint8_t*)pal_osMalloc(length);
+        if (NULL == buffer)
+        {
+            return PAL_ERR_NO_MEMORY;
+        }
+    }
+    palGatherSegments(segments, segmentCount, buffer);
+    result = pal_plat_sendTo(socket, buffer, length, to, toLength, bytesSent);
+    if (stackBuffer != buffer)
+    {
+        pal_osFree(buffer);
+    }
+    return result;
+}
+
+palStatus_t pal_plat_receiveFromv(palSocket_t socket, palBuffer_t* segments, uint32_t segmentCount, palSocketAddress_t* from, palSocketLength_t* fromLength, size_t* bytesReceived)
+{
+    palStatus_t result = PAL_SUCCESS;
+    uint8_t stackBuffer[PAL_SEGMENT_COALESCE_SIZE];
+    uint8_t* buffer = stackBuffer;
+    size_t length = 0;
+
+    if (1 == segmentCount)
+    {
+        return pal_plat_receiveFrom(socket, segments[0].buffer, segments[0].maxBufferLength, from, fromLength, bytesReceived);
+    }
+
+    //! the rest of a datagram which does not fit is dropped, so the whole capacity is received at once.
+    length = palSegmentsLength((const palConstBuffer_t*)segments, segmentCount, true);
+    if (PAL_SEGMENT_COALESCE_SIZE < length)
+    {
+        buffer = (uint8_t*)pal_osMalloc(length);
+        if (NULL == buffer)
+        {
+            return PAL_ERR_NO_MEMORY;
+        }
+    }
+    result = pal_plat_receiveFrom(socket, buffer, length, from, fromLength, bytesReceived);
+    if (PAL_SUCCESS == result)
+    {
+        palScatterSegments(segments, segmentCount, buffer, *bytesReceived);
+    }
+    if (stackBuffer != buffer)
+    {
+        pal_osFree(buffer);
+    }
+    return result;
+}
+
 palStatus_t pal_plat_close(palSocket_t* socket)
 {
     int result = PAL_SUCCESS;
-    Socket* socketObj = (Socket*)*socket;
+    palSocketRecord_t* record = PAL_SOCKET_RECORD(*socket);
+    Socket* socketObj = record->socketObj;
+
+    //! the callbacks which start after the record is closed return without using it.
+    core_util_critical_section_enter();
+    record->open = false;
+#if PAL_NET_ASYNCHRONOUS_SOCKET_API
+    record->pendingEvents = 0;
+#endif //PAL_NET_ASYNCHRONOUS_SOCKET_API
+    core_util_critical_section_exit();
+
+    socketObj->attach(NULL_FUNCTION);
     result = socketObj->close();
     if (result < 0)
     {
         result =  translateErrorToPALError(result);
     }
+    palSocketRecordWaitCallbacks(record);
     delete socketObj;
+
+    core_util_critical_section_enter();
+    record->socketObj = NULL;
+    record->nextFree = s_pal_freeSocketRecords;
+    s_pal_freeSocketRecords = record;
+    core_util_critical_section_exit();
     *socket = NULL;
     return result;
 }
@@ -481,139 +877,538 @@ palStatus_t pal_plat_getNetInterfaceInfo(uint32_t interfaceNum, palNetInterfaceI
     return result;
 }
 
-typedef void(*palSelectCallbackFunction_t)();
+/*! A poller keeps an entry per socket, entries are linked in the list of the poller (guarded by the poller mutex) and in the list of their socket
+* record (guarded by the critical section). An event of a socket queues its entries which are ready for their events of interest on the ready lists
+* of their pollers and releases the poller semaphores. A wait takes the entries off the ready list and reports the events of interest their socket
+* is ready for, and queues the reported entries again: events are level triggered like on other platforms, a socket is reported until a call on it
+* would block.
+*/
+typedef struct palSocketPoller{
+    palSemaphoreID_t semaphore;
+    palMutexID_t mutex;
+    palSocketPollerEntry_t* entries;
+    palSocketPollerEntry_t* readyHead;
+    palSocketPollerEntry_t* readyTail;
+    struct palSocketPoller* nextFree; // the next poller kept for mini selects.
+} palSocketPoller_t;
+
+struct palSocketPollerEntry{
+    palSocketPoller_t* poller;
+    palSocketRecord_t* record;
+    uint8_t interestMask;
+    bool queued;
+    palSocketPollerEntry_t* next;
+    palSocketPollerEntry_t* nextReady;
+    palSocketPollerEntry_t* nextOfSocket;
+};
+
+//! queue an entry on the ready list if its socket is ready for its events of interest, called with the critical section held.
+static bool palSocketPollerQueue(palSocketPollerEntry_t* entry)
+{
+    palSocketPoller_t* socketPoller = entry->poller;
+
+    if (entry->queued || (0 == (entry->record->readyMask & (entry->interestMask | PAL_NET_SOCKET_SELECT_ERR_BIT))))
+    {
+        return false;
+    }
+    entry->queued = true;
+    entry->nextReady = NULL;
+    if (NULL == socketPoller->readyTail)
+    {
+        socketPoller->readyHead = entry;
+    }
+    else
+    {
+        socketPoller->readyTail->nextReady = entry;
+    }
+    socketPoller->readyTail = entry;
+    return true;
+}
+
+//! wake up the pollers of the entries of a socket, entries are not freed while a callback uses the record so the list is walked outside the critical section.
+static void palSocketPollerNotify(palSocketPollerEntry_t* entries)
+{
+    palSocketPollerEntry_t* entry = NULL;
+    bool wakeUp = false;
 
-static palSemaphoreID_t s_palSelectSemaphore = 0;
-static bool s_palSelectSemaphoreInited = false;
-uint32_t s_select_event_happened[PAL_NET_SOCKET_SELECT_MAX_SOCKETS];
+    for (entry = entries; NULL != entry; entry = entry->nextOfSocket)
+    {
+        core_util_critical_section_enter();
+        wakeUp = palSocketPollerQueue(entry);
+        core_util_critical_section_exit();
 
-// select callbacks definition
-// TODO: nirson01 change to define these using a macro.
-void palSelectCallback0() 
-{ 
-    s_select_event_happened[0]++;
-    pal_osSemaphoreRelease(s_palSelectSemaphore); 
+        if (wakeUp)
+        {
+            pal_osSemaphoreRelease(entry->poller->semaphore);
+        }
+    }
 }
-void palSelectCallback1()
+
+//! unlink an entry from the ready list, called with the critical section held.
+static void palSocketPollerUnqueue(palSocketPoller_t* socketPoller, palSocketPollerEntry_t* entry)
 {
-    s_select_event_happened[1]++;
-    pal_osSemaphoreRelease(s_palSelectSemaphore);
+    palSocketPollerEntry_t* previous = NULL;
+    palSocketPollerEntry_t* current = socketPoller->readyHead;
+
+    while ((NULL != current) && (entry != current))
+    {
+        previous = current;
+        current = current->nextReady;
+    }
+    if (NULL != current)
+    {
+        if (NULL == previous)
+        {
+            socketPoller->readyHead = current->nextReady;
+        }
+        else
+        {
+            previous->nextReady = current->nextReady;
+        }
+        if (socketPoller->readyTail == current)
+        {
+            socketPoller->readyTail = previous;
+        }
+    }
+    entry->queued = false;
 }
-void palSelectCallback2()
+
+//! find the entry of a socket, called with the poller mutex held.
+static palSocketPollerEntry_t** palSocketPollerFind(palSocketPoller_t* socketPoller, palSocket_t socket)
 {
-    s_select_event_happened[2]++;
-    pal_osSemaphoreRelease(s_palSelectSemaphore);
+    palSocketPollerEntry_t** link = &socketPoller->entries;
+
+    while ((NULL != *link) && ((*link)->record != PAL_SOCKET_RECORD(socket)))
+    {
+        link = &(*link)->next;
+    }
+    return link;
 }
-void palSelectCallback3()
+
+//! unlink an entry from its socket and free it once no callback of the socket uses it, called with the poller mutex held after the entry left the poller list.
+static void palSocketPollerEntryFree(palSocketPoller_t* socketPoller, palSocketPollerEntry_t* entry)
 {
-    s_select_event_happened[3]++;
-    pal_osSemaphoreRelease(s_palSelectSemaphore);
+    palSocketPollerEntry_t** link = &entry->record->pollerEntries;
+
+    core_util_critical_section_enter();
+    while ((NULL != *link) && (*link != entry))
+    {
+        link = &(*link)->nextOfSocket;
+    }
+    if (NULL != *link)
+    {
+        *link = entry->nextOfSocket;
+    }
+    palSocketPollerUnqueue(socketPoller, entry);
+    core_util_critical_section_exit();
+
+    palSocketRecordWaitCallbacks(entry->record);
+    pal_osFree(entry);
 }
-void palSelectCallback4()
+
+
+palStatus_t pal_plat_socketPollerCreate(palSocketPollerID_t* poller)
 {
-    s_select_event_happened[4]++;
-    pal_osSemaphoreRelease(s_palSelectSemaphore);
+    palStatus_t result = PAL_SUCCESS;
+    palSocketPoller_t* socketPoller = NULL;
+
+    if (NULL == poller)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    socketPoller = (palSocketPoller_t*)pal_osMalloc(sizeof(palSocketPoller_t));
+    if (NULL == socketPoller)
+    {
+        return PAL_ERR_NO_MEMORY;
+    }
+    memset(socketPoller, 0, sizeof(palSocketPoller_t));
+
+    result = pal_osSemaphoreCreate(0, &socketPoller->semaphore);
+    if (PAL_SUCCESS == result)
+    {
+        result = pal_osMutexCreate(&socketPoller->mutex);
+        if (PAL_SUCCESS != result)
+        {
+            pal_osSemaphoreDelete(&socketPoller->semaphore);
+        }
+    }
+
+    if (PAL_SUCCESS != result)
+    {
+        pal_osFree(socketPoller);
+        return result;
+    }
+
+    *poller = (palSocketPollerID_t)socketPoller;
+    return PAL_SUCCESS;
 }
-void palSelectCallback5()
+
+
+palStatus_t pal_plat_socketPollerDestroy(palSocketPollerID_t* poller)
 {
-    s_select_event_happened[5]++;
-    pal_osSemaphoreRelease(s_palSelectSemaphore);
+    palSocketPoller_t* socketPoller = NULL;
+    palSocketPollerEntry_t* entry = NULL;
+
+    if ((NULL == poller) || (NULLPTR == *poller))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    socketPoller = (palSocketPoller_t*)*poller;
+    while (NULL != socketPoller->entries)
+    {
+        entry = socketPoller->entries;
+        socketPoller->entries = entry->next;
+        palSocketPollerEntryFree(socketPoller, entry);
+    }
+
+    pal_osMutexDelete(&socketPoller->mutex);
+    pal_osSemaphoreDelete(&socketPoller->semaphore);
+    pal_osFree(socketPoller);
+    *poller = NULLPTR;
+    return PAL_SUCCESS;
 }
-void palSelectCallback6()
+
+
+palStatus_t pal_plat_socketPollerAdd(palSocketPollerID_t poller, palSocket_t socket, uint8_t interestMask)
 {
-    s_select_event_happened[6]++;
-    pal_osSemaphoreRelease(s_palSelectSemaphore);
+    palStatus_t result = PAL_SUCCESS;
+    palSocketPoller_t* socketPoller = (palSocketPoller_t*)poller;
+    palSocketPollerEntry_t* entry = NULL;
+    bool wakeUp = false;
+
+    if ((NULLPTR == poller) || (NULLPTR == socket))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    result = pal_osMutexWait(socketPoller->mutex, PAL_RTOS_WAIT_FOREVER);
+    if (PAL_SUCCESS != result)
+    {
+        return result;
+    }
+
+    if (NULL != *palSocketPollerFind(socketPoller, socket))
+    {
+        result = PAL_ERR_INVALID_ARGUMENT; // a socket can be added to a poller once.
+    }
+    else
+    {
+        entry = (palSocketPollerEntry_t*)pal_osMalloc(sizeof(palSocketPollerEntry_t));
+        if (NULL == entry)
+        {
+            result = PAL_ERR_NO_MEMORY;
+        }
+        else
+        {
+            memset(entry, 0, sizeof(palSocketPollerEntry_t));
+            entry->poller = socketPoller;
+            entry->record = PAL_SOCKET_RECORD(socket);
+            entry->interestMask = interestMask;
+            entry->next = socketPoller->entries;
+            socketPoller->entries = entry;
+            core_util_critical_section_enter();
+            entry->nextOfSocket = entry->record->pollerEntries;
+            entry->record->pollerEntries = entry;
+            wakeUp = palSocketPollerQueue(entry); // the socket may be ready already.
+            core_util_critical_section_exit();
+        }
+    }
+
+    pal_osMutexRelease(socketPoller->mutex);
+    if (wakeUp)
+    {
+        pal_osSemaphoreRelease(socketPoller->semaphore);
+    }
+    return result;
 }
-void palSelectCallback7()
+
+
+palStatus_t pal_plat_socketPollerModify(palSocketPollerID_t poller, palSocket_t socket, uint8_t interestMask)
 {
-    s_select_event_happened[7]++;
-    pal_osSemaphoreRelease(s_palSelectSemaphore);
+    palStatus_t result = PAL_SUCCESS;
+    palSocketPoller_t* socketPoller = (palSocketPoller_t*)poller;
+    palSocketPollerEntry_t* entry = NULL;
+    bool wakeUp = false;
+
+    if (NULLPTR == poller)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    result = pal_osMutexWait(socketPoller->mutex, PAL_RTOS_WAIT_FOREVER);
+    if (PAL_SUCCESS != result)
+    {
+        return result;
+    }
+
+    entry = *palSocketPollerFind(socketPoller, socket);
+    if (NULL == entry)
+    {
+        result = PAL_ERR_INVALID_ARGUMENT;
+    }
+    else
+    {
+        core_util_critical_section_enter();
+        entry->interestMask = interestMask;
+        wakeUp = palSocketPollerQueue(entry);
+        core_util_critical_section_exit();
+    }
+
+    pal_osMutexRelease(socketPoller->mutex);
+    if (wakeUp)
+    {
+        pal_osSemaphoreRelease(socketPoller->semaphore);
+    }
+    return result;
+}
+
+
+palStatus_t pal_plat_socketPollerRemove(palSocketPollerID_t poller, palSocket_t socket)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palSocketPoller_t* socketPoller = (palSocketPoller_t*)poller;
+    palSocketPollerEntry_t** link = NULL;
+    palSocketPollerEntry_t* entry = NULL;
+
+    if (NULLPTR == poller)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    result = pal_osMutexWait(socketPoller->mutex, PAL_RTOS_WAIT_FOREVER);
+    if (PAL_SUCCESS != result)
+    {
+        return result;
+    }
+
+    link = palSocketPollerFind(socketPoller, socket);
+    entry = *link;
+    if (NULL == entry)
+    {
+        result = PAL_ERR_INVALID_ARGUMENT;
+    }
+    else
+    {
+        *link = entry->next;
+        palSocketPollerEntryFree(socketPoller, entry);
+    }
+
+    pal_osMutexRelease(socketPoller->mutex);
+    return result;
 }
 
-palSelectCallbackFunction_t s_palSelectPalCallbackFunctions[PAL_NET_SOCKET_SELECT_MAX_SOCKETS] = { palSelectCallback0, palSelectCallback1, palSelectCallback2, palSelectCallback3, palSelectCallback4, palSelectCallback5, palSelectCallback6, palSelectCallback7 };
 
+palStatus_t pal_plat_socketPollerWait(palSocketPollerID_t poller, palSocketPollEvent_t* events, uint32_t maxEvents, uint32_t timeout, uint32_t* numberOfEvents)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palSocketPoller_t* socketPoller = (palSocketPoller_t*)poller;
+    palSocketPollerEntry_t* entry = NULL;
+    palSocketPollerEntry_t* reportedHead = NULL;
+    palSocketPollerEntry_t* reportedTail = NULL;
+    uint8_t ready = 0;
+    uint32_t count = 0;
+    uint32_t startTick = 0;
+    uint32_t elapsed = 0;
+    int32_t semaphoreCount = 0;
+
+    if ((NULLPTR == poller) || (NULL == events) || (0 == maxEvents) || (NULL == numberOfEvents))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
 
-palStatus_t pal_plat_socketMiniSelect(const palSocket_t socketsToCheck[PAL_NET_SOCKET_SELECT_MAX_SOCKETS], uint32_t numberOfSockets, pal_timeVal_t* timeout,
+    *numberOfEvents = 0;
+    startTick = pal_osKernelSysTick();
+    while (true)
+    {
+        core_util_critical_section_enter();
+        while ((count < maxEvents) && (NULL != socketPoller->readyHead))
+        {
+            entry = socketPoller->readyHead;
+            socketPoller->readyHead = entry->nextReady;
+            if (NULL == socketPoller->readyHead)
+            {
+                socketPoller->readyTail = NULL;
+            }
+            entry->queued = false;
+            ready = entry->record->readyMask & (entry->interestMask | PAL_NET_SOCKET_SELECT_ERR_BIT);
+            if (0 == ready)
+            {
+                continue; // a call on the socket would block since it was queued.
+            }
+            events[count].socket = (palSocket_t)entry->record;
+            events[count].events = ready;
+            count++;
+            entry->queued = true;
+            entry->nextReady = NULL;
+            if (NULL == reportedTail)
+            {
+                reportedHead = entry;
+            }
+            else
+            {
+                reportedTail->nextReady = entry;
+            }
+            reportedTail = entry;
+        }
+        //! the reported entries are queued again behind the others, the first wait which finds their socket not ready drops them.
+        if (NULL != reportedHead)
+        {
+            if (NULL == socketPoller->readyTail)
+            {
+                socketPoller->readyHead = reportedHead;
+            }
+            else
+            {
+                socketPoller->readyTail->nextReady = reportedHead;
+            }
+            socketPoller->readyTail = reportedTail;
+        }
+        core_util_critical_section_exit();
+
+        if (0 != count)
+        {
+            break;
+        }
+
+        if (PAL_RTOS_WAIT_FOREVER != timeout)
+        {
+            elapsed = (uint32_t)pal_osKernelSysMilliSecTick(pal_osKernelSysTick() - startTick);
+            if (elapsed >= timeout)
+            {
+                break;
+            }
+        }
+        // the semaphore may hold releases of events already consumed by an earlier wait, so the ready list is checked again after each release.
+        result = pal_osSemaphoreWait(socketPoller->semaphore, (PAL_RTOS_WAIT_FOREVER == timeout) ? PAL_RTOS_WAIT_FOREVER : (timeout - elapsed), &semaphoreCount);
+        if (PAL_ERR_RTOS_TIMEOUT == result)
+        {
+            result = PAL_SUCCESS; // timeout is not actually an error in this case
+            break;
+        }
+        if (PAL_SUCCESS != result)
+        {
+            break;
+        }
+    }
+
+    *numberOfEvents = count;
+    return result;
+}
+
+
+//! pollers of finished mini selects, kept for the next ones so a blocking select does not create and delete the RTOS objects of a poller.
+static palSocketPoller_t* s_pal_freeSelectPollers = NULL;
+
+static palStatus_t palSelectPollerAlloc(palSocketPollerID_t* poller)
+{
+    palSocketPoller_t* socketPoller = NULL;
+
+    core_util_critical_section_enter();
+    socketPoller = s_pal_freeSelectPollers;
+    if (NULL != socketPoller)
+    {
+        s_pal_freeSelectPollers = socketPoller->nextFree;
+    }
+    core_util_critical_section_exit();
+
+    if (NULL == socketPoller)
+    {
+        return pal_plat_socketPollerCreate(poller);
+    }
+    *poller = (palSocketPollerID_t)socketPoller;
+    return PAL_SUCCESS;
+}
+
+//! remove the sockets of a mini select from its poller and keep the poller for the next select, its semaphore may keep releases which its next wait ignores.
+static void palSelectPollerFree(palSocketPollerID_t poller)
+{
+    palSocketPoller_t* socketPoller = (palSocketPoller_t*)poller;
+    palSocketPollerEntry_t* entry = NULL;
+
+    while (NULL != socketPoller->entries)
+    {
+        entry = socketPoller->entries;
+        socketPoller->entries = entry->next;
+        palSocketPollerEntryFree(socketPoller, entry);
+    }
+
+    core_util_critical_section_enter();
+    socketPoller->nextFree = s_pal_freeSelectPollers;
+    s_pal_freeSelectPollers = socketPoller;
+    core_util_critical_section_exit();
+}
+
+//! the readiness of the sockets is checked first, the sockets are added to a poller only to wait for an event.
+palStatus_t pal_plat_socketMiniSelect(const palSocket_t socketsToCheck[PAL_NET_SOCKET_SELECT_MAX_SOCKETS], uint32_t numberOfSockets, uint32_t timeout, uint8_t interestMask,
     uint8_t palSocketStatus[PAL_NET_SOCKET_SELECT_MAX_SOCKETS], uint32_t * numberOfSocketsSet)
 {
-        uint32_t index = 0;
-        int32_t counter = 0;
-        uint32_t timeoutInMiliseconds = 0;
-        palStatus_t result = PAL_SUCCESS;
-
-        if ((NULL == socketsToCheck) || (NULL == numberOfSocketsSet) || (NULL == timeout))
-         {
-             return PAL_ERR_INVALID_ARGUMENT;
-         }
-          
-         timeoutInMiliseconds = (timeout->pal_tv_sec * 1000) + (timeout->pal_tv_usec /1000);
-         *numberOfSocketsSet = 0;
-
-         if (0 == numberOfSockets)
-         {
-             return PAL_SUCCESS;
-         }
-         // create semaphore if not initialized before - if it exists ensure count is 0.
-        
-         if (false == s_palSelectSemaphoreInited)
-         {
-             result = pal_osSemaphoreCreate(0, &s_palSelectSemaphore); // create semaphore to wait until socket event happens (semaphore will be re-used and is only created once, and never freed - if terminate is added free this resoruce if allocaed)
-             if (PAL_SUCCESS != result)
-             {
-                 return result; //single exit ??
-             }
-             s_palSelectSemaphoreInited = true;
-         }
-         else {
-             int32_t counters = 0;
-             result = pal_osSemaphoreWait(s_palSelectSemaphore, 1, &counters); // deplete semaphore count until it is 0.
-             while (result != PAL_ERR_RTOS_TIMEOUT)
-             {
-                 result = pal_osSemaphoreWait(s_palSelectSemaphore, 1, &counters);
-             }
-             if (PAL_ERR_RTOS_TIMEOUT != result ) // make sure count is actually 0
-             {
-                 return result; //single exit ??
-             }
-             
-         }
-         for (uint32_t index = 0; index < numberOfSockets; index++)
-         {
-             s_select_event_happened[index] = 0; 
-             palSocketStatus[index] = 0;
-         }
-         
-         for (index = 0; index < numberOfSockets; index++)
-         {
-             Socket* socketObj = (Socket*)socketsToCheck[index];
-             socketObj->attach(s_palSelectPalCallbackFunctions[index]);
-         }
-
-         result = pal_osSemaphoreWait(s_palSelectSemaphore, timeoutInMiliseconds, &counter);
-         if (result == PAL_SUCCESS)
-         {
-             for (index = 0; index < numberOfSockets; index++)
-             {
-                 if (s_select_event_happened[index] > 0)
-                 {
-                     palSocketStatus[index] |= PAL_NET_SOCKET_SELECT_RX_BIT | PAL_NET_SOCKET_SELECT_TX_BIT | PAL_NET_SOCKET_SELECT_ERR_BIT;
-                     *numberOfSocketsSet = *numberOfSocketsSet +1;
-                 }
-             }
-         }
-         if (result == PAL_ERR_RTOS_TIMEOUT) // to socket callback has been called to free the semaphore -> no socket events happenet untill the timout.
-         {
-             *numberOfSocketsSet = 0; // TODO: add debug prints
-             result = PAL_SUCCESS; // timeout is not actually an error in this case
-         }
-
-         for (index = 0; index < numberOfSockets; index++)
-         {
-             
-             Socket* socketObj = (Socket*)socketsToCheck[index];
-             socketObj->attach(NULL_FUNCTION);
-         }
-         return result ;
+    palStatus_t result = PAL_SUCCESS;
+    palSocketPollerID_t poller = NULLPTR;
+    palSocketPollEvent_t events[PAL_NET_SOCKET_SELECT_MAX_SOCKETS];
+    uint32_t numberOfEvents = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+
+    if ((NULL == socketsToCheck) || (NULL == palSocketStatus) || (NULL == numberOfSocketsSet) || (PAL_NET_SOCKET_SELECT_MAX_SOCKETS < numberOfSockets))
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    *numberOfSocketsSet = 0;
+    for (i = 0; i < numberOfSockets; ++i)
+    {
+        palSocketStatus[i] = palSocketRecordReady(PAL_SOCKET_RECORD(socketsToCheck[i]), interestMask);
+        if (0 != palSocketStatus[i])
+        {
+            ++(*numberOfSocketsSet);
+        }
+    }
+    if ((0 != *numberOfSocketsSet) || (0 == numberOfSockets) || (0 == timeout))
+    {
+        return PAL_SUCCESS;
+    }
+
+    result = palSelectPollerAlloc(&poller);
+    if (PAL_SUCCESS != result)
+    {
+        return result;
+    }
+
+    // the same socket may be passed more than once, it is added to the poller once and its events are copied to all of its indexes.
+    for (i = 0; (i < numberOfSockets) && (PAL_SUCCESS == result); ++i)
+    {
+        for (j = 0; (j < i) && (socketsToCheck[j] != socketsToCheck[i]); ++j);
+        if (j == i)
+        {
+            result = pal_plat_socketPollerAdd(poller, socketsToCheck[i], interestMask);
+        }
+    }
+
+    if (PAL_SUCCESS == result)
+    {
+        result = pal_plat_socketPollerWait(poller, events, PAL_NET_SOCKET_SELECT_MAX_SOCKETS, timeout, &numberOfEvents);
+    }
+
+    if (PAL_SUCCESS == result)
+    {
+        for (i = 0; i < numberOfSockets; ++i)
+        {
+            for (j = 0; j < numberOfEvents; ++j)
+            {
+                if (events[j].socket == socketsToCheck[i])
+                {
+                    palSocketStatus[i] = events[j].events;
+                    ++(*numberOfSocketsSet);
+                    break;
+                }
+            }
+        }
+    }
+
+    palSelectPollerFree(poller);
+    return result;
 }
 
 #if PAL_NET_TCP_AND_TLS_SUPPORT // functionality below supported only in case TCP is supported.
@@ -623,7 +1418,7 @@ palStatus_t pal_plat_listen(palSocket_t socket, int backlog)
 {
     int result = PAL_SUCCESS;
 
-    TCPServer* socketObj = (TCPServer*)socket;
+    TCPServer* socketObj = (TCPServer*)PAL_SOCKET_RECORD(socket)->socketObj;
 
 
     result = socketObj->listen(backlog);
@@ -640,9 +1435,13 @@ palStatus_t pal_plat_accept(palSocket_t socket, palSocketAddress_t * address, pa
     int result = PAL_SUCCESS;
     
     SocketAddress incomingAddr;
+    palSocketRecord_t* record = PAL_SOCKET_RECORD(socket);
+    TCPServer* socketObj = (TCPServer*)record->socketObj;
+    uint32_t events = 0;
 
-    TCPServer* socketObj = (TCPServer*)socket;
-    result = socketObj->accept((TCPSocket*)(*acceptedSocket), &incomingAddr);
+    events = palSocketRecordEvents(record);
+    result = socketObj->accept((TCPSocket*)PAL_SOCKET_RECORD(*acceptedSocket)->socketObj, &incomingAddr);
+    palSocketRecordUpdate(record, events, PAL_NET_SOCKET_SELECT_RX_BIT, (NSAPI_ERROR_WOULD_BLOCK == result), ((result < 0) && (NSAPI_ERROR_WOULD_BLOCK != result)));
     if (result < 0)
     {
         result = translateErrorToPALError(result);
@@ -659,7 +1458,7 @@ palStatus_t pal_plat_connect(palSocket_t socket, const palSocketAddress_t* addre
 {
     int result = PAL_SUCCESS;
     SocketAddress internalAddr;
-    TCPSocket* socketObj = (TCPSocket*)socket;
+    TCPSocket* socketObj = (TCPSocket*)PAL_SOCKET_RECORD(socket)->socketObj;
     
     result = palSockAddrToSocketAddress(address, addressLen,  internalAddr);
     if (result == PAL_SUCCESS)
@@ -678,11 +1477,13 @@ palStatus_t pal_plat_recv(palSocket_t socket, void *buf, size_t len, size_t* rec
 {
     int result = PAL_SUCCESS;
     int status = 0;
+    palSocketRecord_t* record = PAL_SOCKET_RECORD(socket);
+    TCPSocket* socketObj = (TCPSocket*)record->socketObj;
+    uint32_t events = 0;
 
-    TCPSocket* socketObj = (TCPSocket*)socket;
-
-
+    events = palSocketRecordEvents(record);
     status = socketObj->recv(buf, len);
+    palSocketRecordUpdate(record, events, PAL_NET_SOCKET_SELECT_RX_BIT, (NSAPI_ERROR_WOULD_BLOCK == status), ((status < 0) && (NSAPI_ERROR_WOULD_BLOCK != status)));
     if (status < 0)
     {
         result = translateErrorToPALError(status);
@@ -698,10 +1499,14 @@ palStatus_t pal_plat_send(palSocket_t socket, const void *buf, size_t len, size_
 {
     palStatus_t result = PAL_SUCCESS;
     int status = 0;
+    palSocketRecord_t* record = PAL_SOCKET_RECORD(socket);
+    TCPSocket* socketObj = (TCPSocket*)record->socketObj;
+    uint32_t events = 0;
 
-    TCPSocket* socketObj = (TCPSocket*)socket;
-    
+    events = palSocketRecordEvents(record);
     status = socketObj->send(buf, len);
+    palSocketRecordUpdate(record, events, PAL_NET_SOCKET_SELECT_TX_BIT, ((NSAPI_ERROR_WOULD_BLOCK == status) || ((0 <= status) && ((size_t)status < len))),
+                          ((status < 0) && (NSAPI_ERROR_WOULD_BLOCK != status)));
     if (status < 0)
     {
         result = translateErrorToPALError(status);
@@ -713,6 +1518,73 @@ palStatus_t pal_plat_send(palSocket_t socket, const void *buf, size_t len, size_
     return result;
 }
 
+palStatus_t pal_plat_sendv(palSocket_t socket, const palConstBuffer_t* segments, uint32_t segmentCount, size_t* sentDataSize)
+{
+    palStatus_t result = PAL_SUCCESS;
+    uint8_t buffer[PAL_SEGMENT_COALESCE_SIZE];
+    size_t length = palSegmentsLength(segments, segmentCount, false);
+    size_t sent = 0;
+    size_t total = 0;
+    uint32_t index = 0;
+
+    if (1 == segmentCount)
+    {
+        return pal_plat_send(socket, segments[0].buffer, segments[0].bufferLength, sentDataSize);
+    }
+
+    //! small segments are coalesced to save stack calls and TCP segments, large ones are sent as they are.
+    if (PAL_SEGMENT_COALESCE_SIZE >= length)
+    {
+        palGatherSegments(segments, segmentCount, buffer);
+        return pal_plat_send(socket, buffer, length, sentDataSize);
+    }
+
+    for (index = 0; index < segmentCount; ++index)
+    {
+        if (0 == segments[index].bufferLength)
+        {
+            continue;
+        }
+        result = pal_plat_send(socket, segments[index].buffer, segments[index].bufferLength, &sent);
+        if (PAL_SUCCESS != result)
+        {
+            break;
+        }
+        total += sent;
+        if (sent < segments[index].bufferLength)
+        {
+            break; // the socket is full, the caller sends the rest like after any partial send.
+        }
+    }
+
+    *sentDataSize = total;
+    return (0 < total) ? PAL_SUCCESS : result;
+}
+
+palStatus_t pal_plat_recvv(palSocket_t socket, palBuffer_t* segments, uint32_t segmentCount, size_t* recievedDataSize)
+{
+    palStatus_t result = PAL_SUCCESS;
+    uint8_t buffer[PAL_SEGMENT_COALESCE_SIZE];
+    size_t length = palSegmentsLength((const palConstBuffer_t*)segments, segmentCount, true);
+
+    if (1 == segmentCount)
+    {
+        return pal_plat_recv(socket, segments[0].buffer, segments[0].maxBufferLength, recievedDataSize);
+    }
+
+    //! a stream may return less than asked, so at most the stack buffer is received and the caller receives again for the rest.
+    if (PAL_SEGMENT_COALESCE_SIZE < length)
+    {
+        length = PAL_SEGMENT_COALESCE_SIZE;
+    }
+    result = pal_plat_recv(socket, buffer, length, recievedDataSize);
+    if (PAL_SUCCESS == result)
+    {
+        palScatterSegments(segments, segmentCount, buffer, *recievedDataSize);
+    }
+    return result;
+}
+
 #endif //PAL_NET_TCP_AND_TLS_SUPPORT
 
 
@@ -721,18 +1593,153 @@ palStatus_t pal_plat_send(palSocket_t socket, const void *buf, size_t len, size_
 
 palStatus_t pal_plat_asynchronousSocket(palSocketDomain_t domain, palSocketType_t type, bool nonBlockingSocket, uint32_t interfaceNum, palAsyncSocketCallback_t callback, palSocket_t* socket)
 {
-    Socket* socketObj = NULL;
     palStatus_t result = pal_plat_socket(domain,  type,  nonBlockingSocket,  interfaceNum, socket);
     if (result == PAL_SUCCESS)
     {
-        socketObj = (Socket*)*socket;
-        socketObj->attach(callback); 
+        PAL_SOCKET_RECORD(*socket)->asyncCallback = callback;
     }
 
     return result;
 
 }
 
+/*! A deferred socket keeps its events in its record until a thread of the application takes the event posted for them from the queue,
+* so a socket has at most one event in the queue. The posted event calls palAsyncSocketDeferred, which tells the callback of the socket
+* the events pending at that time. A record is put in the overflow list before its event is posted, and each event taken from a deferral
+* queue posts the events of the records in the list again: if the queue was full one of the events in it is taken after the record
+* was listed, so the events which find a queue full are posted as soon as it has room.
+*/
+static palSocketRecord_t* s_pal_asyncOverflow = NULL;
+
+static void palAsyncSocketDeferred(palSocket_t socket, uint8_t events, void* context);
+
+//! post an event for the pending events of a deferred socket, unless one is in the queue already.
+static void palAsyncSocketPost(palSocketRecord_t* record)
+{
+    palAsyncSocketEvent_t socketEvent;
+    palMessageQID_t queue = NULLPTR;
+    bool post = false;
+
+    core_util_critical_section_enter();
+    post = record->open && !record->posted && (0 != record->pendingEvents) && (NULLPTR != record->deferralQueue);
+    if (post)
+    {
+        record->posted = true;
+        if (!record->overflowed)
+        {
+            record->overflowed = true;
+            record->nextOverflow = s_pal_asyncOverflow;
+            s_pal_asyncOverflow = record;
+        }
+        queue = record->deferralQueue;
+        socketEvent.socket = (palSocket_t)record;
+        socketEvent.callback = palAsyncSocketDeferred;
+        socketEvent.context = record->context;
+        socketEvent.events = record->pendingEvents;
+    }
+    core_util_critical_section_exit();
+
+    if (post && (PAL_SUCCESS != pal_osMessagePutTyped(queue, &socketEvent, 0))) // the callback context may not wait.
+    {
+        core_util_critical_section_enter();
+        record->posted = false;
+        core_util_critical_section_exit();
+    }
+}
+
+//! post the events of the records in the overflow list, the records whose event finds the queue full again are listed again.
+static void palAsyncSocketPostOverflow(void)
+{
+    palSocketRecord_t* records = NULL;
+    palSocketRecord_t* record = NULL;
+
+    core_util_critical_section_enter();
+    records = s_pal_asyncOverflow;
+    s_pal_asyncOverflow = NULL;
+    core_util_critical_section_exit();
+
+    while (NULL != records)
+    {
+        record = records;
+        core_util_critical_section_enter();
+        records = record->nextOverflow;
+        record->overflowed = false;
+        core_util_critical_section_exit();
+        palAsyncSocketPost(record);
+    }
+}
+
+//! called by a thread of the application for an event it took from a deferral queue.
+static void palAsyncSocketDeferred(palSocket_t socket, uint8_t events, void* context)
+{
+    palSocketRecord_t* record = PAL_SOCKET_RECORD(socket);
+    palAsyncSocketContextCallback_t callback = NULL;
+
+    //! the record may have been closed (and reused) since the event was posted, the events pending now are the ones to tell.
+    core_util_critical_section_enter();
+    record->posted = false;
+    events = 0;
+    if (record->open)
+    {
+        events = record->pendingEvents;
+        record->pendingEvents = 0;
+        callback = record->contextCallback;
+        context = record->context;
+    }
+    core_util_critical_section_exit();
+
+    palAsyncSocketPostOverflow(); // the event just taken made room in its queue.
+    if ((NULL != callback) && (0 != events))
+    {
+        callback(socket, events, context);
+    }
+}
+
+//! called by the sigio callback of every socket, with the events the socket is ready for.
+static void palAsyncSocketNotify(palSocketRecord_t* record, uint8_t events)
+{
+    if (NULL != record->asyncCallback)
+    {
+        record->asyncCallback();
+    }
+    if (NULL == record->contextCallback)
+    {
+        return;
+    }
+
+    if (NULLPTR == record->deferralQueue)
+    {
+        record->contextCallback((palSocket_t)record, events, record->context);
+        return;
+    }
+
+    core_util_critical_section_enter();
+    record->pendingEvents |= events;
+    core_util_critical_section_exit();
+    palAsyncSocketPost(record);
+}
+
+palStatus_t pal_plat_asynchronousSocketWithContext(palSocketDomain_t domain, palSocketType_t type, bool nonBlockingSocket, uint32_t interfaceNum, palAsyncSocketContextCallback_t callback, void* context,
+                                                   palMessageQID_t deferralQueue, palSocket_t* socket)
+{
+    palSocketRecord_t* record = NULL;
+    palStatus_t result = PAL_SUCCESS;
+
+    result = pal_plat_socket(domain, type, nonBlockingSocket, interfaceNum, socket);
+    if (PAL_SUCCESS != result)
+    {
+        return result;
+    }
+
+    record = PAL_SOCKET_RECORD(*socket);
+    core_util_critical_section_enter();
+    record->context = context;
+    record->deferralQueue = deferralQueue;
+    record->contextCallback = callback;
+    core_util_critical_section_exit();
+    return PAL_SUCCESS;
+}
+
 #endif
 
 #if PAL_NET_DNS_SUPPORT
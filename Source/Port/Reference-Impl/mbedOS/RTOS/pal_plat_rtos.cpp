@@ -19,10 +19,12 @@
 #include "pal_plat_rtos.h"
 #include "pal_errors.h"
 #include "stdlib.h"
+#include "stddef.h"
 #include "string.h"
 
 #include "mbed.h"
 #include "cmsis_os2.h" // Revision:    V2.1
+#include "rtx_os.h"
 
 
 #define PAL_RTOS_TRANSLATE_CMSIS_ERROR_CODE(cmsisCode)\
@@ -55,10 +57,22 @@ typedef struct palThread{
     palThreadFuncWrapper_t     threadFuncWrapper;
     osThreadAttr_t             osThread;
     mbed_rtos_storage_thread_t osThreadStorage;
+    uint32_t                   nextFree;    //! the next free slot while the slot is in the free list.
+    uint32_t                   mutexWaits;  //! the waits for a PAL mutex which blocked, only the thread itself adds to them.
+    uint32_t                   mutexWaitTicks;
 } palThread_t;
 
+#define PAL_THREADS_REGISTRY_CHUNKS ((PAL_MAX_NUMBER_OF_THREADS + PAL_THREADS_REGISTRY_GROWTH - 1) / PAL_THREADS_REGISTRY_GROWTH)
+#define PAL_THREADS_NO_FREE_SLOT PAL_MAX_NUMBER_OF_THREADS
 
-palThread_t g_palThreads[PAL_MAX_NUMBER_OF_THREADS] = {0};
+//! The thread registry grows by chunks of PAL_THREADS_REGISTRY_GROWTH slots up to PAL_MAX_NUMBER_OF_THREADS.
+//! A chunk never moves once allocated, so the control blocks RTX keeps in it stay in place.
+static palThread_t* s_palThreadChunks[PAL_THREADS_REGISTRY_CHUNKS] = {NULL};
+static uint32_t s_palThreadsCapacity = 0;
+//! The free slots are a stack linked through nextFree, so a slot is found without searching the registry.
+static uint32_t s_palThreadsFree = PAL_THREADS_NO_FREE_SLOT;
+
+#define PAL_THREAD_SLOT(index) (&s_palThreadChunks[(index) / PAL_THREADS_REGISTRY_GROWTH][(index) % PAL_THREADS_REGISTRY_GROWTH])
 
 //! Timer structure
 typedef struct palTimer{
@@ -72,6 +86,7 @@ typedef struct palMutex{
     palMutexID_t              mutexID;
     osMutexAttr_t             osMutex;
     mbed_rtos_storage_mutex_t osMutexStorage;
+    uint32_t                  depth;      //! the times the holder took the mutex, only the holder changes it.
 }palMutex_t;
 
 //! Semaphore structure
@@ -81,14 +96,6 @@ typedef struct palSemaphore{
     mbed_rtos_storage_semaphore_t osSemaphoreStorage;
 }palSemaphore_t;
 
-//! Memoey Pool structure
-typedef struct palMemPool{
-    palMemoryPoolID_t            memoryPoolID;
-    osMemoryPoolAttr_t           osPool;
-    mbed_rtos_storage_mem_pool_t osPoolStorage;
-    uint32_t                     blockSize;
-}palMemoryPool_t;
-
 //! Message Queue structure
 typedef struct palMessageQ{
     palMessageQID_t               messageQID;
@@ -97,72 +104,23 @@ typedef struct palMessageQ{
 }palMessageQ_t;
 
 
+//! PAL priorities map one to one to the CMSIS-RTOS2 levels from osPriorityLow to osPriorityRealtime (which have the same
+//! PAL_THREAD_PRIORITY_LEVELS sub levels), there is no CMSIS level between osPriorityIdle and osPriorityLow.
 inline PAL_PRIVATE int mapThreadPriorityToPlatSpecific(palThreadPriority_t priority)
 {
     int adjustedPriority = -1;
 
-    switch (priority)
-    {
-        case PAL_osPriorityIdle:
-            adjustedPriority = 1;
-            break;
-        case PAL_osPriorityLow:
-            adjustedPriority = 8;        
-            break;
-        case PAL_osPriorityBelowNormal:
-            adjustedPriority = 16;        
-            break;
-        case PAL_osPriorityNormal:
-            adjustedPriority = 24;        
-            break;
-        case PAL_osPriorityAboveNormal:
-            adjustedPriority = 32;        
-            break;
-        case PAL_osPriorityHigh:
-            adjustedPriority = 40;        
-            break;
-        case PAL_osPriorityRealtime:
-            adjustedPriority = 48;        
-            break;
-        case PAL_osPriorityError:
-            adjustedPriority = -1;        
-            break;
+    if (PAL_osPriorityIdle == priority)
+    {
+        adjustedPriority = osPriorityIdle;
     }
-
-    return adjustedPriority;
-}
-
-
-inline PAL_PRIVATE palThreadPriority_t mapThreadPriorityToPalGeneric(int priority)
-{
-    palThreadPriority_t adjustedPriority = PAL_osPriorityError;
-
-    switch (priority)
-    {
-        case 1:
-            adjustedPriority = PAL_osPriorityIdle;
-            break;
-        case 8:
-            adjustedPriority = PAL_osPriorityLow;        
-            break;
-        case 16:
-            adjustedPriority = PAL_osPriorityBelowNormal;        
-            break;
-        case 24:
-            adjustedPriority = PAL_osPriorityNormal;        
-            break;
-        case 32:
-            adjustedPriority = PAL_osPriorityAboveNormal;        
-            break;
-        case 40:
-            adjustedPriority = PAL_osPriorityHigh;        
-            break;
-        case 48:
-            adjustedPriority = PAL_osPriorityRealtime;        
-            break;
-        case -1:
-            adjustedPriority = PAL_osPriorityError;        
-            break;
+    else if ((priority > PAL_osPriorityIdle) && (priority < PAL_osPriorityLow))
+    {
+        adjustedPriority = osPriorityLow;
+    }
+    else if ((priority >= PAL_osPriorityLow) && (priority <= PAL_osPriorityRealtime))
+    {
+        adjustedPriority = osPriorityNormal + (priority - PAL_osPriorityNormal);
     }
 
     return adjustedPriority;
@@ -171,10 +129,6 @@ inline PAL_PRIVATE palThreadPriority_t mapThreadPriorityToPalGeneric(int priorit
 
 inline PAL_PRIVATE void setDefaultThreadValues(palThread_t* thread)
 {
-#if PAL_UNIQUE_THREAD_PRIORITY
-    palThreadPriority_t threadGenericPriority = mapThreadPriorityToPalGeneric(thread->osThread.priority);      
-    g_palThreadPriorities[threadGenericPriority+PRIORITY_INDEX_OFFSET] = false;
-#endif //PAL_UNIQUE_THREAD_PRIORITY     
     thread->threadStore = NULL;
     thread->threadFuncWrapper.realThreadArgs = NULL;
     thread->threadFuncWrapper.realThreadFunc = NULL;
@@ -185,12 +139,11 @@ inline PAL_PRIVATE void setDefaultThreadValues(palThread_t* thread)
     thread->osThread.cb_mem = NULL;
     thread->osThread.cb_size = 0;
     thread->osThread.stack_size = 0;
-    if (thread->osThread.stack_mem != NULL)
-    {
-        free(thread->osThread.stack_mem);
-    }
+    thread->osThread.stack_mem = NULL; //! the stack belongs to the creator of the thread.
 	thread->osThread.priority = (osPriority_t)mapThreadPriorityToPlatSpecific(PAL_osPriorityError);
     thread->osThread.tz_module = 0;
+    thread->mutexWaits = 0;
+    thread->mutexWaitTicks = 0;
 
     thread->threadID = NULLPTR;
     //! This line should be last thing to be done in this function.
@@ -199,20 +152,72 @@ inline PAL_PRIVATE void setDefaultThreadValues(palThread_t* thread)
     thread->initialized = false;
 }
 
-/*! Clean thread data from the global thread data base (g_palThreads). Thread Safe API
+/*! Clean thread data from the thread registry and return its slot to the free slots. Thread Safe API
 *
-* @param[in] dbPointer: data base pointer.
-* @param[in] index: the index in the data base to be cleaned.
+* @param[in] index: the index in the registry to be cleaned.
 */
-static void threadCleanUp(void* dbPointer, uint32_t index)
+static void threadCleanUp(uint32_t index)
 {
-    palThread_t* threadsDB = (palThread_t*)dbPointer;
+    palThread_t* thread = NULL;
 
-    if (NULL == dbPointer || index >= PAL_MAX_NUMBER_OF_THREADS)
+    if (index >= s_palThreadsCapacity)
     {
         return;
     }
-    setDefaultThreadValues(&threadsDB[index]);
+    thread = PAL_THREAD_SLOT(index);
+    setDefaultThreadValues(thread);
+    core_util_critical_section_enter();
+    thread->nextFree = s_palThreadsFree;
+    s_palThreadsFree = index;
+    core_util_critical_section_exit();
+}
+
+/*! Take a free slot of the thread registry, the registry grows by a chunk when no slot is free. Thread Safe API
+*
+* \return the index of the slot, PAL_THREADS_NO_FREE_SLOT when the registry is full or out of memory.
+*/
+static uint32_t threadSlotAlloc(void)
+{
+    palThread_t* chunk = NULL;
+    uint32_t index = PAL_THREADS_NO_FREE_SLOT;
+    uint32_t first = 0;
+    uint32_t i = 0;
+
+    core_util_critical_section_enter();
+    if ((PAL_THREADS_NO_FREE_SLOT == s_palThreadsFree) && (s_palThreadsCapacity < PAL_MAX_NUMBER_OF_THREADS))
+    {
+        //! the chunk is allocated outside the critical section, and dropped if another thread grew the registry meanwhile.
+        core_util_critical_section_exit();
+        chunk = (palThread_t*)calloc(PAL_THREADS_REGISTRY_GROWTH, sizeof(palThread_t));
+        core_util_critical_section_enter();
+        if ((NULL != chunk) && (PAL_THREADS_NO_FREE_SLOT == s_palThreadsFree) && (s_palThreadsCapacity < PAL_MAX_NUMBER_OF_THREADS))
+        {
+            first = s_palThreadsCapacity;
+            s_palThreadChunks[first / PAL_THREADS_REGISTRY_GROWTH] = chunk;
+            chunk = NULL;
+            //! pushed from the last slot so the lowest indices are taken first.
+            for (i = PAL_THREADS_REGISTRY_GROWTH; i > 0; --i)
+            {
+                if ((first + i - 1) < PAL_MAX_NUMBER_OF_THREADS)
+                {
+                    PAL_THREAD_SLOT(first + i - 1)->nextFree = s_palThreadsFree;
+                    s_palThreadsFree = first + i - 1;
+                }
+            }
+            s_palThreadsCapacity = ((first + PAL_THREADS_REGISTRY_GROWTH) > PAL_MAX_NUMBER_OF_THREADS) ? PAL_MAX_NUMBER_OF_THREADS : (first + PAL_THREADS_REGISTRY_GROWTH);
+        }
+    }
+
+    if (PAL_THREADS_NO_FREE_SLOT != s_palThreadsFree)
+    {
+        index = s_palThreadsFree;
+        s_palThreadsFree = PAL_THREAD_SLOT(index)->nextFree;
+        PAL_THREAD_SLOT(index)->initialized = true;
+    }
+    core_util_critical_section_exit();
+
+    free(chunk);
+    return index;
 }
 
 
@@ -229,14 +234,27 @@ palStatus_t pal_plat_RTOSInitialize(void* opaqueContext)
     palStatus_t status = PAL_SUCCESS;
     int32_t platStatus = 0;
     size_t actualOutputLen = 0;
+    uint32_t i = 0;
     g_randInitiated = true;
 
-	 memset(g_palThreads,0,sizeof(palThread_t) * PAL_MAX_NUMBER_OF_THREADS);
+    //! the registry keeps the chunks it grew, all their slots become free.
+    core_util_critical_section_enter();
+    s_palThreadsFree = PAL_THREADS_NO_FREE_SLOT;
+    for (i = s_palThreadsCapacity; i > 0; --i)
+    {
+        memset(PAL_THREAD_SLOT(i - 1), 0, sizeof(palThread_t));
+        PAL_THREAD_SLOT(i - 1)->nextFree = s_palThreadsFree;
+        s_palThreadsFree = i - 1;
+    }
+    core_util_critical_section_exit();
 
     //Add implicit the running task as PAL main
-    g_palThreads[0].initialized = true;
-    g_palThreads[0].threadID = (palThreadID_t)osThreadGetId();
-    g_palThreads[0].osThread.stack_mem = NULL;
+    if (0 != threadSlotAlloc())
+    {
+        return PAL_ERR_CREATION_FAILED;
+    }
+    PAL_THREAD_SLOT(0)->threadID = (palThreadID_t)osThreadGetId();
+    PAL_THREAD_SLOT(0)->osThread.stack_mem = NULL;
 
     return status;
 }
@@ -294,65 +312,41 @@ uint64_t pal_plat_osKernelSysMilliSecTick(uint64_t sysTicks)
 palStatus_t pal_plat_osThreadCreate(palThreadFuncPtr function, void* funcArgument, palThreadPriority_t priority, uint32_t stackSize, uint32_t* stackPtr, palThreadLocalStore_t* store, palThreadID_t* threadID)
 {
     palStatus_t status = PAL_SUCCESS;
-    uint32_t firstAvailableThreadIndex = PAL_MAX_NUMBER_OF_THREADS;
-    uint32_t i;
-    uint32_t *stackAllocPtr = NULL;
+    uint32_t firstAvailableThreadIndex = PAL_THREADS_NO_FREE_SLOT;
+    palThread_t* thread = NULL;
     osThreadId_t osThreadID = NULL;
 
-    if (NULL == threadID || NULL == function || 0 == stackSize || priority > PAL_osPriorityRealtime)
+    if (NULL == threadID || NULL == function || 0 == stackSize || NULL == stackPtr || priority < PAL_osPriorityIdle || priority > PAL_osPriorityRealtime)
     {
         return PAL_ERR_INVALID_ARGUMENT;
     }
 
-    for (i = 0; i < PAL_MAX_NUMBER_OF_THREADS; ++i)
-    {
-    	if (!g_palThreads[i].initialized)
-        {
-    		g_palThreads[i].initialized = true;
-            firstAvailableThreadIndex = i;
-            break;
-        }
-    }
-
-    if (firstAvailableThreadIndex >= PAL_MAX_NUMBER_OF_THREADS)
+    firstAvailableThreadIndex = threadSlotAlloc();
+    if (PAL_THREADS_NO_FREE_SLOT == firstAvailableThreadIndex)
     {
         status = PAL_ERR_RTOS_RESOURCE;
     }
 
     if (PAL_SUCCESS == status)
     {
-        stackAllocPtr =  (uint32_t*)malloc(stackSize);
-
-        if(NULL == stackAllocPtr)
-        {
-            status = PAL_ERR_RTOS_RESOURCE;
-        }
-    }
-
-    if (PAL_SUCCESS == status)
-    {
-        g_palThreads[firstAvailableThreadIndex].threadStore = store;
-        g_palThreads[firstAvailableThreadIndex].threadFuncWrapper.realThreadArgs = funcArgument;
-        g_palThreads[firstAvailableThreadIndex].threadFuncWrapper.realThreadFunc = function;
-        g_palThreads[firstAvailableThreadIndex].threadFuncWrapper.threadIndex = firstAvailableThreadIndex;
-        g_palThreads[firstAvailableThreadIndex].osThread.priority = (osPriority_t)mapThreadPriorityToPlatSpecific(priority);
-        g_palThreads[firstAvailableThreadIndex].osThread.stack_size = stackSize;
-        g_palThreads[firstAvailableThreadIndex].osThread.stack_mem = stackAllocPtr;
-        g_palThreads[firstAvailableThreadIndex].osThread.cb_mem = &(g_palThreads[firstAvailableThreadIndex].osThreadStorage);
-        g_palThreads[firstAvailableThreadIndex].osThread.cb_size = sizeof(g_palThreads[firstAvailableThreadIndex].osThreadStorage);
-        memset(&(g_palThreads[firstAvailableThreadIndex].osThreadStorage), 0, sizeof(g_palThreads[firstAvailableThreadIndex].osThreadStorage));
-
-#if PAL_UNIQUE_THREAD_PRIORITY      
-        g_palThreadPriorities[priority+PRIORITY_INDEX_OFFSET] = true;
-#endif //PAL_UNIQUE_THREAD_PRIORITY     
-
-
-        osThreadID = osThreadNew((osThreadFunc_t)function, funcArgument, &g_palThreads[firstAvailableThreadIndex].osThread);
-        g_palThreads[firstAvailableThreadIndex].threadID = (palThreadID_t)osThreadID;
+        thread = PAL_THREAD_SLOT(firstAvailableThreadIndex);
+        thread->threadStore = store;
+        thread->threadFuncWrapper.realThreadArgs = funcArgument;
+        thread->threadFuncWrapper.realThreadFunc = function;
+        thread->threadFuncWrapper.threadIndex = firstAvailableThreadIndex;
+        thread->osThread.priority = (osPriority_t)mapThreadPriorityToPlatSpecific(priority);
+        thread->osThread.stack_size = stackSize;
+        thread->osThread.stack_mem = stackPtr;
+        thread->osThread.cb_mem = &(thread->osThreadStorage);
+        thread->osThread.cb_size = sizeof(thread->osThreadStorage);
+        memset(&(thread->osThreadStorage), 0, sizeof(thread->osThreadStorage));
+
+        osThreadID = osThreadNew((osThreadFunc_t)function, funcArgument, &thread->osThread);
+        thread->threadID = (palThreadID_t)osThreadID;
         if(NULL == osThreadID)
         {
-            //! in case of error in the thread creation, reset the data of the given index in the threads array.
-            threadCleanUp(g_palThreads, firstAvailableThreadIndex);
+            //! in case of error in the thread creation, reset the data of the given index in the registry.
+            threadCleanUp(firstAvailableThreadIndex);
             status = PAL_ERR_GENERIC_FAILURE;
             *threadID = PAL_INVALID_THREAD;
         }
@@ -367,40 +361,65 @@ palStatus_t pal_plat_osThreadCreate(palThreadFuncPtr function, void* funcArgumen
 
 palThreadID_t pal_plat_osThreadGetId(void)
 {
-	int i = 0;
-	palThreadID_t osThreadID;
-	palThreadID_t ret = PAL_INVALID_THREAD;
-	osThreadID = (palThreadID_t)osThreadGetId();
+    palThreadID_t ret = PAL_INVALID_THREAD;
+    uintptr_t osThreadID = (uintptr_t)osThreadGetId();
+    uintptr_t chunkStart = 0;
+    uintptr_t offset = 0;
+    uint32_t chunk = 0;
 
-	for(i= 0; i < PAL_MAX_NUMBER_OF_THREADS; i++)
-	{
-		if(osThreadID == g_palThreads[i].threadID)
-		{
-			ret = i;
-			break;
-		}
-	}
+    if (core_util_is_isr_active())
+    {
+        return PAL_INVALID_THREAD; //! an interrupt is not a PAL thread, even though the thread it interrupted is still the running thread.
+    }
+
+    //! RTX uses the control block memory given in osThread.cb_mem as the thread id, so the index of a thread created by PAL
+    //! is the position of its control block in its registry chunk, only the few chunks are searched.
+    for (chunk = 0; (PAL_INVALID_THREAD == ret) && (chunk < (s_palThreadsCapacity + PAL_THREADS_REGISTRY_GROWTH - 1) / PAL_THREADS_REGISTRY_GROWTH); ++chunk)
+    {
+        chunkStart = (uintptr_t)s_palThreadChunks[chunk] + offsetof(palThread_t, osThreadStorage);
+        offset = osThreadID - chunkStart;
+        if ((osThreadID >= chunkStart) && (0 == (offset % sizeof(palThread_t))) && ((offset / sizeof(palThread_t)) < PAL_THREADS_REGISTRY_GROWTH))
+        {
+            ret = (chunk * PAL_THREADS_REGISTRY_GROWTH) + (offset / sizeof(palThread_t));
+        }
+    }
+    if ((PAL_INVALID_THREAD == ret) && (0 < s_palThreadsCapacity) && ((palThreadID_t)osThreadID == PAL_THREAD_SLOT(0)->threadID))
+    {
+        ret = 0; //! the implicit PAL main thread was not created by PAL and has its control block elsewhere.
+    }
+
+    if ((PAL_INVALID_THREAD != ret) && ((ret >= s_palThreadsCapacity) || !PAL_THREAD_SLOT(ret)->initialized))
+    {
+        ret = PAL_INVALID_THREAD;
+    }
     return ret;
 }
 
+uintptr_t pal_plat_osThreadSelf(void)
+{
+    return (uintptr_t)osThreadGetId();
+}
+
 palStatus_t pal_plat_osThreadTerminate(palThreadID_t* threadID)
 {
     palStatus_t status = PAL_ERR_INVALID_ARGUMENT;
     osStatus_t platStatus = osOK;
+    palThread_t* thread = NULL;
 
-    if (*threadID >= PAL_MAX_NUMBER_OF_THREADS)
+    if (*threadID >= s_palThreadsCapacity)
     {
         return status;
     }
 
-    if ((palThreadID_t)osThreadGetId() != g_palThreads[*threadID].threadID)
+    thread = PAL_THREAD_SLOT(*threadID);
+    if ((palThreadID_t)osThreadGetId() != thread->threadID)
     {//Kill only if not trying to kill from running task
-    	if (g_palThreads[*threadID].initialized)
+    	if (thread->initialized)
     	{
-    		platStatus = osThreadTerminate((osThreadId_t)(g_palThreads[*threadID].threadID));
+    		platStatus = osThreadTerminate((osThreadId_t)(thread->threadID));
             if (platStatus != osErrorISR) // osErrorISR: osThreadTerminate cannot be called from interrupt service routines.
     		{
-                threadCleanUp(g_palThreads, *threadID);
+                threadCleanUp(*threadID);
             }
             else 
             {
@@ -421,15 +440,64 @@ palStatus_t pal_plat_osThreadTerminate(palThreadID_t* threadID)
 palThreadLocalStore_t* pal_plat_osThreadGetLocalStore(void)
 {
 	palThreadLocalStore_t* localStore = NULL;
-	palThreadID_t id = (uintptr_t)pal_osThreadGetId();
+	palThreadID_t id = pal_plat_osThreadGetId();
 
-	if( g_palThreads[id].initialized)
+	if ((PAL_INVALID_THREAD != id) && PAL_THREAD_SLOT(id)->initialized)
 	{
-		localStore = g_palThreads[id].threadStore;
+		localStore = PAL_THREAD_SLOT(id)->threadStore;
 	}
 	return localStore;
 }
 
+#if PAL_THREAD_STACK_PAINT
+//! The stacks grow down, the paint left at the bottom of the stack was never reached. RTX keeps the magic word of its stack
+//! overflow check in the bottom word, the paint starts above it.
+PAL_PRIVATE uint32_t threadStackUsed(const uint32_t* stackPtr, uint32_t stackSize)
+{
+    const uint32_t* word = stackPtr + 1;
+    const uint32_t* end = stackPtr + (stackSize / sizeof(uint32_t));
+
+    if (NULL == stackPtr)
+    {
+        return 0;
+    }
+    while ((word < end) && (PAL_THREAD_STACK_PAINT_PATTERN == *word))
+    {
+        ++word;
+    }
+    return (uint32_t)((end - word) * sizeof(uint32_t));
+}
+#endif //PAL_THREAD_STACK_PAINT
+
+palStatus_t pal_plat_osThreadGetStats(palThreadID_t threadID, palThreadStats_t* stats)
+{
+    palThread_t* thread = NULL;
+
+    if ((NULL == stats) || (threadID >= s_palThreadsCapacity) || !PAL_THREAD_SLOT(threadID)->initialized)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    //! RTX neither measures the run time of the threads nor counts their context switches, those stay 0.
+    memset(stats, 0, sizeof(palThreadStats_t));
+    thread = PAL_THREAD_SLOT(threadID);
+    stats->stackSize = thread->osThread.stack_size;
+    if ((NULL != thread->osThread.stack_mem) && (0 != (osRtxConfig.flags & osRtxConfigStackWatermark)))
+    {
+        //! with its stack watermark enabled RTX paints the stacks itself, over the PAL paint.
+        stats->stackHighWaterMark = thread->osThread.stack_size - osThreadGetStackSpace((osThreadId_t)thread->threadID);
+    }
+#if PAL_THREAD_STACK_PAINT
+    else
+    {
+        stats->stackHighWaterMark = threadStackUsed((const uint32_t*)thread->osThread.stack_mem, thread->osThread.stack_size);
+    }
+#endif //PAL_THREAD_STACK_PAINT
+    stats->mutexWaits = thread->mutexWaits;
+    stats->mutexWaitMicroSec = ((uint64_t)thread->mutexWaitTicks * 1000000) / osKernelGetTickFreq();
+    return PAL_SUCCESS;
+}
+
 
 palStatus_t pal_plat_osTimerCreate(palTimerFuncPtr function, void* funcArgument, palTimerType_t timerType, palTimerID_t* timerID)
 {
@@ -441,7 +509,7 @@ palStatus_t pal_plat_osTimerCreate(palTimerFuncPtr function, void* funcArgument,
         return PAL_ERR_INVALID_ARGUMENT;
     }
 
-    timer = (palTimer_t*)malloc(sizeof(palTimer_t));
+    timer = (palTimer_t*)pal_osMalloc(sizeof(palTimer_t));
     if (NULL == timer)
     {
         status = PAL_ERR_NO_MEMORY;
@@ -458,7 +526,7 @@ palStatus_t pal_plat_osTimerCreate(palTimerFuncPtr function, void* funcArgument,
         timer->timerID = (uintptr_t)osTimerNew((osTimerFunc_t)function, (osTimerType_t)timerType, funcArgument, &timer->osTimer);
         if (NULLPTR == timer->timerID)
         {
-            free(timer);
+            pal_osFree(timer);
             timer = NULL;
             status = PAL_ERR_GENERIC_FAILURE;
         }
@@ -535,7 +603,7 @@ palStatus_t pal_plat_osTimerDelete(palTimerID_t* timerID)
     platStatus = osTimerDelete((osTimerId_t)timer->timerID);
     if (osOK == platStatus)
     {
-        free(timer);
+        pal_osFree(timer);
         *timerID = NULLPTR;
         status = PAL_SUCCESS;
     }
@@ -557,7 +625,7 @@ palStatus_t pal_plat_osMutexCreate(palMutexID_t* mutexID)
         return PAL_ERR_INVALID_ARGUMENT;
     }
 
-    mutex = (palMutex_t*)malloc(sizeof(palMutex_t));
+    mutex = (palMutex_t*)pal_osMalloc(sizeof(palMutex_t));
     if (NULL == mutex)
     {
         status = PAL_ERR_NO_MEMORY;
@@ -570,11 +638,12 @@ palStatus_t pal_plat_osMutexCreate(palMutexID_t* mutexID)
         mutex->osMutex.cb_mem = &mutex->osMutexStorage;
         mutex->osMutex.cb_size = sizeof(mutex->osMutexStorage);
         memset(&mutex->osMutexStorage, 0, sizeof(mutex->osMutexStorage));
+        mutex->depth = 0;
 
         mutex->mutexID = (uintptr_t)osMutexCreate(&mutex->osMutex);
         if (NULLPTR == mutex->mutexID)
         {
-            free(mutex);
+            pal_osFree(mutex);
             mutex = NULL;
             status = PAL_ERR_GENERIC_FAILURE;
         }
@@ -592,6 +661,8 @@ palStatus_t pal_plat_osMutexWait(palMutexID_t mutexID, uint32_t millisec)
     palStatus_t status = PAL_SUCCESS;
     osStatus_t platStatus = osOK;
     palMutex_t* mutex = NULL;
+    palThreadID_t threadId = PAL_INVALID_THREAD;
+    uint32_t waitStart = 0;
     
     if(NULLPTR == mutexID)
     {
@@ -599,9 +670,22 @@ palStatus_t pal_plat_osMutexWait(palMutexID_t mutexID, uint32_t millisec)
     }
 
     mutex = (palMutex_t*)mutexID;
-    platStatus = osMutexAcquire((osMutexId_t)mutex->mutexID, millisec);
+    //! only a wait which blocks is timed for the statistics of the thread, a free mutex costs the try alone.
+    platStatus = osMutexAcquire((osMutexId_t)mutex->mutexID, 0);
+    if ((osErrorResource == platStatus) && (0 != millisec))
+    {
+        waitStart = osKernelGetTickCount();
+        platStatus = osMutexAcquire((osMutexId_t)mutex->mutexID, millisec);
+        threadId = pal_plat_osThreadGetId();
+        if (PAL_INVALID_THREAD != threadId)
+        {
+            PAL_THREAD_SLOT(threadId)->mutexWaits++;
+            PAL_THREAD_SLOT(threadId)->mutexWaitTicks += osKernelGetTickCount() - waitStart;
+        }
+    }
     if (osOK == platStatus)
     {
+        mutex->depth++;
         status = PAL_SUCCESS;
     }
     else
@@ -625,6 +709,11 @@ palStatus_t pal_plat_osMutexRelease(palMutexID_t mutexID)
     }
 
     mutex = (palMutex_t*)mutexID;
+    //! a thread which does not hold the mutex leaves the depth alone, the release fails for it.
+    if (osThreadGetId() == osMutexGetOwner((osMutexId_t)mutex->mutexID))
+    {
+        mutex->depth--;
+    }
     platStatus = osMutexRelease((osMutexId_t)mutex->mutexID);
     if (osOK == platStatus)
     {
@@ -638,6 +727,17 @@ palStatus_t pal_plat_osMutexRelease(palMutexID_t mutexID)
     return status;
 }
 
+uint32_t pal_plat_osMutexDepth(palMutexID_t mutexID)
+{
+    palMutex_t* mutex = (palMutex_t*)mutexID;
+
+    if ((NULLPTR == mutexID) || (osThreadGetId() != osMutexGetOwner((osMutexId_t)mutex->mutexID)))
+    {
+        return 0;
+    }
+    return mutex->depth;
+}
+
 palStatus_t pal_plat_osMutexDelete(palMutexID_t* mutexID)
 {
     palStatus_t status = PAL_SUCCESS;
@@ -653,7 +753,7 @@ palStatus_t pal_plat_osMutexDelete(palMutexID_t* mutexID)
     platStatus = osMutexDelete((osMutexId_t)mutex->mutexID);
     if (osOK == platStatus)
     {
-        free(mutex);
+        pal_osFree(mutex);
         *mutexID = NULLPTR;
         status = PAL_SUCCESS;
     }
@@ -674,7 +774,7 @@ palStatus_t pal_plat_osSemaphoreCreate(uint32_t count, palSemaphoreID_t* semapho
         return PAL_ERR_INVALID_ARGUMENT;
     }
 
-    semaphore = (palSemaphore_t*)malloc(sizeof(palSemaphore_t));
+    semaphore = (palSemaphore_t*)pal_osMalloc(sizeof(palSemaphore_t));
     if (NULL == semaphore)
     {
         status = PAL_ERR_NO_MEMORY;
@@ -689,7 +789,7 @@ palStatus_t pal_plat_osSemaphoreCreate(uint32_t count, palSemaphoreID_t* semapho
         semaphore->semaphoreID = (uintptr_t)osSemaphoreNew(PAL_MAX_SEMAPHORE_COUNT, count, &semaphore->osSemaphore);
         if (NULLPTR == semaphore->semaphoreID)
         {
-            free(semaphore);
+            pal_osFree(semaphore);
             semaphore = NULL;
             status = PAL_ERR_GENERIC_FAILURE;
         }
@@ -770,7 +870,7 @@ palStatus_t pal_plat_osSemaphoreDelete(palSemaphoreID_t* semaphoreID)
     platStatus = osSemaphoreDelete((osSemaphoreId_t)semaphore->semaphoreID);
     if (osOK == platStatus)
     {
-        free(semaphore);
+        pal_osFree(semaphore);
         *semaphoreID = NULLPTR;
         status = PAL_SUCCESS;
     }
@@ -782,148 +882,17 @@ palStatus_t pal_plat_osSemaphoreDelete(palSemaphoreID_t* semaphoreID)
     return status;  
 }
 
-palStatus_t pal_plat_osPoolCreate(uint32_t blockSize, uint32_t blockCount, palMemoryPoolID_t* memoryPoolID)
-{
-    palStatus_t status = PAL_SUCCESS;
-    palMemoryPool_t* memoryPool = NULL;
-    if(NULL == memoryPoolID)
-    {
-        return PAL_ERR_INVALID_ARGUMENT;
-    }
-
-    //! allocate the memory pool structure
-    memoryPool = (palMemoryPool_t*)malloc(sizeof(palMemoryPool_t));
-    if (NULL == memoryPool)
-    {
-        status = PAL_ERR_NO_MEMORY;
-    }
-
-    if(PAL_SUCCESS == status)
-    {
-        memoryPool->blockSize = blockSize;
-        memoryPool->osPool.name = NULL;
-        memoryPool->osPool.attr_bits = 0;
-        memoryPool->osPool.cb_mem = &memoryPool->osPoolStorage;
-        memoryPool->osPool.cb_size = sizeof(memoryPool->osPoolStorage);
-        memset(&memoryPool->osPoolStorage, 0, sizeof(memoryPool->osPoolStorage));
-        memoryPool->osPool.mp_size = blockSize * blockCount;
-        memoryPool->osPool.mp_mem = (uint32_t*)malloc(memoryPool->osPool.mp_size);
-        if (NULL == memoryPool->osPool.mp_mem)
-        {
-            free(memoryPool);
-            *memoryPoolID = NULLPTR;
-            status = PAL_ERR_NO_MEMORY;
-        }
-        else
-        {
-            memset(memoryPool->osPool.mp_mem, 0, memoryPool->osPool.mp_size);
-
-            memoryPool->memoryPoolID = (uintptr_t)osMemoryPoolNew(blockCount, blockSize, &memoryPool->osPool);
-            if (NULLPTR == memoryPool->memoryPoolID)
-            {
-                free(memoryPool->osPool.mp_mem);
-                free(memoryPool);
-                memoryPool = NULL;
-                status = PAL_ERR_GENERIC_FAILURE;
-            }
-            else
-            {
-                *memoryPoolID = (palMemoryPoolID_t)memoryPool;
-            }
-        }
-    }
-    return status;      
-}
-
-void* pal_plat_osPoolAlloc(palMemoryPoolID_t memoryPoolID)
-{
-    void* result = NULL;
-    palMemoryPool_t* memoryPool = NULL;
-    
-    if(NULLPTR == memoryPoolID)
-    {
-        return NULL;
-    }
-
-    memoryPool = (palMemoryPool_t*)memoryPoolID;
-    result = osMemoryPoolAlloc((osMemoryPoolId_t)memoryPool->memoryPoolID, 0);
-
-    return result;
-}
-
-void* pal_plat_osPoolCAlloc(palMemoryPoolID_t memoryPoolID)
-{
-    void* result = NULL;
-    palMemoryPool_t* memoryPool = NULL;
-    
-    if(NULLPTR == memoryPoolID)
-    {
-        return NULL;
-    }
-
-    memoryPool = (palMemoryPool_t*)memoryPoolID;
-    result = osMemoryPoolAlloc((osMemoryPoolId_t)memoryPool->memoryPoolID, 0);
-    if (NULLPTR != result)
-    {
-        memset(result, 0, memoryPool->blockSize);
-    }
-
-    return result;  
-}
-
-palStatus_t pal_plat_osPoolFree(palMemoryPoolID_t memoryPoolID, void* block)
-{
-    palStatus_t status = PAL_SUCCESS;
-    osStatus_t platStatus = osOK;
-    palMemoryPool_t* memoryPool = NULL;
-    
-    if(NULLPTR == memoryPoolID || NULL == block)
-    {
-        return PAL_ERR_INVALID_ARGUMENT;
-    }
-
-    memoryPool = (palMemoryPool_t*)memoryPoolID;
-    platStatus = osMemoryPoolFree((osMemoryPoolId_t)memoryPool->memoryPoolID, block);
-    if (osOK == platStatus)
-    {
-        status = PAL_SUCCESS;
-    }
-    else
-    {
-        status = PAL_RTOS_TRANSLATE_CMSIS_ERROR_CODE(platStatus);
-    }
-
-    return status;  
-}
-
-palStatus_t pal_plat_osPoolDestroy(palMemoryPoolID_t* memoryPoolID)
-{
-    palStatus_t status = PAL_SUCCESS;
-    palMemoryPool_t* memoryPool = NULL;
-    
-    if(NULL == memoryPoolID || NULLPTR == *memoryPoolID)
-    {
-        return PAL_ERR_INVALID_ARGUMENT;
-    }   
-
-    memoryPool = (palMemoryPool_t*)*memoryPoolID;
-    free(memoryPool->osPool.mp_mem);
-    free(memoryPool);
-    *memoryPoolID = NULLPTR;
-    return status;
-}
-
-palStatus_t pal_plat_osMessageQueueCreate(uint32_t messageQCount, palMessageQID_t* messageQID)
+palStatus_t pal_plat_osMessageQueueCreate(uint32_t messageQCount, uint32_t messageSize, palMessageQID_t* messageQID)
 {
     palStatus_t status = PAL_SUCCESS;
     palMessageQ_t* messageQ = NULL;
-    if(NULL == messageQID)
+    if(NULL == messageQID || 0 == messageQCount || 0 == messageSize)
     {
         return PAL_ERR_INVALID_ARGUMENT;
     }
 
     //! allocate the message queue structure
-    messageQ = (palMessageQ_t*)malloc(sizeof(palMessageQ_t));
+    messageQ = (palMessageQ_t*)pal_osMalloc(sizeof(palMessageQ_t));
     if (NULL == messageQ)
     {
         status = PAL_ERR_NO_MEMORY;
@@ -936,11 +905,12 @@ palStatus_t pal_plat_osMessageQueueCreate(uint32_t messageQCount, palMessageQID_
         messageQ->osMessageQ.cb_size = sizeof(messageQ->osMessageQStorage);
         messageQ->osMessageQ.cb_mem = &messageQ->osMessageQStorage;
         memset(&messageQ->osMessageQStorage, 0, sizeof(messageQ->osMessageQStorage));
-        messageQ->osMessageQ.mq_size = (sizeof(uint32_t) + sizeof(mbed_rtos_storage_message_t)) * messageQCount ;
-        messageQ->osMessageQ.mq_mem = (uint32_t*)malloc(messageQ->osMessageQ.mq_size);
+        //! RTX keeps every message in a 4 byte aligned slot after its header
+        messageQ->osMessageQ.mq_size = (((messageSize + 3) & ~3U) + sizeof(mbed_rtos_storage_message_t)) * messageQCount;
+        messageQ->osMessageQ.mq_mem = (uint32_t*)pal_osMalloc(messageQ->osMessageQ.mq_size);
         if (NULL == messageQ->osMessageQ.mq_mem)
         {
-            free(messageQ);
+            pal_osFree(messageQ);
             messageQ = NULL;
             status = PAL_ERR_NO_MEMORY;
         }
@@ -948,11 +918,11 @@ palStatus_t pal_plat_osMessageQueueCreate(uint32_t messageQCount, palMessageQID_
         {
             memset(messageQ->osMessageQ.mq_mem, 0, messageQ->osMessageQ.mq_size);
 
-            messageQ->messageQID = (uintptr_t)osMessageQueueNew(messageQCount, sizeof(uint32_t), &messageQ->osMessageQ);
+            messageQ->messageQID = (uintptr_t)osMessageQueueNew(messageQCount, messageSize, &messageQ->osMessageQ);
             if (NULLPTR == messageQ->messageQID)
             {
-                free(messageQ->osMessageQ.mq_mem);
-                free(messageQ);
+                pal_osFree(messageQ->osMessageQ.mq_mem);
+                pal_osFree(messageQ);
                 messageQ = NULL;
                 status = PAL_ERR_GENERIC_FAILURE;
             }
@@ -965,19 +935,19 @@ palStatus_t pal_plat_osMessageQueueCreate(uint32_t messageQCount, palMessageQID_
     return status;      
 }
 
-palStatus_t pal_plat_osMessagePut(palMessageQID_t messageQID, uint32_t info, uint32_t timeout)
+palStatus_t pal_plat_osMessagePut(palMessageQID_t messageQID, const void* message, uint32_t timeout)
 {
     palStatus_t status = PAL_SUCCESS;
     osStatus_t platStatus = osOK;
     palMessageQ_t* messageQ = NULL;
     
-    if(NULLPTR == messageQID)
+    if(NULLPTR == messageQID || NULL == message)
     {
         return PAL_ERR_INVALID_ARGUMENT;
     }
 
     messageQ = (palMessageQ_t*)messageQID;
-    platStatus = osMessageQueuePut((osMessageQueueId_t)messageQ->messageQID, (void *)&info, 0, timeout);
+    platStatus = osMessageQueuePut((osMessageQueueId_t)messageQ->messageQID, message, 0, timeout);
     if (osOK == platStatus)
     {
         status = PAL_SUCCESS;
@@ -990,19 +960,19 @@ palStatus_t pal_plat_osMessagePut(palMessageQID_t messageQID, uint32_t info, uin
     return status;  
 }
 
-palStatus_t pal_plat_osMessageGet(palMessageQID_t messageQID, uint32_t timeout, uint32_t* messageValue)
+palStatus_t pal_plat_osMessageGet(palMessageQID_t messageQID, uint32_t timeout, void* message)
 {
     palStatus_t status = PAL_SUCCESS;
     osStatus_t platStatus;
     palMessageQ_t* messageQ = NULL;
 
-    if (NULLPTR == messageQID || NULLPTR == messageValue)
+    if (NULLPTR == messageQID || NULL == message)
     {
         return PAL_ERR_INVALID_ARGUMENT;
     }
 
     messageQ = (palMessageQ_t*)messageQID;
-    platStatus = osMessageQueueGet((osMessageQueueId_t)messageQ->messageQID, messageValue, NULL, timeout);
+    platStatus = osMessageQueueGet((osMessageQueueId_t)messageQ->messageQID, message, NULL, timeout);
     if (osOK == platStatus)
     {
         status = PAL_SUCCESS;
@@ -1011,7 +981,11 @@ palStatus_t pal_plat_osMessageGet(palMessageQID_t messageQID, uint32_t timeout,
     {
         status = PAL_ERR_RTOS_TIMEOUT;
     }
-    else if (osOK != platStatus)
+    else if (osErrorResource == platStatus)
+    {
+        status = PAL_ERR_RTOS_RESOURCE;
+    }
+    else
     {
         status = PAL_ERR_RTOS_PARAMETER;
     }
@@ -1019,6 +993,59 @@ palStatus_t pal_plat_osMessageGet(palMessageQID_t messageQID, uint32_t timeout,
     return status;
 }
 
+//! CMSIS-RTOS2 has no batch message calls, only the first message waits for the timeout and the rest are moved without blocking.
+palStatus_t pal_plat_osMessagePutBatch(palMessageQID_t messageQID, const void* messages, uint32_t count, uint32_t timeout, uint32_t* putCount)
+{
+    palStatus_t status = PAL_SUCCESS;
+    const uint8_t* message = (const uint8_t*)messages;
+    uint32_t messageSize = 0;
+    uint32_t copied = 0;
+
+    if (NULLPTR == messageQID || NULL == messages || 0 == count)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    messageSize = osMessageQueueGetMsgSize((osMessageQueueId_t)((palMessageQ_t*)messageQID)->messageQID);
+    status = pal_plat_osMessagePut(messageQID, message, timeout);
+    while ((PAL_SUCCESS == status) && (++copied < count))
+    {
+        status = pal_plat_osMessagePut(messageQID, message + ((size_t)copied * messageSize), 0);
+    }
+
+    if (NULL != putCount)
+    {
+        *putCount = copied;
+    }
+    return (copied > 0) ? PAL_SUCCESS : status;
+}
+
+palStatus_t pal_plat_osMessageGetBatch(palMessageQID_t messageQID, uint32_t timeout, void* messages, uint32_t count, uint32_t* getCount)
+{
+    palStatus_t status = PAL_SUCCESS;
+    uint8_t* message = (uint8_t*)messages;
+    uint32_t messageSize = 0;
+    uint32_t copied = 0;
+
+    if (NULLPTR == messageQID || NULL == messages || 0 == count)
+    {
+        return PAL_ERR_INVALID_ARGUMENT;
+    }
+
+    messageSize = osMessageQueueGetMsgSize((osMessageQueueId_t)((palMessageQ_t*)messageQID)->messageQID);
+    status = pal_plat_osMessageGet(messageQID, timeout, message);
+    while ((PAL_SUCCESS == status) && (++copied < count))
+    {
+        status = pal_plat_osMessageGet(messageQID, 0, message + ((size_t)copied * messageSize));
+    }
+
+    if (NULL != getCount)
+    {
+        *getCount = copied;
+    }
+    return (copied > 0) ? PAL_SUCCESS : status;
+}
+
 
 palStatus_t pal_plat_osMessageQueueDestroy(palMessageQID_t* messageQID)
 {
@@ -1031,22 +1058,191 @@ palStatus_t pal_plat_osMessageQueueDestroy(palMessageQID_t* messageQID)
     }   
 
     messageQ = (palMessageQ_t*)*messageQID;
-    free(messageQ->osMessageQ.mq_mem);
-    free(messageQ);
+    pal_osFree(messageQ->osMessageQ.mq_mem);
+    pal_osFree(messageQ);
     *messageQID = NULLPTR;
     return status;
 }
 
 
-int32_t pal_plat_osAtomicIncrement(int32_t* valuePtr, int32_t increment)
+//! The core_util atomics are plain exclusive accesses, the barriers of the memory order are added around them.
+static inline void palAtomicBarrierBefore(palMemoryOrder_t order)
+{
+    if ((PAL_MEMORY_ORDER_RELEASE == order) || (PAL_MEMORY_ORDER_ACQ_REL == order) || (PAL_MEMORY_ORDER_SEQ_CST == order))
+    {
+        __DMB();
+    }
+}
+
+static inline void palAtomicBarrierAfter(palMemoryOrder_t order)
+{
+    if ((PAL_MEMORY_ORDER_ACQUIRE == order) || (PAL_MEMORY_ORDER_ACQ_REL == order) || (PAL_MEMORY_ORDER_SEQ_CST == order))
+    {
+        __DMB();
+    }
+}
+
+uint32_t pal_plat_osAtomicLoad32(const uint32_t* valuePtr, palMemoryOrder_t order)
+{
+    uint32_t value;
+    if (PAL_MEMORY_ORDER_SEQ_CST == order)
+    {
+        __DMB();
+    }
+    value = *(const volatile uint32_t*)valuePtr;
+    palAtomicBarrierAfter(order);
+    return value;
+}
+
+void pal_plat_osAtomicStore32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order)
 {
-    if (increment >= 0)
+    palAtomicBarrierBefore(order);
+    *(volatile uint32_t*)valuePtr = value;
+    if (PAL_MEMORY_ORDER_SEQ_CST == order)
     {
-        return core_util_atomic_incr_u32((uint32_t*)valuePtr, increment);
+        __DMB();
+    }
+}
+
+bool pal_plat_osAtomicCompareAndSwap32(uint32_t* valuePtr, uint32_t* expected, uint32_t desired, palMemoryOrder_t order)
+{
+    uint32_t observed = *expected;
+    bool swapped = false;
+
+    palAtomicBarrierBefore(order);
+    //! a failed store exclusive (e.g. an interrupt in between) leaves expected unchanged, only a different value ends the loop without a swap.
+    do
+    {
+        swapped = core_util_atomic_cas_u32(valuePtr, expected, desired);
+    } while (!swapped && (*expected == observed));
+    palAtomicBarrierAfter(order);
+    return swapped;
+}
+
+uint32_t pal_plat_osAtomicExchange32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order)
+{
+    uint32_t current = *(volatile uint32_t*)valuePtr;
+    while (!pal_plat_osAtomicCompareAndSwap32(valuePtr, &current, value, order));
+    return current;
+}
+
+uint32_t pal_plat_osAtomicFetchAdd32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order)
+{
+    uint32_t current = *(volatile uint32_t*)valuePtr;
+    while (!pal_plat_osAtomicCompareAndSwap32(valuePtr, &current, current + value, order));
+    return current;
+}
+
+uint32_t pal_plat_osAtomicFetchAnd32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order)
+{
+    uint32_t current = *(volatile uint32_t*)valuePtr;
+    while (!pal_plat_osAtomicCompareAndSwap32(valuePtr, &current, current & value, order));
+    return current;
+}
+
+uint32_t pal_plat_osAtomicFetchOr32(uint32_t* valuePtr, uint32_t value, palMemoryOrder_t order)
+{
+    uint32_t current = *(volatile uint32_t*)valuePtr;
+    while (!pal_plat_osAtomicCompareAndSwap32(valuePtr, &current, current | value, order));
+    return current;
+}
+
+//! Cortex-M has no 64 bit exclusive access, the 64 bit operations run in a critical section (which also excludes interrupts).
+uint64_t pal_plat_osAtomicLoad64(const uint64_t* valuePtr, palMemoryOrder_t order)
+{
+    uint64_t value;
+    palAtomicBarrierBefore((PAL_MEMORY_ORDER_SEQ_CST == order) ? order : PAL_MEMORY_ORDER_RELAXED);
+    core_util_critical_section_enter();
+    value = *(const volatile uint64_t*)valuePtr;
+    core_util_critical_section_exit();
+    palAtomicBarrierAfter(order);
+    return value;
+}
+
+void pal_plat_osAtomicStore64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order)
+{
+    palAtomicBarrierBefore(order);
+    core_util_critical_section_enter();
+    *(volatile uint64_t*)valuePtr = value;
+    core_util_critical_section_exit();
+    if (PAL_MEMORY_ORDER_SEQ_CST == order)
+    {
+        __DMB();
+    }
+}
+
+uint64_t pal_plat_osAtomicExchange64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order)
+{
+    uint64_t current;
+    palAtomicBarrierBefore(order);
+    core_util_critical_section_enter();
+    current = *valuePtr;
+    *valuePtr = value;
+    core_util_critical_section_exit();
+    palAtomicBarrierAfter(order);
+    return current;
+}
+
+bool pal_plat_osAtomicCompareAndSwap64(uint64_t* valuePtr, uint64_t* expected, uint64_t desired, palMemoryOrder_t order)
+{
+    bool swapped = false;
+    palAtomicBarrierBefore(order);
+    core_util_critical_section_enter();
+    if (*valuePtr == *expected)
+    {
+        *valuePtr = desired;
+        swapped = true;
     }
     else
     {
-        return core_util_atomic_decr_u32((uint32_t*)valuePtr, 0 - increment);
+        *expected = *valuePtr;
+    }
+    core_util_critical_section_exit();
+    palAtomicBarrierAfter(order);
+    return swapped;
+}
+
+uint64_t pal_plat_osAtomicFetchAdd64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order)
+{
+    uint64_t current;
+    palAtomicBarrierBefore(order);
+    core_util_critical_section_enter();
+    current = *valuePtr;
+    *valuePtr = current + value;
+    core_util_critical_section_exit();
+    palAtomicBarrierAfter(order);
+    return current;
+}
+
+uint64_t pal_plat_osAtomicFetchAnd64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order)
+{
+    uint64_t current;
+    palAtomicBarrierBefore(order);
+    core_util_critical_section_enter();
+    current = *valuePtr;
+    *valuePtr = current & value;
+    core_util_critical_section_exit();
+    palAtomicBarrierAfter(order);
+    return current;
+}
+
+uint64_t pal_plat_osAtomicFetchOr64(uint64_t* valuePtr, uint64_t value, palMemoryOrder_t order)
+{
+    uint64_t current;
+    palAtomicBarrierBefore(order);
+    core_util_critical_section_enter();
+    current = *valuePtr;
+    *valuePtr = current | value;
+    core_util_critical_section_exit();
+    palAtomicBarrierAfter(order);
+    return current;
+}
+
+void pal_plat_osAtomicFence(palMemoryOrder_t order)
+{
+    if (PAL_MEMORY_ORDER_RELAXED != order)
+    {
+        __DMB();
     }
 }
 
@@ -16,6 +16,7 @@
 
 
 #include "pal_plat_update.h"
+#include "pal_rtos.h"
 #if (defined(TARGET_K64F))
 
 
@@ -292,7 +293,7 @@ void PAL_PI_MBED_journal_callbackHandler(int32_t status, FlashJournal_OpCode_t c
 {
 	int32_t rc = 0;
 	//solve compilation warning to be removed
-	DEBUG_PRINT("pal_pi_mbed_active_fsm %u cmd_code %u\n", pal_pi_mbed_active_fsm, cmd_code);
+	PAL_TRACE("pal_pi_mbed_active_fsm %u cmd_code %u\n", pal_pi_mbed_active_fsm, cmd_code);
 	if (FLASH_JOURNAL_OPCODE_RESET == cmd_code)
 		return;
 	switch (pal_pi_mbed_active_fsm)
@@ -327,21 +328,21 @@ void PAL_PI_MBED_journal_callbackHandler(int32_t status, FlashJournal_OpCode_t c
 			break;
 	}
 
-	DEBUG_PRINT("rc is %d\r\n",rc);
+	PAL_TRACE("rc is %d\r\n",rc);
 }
 
 
 
 void PAL_PI_MBED_journalMTD_callbackHandler(int32_t status, ARM_STORAGE_OPERATION operation)
 {
-    DEBUG_PRINT("in journalMTD_callbackHandler for operation %d with status %d\r\n", operation, status);
+    PAL_TRACE("in journalMTD_callbackHandler for operation %d with status %d\r\n", operation, status);
     /* TODO implement for possible asynch behaviour of MTD */
 }
 
 void PAL_PI_MBED_volumeManager_initializeCallbackHandler(int32_t status)
 {
     int rc = 0;
-    DEBUG_PRINT("in volumeManager_initializeCallbackHandler with status %d\r\n", status);
+    PAL_TRACE("in volumeManager_initializeCallbackHandler with status %d\r\n", status);
     switch (pal_pi_mbed_active_fsm)
     {
         case PAL_PI_MBED_FSM_SETUP:
@@ -394,12 +395,12 @@ palStatus_t pal_plat_imageActivate(palImageId_t imageId)
 int PAL_PI_MBED_GetAtiveHash_StateMachine()
 {
     int rc = JOURNAL_STATUS_OK;
-    DEBUG_PRINT("PAL_PI_MBED_GetAtiveHash_StateMachine %u\r\n", pal_pi_mbed_getativehash_state);
+    PAL_TRACE("PAL_PI_MBED_GetAtiveHash_StateMachine %u\r\n", pal_pi_mbed_getativehash_state);
 
     switch(pal_pi_mbed_getativehash_state)
     {
         case PAL_PI_GETATIVEHASH_UNINITIALIZED:
-            DEBUG_PRINT("PAL_PI_GETATIVEHASH_UNINITIALIZED\r\n");
+            PAL_TRACE("PAL_PI_GETATIVEHASH_UNINITIALIZED\r\n");
             if (volumeManager.isInitialized() == 0)
             {
                 rc = volumeManager.initialize(mtd, PAL_PI_MBED_volumeManager_initializeCallbackHandler);
@@ -412,7 +413,7 @@ int PAL_PI_MBED_GetAtiveHash_StateMachine()
             if (rc < ARM_DRIVER_OK)
             {
             	rc = palTranslateDriverErr(rc);
-                DEBUG_PRINT("Volume Manager Initialize Error %i\r\n", rc);
+                PAL_TRACE("Volume Manager Initialize Error %i\r\n", rc);
                 break;
             }
             else if (rc > ARM_DRIVER_OK)
@@ -424,7 +425,7 @@ int PAL_PI_MBED_GetAtiveHash_StateMachine()
             break;
 
         case PAL_PI_GETATIVEHASH_VOLUME_MANAGER_INITIALIZED:
-            DEBUG_PRINT("PAL_PI_GETATIVEHASH_VOLUME_MANAGER_INITIALIZED\r\n");
+            PAL_TRACE("PAL_PI_GETATIVEHASH_VOLUME_MANAGER_INITIALIZED\r\n");
             if (flag_hash_volumne_intialized == 0)
             {
                 rc = volumeManager.addVolume_C(PAL_UPDATE_ACTIVE_METADATA_HEADER_OFFSET, sizeof(FirmwareHeader_t), &metadataHeaderMTD);
@@ -432,11 +433,11 @@ int PAL_PI_MBED_GetAtiveHash_StateMachine()
                 if (rc < ARM_DRIVER_OK)
                 {
                 	rc = palTranslateDriverErr(rc);
-                    DEBUG_PRINT("addVolume_C Error %d\r\n", rc);
+                    PAL_TRACE("addVolume_C Error %d\r\n", rc);
                     break;
                 }
 
-                DEBUG_PRINT("metadataHeaderMTD initialize\r\n");
+                PAL_TRACE("metadataHeaderMTD initialize\r\n");
                 rc = metadataHeaderMTD.Initialize(PAL_PI_MBED_journalMTD_callbackHandler);
             }
             else
@@ -459,7 +460,7 @@ int PAL_PI_MBED_GetAtiveHash_StateMachine()
             break;
 
         case PAL_PI_GETATIVEHASH_STORAGE_DRIVER_INITIALIZED:
-            DEBUG_PRINT("PAL_PI_GETATIVEHASH_STORAGE_DRIVER_INITIALIZED\r\n");
+            PAL_TRACE("PAL_PI_GETATIVEHASH_STORAGE_DRIVER_INITIALIZED\r\n");
             /* TODO validate the header before returning the member data */
             rc = metadataHeaderMTD.ReadData(offsetof(FirmwareHeader_t, firmwareSHA256), pal_pi_mbed_hash_buffer->buffer, SIZEOF_SHA256);
             if (rc < ARM_DRIVER_OK)
@@ -476,12 +477,12 @@ int PAL_PI_MBED_GetAtiveHash_StateMachine()
             break;
 
         case PAL_PI_GETATIVEHASH_DONE:
-            DEBUG_PRINT("PAL_PI_GETATIVEHASH_DONE\r\n");
+            PAL_TRACE("PAL_PI_GETATIVEHASH_DONE\r\n");
             g_palUpdateServiceCBfunc(PAL_IMAGE_EVENT_GETACTIVEHASH);
             break;
 
         case PAL_PI_GETATIVEHASH_ERROR:
-            DEBUG_PRINT("PAL_PI_GETATIVEHASH_ERROR\r\n");
+            PAL_TRACE("PAL_PI_GETATIVEHASH_ERROR\r\n");
             g_palUpdateServiceCBfunc(PAL_IMAGE_EVENT_ERROR);
             break;
     }
@@ -556,7 +557,7 @@ int PAL_PI_MBED_Setup_StateMachine_Enter()
     switch(pal_pi_mbed_setup_state)
     {
         case PAL_PI_SETUP_UNINITIALIZED:
-            DEBUG_PRINT("PAL_PI_SETUP_UNINITIALIZED\r\n");
+            PAL_TRACE("PAL_PI_SETUP_UNINITIALIZED\r\n");
 
             pal_pi_mbed_metadata_logged = 0;
             if (volumeManager.isInitialized() == 0)
@@ -565,14 +566,14 @@ int PAL_PI_MBED_Setup_StateMachine_Enter()
             }
             else
             {
-                DEBUG_PRINT("volumeManager already initialized\r\n");
+                PAL_TRACE("volumeManager already initialized\r\n");
                 rc = ARM_DRIVER_OK+1;
             }
 
             if (rc < ARM_DRIVER_OK)
             {
             	rc = palTranslateDriverErr(rc);
-                DEBUG_PRINT("Initialize Error %i\r\n", rc);
+                PAL_TRACE("Initialize Error %i\r\n", rc);
                 break;
             }
             else if (rc > ARM_DRIVER_OK)
@@ -584,21 +585,21 @@ int PAL_PI_MBED_Setup_StateMachine_Enter()
             break;
 
         case PAL_PI_SETUP_VOLUME_MANAGER_INITIALIZED:
-        	DEBUG_PRINT("PAL_PI_SETUP_VOLUME_MANAGER_INITIALIZED\r\n");
+        	PAL_TRACE("PAL_PI_SETUP_VOLUME_MANAGER_INITIALIZED\r\n");
 
             rc = volumeManager.addVolume_C(PAL_UPDATE_JOURNAL_START_OFFSET, PAL_UPDATE_JOURNAL_SIZE, &journalMTD);
             if (rc < ARM_DRIVER_OK)
             {
-            	DEBUG_PRINT("addVolume_C Error %d\r\n", rc);
+            	PAL_TRACE("addVolume_C Error %d\r\n", rc);
             	rc = palTranslateDriverErr(rc);
                 break;
             }
 
-            DEBUG_PRINT("journalMTD initialize\r\n");
+            PAL_TRACE("journalMTD initialize\r\n");
             rc = journalMTD.Initialize(PAL_PI_MBED_journalMTD_callbackHandler);
             if (rc < JOURNAL_STATUS_OK)
             {
-            	DEBUG_PRINT("journalMTD.Initialize Error %i\r\n", rc);
+            	PAL_TRACE("journalMTD.Initialize Error %i\r\n", rc);
             	rc = palTranslateJournalErr(rc);
                 break; // handle error
             }
@@ -610,12 +611,12 @@ int PAL_PI_MBED_Setup_StateMachine_Enter()
 
             break;
         case PAL_PI_SETUP_STORAGE_DRIVER_FORMAT:
-        	DEBUG_PRINT("PAL_PI_SETUP_STORAGE_DRIVER_FORMAT\r\n");
-        	DEBUG_PRINT("pal_pi_mbed_active_fsm %d\n", pal_pi_mbed_active_fsm);
+        	PAL_TRACE("PAL_PI_SETUP_STORAGE_DRIVER_FORMAT\r\n");
+        	PAL_TRACE("pal_pi_mbed_active_fsm %d\n", pal_pi_mbed_active_fsm);
             rc = flashJournalStrategySequential_format((ARM_DRIVER_STORAGE *)&journalMTD, PAL_UPDATE_JOURNAL_NUM_SLOTS, PAL_PI_MBED_journal_callbackHandler);
             if (rc < JOURNAL_STATUS_OK)
             {
-            	DEBUG_PRINT("FlashJournal_initialize Error %i\r\n", rc);
+            	PAL_TRACE("FlashJournal_initialize Error %i\r\n", rc);
             	rc = palTranslateJournalErr(rc);
                 break;// handle error
             }
@@ -626,11 +627,11 @@ int PAL_PI_MBED_Setup_StateMachine_Enter()
             }
             break;
         case PAL_PI_SETUP_STORAGE_DRIVER_INITIALIZED:
-            DEBUG_PRINT("PAL_PI_SETUP_STORAGE_DRIVER_INITIALIZED\r\n");
+            PAL_TRACE("PAL_PI_SETUP_STORAGE_DRIVER_INITIALIZED\r\n");
             rc = FlashJournal_initialize(&pal_pi_mbed_journal, (ARM_DRIVER_STORAGE *)&journalMTD, &FLASH_JOURNAL_STRATEGY_SEQUENTIAL, PAL_PI_MBED_journal_callbackHandler);
             if (rc < JOURNAL_STATUS_OK)
             {
-            	DEBUG_PRINT("FlashJournal_initialize Error %i\r\n", rc);
+            	PAL_TRACE("FlashJournal_initialize Error %i\r\n", rc);
             	rc = palTranslateJournalErr(rc);
                 break;// handle error
             }
@@ -642,17 +643,17 @@ int PAL_PI_MBED_Setup_StateMachine_Enter()
             break;
 
         case PAL_PI_SETUP_DONE:
-            DEBUG_PRINT("PAL_PI_SETUP_DONE\r\n");
+            PAL_TRACE("PAL_PI_SETUP_DONE\r\n");
             rc = FlashJournal_getInfo(&pal_pi_mbed_journal, &pal_pi_mbed_journal_info);
             if (rc < JOURNAL_STATUS_OK)
             {
-            	DEBUG_PRINT("FlashJournal_getInfo Error %i\r\n", rc);
+            	PAL_TRACE("FlashJournal_getInfo Error %i\r\n", rc);
             	rc = palTranslateJournalErr(rc);
                 break; // handle error
             }
             else
             {
-                DEBUG_PRINT("journalInfo: capacity %lu, size %lu, program_unit %lu\r\n",
+                PAL_TRACE("journalInfo: capacity %lu, size %lu, program_unit %lu\r\n",
                     (uint32_t)(pal_pi_mbed_journal_info.capacity),
                     (uint32_t)(pal_pi_mbed_journal_info.sizeofJournaledBlob),
                     (uint32_t)(pal_pi_mbed_journal_info.program_unit));
@@ -665,7 +666,7 @@ int PAL_PI_MBED_Setup_StateMachine_Enter()
             break;
 
         case PAL_PI_SETUP_ERROR:
-            DEBUG_PRINT("PAL_PI_SETUP_ERROR\r\n");
+            PAL_TRACE("PAL_PI_SETUP_ERROR\r\n");
             g_palUpdateServiceCBfunc(PAL_IMAGE_EVENT_ERROR);
             break;
     }
@@ -700,11 +701,11 @@ palStatus_t pal_plat_imageSetHeader(palImageId_t imageId,palImageHeaderDeails_t
 palStatus_t pal_plat_imageReserveSpace(palImageId_t imageId, size_t imageSize)
 {
 	palStatus_t status;
-	DEBUG_PRINT("pal_pi_mbed_active_fsm %d\n", pal_pi_mbed_active_fsm);
+	PAL_TRACE("pal_pi_mbed_active_fsm %d\n", pal_pi_mbed_active_fsm);
 	pal_pi_mbed_active_fsm = PAL_PI_MBED_FSM_SETUP;
 	pal_pi_mbed_setup_state = PAL_PI_SETUP_UNINITIALIZED;
 	status = PAL_PI_MBED_Setup_StateMachine_Enter();
-	DEBUG_PRINT("pal_plat_imageReserveSpace size = %ld\r\n",imageSize);
+	PAL_TRACE("pal_plat_imageReserveSpace size = %lu\r\n",(uint32_t)imageSize);
 	return status;
 }
 
@@ -754,7 +755,7 @@ int PAL_PI_MBED_Write_LogResidual()
 
 void PAL_PI_MBED_Write_StateMachine_Advance(int32_t status)
 {
-	DEBUG_PRINT("status = %d\r\n",status);
+	PAL_TRACE("status = %d\r\n",status);
     if (status < 0)
     {
         pal_pi_mbed_write_state = PAL_PI_WRITE_ERROR;
@@ -789,7 +790,7 @@ int PAL_PI_MBED_Write_StateMachine_Enter(int32_t status)
     switch(pal_pi_mbed_write_state)
     {
         case PAL_PI_WRITE_UNINITIALIZED:
-            DEBUG_PRINT("PAL_PI_WRITE_UNINITIALIZED\r\n");
+            PAL_TRACE("PAL_PI_WRITE_UNINITIALIZED\r\n");
             // If the journal is clean, write metadata header first
             if (pal_pi_mbed_metadata_logged == 0)
             {
@@ -798,7 +799,7 @@ int PAL_PI_MBED_Write_StateMachine_Enter(int32_t status)
                 rc = FlashJournal_log(&pal_pi_mbed_journal, &pal_pi_mbed_firmware_header, sizeof(pal_pi_mbed_firmware_header));
                 if (rc < JOURNAL_STATUS_OK)
                 {
-                	DEBUG_PRINT("FlashJournal_log Error %i\r\n", rc);
+                	PAL_TRACE("FlashJournal_log Error %i\r\n", rc);
                 	rc = palTranslateJournalErr(rc);
                     return rc;
                 }
@@ -813,7 +814,7 @@ int PAL_PI_MBED_Write_StateMachine_Enter(int32_t status)
             break;
 
         case PAL_PI_WRITE_METADATA_LOGGED:
-            DEBUG_PRINT("PAL_PI_WRITE_METADATA_LOGGED\r\n");
+            PAL_TRACE("PAL_PI_WRITE_METADATA_LOGGED\r\n");
 
             if (pal_pi_mbed_metadata_logged == 0 && rc < (int)sizeof(pal_pi_mbed_firmware_header))
             {
@@ -826,7 +827,7 @@ int PAL_PI_MBED_Write_StateMachine_Enter(int32_t status)
             rc = PAL_PI_MBED_Write_LogResidual();
             if (rc < JOURNAL_STATUS_OK)
             {
-            	DEBUG_PRINT("PAL_PI_MBED_Write_LogResidual Error %i\r\n", rc);
+            	PAL_TRACE("PAL_PI_MBED_Write_LogResidual Error %i\r\n", rc);
             	rc = palTranslateJournalErr(rc);
             	return rc;
             }
@@ -839,11 +840,11 @@ int PAL_PI_MBED_Write_StateMachine_Enter(int32_t status)
             break;
 
         case PAL_PI_WRITE_RESIDUAL_LOGGED:
-            DEBUG_PRINT("PAL_PI_WRITE_RESIDUAL_LOGGED\r\n");
+            PAL_TRACE("PAL_PI_WRITE_RESIDUAL_LOGGED\r\n");
 
             pal_pi_mbed_overflow_buffer_size = 0;
 
-            DEBUG_PRINT("fragment_size %d package_fragment=%p\r\n", pal_pi_mbed_write_context.fragment_size,pal_pi_mbed_write_context.package_fragment);
+            PAL_TRACE("fragment_size %d package_fragment=%p\r\n", pal_pi_mbed_write_context.fragment_size, (uint32_t)(uintptr_t)pal_pi_mbed_write_context.package_fragment);
             if (pal_pi_mbed_write_context.fragment_size > 0)
             {
                 rc = FlashJournal_log(&pal_pi_mbed_journal, pal_pi_mbed_write_context.package_fragment, pal_pi_mbed_write_context.fragment_size);
@@ -853,7 +854,7 @@ int PAL_PI_MBED_Write_StateMachine_Enter(int32_t status)
                 }
                 else if (rc < JOURNAL_STATUS_OK)
                 {
-                	DEBUG_PRINT("FlashJournal_log Error %i\r\n", rc);
+                	PAL_TRACE("FlashJournal_log Error %i\r\n", rc);
                 	rc = palTranslateJournalErr(rc);
                 	return rc;
                 }
@@ -868,7 +869,7 @@ int PAL_PI_MBED_Write_StateMachine_Enter(int32_t status)
             break;
 
         case PAL_PI_WRITE_DONE:
-            DEBUG_PRINT("PAL_PI_WRITE_DONE\r\n");
+            PAL_TRACE("PAL_PI_WRITE_DONE\r\n");
             if (status < pal_pi_mbed_write_context.fragment_size)
             {
                 uint32_t residual = pal_pi_mbed_write_context.fragment_size - rc;
@@ -880,7 +881,7 @@ int PAL_PI_MBED_Write_StateMachine_Enter(int32_t status)
             break;
 
         case PAL_PI_WRITE_ERROR:
-            DEBUG_PRINT("PAL_PI_WRITE_ERROR\r\n");
+            PAL_TRACE("PAL_PI_WRITE_ERROR\r\n");
             g_palUpdateServiceCBfunc(PAL_IMAGE_EVENT_ERROR);
             break;
 
@@ -927,7 +928,7 @@ void PAL_PI_MBED_Read_StateMachine_Advance(int32_t status)
             	// if not set by now
             	if (0 == pal_pi_mbed_read_context.buffer->bufferLength)
             	{
-                	DEBUG_PRINT("Working in a-sync mode number of bytes read = %d\r\n",status);
+                	PAL_TRACE("Working in a-sync mode number of bytes read = %d\r\n",status);
                 	pal_pi_mbed_read_context.buffer->bufferLength = status;
             	}
                 pal_pi_mbed_read_state = PAL_PI_READ_DONE;
@@ -947,10 +948,10 @@ int PAL_PI_MBED_Read_StateMachine_Enter()
     switch(pal_pi_mbed_read_state)
     {
         case PAL_PI_READ_SKIP_METADATA:
-            DEBUG_PRINT("PAL_PI_READ_SKIP_METADATA\r\n");
+            PAL_TRACE("PAL_PI_READ_SKIP_METADATA\r\n");
             pal_pi_mbed_read_context.numberOfByesRemain = pal_pi_mbed_firmware_header.totalSize - sizeof(FirmwareHeader_t);
             rc = FlashJournal_read(&pal_pi_mbed_journal, &pal_pi_mbed_firmware_header, sizeof(pal_pi_mbed_firmware_header));
-            DEBUG_PRINT("FlashJournal_read header have return %d size of header is %d\r\n",rc,sizeof(pal_pi_mbed_firmware_header));
+            PAL_TRACE("FlashJournal_read header have return %d size of header is %d\r\n",rc,(uint32_t)sizeof(pal_pi_mbed_firmware_header));
             if (rc <= JOURNAL_STATUS_OK)
             {
             	rc = palTranslateJournalErr(rc);
@@ -961,9 +962,9 @@ int PAL_PI_MBED_Read_StateMachine_Enter()
             break;
 
         case PAL_PI_READ_UNINITIALIZED:
-            DEBUG_PRINT("PAL_PI_READ_UNINITIALIZED\r\n");
+            PAL_TRACE("PAL_PI_READ_UNINITIALIZED\r\n");
             rc = FlashJournal_read(&pal_pi_mbed_journal, pal_pi_mbed_read_context.buffer->buffer, pal_pi_mbed_read_context.buffer->maxBufferLength);
-            DEBUG_PRINT("FlashJournal_read have return %i\r\n",rc);
+            PAL_TRACE("FlashJournal_read have return %i\r\n",rc);
             if (rc > JOURNAL_STATUS_OK) // handle synchronous completion
             {
             	/*
@@ -972,7 +973,7 @@ int PAL_PI_MBED_Read_StateMachine_Enter()
             	 * the API keep tracking on how many byes are left to read from the image.
             	 * if the journal API return that it read more bytes just ignore them
             	 */
-            	DEBUG_PRINT("numberOfByesRemain have  %i\r\n",pal_pi_mbed_read_context.numberOfByesRemain);
+            	PAL_TRACE("numberOfByesRemain have  %i\r\n",pal_pi_mbed_read_context.numberOfByesRemain);
             	if (rc <= pal_pi_mbed_read_context.numberOfByesRemain)
             	{
             		pal_pi_mbed_read_context.buffer->bufferLength = rc;
@@ -982,7 +983,7 @@ int PAL_PI_MBED_Read_StateMachine_Enter()
             	{
             		pal_pi_mbed_read_context.buffer->bufferLength =  pal_pi_mbed_read_context.numberOfByesRemain;
             	}
-            	DEBUG_PRINT("Working in sync mode number of bytes read = %d\r\n",pal_pi_mbed_read_context.buffer->bufferLength);
+            	PAL_TRACE("Working in sync mode number of bytes read = %d\r\n",pal_pi_mbed_read_context.buffer->bufferLength);
             	//in sync mode the return value is the number of bytes that was read
                 PAL_PI_MBED_Read_StateMachine_Advance(0);
                 rc = PAL_PI_MBED_Read_StateMachine_Enter();
@@ -995,12 +996,12 @@ int PAL_PI_MBED_Read_StateMachine_Enter()
             break;
 
         case PAL_PI_READ_DONE:
-            DEBUG_PRINT("PAL_PI_READ_DONE\r\n");
+            PAL_TRACE("PAL_PI_READ_DONE\r\n");
             g_palUpdateServiceCBfunc(PAL_IMAGE_EVENT_READTOBUFFER);
             break;
 
         case PAL_PI_READ_ERROR:
-            DEBUG_PRINT("PAL_PI_READ_ERROR\r\n");
+            PAL_TRACE("PAL_PI_READ_ERROR\r\n");
             g_palUpdateServiceCBfunc(PAL_IMAGE_EVENT_ERROR);
             break;
 
@@ -1017,7 +1018,7 @@ palStatus_t pal_plat_imageReadToBuffer(palImageId_t imageId, size_t offset, palB
 	/*check if this is the 1st time reading if so you have to skip the header
 	 * if not you can read normally
 	 */
-    DEBUG_PRINT("pal_plat_imageReadToBuffer\r\n");
+    PAL_TRACE("pal_plat_imageReadToBuffer\r\n");
     if (pal_pi_mbed_active_fsm != PAL_PI_MBED_FSM_READ)
     {
         pal_pi_mbed_read_state = PAL_PI_READ_SKIP_METADATA;
@@ -1076,7 +1077,7 @@ int PAL_PI_MBED_Commit_StateMachine_Enter()
     switch(pal_pi_mbed_commit_state)
     {
         case PAL_PI_COMMIT_UNINITIALIZED:
-            DEBUG_PRINT("PAL_PI_COMMIT_UNINITIALIZED\r\n");
+            PAL_TRACE("PAL_PI_COMMIT_UNINITIALIZED\r\n");
             rc = FlashJournal_getInfo(&pal_pi_mbed_journal, &pal_pi_mbed_journal_info);
             if (rc < JOURNAL_STATUS_OK)
             {
@@ -1099,7 +1100,7 @@ int PAL_PI_MBED_Commit_StateMachine_Enter()
             break;
 
         case PAL_PI_COMMIT_RESIDUAL_LOGGED:
-            DEBUG_PRINT("PAL_PI_COMMIT_RESIDUAL_LOGGED\r\n");
+            PAL_TRACE("PAL_PI_COMMIT_RESIDUAL_LOGGED\r\n");
             // Clear the overflow buffer
             pal_pi_mbed_overflow_buffer_size = 0;
 
@@ -1118,12 +1119,12 @@ int PAL_PI_MBED_Commit_StateMachine_Enter()
             break;
 
         case PAL_PI_COMMIT_DONE:
-			DEBUG_PRINT("PAL_PI_COMMIT_DONE\r\n");
+			PAL_TRACE("PAL_PI_COMMIT_DONE\r\n");
 			g_palUpdateServiceCBfunc(PAL_IMAGE_EVENT_FINALIZE);
 			break;
 
 		case PAL_PI_COMMIT_ERROR:
-			DEBUG_PRINT("PAL_PI_COMMIT_ERROR\r\n");
+			PAL_TRACE("PAL_PI_COMMIT_ERROR\r\n");
 			g_palUpdateServiceCBfunc(PAL_IMAGE_EVENT_ERROR);
 			break;
         default:
@@ -0,0 +1,119 @@
+# -----------------------------------------------------------------------
+# Copyright (c) 2016 ARM Limited. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+# Licensed under the Apache License, Version 2.0 (the License); you may
+# not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an AS IS BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# -----------------------------------------------------------------------
+
+
+###########################################################################
+# Define test targets based on PROJECT
+# Make files that include this must define PROJECT and TARGET_PLATFORM
+# Requirements
+# - gcc and the pthread/rt libraries of the host.
+#
+# The following targets may also be defined:
+# $(PROJECT)_ADDITIONAL_SOURCES
+#
+# Tests needing a network interface use the one named by PAL_TEST_NET_INTERFACE (default eth0).
+###########################################################################
+
+# Add targets for platform/project combination
+.PHONY: $(TARGET_PLATFORM)_all $(TARGET_PLATFORM)_clean $(TARGET_PLATFORM)_check
+$(TARGET_PLATFORM)_all: $(TARGET_PLATFORM)_$(PROJECT)
+$(TARGET_PLATFORM)_clean: $(TARGET_PLATFORM)_clean_$(PROJECT)
+$(TARGET_PLATFORM)_check: $(TARGET_PLATFORM)_check_$(PROJECT)
+
+# Process command line argument of the form INCLUDE=, in order to pass it to the compilation.
+# One or more tests can be selected in this way. If the argument is not present then all tests are selected.
+$(info PAL_TEST=$(PAL_TEST))
+ifeq ($(strip $(PAL_TEST)),)
+  CC_TESTS = PAL_INCLUDE=1
+else
+  CC_TESTS = PAL_INCLUDE=0 $(patsubst %,%=1, $(PAL_TEST))
+endif
+
+# Define variables to be used in the recipes of the targets in the context of the main target.
+# We do this because the original variables will be overridden by other make files by the time the
+# recipe is executed. Note that these variables are recursively inherited by all prerequisites.
+$(TARGET_PLATFORM)_$(PROJECT) : LINUX_CC_TESTS_D := $(patsubst %,-D%, $(CC_TESTS))
+#################################################################################################################
+# Target platform dependant definitions.
+
+ifeq ($(DEBUG), 1)
+  $(info "DEBUG")
+  $(TARGET_PLATFORM)_$(PROJECT) : DEBUG_FLAGS += -DDEBUG -g -O0
+else
+  $(TARGET_PLATFORM)_$(PROJECT) : DEBUG_FLAGS += -O2
+endif
+
+ifeq ($(VERBOSE), 1)
+  $(info "VERBOSE")
+  $(TARGET_PLATFORM)_$(PROJECT) : DEBUG_FLAGS += -DVERBOSE
+endif
+
+# compiler defaults
+ifeq ($(strip $(LINUX_CC)),)
+	LINUX_CC = gcc
+endif
+
+LINUX_CFLAGS = -std=gnu99 -Wall -D__LINUX__ -D_GNU_SOURCE
+LINUX_LIBS = -lpthread -lrt
+
+#################################################################################################################
+
+### UNITY FILES ###
+UNITY_ROOT=$(PAL_ROOT)/Test/Unity
+UNITY_INCLUDE_PATHS=$(UNITY_ROOT)/src $(UNITY_ROOT)/extras/fixture/src
+INCLUDE_PATHS = $(UNITY_INCLUDE_PATHS) $(PAL_ROOT)/Source/PAL-Impl/Services-API $(PAL_ROOT)/Source/Port/Platform-API  $(PAL_ROOT)/Test/Common $(PAL_ROOT)/Source/Port/Reference-Impl/$(TARGET_PLATFORM)/CFStore
+UNITY_OBJECTS = $(UNITY_ROOT)/src/unity.c $(UNITY_ROOT)/extras/fixture/src/unity_fixture.c
+###################
+
+# Fixed list of test files for each test executable.
+TST_SOURCES:=	$(UNITY_OBJECTS) \
+				$(wildcard $(PAL_ROOT)/Test/Common/*.c) \
+				$(PAL_ROOT)/Test/$(TYPE)/$(PROJECT)_test.c \
+				$(PAL_ROOT)/Test/$(TYPE)/$(PROJECT)_test_runner.c \
+				$(PAL_ROOT)/Test/$(TYPE)/$(PROJECT)_test_main_$(TARGET_PLATFORM).c \
+				$($(PROJECT)_ADDITIONAL_SOURCES)
+
+# Build executables.
+.PHONY: $(TARGET_PLATFORM)_$(PROJECT)
+$(TARGET_PLATFORM)_$(PROJECT):  $(OUT)/$(PROJECT).elf
+
+$(TARGET_PLATFORM)_$(PROJECT):  INCLUDE_PATHS:=$(INCLUDE_PATHS)
+
+# Always rebuild since PAL_TEST argument change requires that the test runner is recompiled.
+$(OUT)/$(PROJECT).elf:  $(TST_SOURCES) .FORCE
+	$(MKDIR_QUIET) $(dir $@)
+	$(LINUX_CC) $(LINUX_CFLAGS) $(addprefix -I, $(INCLUDE_PATHS)) $(LINUX_CC_TESTS_D) $(DEBUG_FLAGS) -o $@ $(filter-out .FORCE, $^) $(LINUX_LIBS)
+
+# Create a list of files to delete for each target on the first pass of the make
+$(TARGET_PLATFORM)_clean_$(PROJECT) : OUTPUTS:= $(OUT)
+
+
+# Remove files in the list $(PROJECT)_OUTPUTS.
+# We dynamically create the list variable from the target
+PHONY: $(TARGET_PLATFORM)_clean_$(PROJECT)
+$(TARGET_PLATFORM)_clean_$(PROJECT):
+	$(RM) $(OUTPUTS)
+
+# This makes sure anyone who is dependant on it always executes its recipe
+.FORCE:
+
+# Always run the test. The executable returns the number of failed tests.
+$(OUT)/$(PROJECT)_result.txt: $(TARGET_PLATFORM)_$(PROJECT) $(OUT)/$(PROJECT).elf .FORCE
+	set -o pipefail; $(word 2, $^) | tee $@
+
+# check. Run tests
+.PHONY: $(TARGET_PLATFORM)check_$(PROJECT)
+$(TARGET_PLATFORM)_check_$(PROJECT):  $(OUT)/$(PROJECT)_result.txt
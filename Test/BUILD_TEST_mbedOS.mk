@@ -76,11 +76,6 @@ ifeq ($(DEBUG), 1)
   $(TARGET_PLATFORM)_$(PROJECT) : DEBUG_FLAGS += -DDEBUG
 endif
 
-ifeq ($(PAL_IGNORE_UNIQUE_THREAD_PRIORITY), 1)
-  $(info "PAL_IGNORE_UNIQUE_THREAD_PRIORITY")
-  $(TARGET_PLATFORM)_$(PROJECT) : DEBUG_FLAGS += -DPAL_IGNORE_UNIQUE_THREAD_PRIORITY
-endif
-
 ifeq ($(VERBOSE), 1)
   $(info "VERBOSE")
   $(TARGET_PLATFORM)_$(PROJECT) : DEBUG_FLAGS += -DVERBOSE
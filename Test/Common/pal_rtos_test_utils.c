@@ -19,6 +19,7 @@
 #include "unity_fixture.h"
 
 #include "pal.h"
+#include "string.h"
 
 threadsArgument_t threadsArg;
 timerArgument_t timerArgs;
@@ -48,11 +49,11 @@ void palThreadFunc1(void const *argument)
     TEST_PRINTF("palThreadFunc1::Thread ID is %d\n", threadID);
 
     threadStorage = pal_osThreadGetLocalStore();
-    if (threadStorage == g_threadStorage)
+    if (threadStorage == (palThreadLocalStore_t*)g_threadStorage)
     {
         TEST_PRINTF("Thread storage updated as expected\n");    
     }
-    TEST_ASSERT_EQUAL(threadStorage, g_threadStorage);
+    TEST_ASSERT_EQUAL_PTR((palThreadLocalStore_t*)g_threadStorage, threadStorage);
 #ifdef MUTEX_UNITY_TEST
     status = pal_osMutexRelease(mutex1);
     TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
@@ -215,6 +216,17 @@ void palTimerFunc2(void const *argument)
     TEST_PRINTF("Periodic Timer function was called\n");    
 }
 
+void palTimerFuncWheel(void const *argument)
+{
+    wheelTimerArgument_t* timerArgument = (wheelTimerArgument_t*)argument;
+
+    if (0 == timerArgument->fired)
+    {
+        timerArgument->firedTick = pal_osKernelSysTick64();
+    }
+    timerArgument->fired++;
+}
+
 void palThreadFuncCustom1(void const *argument)
 {
     TEST_PRINTF("palThreadFuncCustom1 was called\n");
@@ -245,12 +257,13 @@ void palRunThreads()
   palThreadID_t threadID5 = NULLPTR;
   palThreadID_t threadID6 = NULLPTR;
 
-  uint32_t *stack1 = malloc(THREAD_STACK_SIZE);
-  uint32_t *stack2 = malloc(THREAD_STACK_SIZE);
-  uint32_t *stack3 = malloc(THREAD_STACK_SIZE);
-  uint32_t *stack4 = malloc(THREAD_STACK_SIZE);
-  uint32_t *stack5 = malloc(THREAD_STACK_SIZE);
-  uint32_t *stack6 = malloc(THREAD_STACK_SIZE);
+  //! the threads keep running on their stacks after this function returns.
+  static uint32_t stack1[THREAD_STACK_SIZE / sizeof(uint32_t)];
+  static uint32_t stack2[THREAD_STACK_SIZE / sizeof(uint32_t)];
+  static uint32_t stack3[THREAD_STACK_SIZE / sizeof(uint32_t)];
+  static uint32_t stack4[THREAD_STACK_SIZE / sizeof(uint32_t)];
+  static uint32_t stack5[THREAD_STACK_SIZE / sizeof(uint32_t)];
+  static uint32_t stack6[THREAD_STACK_SIZE / sizeof(uint32_t)];
 
   status = pal_init(NULL);
   TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
@@ -272,12 +285,376 @@ void palRunThreads()
 
   status = pal_osThreadCreate(palThreadFunc6, &g_threadsArg, PAL_osPriorityHigh, THREAD_STACK_SIZE, stack6, NULL, &threadID6);
   TEST_ASSERT_EQUAL(PAL_SUCCESS, status); 
+}
+
+threadIdBenchmark_t g_threadIdBenchmark = {0};
+
+void palThreadFuncGetIdBenchmark(void const *argument)
+{
+    threadIdBenchmark_t* benchmark = (threadIdBenchmark_t*)argument;
+    volatile palThreadID_t threadID = PAL_INVALID_THREAD;
+    palThreadLocalStore_t* volatile store = NULL;
+    uint64_t start = 0;
+    uint32_t i = 0;
+
+    start = pal_osKernelSysTick64();
+    for (i = 0; i < PAL_RTOS_BENCHMARK_ITERATIONS; ++i)
+    {
+        threadID = pal_osThreadGetId();
+    }
+    benchmark->getIdTicks = pal_osKernelSysTick64() - start;
+    benchmark->threadID = threadID;
+
+    start = pal_osKernelSysTick64();
+    for (i = 0; i < PAL_RTOS_BENCHMARK_ITERATIONS; ++i)
+    {
+        store = pal_osThreadGetLocalStore();
+    }
+    benchmark->getLocalStoreTicks = pal_osKernelSysTick64() - start;
+    if (store != benchmark->store)
+    {
+        benchmark->errors++;
+    }
+
+    pal_osSemaphoreRelease(benchmark->done);
+}
+
+void palThreadFuncPool(void const *argument)
+{
+    poolThreadsArgument_t* arg = (poolThreadsArgument_t*)argument;
+    void* blocks[MEMORY_POOL_THREAD_BULK];
+    uint32_t allocated = 0;
+    uint32_t round = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+
+    for (round = 0; round < MEMORY_POOL_THREAD_ROUNDS; ++round)
+    {
+        if (0 == (round & 1))
+        {
+            pal_osPoolAllocBulk(arg->poolID, blocks, MEMORY_POOL_THREAD_BULK, &allocated);
+        }
+        else
+        {
+            for (allocated = 0; allocated < MEMORY_POOL_THREAD_BULK; ++allocated)
+            {
+                blocks[allocated] = pal_osPoolAlloc(arg->poolID);
+                if (NULL == blocks[allocated])
+                {
+                    break;
+                }
+            }
+        }
+        if (MEMORY_POOL_THREAD_BULK != allocated)
+        {
+            arg->errors++;
+        }
+
+        for (i = 0; i < allocated; ++i)
+        {
+            memset(blocks[i], arg->pattern, MEMORY_POOL3_BLOCK_SIZE);
+        }
+        if (0 == (round % 256))
+        {
+            pal_osDelay(1); // let the other thread run while blocks are held
+        }
+        for (i = 0; i < allocated; ++i)
+        {
+            for (j = 0; j < MEMORY_POOL3_BLOCK_SIZE; ++j)
+            {
+                if (arg->pattern != ((uint8_t*)blocks[i])[j])
+                {
+                    arg->errors++;
+                    break;
+                }
+            }
+        }
+
+        if (0 == (round & 2))
+        {
+            pal_osPoolFreeBulk(arg->poolID, blocks, allocated);
+        }
+        else
+        {
+            for (i = 0; i < allocated; ++i)
+            {
+                pal_osPoolFree(arg->poolID, blocks[i]);
+            }
+        }
+    }
+
+    pal_osSemaphoreRelease(arg->done);
+}
+
+uint64_t g_tickStressTick = 0;
+uint32_t g_tickStressState = 0;
+uint32_t g_tickSequenceValue = 0;
+
+uint32_t palTickFuncStress(void)
+{
+    return (uint32_t)(pal_osAtomicFetchAdd64(&g_tickStressTick, TICK_STRESS_STEP, PAL_MEMORY_ORDER_SEQ_CST) + TICK_STRESS_STEP);
+}
+
+uint32_t palTickFuncSequence(void)
+{
+    return g_tickSequenceValue;
+}
+
+void palThreadFuncTickStress(void const *argument)
+{
+    tickStressArgument_t* stress = (tickStressArgument_t*)argument;
+    uint64_t previous = 0;
+    uint64_t current = 0;
+    uint64_t before = 0;
+    uint64_t after = 0;
+    uint32_t i = 0;
+
+    for (i = 0; i < TICK_STRESS_READS; ++i)
+    {
+        //! the extended tick is one of the simulated ticks read during the call, a lost (or doubled) wraparound is off by 2^32
+        before = pal_osAtomicLoad64(&g_tickStressTick, PAL_MEMORY_ORDER_SEQ_CST);
+        current = pal_osKernelSysTickExtend(&g_tickStressState, palTickFuncStress);
+        after = pal_osAtomicLoad64(&g_tickStressTick, PAL_MEMORY_ORDER_SEQ_CST);
+        if ((current <= before) || (current > after) || (current <= previous))
+        {
+            stress->errors++;
+        }
+        previous = current;
+    }
+    pal_osSemaphoreRelease(stress->done);
+}
+
+void palThreadFuncAtomicStress(void const *argument)
+{
+    atomicStressArgument_t* arg = (atomicStressArgument_t*)argument;
+    atomicStressShared_t* shared = arg->shared;
+    uint64_t expected64 = 0;
+    uint32_t expected32 = 0;
+    uint32_t i = 0;
+
+    pal_osAtomicFetchOr32(&shared->bits, 1 << arg->index, PAL_MEMORY_ORDER_RELAXED);
+    for (i = 0; i < ATOMIC_STRESS_ITERATIONS; ++i)
+    {
+        pal_osAtomicFetchAdd32(&shared->counter32, 1, PAL_MEMORY_ORDER_RELAXED);
+        pal_osAtomicFetchAdd64(&shared->counter64, ATOMIC_STRESS_STEP64, PAL_MEMORY_ORDER_ACQ_REL);
+        expected32 = pal_osAtomicLoad32(&shared->casCounter32, PAL_MEMORY_ORDER_RELAXED);
+        while (!pal_osAtomicCompareAndSwap32(&shared->casCounter32, &expected32, expected32 + 1, PAL_MEMORY_ORDER_ACQ_REL));
+        //! add and take back through the 64 bit swap, which leaves the counter unchanged
+        expected64 = pal_osAtomicLoad64(&shared->counter64, PAL_MEMORY_ORDER_RELAXED);
+        while (!pal_osAtomicCompareAndSwap64(&shared->counter64, &expected64, expected64 + 1, PAL_MEMORY_ORDER_SEQ_CST));
+        pal_osAtomicFetchSub64(&shared->counter64, 1, PAL_MEMORY_ORDER_SEQ_CST);
+    }
+    pal_osSemaphoreRelease(arg->done);
+}
+
+logTest_t g_logTest = {0};
+
+void palTestLogSink(const char* line)
+{
+    int32_t count = 0;
+
+    strncpy(g_logTest.lastLine, line, LOG_TEST_LINE_SIZE - 1);
+    g_logTest.lines++;
+    if (g_logTest.blocked)
+    {
+        pal_osSemaphoreWait(g_logTest.gate, PAL_RTOS_WAIT_FOREVER, &count);
+    }
+}
+
+void palThreadFuncLog(void const *argument)
+{
+    logThreadArgument_t* arg = (logThreadArgument_t*)argument;
+    uint32_t i = 0;
+
+    for (i = 0; i < LOG_TEST_MESSAGES; ++i)
+    {
+        pal_osLogPrintf(__FUNCTION__, __LINE__, "thread %u message %u of %s\n", arg->index, i, "palThreadFuncLog");
+    }
+    pal_osSemaphoreRelease(arg->done);
+}
+
+executorTest_t g_executorTest = {0};
+
+void palWorkFuncCount(void* argument)
+{
+    (void)argument;
+    pal_osAtomicFetchAdd32(&g_executorTest.executed, 1, PAL_MEMORY_ORDER_RELAXED);
+}
+
+void palWorkFuncGate(void* argument)
+{
+    int32_t count = 0;
+
+    (void)argument;
+    pal_osSemaphoreWait(g_executorTest.gate, PAL_RTOS_WAIT_FOREVER, &count);
+    pal_osAtomicFetchAdd32(&g_executorTest.executed, 1, PAL_MEMORY_ORDER_RELAXED);
+}
 
-  
-  free(stack1);
-  free(stack2);
-  free(stack3);
-  free(stack4);
-  free(stack5);
-  free(stack6);
+void palWorkFuncRecordOrder(void* argument)
+{
+    uint32_t index = pal_osAtomicFetchAdd32(&g_executorTest.orderCount, 1, PAL_MEMORY_ORDER_RELAXED);
+
+    g_executorTest.order[index] = (uint32_t)(uintptr_t)argument;
+    pal_osAtomicFetchAdd32(&g_executorTest.executed, 1, PAL_MEMORY_ORDER_RELAXED);
+}
+
+void palWorkFuncCompletion(void* argument)
+{
+    (void)argument;
+    if ((pal_osAtomicFetchAdd32(&g_executorTest.completed, 1, PAL_MEMORY_ORDER_ACQ_REL) + 1) == g_executorTest.expected)
+    {
+        pal_osSemaphoreRelease(g_executorTest.done);
+    }
+}
+
+threadScaleTest_t g_threadScaleTest = {0};
+
+void palThreadFuncScale(void const *argument)
+{
+    int32_t count = 0;
+
+    (void)argument;
+    pal_osAtomicFetchAdd32(&g_threadScaleTest.started, 1, PAL_MEMORY_ORDER_RELAXED);
+    pal_osSemaphoreWait(g_threadScaleTest.release, PAL_RTOS_WAIT_FOREVER, &count);
+    pal_osAtomicFetchAdd32(&g_threadScaleTest.finished, 1, PAL_MEMORY_ORDER_RELAXED);
+}
+
+void palThreadFuncStackUse(void const *argument)
+{
+    volatile uint8_t buffer[STACK_POOL_TEST_USED_BYTES];
+
+    memset((void*)buffer, 0, sizeof(buffer));
+    pal_osSemaphoreRelease(*(palSemaphoreID_t*)argument);
+}
+
+void palThreadFuncStats(void const *argument)
+{
+    threadStatsTest_t* test = (threadStatsTest_t*)argument;
+    volatile uint8_t buffer[STACK_POOL_TEST_USED_BYTES];
+#if defined(__LINUX__)
+    //! the thread burns CPU time, not wall time, which a loaded host stretches. the wall time is bounded by half the hold time.
+    uint64_t end = pal_osKernelSysTick64() + pal_osKernelSysTickMicroSec(THREAD_STATS_TEST_HOLD_MS * 500);
+    palThreadStats_t stats;
+
+    memset((void*)buffer, 0, sizeof(buffer));
+    while ((pal_osKernelSysTick64() < end) && (PAL_SUCCESS == pal_osThreadGetStats(pal_osThreadGetId(), &stats)) &&
+           (stats.runTimeMicroSec < (THREAD_STATS_TEST_RUN_MS * 1000)));
+#else
+    uint64_t end = pal_osKernelSysTick64() + pal_osKernelSysTickMicroSec(THREAD_STATS_TEST_RUN_MS * 1000);
+
+    memset((void*)buffer, 0, sizeof(buffer));
+    while (pal_osKernelSysTick64() < end);
+#endif
+
+    pal_osMutexWait(test->mutex, PAL_RTOS_WAIT_FOREVER);
+    pal_osMutexRelease(test->mutex);
+    pal_osSemaphoreRelease(test->done);
+    pal_osSemaphoreWait(test->release, PAL_RTOS_WAIT_FOREVER, NULL);
+}
+
+void palLockStatsFind(const palLockStats_t* stats, void* funcArgument)
+{
+    lockStatsFind_t* find = (lockStatsFind_t*)funcArgument;
+
+    if (stats->id == find->id)
+    {
+        find->stats = *stats;
+        find->found = true;
+    }
+}
+
+void palThreadFuncRwLockReader(void const *argument)
+{
+    rwLockTest_t* test = (rwLockTest_t*)argument;
+    palStatus_t status = PAL_SUCCESS;
+    uint32_t sum = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+
+    for (i = 0; i < PAL_RTOS_BENCHMARK_ITERATIONS; ++i)
+    {
+        status = test->useMutex ? pal_osMutexWait(test->mutexID, PAL_RTOS_WAIT_FOREVER) : pal_osRwLockReadLock(test->rwLockID, PAL_RTOS_WAIT_FOREVER);
+        if (PAL_SUCCESS != status)
+        {
+            pal_osAtomicIncrement((int32_t*)&test->errors, 1);
+            continue;
+        }
+        sum = 0;
+        for (j = 0; j < RWLOCK_TEST_TABLE_SIZE; ++j)
+        {
+            sum += test->table[j];
+        }
+        status = test->useMutex ? pal_osMutexRelease(test->mutexID) : pal_osRwLockUnlock(test->rwLockID);
+        if ((PAL_SUCCESS != status) || (RWLOCK_TEST_TABLE_SIZE != sum))
+        {
+            pal_osAtomicIncrement((int32_t*)&test->errors, 1);
+        }
+    }
+    pal_osSemaphoreRelease(test->done);
+}
+
+void palThreadFuncRwLockWriter(void const *argument)
+{
+    rwLockTest_t* test = (rwLockTest_t*)argument;
+
+    if (PAL_SUCCESS == pal_osRwLockWriteLock(test->rwLockID, PAL_RTOS_WAIT_FOREVER))
+    {
+        test->written++;
+        pal_osRwLockUnlock(test->rwLockID);
+    }
+    pal_osSemaphoreRelease(test->done);
+}
+
+void palThreadFuncEventFlagsWaiter(void const *argument)
+{
+    syncTest_t* test = (syncTest_t*)argument;
+
+    if (PAL_SUCCESS == pal_osEventFlagsWait(test->eventFlagsID, test->waitFlags, PAL_OS_FLAGS_WAIT_ALL, PAL_RTOS_WAIT_FOREVER, &test->flags))
+    {
+        pal_osAtomicIncrement((int32_t*)&test->woken, 1);
+    }
+    pal_osSemaphoreRelease(test->done);
+}
+
+void palThreadFuncCondVarWaiter(void const *argument)
+{
+    syncTest_t* test = (syncTest_t*)argument;
+
+    pal_osMutexWait(test->mutexID, PAL_RTOS_WAIT_FOREVER);
+    while (0 == test->tickets)
+    {
+        pal_osCondVarWait(test->condVarID, test->mutexID, PAL_RTOS_WAIT_FOREVER);
+    }
+    test->tickets--;
+    test->woken++;
+    pal_osMutexRelease(test->mutexID);
+    pal_osSemaphoreRelease(test->done);
+}
+
+void palThreadFuncSpscRingProducer(void const *argument)
+{
+    queueBenchmark_t* benchmark = (queueBenchmark_t*)argument;
+    uint32_t i = 0;
+
+    for (i = 0; i < PAL_RTOS_BENCHMARK_ITERATIONS; ++i)
+    {
+        if (PAL_SUCCESS != pal_osSpscRingPush(benchmark->ringID, &i, PAL_RTOS_WAIT_FOREVER))
+        {
+            benchmark->errors++;
+        }
+    }
+}
+
+void palThreadFuncMessageQueueProducer(void const *argument)
+{
+    queueBenchmark_t* benchmark = (queueBenchmark_t*)argument;
+    uint32_t i = 0;
+
+    for (i = 0; i < PAL_RTOS_BENCHMARK_ITERATIONS; ++i)
+    {
+        if (PAL_SUCCESS != pal_osMessagePut(benchmark->messageQID, i, PAL_RTOS_WAIT_FOREVER))
+        {
+            benchmark->errors++;
+        }
+    }
 }
@@ -57,6 +57,19 @@ extern timerArgument_t g_timerArgs;
 void palTimerFunc1(void const *argument);
 void palTimerFunc2(void const *argument);
 
+#define WHEEL_TIMER_TEST_COUNT 128
+#define WHEEL_TIMER_TEST_MAX_DELAY 1500
+//! how late a wheel timer may fire, on top of its two ticks resolution, on a loaded test machine.
+#define WHEEL_TIMER_TEST_TOLERANCE 200
+
+typedef struct wheelTimerArgument{
+    uint64_t startTick;
+    uint64_t firedTick;
+    uint32_t fired;
+}wheelTimerArgument_t;
+
+void palTimerFuncWheel(void const *argument);
+
 
 void palThreadFuncCustom1(void const *argument);
 void palThreadFuncCustom2(void const *argument);
@@ -64,10 +77,219 @@ void palThreadFuncCustom3(void const *argument);
 void palThreadFuncCustom4(void const *argument);
 
 
+//! number of calls measured by the thread id / local store benchmark.
+#define PAL_RTOS_BENCHMARK_ITERATIONS 100000
+
+typedef struct threadIdBenchmark{
+    palSemaphoreID_t done;
+    palThreadLocalStore_t* store;
+    palThreadID_t threadID;
+    uint32_t errors;
+    uint64_t getIdTicks;
+    uint64_t getLocalStoreTicks;
+}threadIdBenchmark_t;
+
+extern threadIdBenchmark_t g_threadIdBenchmark;
+
+void palThreadFuncGetIdBenchmark(void const *argument);
+
+#define TICK_STRESS_THREADS 3
+#define TICK_STRESS_READS 100000
+//! each read of the simulated tick advances it by this much, so it wraps around every 4096 reads.
+#define TICK_STRESS_STEP 0x00100000
+
+typedef struct tickStressArgument{
+    palSemaphoreID_t done;
+    uint32_t errors;
+}tickStressArgument_t;
+
+//! the simulated tick in 64 bits, and the state word the threads extend its low 32 bits with.
+extern uint64_t g_tickStressTick;
+extern uint32_t g_tickStressState;
+//! the value palTickFuncSequence returns.
+extern uint32_t g_tickSequenceValue;
+
+uint32_t palTickFuncStress(void);
+uint32_t palTickFuncSequence(void);
+void palThreadFuncTickStress(void const *argument);
+
+#define ATOMIC_STRESS_THREADS 3
+#define ATOMIC_STRESS_ITERATIONS 100000
+//! a 64 bit step, so the 64 bit counter carries into its upper half.
+#define ATOMIC_STRESS_STEP64 0x10001ULL
+
+typedef struct atomicStressShared{
+    uint32_t counter32;
+    uint32_t casCounter32;
+    uint32_t bits;
+    uint64_t counter64;
+}atomicStressShared_t;
+
+typedef struct atomicStressArgument{
+    palSemaphoreID_t done;
+    atomicStressShared_t* shared;
+    uint32_t index;
+}atomicStressArgument_t;
+
+void palThreadFuncAtomicStress(void const *argument);
+
+#define LOG_TEST_THREADS 3
+#define LOG_TEST_MESSAGES 200
+#define LOG_TEST_LINE_SIZE 256
+
+typedef struct logTest{
+    palSemaphoreID_t gate;      //! the sink waits on it while blocked is set
+    bool blocked;
+    uint32_t lines;
+    char lastLine[LOG_TEST_LINE_SIZE];
+}logTest_t;
+
+extern logTest_t g_logTest;
+
+typedef struct logThreadArgument{
+    palSemaphoreID_t done;
+    uint32_t index;
+}logThreadArgument_t;
+
+void palTestLogSink(const char* line);
+void palThreadFuncLog(void const *argument);
+
+#define EXECUTOR_TEST_WORKERS 3
+#define EXECUTOR_TEST_QUEUE_SIZE 64
+#define EXECUTOR_TEST_WORK_ITEMS 150
+
+typedef struct executorTest{
+    palSemaphoreID_t gate;  //! palWorkFuncGate waits on it
+    palSemaphoreID_t done;  //! released by the completion of the last work
+    uint32_t expected;
+    uint32_t executed;
+    uint32_t completed;
+    uint32_t orderCount;
+    uint32_t order[EXECUTOR_TEST_WORK_ITEMS];
+}executorTest_t;
+
+extern executorTest_t g_executorTest;
+
+void palWorkFuncCount(void* argument);
+void palWorkFuncGate(void* argument);
+void palWorkFuncRecordOrder(void* argument);
+void palWorkFuncCompletion(void* argument);
+
+#define THREAD_SCALE_TEST_THREADS 32
+
+typedef struct threadScaleTest{
+    palSemaphoreID_t release;  //! the threads wait on it before they return
+    uint32_t started;
+    uint32_t finished;
+}threadScaleTest_t;
+
+extern threadScaleTest_t g_threadScaleTest;
+
+void palThreadFuncScale(void const *argument);
+
+#define STACK_POOL_TEST_STACK_SIZE 40000 // served by the 65536 bytes class, large enough for a Linux thread to run on it
+#define STACK_POOL_TEST_CLASS 3
+#define STACK_POOL_TEST_USED_BYTES 2048
+
+void palThreadFuncStackUse(void const *argument);
+
+#define THREAD_STATS_TEST_RUN_MS 20        // CPU time the thread burns
+#define THREAD_STATS_TEST_HOLD_MS 100      // the mutex is held this long after the thread was created
+
+typedef struct threadStatsTest{
+    palMutexID_t mutex;         //! held by the test while the thread starts
+    palSemaphoreID_t done;      //! released by the thread once it got the mutex
+    palSemaphoreID_t release;   //! the thread waits on it before it returns
+}threadStatsTest_t;
+
+void palThreadFuncStats(void const *argument);
+
+typedef struct lockStatsFind{
+    uintptr_t id;           //! the mutex or semaphore to find
+    palLockStats_t stats;
+    bool found;
+}lockStatsFind_t;
+
+void palLockStatsFind(const palLockStats_t* stats, void* funcArgument);
+
+#define RWLOCK_BENCHMARK_MAX_READERS 8
+#define RWLOCK_TEST_TABLE_SIZE 16
+#define RWLOCK_TEST_WAIT_MS 50
+
+typedef struct rwLockTest{
+    palRwLockID_t rwLockID;
+    palMutexID_t mutexID;       //! the readers take it instead of the reader-writer lock when useMutex is true
+    bool useMutex;
+    palSemaphoreID_t done;      //! released by each thread when it finished
+    uint32_t table[RWLOCK_TEST_TABLE_SIZE];
+    uint32_t written;
+    uint32_t errors;
+}rwLockTest_t;
+
+void palThreadFuncRwLockReader(void const *argument);
+void palThreadFuncRwLockWriter(void const *argument);
+
+#define SYNC_TEST_WAIT_MS 50
+#define SYNC_TEST_WAITERS 3
+
+typedef struct syncTest{
+    palEventFlagsID_t eventFlagsID;
+    palCondVarID_t condVarID;
+    palMutexID_t mutexID;       //! guards tickets and woken
+    palSemaphoreID_t done;      //! released by each thread when it finished
+    uint32_t waitFlags;         //! the flags palThreadFuncEventFlagsWaiter waits for, all of them
+    uint32_t flags;             //! the flags which ended its wait
+    uint32_t tickets;           //! each palThreadFuncCondVarWaiter waits for a ticket and takes it
+    uint32_t woken;
+}syncTest_t;
+
+void palThreadFuncEventFlagsWaiter(void const *argument);
+void palThreadFuncCondVarWaiter(void const *argument);
+
+
 #define MEMORY_POOL1_BLOCK_SIZE 32
 #define MEMORY_POOL1_BLOCK_COUNT 5
 #define MEMORY_POOL2_BLOCK_SIZE 12
 #define MEMORY_POOL2_BLOCK_COUNT 4
+#define MEMORY_POOL3_BLOCK_SIZE 16
+//! enough blocks for the pool to be cached with the default configuration (2 * PAL_MAX_NUMBER_OF_THREADS * PAL_RTOS_POOL_THREAD_CACHE_SIZE).
+#define MEMORY_POOL3_BLOCK_COUNT 512
+
+#define SLAB_TEST_MAX_BLOCKS 64
+#define SLAB_TEST_LARGE_ALLOCATION 4096
+
+//! number of bulk alloc/free rounds each thread of the memory pool threads test runs.
+#define MEMORY_POOL_THREAD_ROUNDS 20000
+#define MEMORY_POOL_THREAD_BULK 8
+
+typedef struct poolThreadsArgument{
+    palMemoryPoolID_t poolID;
+    palSemaphoreID_t done;
+    uint8_t pattern;
+    uint32_t errors;
+}poolThreadsArgument_t;
+
+void palThreadFuncPool(void const *argument);
+
+#define TYPED_MESSAGE_QUEUE_SIZE 4
+
+typedef struct typedMessage{
+    uint64_t sequence;
+    uint16_t length;
+    void* payload;
+}typedMessage_t;
+
+#define SPSC_RING_TEST_CAPACITY 8
+#define SPSC_RING_BENCHMARK_CAPACITY 256
+
+typedef struct queueBenchmark{
+    palSpscRingID_t ringID;
+    palMessageQID_t messageQID;
+    uint32_t errors;
+}queueBenchmark_t;
+
+void palThreadFuncSpscRingProducer(void const *argument);
+void palThreadFuncMessageQueueProducer(void const *argument);
 
 extern palMutexID_t mutex1;
 extern palMutexID_t mutex2;
@@ -0,0 +1,42 @@
+/*
+* Copyright (c) 2016 ARM Limited. All rights reserved.
+* SPDX-License-Identifier: Apache-2.0
+* Licensed under the Apache License, Version 2.0 (the License); you may
+* not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an AS IS BASIS, WITHOUT
+* WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#if defined(__LINUX__)
+
+#include "pal.h"
+#include "pal_network.h"
+#include "pal_socket_test_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TEST_PRINTF printf
+
+//! Interface used when PAL_TEST_NET_INTERFACE is not set in the environment.
+#define PAL_TEST_DEFAULT_NET_INTERFACE "eth0"
+
+void* palTestGetNetWorkInterfaceContext()
+{
+    // On Linux the network interface context is the interface name, the interface is brought up by the host.
+    const char* interfaceName = getenv("PAL_TEST_NET_INTERFACE");
+    if (NULL == interfaceName)
+    {
+        interfaceName = PAL_TEST_DEFAULT_NET_INTERFACE;
+    }
+    TEST_PRINTF("using interface %s\r\n", interfaceName);
+    return (void*)interfaceName;
+}
+
+#endif //__LINUX__
@@ -0,0 +1,184 @@
+# -----------------------------------------------------------------------
+# Copyright (c) 2016 ARM Limited. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+# Licensed under the Apache License, Version 2.0 (the License); you may
+# not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an AS IS BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# -----------------------------------------------------------------------
+
+# Decodes a PAL_TRACE snapshot (pal_osTraceSnapshot) to text, with the format
+# strings read from the pal_trace_fmt section of the ELF file of the program.
+#
+# usage: pal_trace_decode.py <program.elf> <snapshot.bin>
+#        pal_trace_decode.py --hex <program.elf> <snapshot.txt>  (the snapshot as hex digits, whitespace is ignored)
+
+import re
+import struct
+import sys
+
+TRACE_SECTION_NAME = "pal_trace_fmt"
+SNAPSHOT_MAGIC = 0x544C4150
+SNAPSHOT_VERSION = 2
+SNAPSHOT_HEADER_FORMAT = "IHHIII"
+ENTRY_FIXED_WORDS = 5 # sequence, id, timestamp, timestampHigh, argumentCount
+
+# A printf conversion specification: flags, width, precision, length and conversion.
+SPEC_PATTERN = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|L|z|j|t)?([diouxXcsfFeEgGaApn%])")
+
+
+def read_trace_section(elfPath):
+
+    with open(elfPath, "rb") as elfFile:
+        elf = elfFile.read()
+
+    if elf[:4] != b"\x7fELF":
+        raise ValueError("{} is not an ELF file".format(elfPath))
+
+    is64 = (2 == bytearray(elf)[4])
+    endian = "<" if (1 == bytearray(elf)[5]) else ">"
+
+    if is64:
+        shoff, = struct.unpack_from(endian + "Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", elf, 0x3A)
+        sectionFormat = endian + "IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from(endian + "I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", elf, 0x2E)
+        sectionFormat = endian + "IIIIIIIIII"
+
+    sections = [struct.unpack_from(sectionFormat, elf, shoff + index * shentsize) for index in range(shnum)]
+    namesOffset = sections[shstrndx][4]
+
+    for section in sections:
+        nameStart = namesOffset + section[0]
+        name = elf[nameStart:elf.index(b"\0", nameStart)].decode("ascii")
+        if TRACE_SECTION_NAME == name:
+            return elf[section[4]:section[4] + section[5]]
+
+    raise ValueError("{} has no {} section".format(elfPath, TRACE_SECTION_NAME))
+
+
+def read_snapshot(snapshot):
+
+    # the snapshot is in the byte order of the target, the magic tells which one it is.
+    endian = "<"
+    if struct.unpack_from("<I", snapshot, 0)[0] != SNAPSHOT_MAGIC:
+        endian = ">"
+        if struct.unpack_from(">I", snapshot, 0)[0] != SNAPSHOT_MAGIC:
+            raise ValueError("not a PAL trace snapshot")
+
+    magic, version, entrySize, entryCount, lost, tickFrequency = struct.unpack_from(endian + SNAPSHOT_HEADER_FORMAT, snapshot, 0)
+    if SNAPSHOT_VERSION != version:
+        raise ValueError("unsupported PAL trace snapshot version {}".format(version))
+
+    words = entrySize // 4
+    offset = struct.calcsize(SNAPSHOT_HEADER_FORMAT)
+    entries = []
+    for index in range(entryCount):
+        values = struct.unpack_from(endian + "I" * words, snapshot, offset + index * entrySize)
+        sequence, traceId, timestamp, timestampHigh, argumentCount = values[:ENTRY_FIXED_WORDS]
+        timestamp |= timestampHigh << 32
+        arguments = list(values[ENTRY_FIXED_WORDS:ENTRY_FIXED_WORDS + argumentCount])
+        entries.append((sequence, traceId, timestamp, arguments))
+
+    return entries, lost, tickFrequency
+
+
+def format_trace(formatString, arguments):
+
+    remaining = list(arguments)
+
+    def next_argument():
+        return remaining.pop(0) if remaining else None
+
+    def replace(match):
+        flags, width, precision, length, conversion = match.groups()
+        if "%" == conversion:
+            return "%"
+
+        if "*" == width:
+            width = next_argument()
+            width = "?" if width is None else str(struct.unpack("i", struct.pack("I", width))[0])
+        if "*" == precision:
+            precision = next_argument()
+            precision = "?" if precision is None else str(precision)
+
+        value = next_argument()
+        if value is None:
+            return "<missing>"
+        if "?" in (width, precision):
+            return "<missing>"
+
+        spec = "%" + flags + (width or "") + ("." + precision if precision is not None else "")
+        if conversion in "di":
+            return (spec + "d") % struct.unpack("i", struct.pack("I", value))[0]
+        if "u" == conversion:
+            return (spec + "d") % value
+        if conversion in "oxX":
+            return (spec + conversion) % value
+        if "c" == conversion:
+            return (spec + "c") % chr(value & 0xFF)
+        if "p" == conversion:
+            return (spec + "s") % "0x{:08x}".format(value)
+        # strings and floating point values are not recorded, only a 32 bit word is.
+        return "<%{} 0x{:08x}>".format(conversion, value)
+
+    return SPEC_PATTERN.sub(replace, formatString)
+
+
+def decode(elfPath, snapshot):
+
+    section = read_trace_section(elfPath)
+    entries, lost, tickFrequency = read_snapshot(snapshot)
+
+    lines = []
+    if lost:
+        lines.append("[{} older records lost]".format(lost))
+
+    previousSequence = None
+    for sequence, traceId, timestamp, arguments in entries:
+        if previousSequence is not None and sequence != previousSequence + 1:
+            lines.append("[{} records lost]".format(sequence - previousSequence - 1))
+        previousSequence = sequence
+
+        if traceId >= len(section) or (traceId and section[traceId - 1:traceId] != b"\0"):
+            text = "<unknown trace id 0x{:x}> {}".format(traceId, " ".join("0x{:08x}".format(a) for a in arguments))
+        else:
+            formatString = section[traceId:section.index(b"\0", traceId)].decode("ascii", "replace")
+            text = format_trace(formatString, arguments)
+
+        seconds = float(timestamp) / tickFrequency if tickFrequency else 0.0
+        lines.append("[{:12.6f}] #{} {}".format(seconds, sequence, text.rstrip("\r\n")))
+
+    return lines
+
+
+def main(argv):
+
+    useHex = "--hex" in argv
+    paths = [arg for arg in argv[1:] if "--hex" != arg]
+    if 2 != len(paths):
+        sys.stderr.write("usage: {} [--hex] <program.elf> <snapshot>\n".format(argv[0]))
+        return 1
+
+    with open(paths[1], "rb") as snapshotFile:
+        snapshot = snapshotFile.read()
+    if useHex:
+        snapshot = bytearray.fromhex(re.sub(r"\s+", "", snapshot.decode("ascii")))
+    snapshot = bytes(snapshot)
+
+    for line in decode(paths[0], snapshot):
+        print(line)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -18,6 +18,8 @@
 #include "unity.h"
 #include "unity_fixture.h"
 #include "pal_rtos_test_utils.h"
+#include "string.h"
+#include "stdio.h"
 #include "pal.h"
 #include "pal_rtos_test_utils.h"
 
@@ -66,6 +68,75 @@ TEST(pal_rtos, pal_osKernelSysTick64_Unity)
   TEST_ASSERT_TRUE(tick2 > tick1);
 }
 
+TEST(pal_rtos, TickWraparoundStressTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palThreadPriority_t priorities[TICK_STRESS_THREADS] = { PAL_osPriorityRealtime, PAL_osPriorityHigh, PAL_osPriorityAboveNormal };
+  palThreadID_t threadIDs[TICK_STRESS_THREADS] = {0};
+  tickStressArgument_t arguments[TICK_STRESS_THREADS];
+  uint32_t* stacks[TICK_STRESS_THREADS] = {0};
+  uint32_t state = 0;
+  uint64_t expected = 0;
+  uint64_t tick = 0;
+  int32_t count = 0;
+  uint32_t i = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  //! a tick read at least once every 15/16 of the wraparound period is extended exactly, the longest such gap starts a top bit window
+  g_tickSequenceValue = 0x0FFFFFFF;
+  expected = g_tickSequenceValue;
+  for (i = 0; i < 64; ++i)
+  {
+    tick = pal_osKernelSysTickExtend(&state, palTickFuncSequence);
+    TEST_ASSERT_TRUE(expected == tick);
+    expected += 0xF0000000;
+    g_tickSequenceValue = (uint32_t)expected;
+  }
+  //! a gap which ends in the top bit window it started in is not seen as a wraparound, which is why the period is 15/16
+  state = 0;
+  g_tickSequenceValue = 0x1FFFFFFF;
+  tick = pal_osKernelSysTickExtend(&state, palTickFuncSequence);
+  TEST_ASSERT_TRUE(0x1FFFFFFF == tick);
+  g_tickSequenceValue = 0x17FFFFFF;
+  tick = pal_osKernelSysTickExtend(&state, palTickFuncSequence);
+  TEST_ASSERT_TRUE(0x17FFFFFF == tick);
+
+  //! the threads extend a simulated tick which wraps around every 4096 reads, and check every read against the ticks read around it
+  g_tickStressTick = 0;
+  g_tickStressState = 0;
+  memset(arguments, 0, sizeof(arguments));
+  for (i = 0; i < TICK_STRESS_THREADS; ++i)
+  {
+    status = pal_osSemaphoreCreate(0, &arguments[i].done);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+    stacks[i] = (uint32_t*)malloc(THREAD_STACK_SIZE);
+    TEST_ASSERT_NOT_NULL(stacks[i]);
+    status = pal_osThreadCreate(palThreadFuncTickStress, &arguments[i], priorities[i], THREAD_STACK_SIZE, stacks[i], NULL, &threadIDs[i]);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  }
+
+  for (i = 0; i < TICK_STRESS_THREADS; ++i)
+  {
+    status = pal_osSemaphoreWait(arguments[i].done, PAL_RTOS_WAIT_FOREVER, &count);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  }
+  pal_osDelay(100); // let the threads return before their stacks are freed
+
+  tick = pal_osKernelSysTickExtend(&g_tickStressState, palTickFuncStress);
+  TEST_ASSERT_TRUE(g_tickStressTick == tick);
+  TEST_ASSERT_TRUE((tick >> 32) >= ((TICK_STRESS_THREADS * TICK_STRESS_READS) / (0x100000000ULL / TICK_STRESS_STEP)));
+  for (i = 0; i < TICK_STRESS_THREADS; ++i)
+  {
+    TEST_ASSERT_EQUAL_UINT32(0, arguments[i].errors);
+    status = pal_osSemaphoreDelete(&arguments[i].done);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+    free(stacks[i]);
+  }
+  pal_destroy();
+}
+
 TEST(pal_rtos, pal_osKernelSysTickMicroSec_Unity)
 {
   uint64_t tick = 0;
@@ -181,6 +252,107 @@ TEST(pal_rtos, TimerUnityTest)
   TEST_ASSERT_EQUAL(NULL, timerID2);
 }
 
+TEST(pal_rtos, WheelTimerUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palWheelTimerID_t timers[WHEEL_TIMER_TEST_COUNT] = {0};
+  wheelTimerArgument_t arguments[WHEEL_TIMER_TEST_COUNT];
+  palWheelTimerID_t periodicTimer = NULLPTR;
+  palWheelTimerID_t stoppedTimer = NULLPTR;
+  palWheelTimerID_t restartedTimer = NULLPTR;
+  wheelTimerArgument_t periodicArgument = {0};
+  wheelTimerArgument_t stoppedArgument = {0};
+  wheelTimerArgument_t restartedArgument = {0};
+  uint32_t periodicFired = 0;
+  uint32_t delay = 0;
+  uint64_t elapsed = 0;
+  uint32_t i = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  memset(arguments, 0, sizeof(arguments));
+
+  status = pal_osWheelTimerCreate(palTimerFuncWheel, &periodicArgument, palOsTimerPeriodic, &periodicTimer);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osWheelTimerCreate(palTimerFuncWheel, &stoppedArgument, palOsTimerOnce, &stoppedTimer);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osWheelTimerCreate(palTimerFuncWheel, &restartedArgument, palOsTimerOnce, &restartedTimer);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  //! the delays span several wheel levels, so the timers are cascaded before they expire
+  for (i = 0; i < WHEEL_TIMER_TEST_COUNT; ++i)
+  {
+    status = pal_osWheelTimerCreate(palTimerFuncWheel, &arguments[i], palOsTimerOnce, &timers[i]);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+    arguments[i].startTick = pal_osKernelSysTick64();
+    status = pal_osWheelTimerStart(timers[i], 10 + ((i * 37) % WHEEL_TIMER_TEST_MAX_DELAY));
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  }
+
+  status = pal_osWheelTimerStart(periodicTimer, 20);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osWheelTimerStart(stoppedTimer, 50);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osWheelTimerStop(stoppedTimer);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osWheelTimerStart(restartedTimer, 50);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  restartedArgument.startTick = pal_osKernelSysTick64();
+  status = pal_osWheelTimerStart(restartedTimer, 600);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  pal_osDelay(WHEEL_TIMER_TEST_MAX_DELAY + 10 + (2 * PAL_TIMER_WHEEL_TICK_MS) + WHEEL_TIMER_TEST_TOLERANCE);
+
+  for (i = 0; i < WHEEL_TIMER_TEST_COUNT; ++i)
+  {
+    delay = 10 + ((i * 37) % WHEEL_TIMER_TEST_MAX_DELAY);
+    TEST_ASSERT_EQUAL_UINT32(1, arguments[i].fired);
+    elapsed = pal_osKernelSysMilliSecTick(arguments[i].firedTick - arguments[i].startTick);
+    TEST_ASSERT_TRUE(elapsed >= delay);
+    TEST_ASSERT_TRUE(elapsed <= delay + (2 * PAL_TIMER_WHEEL_TICK_MS) + WHEEL_TIMER_TEST_TOLERANCE);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, stoppedArgument.fired);
+  TEST_ASSERT_EQUAL_UINT32(1, restartedArgument.fired);
+  TEST_ASSERT_TRUE(pal_osKernelSysMilliSecTick(restartedArgument.firedTick - restartedArgument.startTick) >= 600);
+  TEST_ASSERT_TRUE(periodicArgument.fired > 10);
+
+  //! a stopped periodic timer does not fire any more
+  status = pal_osWheelTimerStop(periodicTimer);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  periodicFired = periodicArgument.fired;
+  pal_osDelay(100);
+  TEST_ASSERT_EQUAL_UINT32(periodicFired, periodicArgument.fired);
+
+  status = pal_osWheelTimerStart(NULLPTR, 10);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osWheelTimerStart(periodicTimer, 0);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+
+  for (i = 0; i < WHEEL_TIMER_TEST_COUNT; ++i)
+  {
+    status = pal_osWheelTimerDelete(&timers[i]);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+    TEST_ASSERT_EQUAL(NULLPTR, timers[i]);
+  }
+  status = pal_osWheelTimerDelete(&periodicTimer);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osWheelTimerDelete(&stoppedTimer);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osWheelTimerDelete(&restartedTimer);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  //! the wheel is released with the last timer and is created again with the next one
+  memset(&periodicArgument, 0, sizeof(periodicArgument));
+  status = pal_osWheelTimerCreate(palTimerFuncWheel, &periodicArgument, palOsTimerOnce, &periodicTimer);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osWheelTimerStart(periodicTimer, 20);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_osDelay(100);
+  TEST_ASSERT_EQUAL_UINT32(1, periodicArgument.fired);
+  status = pal_osWheelTimerDelete(&periodicTimer);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+}
+
 TEST(pal_rtos, PrimitivesUnityTest1)
 {
     palStatus_t status = PAL_SUCCESS;
@@ -305,6 +477,178 @@ TEST(pal_rtos, MemoryPoolUnityTest)
 }
 
 
+TEST(pal_rtos, MemoryPoolBulkUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palMemoryPoolID_t poolID = NULLPTR;
+  palMemoryPoolStats_t stats;
+  void* blocks[MEMORY_POOL3_BLOCK_COUNT] = {0};
+  uint32_t allocated = 0;
+  uint8_t* block = NULL;
+  uint32_t i = 0;
+
+  status = pal_init();
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osPoolCreate(MEMORY_POOL3_BLOCK_SIZE, PAL_RTOS_POOL_MAX_BLOCKS + 1, &poolID);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+
+  status = pal_osPoolCreate(MEMORY_POOL3_BLOCK_SIZE, MEMORY_POOL3_BLOCK_COUNT, &poolID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osPoolAllocBulk(poolID, blocks, MEMORY_POOL3_BLOCK_COUNT, &allocated);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL(MEMORY_POOL3_BLOCK_COUNT, allocated);
+  TEST_ASSERT_EQUAL(NULL, pal_osPoolAlloc(poolID));
+
+  status = pal_osPoolFree(poolID, (uint8_t*)blocks[0] + 1);
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_PARAMETER, status);
+
+  status = pal_osPoolFreeBulk(poolID, blocks, MEMORY_POOL3_BLOCK_COUNT);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  // every block is back - the whole pool can be allocated again, and blocks from CAlloc are zeroed.
+  for (i = 0; i < MEMORY_POOL3_BLOCK_COUNT; ++i)
+  {
+    block = (uint8_t*)pal_osPoolCAlloc(poolID);
+    TEST_ASSERT_NOT_EQUAL(NULL, block);
+    TEST_ASSERT_EQUAL(0, block[0]);
+    TEST_ASSERT_EQUAL(0, block[MEMORY_POOL3_BLOCK_SIZE - 1]);
+    blocks[i] = block;
+  }
+  TEST_ASSERT_EQUAL(NULL, pal_osPoolAlloc(poolID));
+  status = pal_osPoolFreeBulk(poolID, blocks, MEMORY_POOL3_BLOCK_COUNT);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osPoolGetStats(poolID, &stats);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL(MEMORY_POOL3_BLOCK_COUNT, stats.blockCount);
+  TEST_ASSERT(stats.blockSize >= MEMORY_POOL3_BLOCK_SIZE);
+  TEST_ASSERT_EQUAL(2, stats.failedAllocations);
+  TEST_ASSERT((stats.cacheHits + stats.cacheMisses) >= (4 * MEMORY_POOL3_BLOCK_COUNT));
+  TEST_PRINTF("pool cache hits %u misses %u\n", stats.cacheHits, stats.cacheMisses);
+
+  status = pal_osPoolDestroy(&poolID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL(NULLPTR, poolID);
+  pal_destroy();
+}
+
+TEST(pal_rtos, MemoryPoolThreadsUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palThreadID_t threadID1 = NULLPTR;
+  palThreadID_t threadID2 = NULLPTR;
+  int32_t count = 0;
+  uint32_t *stack1 = (uint32_t*)malloc(THREAD_STACK_SIZE);
+  uint32_t *stack2 = (uint32_t*)malloc(THREAD_STACK_SIZE);
+  poolThreadsArgument_t arg1 = {0};
+  poolThreadsArgument_t arg2 = {0};
+  palMemoryPoolStats_t stats;
+
+  status = pal_init();
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osPoolCreate(MEMORY_POOL3_BLOCK_SIZE, MEMORY_POOL3_BLOCK_COUNT, &arg1.poolID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreCreate(0, &arg1.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  arg2.poolID = arg1.poolID;
+  arg2.done = arg1.done;
+  arg1.pattern = 0x5A;
+  arg2.pattern = 0xA5;
+
+  status = pal_osThreadCreate(palThreadFuncPool, &arg1, PAL_osPriorityRealtime, THREAD_STACK_SIZE, stack1, NULL, &threadID1);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osThreadCreate(palThreadFuncPool, &arg2, PAL_osPriorityIdle, THREAD_STACK_SIZE, stack2, NULL, &threadID2);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osSemaphoreWait(arg1.done, PAL_RTOS_WAIT_FOREVER, &count);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreWait(arg1.done, PAL_RTOS_WAIT_FOREVER, &count);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  // a block handed to both threads at once would have its pattern overwritten by the other thread.
+  TEST_ASSERT_EQUAL(0, arg1.errors);
+  TEST_ASSERT_EQUAL(0, arg2.errors);
+
+  status = pal_osPoolGetStats(arg1.poolID, &stats);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL(0, stats.failedAllocations);
+#if PAL_RTOS_POOL_THREAD_CACHE_SIZE
+  // the pool is large enough to be cached, so the threads hit their caches.
+  TEST_ASSERT(stats.cacheHits > 0);
+#endif //PAL_RTOS_POOL_THREAD_CACHE_SIZE
+  TEST_PRINTF("pool cache hits %u misses %u\n", stats.cacheHits, stats.cacheMisses);
+
+  pal_osDelay(100); // let the threads return before their stacks are freed
+  status = pal_osSemaphoreDelete(&arg1.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osPoolDestroy(&arg1.poolID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  free(stack1);
+  free(stack2);
+  pal_destroy();
+}
+
+
+TEST(pal_rtos, SlabUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palSlabClassStats_t statsBefore;
+  palSlabClassStats_t stats;
+  void* blocks[SLAB_TEST_MAX_BLOCKS] = {0};
+  void* large = NULL;
+  uint32_t count = 0;
+  uint32_t i = 0;
+
+  status = pal_osMallocGetStats(0, &statsBefore);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT(statsBefore.blockCount < SLAB_TEST_MAX_BLOCKS);
+
+  status = pal_osMallocGetStats(0, NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+
+  // allocate from the smallest class until it falls back to the heap.
+  for (count = 0; count < SLAB_TEST_MAX_BLOCKS; ++count)
+  {
+    blocks[count] = pal_osMalloc(statsBefore.blockSize);
+    TEST_ASSERT_NOT_EQUAL(NULL, blocks[count]);
+    memset(blocks[count], 0xA5, statsBefore.blockSize);
+    status = pal_osMallocGetStats(0, &stats);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+    if (stats.heapFallbacks != statsBefore.heapFallbacks)
+    {
+      ++count;
+      break;
+    }
+  }
+  TEST_ASSERT_EQUAL(stats.blockCount, stats.inUse);
+  TEST_ASSERT_EQUAL(stats.blockCount, stats.peakInUse);
+  TEST_ASSERT_EQUAL(statsBefore.heapFallbacks + 1, stats.heapFallbacks);
+  TEST_ASSERT_EQUAL(statsBefore.allocations + (stats.blockCount - statsBefore.inUse), stats.allocations);
+
+  // allocations larger than every class are served by the heap.
+  large = pal_osMalloc(SLAB_TEST_LARGE_ALLOCATION);
+  TEST_ASSERT_NOT_EQUAL(NULL, large);
+  pal_osFree(large);
+  pal_osFree(NULL);
+
+  for (i = 0; i < count; ++i)
+  {
+    pal_osFree(blocks[i]);
+  }
+  status = pal_osMallocGetStats(0, &stats);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL(statsBefore.inUse, stats.inUse);
+
+  for (i = 0; PAL_SUCCESS == pal_osMallocGetStats(i, &stats); ++i)
+  {
+    TEST_PRINTF("slab class %u: size %u count %u in use %u peak %u allocations %u heap fallbacks %u\n", i, stats.blockSize, stats.blockCount, stats.inUse, stats.peakInUse, stats.allocations, stats.heapFallbacks);
+  }
+}
+
+
 TEST(pal_rtos, MessageUnityTest)
 {
   palStatus_t status = PAL_SUCCESS;
@@ -331,6 +675,205 @@ TEST(pal_rtos, MessageUnityTest)
   TEST_ASSERT_EQUAL(messageQID, NULL);
 }
 
+TEST(pal_rtos, TypedMessageUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palMessageQID_t messageQID = NULLPTR;
+  typedMessage_t messagesToSend[TYPED_MESSAGE_QUEUE_SIZE + 2];
+  typedMessage_t messagesToGet[TYPED_MESSAGE_QUEUE_SIZE + 2];
+  typedMessage_t messageToGet;
+  uint32_t pointee = 0;
+  uint32_t* pointerToSend = &pointee;
+  uint32_t* pointerToGet = NULL;
+  uint32_t count = 0;
+  uint32_t i = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  memset(messagesToSend, 0, sizeof(messagesToSend));
+  for (i = 0; i < TYPED_MESSAGE_QUEUE_SIZE + 2; ++i)
+  {
+    messagesToSend[i].sequence = 0x100000000ULL + i;
+    messagesToSend[i].length = (uint16_t)(i * 3);
+    messagesToSend[i].payload = &messagesToSend[i];
+  }
+
+  //! a struct carried by value
+  status = pal_osMessageQueueCreateTyped(TYPED_MESSAGE_QUEUE_SIZE, sizeof(typedMessage_t), &messageQID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osMessagePutTyped(messageQID, &messagesToSend[0], 1500);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  memset(&messageToGet, 0, sizeof(messageToGet));
+  status = pal_osMessageGetTyped(messageQID, 1500, &messageToGet);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_MEMORY(&messagesToSend[0], &messageToGet, sizeof(typedMessage_t));
+
+  //! a batch put stops when the queue is full, a batch get returns only what is queued
+  status = pal_osMessagePutBatch(messageQID, messagesToSend, TYPED_MESSAGE_QUEUE_SIZE + 2, 0, &count);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT32(TYPED_MESSAGE_QUEUE_SIZE, count);
+  status = pal_osMessagePutBatch(messageQID, &messagesToSend[TYPED_MESSAGE_QUEUE_SIZE], 2, 0, &count);
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_RESOURCE, status);
+  TEST_ASSERT_EQUAL_UINT32(0, count);
+
+  memset(messagesToGet, 0, sizeof(messagesToGet));
+  status = pal_osMessageGetBatch(messageQID, 1500, messagesToGet, TYPED_MESSAGE_QUEUE_SIZE + 2, &count);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT32(TYPED_MESSAGE_QUEUE_SIZE, count);
+  TEST_ASSERT_EQUAL_MEMORY(messagesToSend, messagesToGet, sizeof(typedMessage_t) * TYPED_MESSAGE_QUEUE_SIZE);
+
+  status = pal_osMessageGetBatch(messageQID, 0, messagesToGet, 1, &count);
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_RESOURCE, status);
+  TEST_ASSERT_EQUAL_UINT32(0, count);
+  status = pal_osMessageGetTyped(messageQID, 10, &messageToGet);
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_TIMEOUT, status);
+
+  status = pal_osMessageQueueDestroy(&messageQID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL(messageQID, NULL);
+
+  //! a pointer carried by value
+  status = pal_osMessageQueueCreateTyped(TYPED_MESSAGE_QUEUE_SIZE, sizeof(uint32_t*), &messageQID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osMessagePutTyped(messageQID, &pointerToSend, 1500);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMessageGetTyped(messageQID, 1500, &pointerToGet);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_PTR(pointerToSend, pointerToGet);
+
+  status = pal_osMessageQueueDestroy(&messageQID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osMessageQueueCreateTyped(TYPED_MESSAGE_QUEUE_SIZE, 0, &messageQID);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+}
+
+TEST(pal_rtos, SpscRingUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palSpscRingID_t ringID = NULLPTR;
+  uint64_t element = 0;
+  uint32_t i = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osSpscRingCreate(SPSC_RING_TEST_CAPACITY - 1, sizeof(uint64_t), false, &ringID);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osSpscRingCreate(SPSC_RING_TEST_CAPACITY, 0, false, &ringID);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+
+  //! a non blocking ring never waits, even with a timeout
+  status = pal_osSpscRingCreate(SPSC_RING_TEST_CAPACITY, sizeof(uint64_t), false, &ringID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osSpscRingPop(ringID, 1500, &element);
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_RESOURCE, status);
+  //! go around the ring a few times so the positions wrap past the capacity
+  for (i = 0; i < SPSC_RING_TEST_CAPACITY * 3; ++i)
+  {
+    element = 0x100000000ULL + i;
+    status = pal_osSpscRingPush(ringID, &element, 0);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+    if ((SPSC_RING_TEST_CAPACITY - 1) == (i % SPSC_RING_TEST_CAPACITY))
+    {
+      status = pal_osSpscRingPush(ringID, &element, 1500);
+      TEST_ASSERT_EQUAL(PAL_ERR_RTOS_RESOURCE, status);
+      for (element = i + 1 - SPSC_RING_TEST_CAPACITY; element <= i; ++element)
+      {
+        uint64_t popped = 0;
+        status = pal_osSpscRingPop(ringID, 0, &popped);
+        TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+        TEST_ASSERT_TRUE(0x100000000ULL + element == popped);
+      }
+    }
+  }
+
+  status = pal_osSpscRingDestroy(&ringID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL(ringID, NULL);
+
+  //! a blocking ring waits for the timeout
+  status = pal_osSpscRingCreate(SPSC_RING_TEST_CAPACITY, sizeof(uint64_t), true, &ringID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSpscRingPop(ringID, 0, &element);
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_RESOURCE, status);
+  status = pal_osSpscRingPop(ringID, 10, &element);
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_TIMEOUT, status);
+  status = pal_osSpscRingDestroy(&ringID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+}
+
+TEST(pal_rtos, SpscRingBenchmark)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palThreadID_t threadID = NULLPTR;
+  queueBenchmark_t benchmark;
+  uint32_t *stack = (uint32_t*)malloc(THREAD_STACK_SIZE);
+  uint64_t ringTicks = 0;
+  uint64_t messageQueueTicks = 0;
+  uint64_t start = 0;
+  uint32_t value = 0;
+  uint32_t errors = 0;
+  uint32_t i = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  memset(&benchmark, 0, sizeof(benchmark));
+  status = pal_osSpscRingCreate(SPSC_RING_BENCHMARK_CAPACITY, sizeof(uint32_t), true, &benchmark.ringID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMessageQueueCreate(SPSC_RING_BENCHMARK_CAPACITY, &benchmark.messageQID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  start = pal_osKernelSysTick64();
+  status = pal_osThreadCreate(palThreadFuncSpscRingProducer, &benchmark, PAL_osPriorityRealtime, THREAD_STACK_SIZE, stack, NULL, &threadID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  for (i = 0; i < PAL_RTOS_BENCHMARK_ITERATIONS; ++i)
+  {
+    status = pal_osSpscRingPop(benchmark.ringID, PAL_RTOS_WAIT_FOREVER, &value);
+    if ((PAL_SUCCESS != status) || (i != value))
+    {
+      errors++;
+    }
+  }
+  ringTicks = pal_osKernelSysTick64() - start;
+  pal_osDelay(100); // let the thread return before its slot is reused
+  status = pal_osThreadTerminate(&threadID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  start = pal_osKernelSysTick64();
+  status = pal_osThreadCreate(palThreadFuncMessageQueueProducer, &benchmark, PAL_osPriorityRealtime, THREAD_STACK_SIZE, stack, NULL, &threadID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  for (i = 0; i < PAL_RTOS_BENCHMARK_ITERATIONS; ++i)
+  {
+    status = pal_osMessageGet(benchmark.messageQID, PAL_RTOS_WAIT_FOREVER, &value);
+    if ((PAL_SUCCESS != status) || (i != value))
+    {
+      errors++;
+    }
+  }
+  messageQueueTicks = pal_osKernelSysTick64() - start;
+  pal_osDelay(100); // let the thread return before its stack is freed
+  status = pal_osThreadTerminate(&threadID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  TEST_ASSERT_EQUAL(0, errors);
+  TEST_ASSERT_EQUAL(0, benchmark.errors);
+  TEST_PRINTF("pal_osSpscRingPush/Pop: %u messages/sec\n", (uint32_t)((PAL_RTOS_BENCHMARK_ITERATIONS * pal_osKernelSysTickFrequency()) / (ringTicks + 1)));
+  TEST_PRINTF("pal_osMessagePut/Get: %u messages/sec\n", (uint32_t)((PAL_RTOS_BENCHMARK_ITERATIONS * pal_osKernelSysTickFrequency()) / (messageQueueTicks + 1)));
+
+  status = pal_osSpscRingDestroy(&benchmark.ringID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMessageQueueDestroy(&benchmark.messageQID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  free(stack);
+  pal_destroy();
+}
+
 TEST(pal_rtos, AtomicIncrementUnityTest)
 {
   int32_t num1 = 0;
@@ -342,7 +885,1257 @@ TEST(pal_rtos, AtomicIncrementUnityTest)
 
   
   TEST_ASSERT_EQUAL(original + increment, tmp);
-  
+
+  //! negative increments cross zero
+  tmp = pal_osAtomicIncrement(&num1, -25);
+  TEST_ASSERT_EQUAL(-15, tmp);
+  TEST_ASSERT_EQUAL(-15, num1);
+  tmp = pal_osAtomicIncrement(&num1, 15);
+  TEST_ASSERT_EQUAL(0, tmp);
+}
+
+TEST(pal_rtos, AtomicOperationsUnityTest)
+{
+  uint32_t value32 = 5;
+  uint64_t value64 = 0x100000005ULL;
+  uint32_t expected32 = 0;
+  uint64_t expected64 = 0;
+  int first = 0;
+  int second = 0;
+  void* pointer = &first;
+  void* expectedPointer = NULL;
+
+  TEST_ASSERT_EQUAL_UINT32(5, pal_osAtomicLoad32(&value32, PAL_MEMORY_ORDER_ACQUIRE));
+  pal_osAtomicStore32(&value32, 7, PAL_MEMORY_ORDER_RELEASE);
+  TEST_ASSERT_EQUAL_UINT32(7, pal_osAtomicExchange32(&value32, 9, PAL_MEMORY_ORDER_ACQ_REL));
+  TEST_ASSERT_EQUAL_UINT32(9, pal_osAtomicFetchAdd32(&value32, 3, PAL_MEMORY_ORDER_RELAXED));
+  TEST_ASSERT_EQUAL_UINT32(12, pal_osAtomicFetchSub32(&value32, 13, PAL_MEMORY_ORDER_SEQ_CST));
+  TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFF, value32);
+  TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFF, pal_osAtomicFetchAnd32(&value32, 0xF0F0, PAL_MEMORY_ORDER_SEQ_CST));
+  TEST_ASSERT_EQUAL_UINT32(0xF0F0, pal_osAtomicFetchOr32(&value32, 0x0F00, PAL_MEMORY_ORDER_SEQ_CST));
+  TEST_ASSERT_EQUAL_UINT32(0xFFF0, value32);
+
+  //! a failed swap reports the current value and leaves the value unchanged
+  expected32 = 1;
+  TEST_ASSERT_FALSE(pal_osAtomicCompareAndSwap32(&value32, &expected32, 2, PAL_MEMORY_ORDER_SEQ_CST));
+  TEST_ASSERT_EQUAL_UINT32(0xFFF0, expected32);
+  TEST_ASSERT_EQUAL_UINT32(0xFFF0, value32);
+  TEST_ASSERT_TRUE(pal_osAtomicCompareAndSwap32(&value32, &expected32, 2, PAL_MEMORY_ORDER_SEQ_CST));
+  TEST_ASSERT_EQUAL_UINT32(2, value32);
+
+  //! the 64 bit operations carry into and borrow from the upper half
+  TEST_ASSERT_TRUE(0x100000005ULL == pal_osAtomicLoad64(&value64, PAL_MEMORY_ORDER_SEQ_CST));
+  TEST_ASSERT_TRUE(0x100000005ULL == pal_osAtomicFetchSub64(&value64, 6, PAL_MEMORY_ORDER_ACQ_REL));
+  TEST_ASSERT_TRUE(0xFFFFFFFFULL == value64);
+  TEST_ASSERT_TRUE(0xFFFFFFFFULL == pal_osAtomicFetchAdd64(&value64, 1, PAL_MEMORY_ORDER_RELAXED));
+  TEST_ASSERT_TRUE(0x100000000ULL == pal_osAtomicFetchOr64(&value64, 0xF000000000000001ULL, PAL_MEMORY_ORDER_RELEASE));
+  TEST_ASSERT_TRUE(0xF000000100000001ULL == pal_osAtomicFetchAnd64(&value64, 0xFFFFFFFF00000000ULL, PAL_MEMORY_ORDER_ACQUIRE));
+  TEST_ASSERT_TRUE(0xF000000100000000ULL == pal_osAtomicExchange64(&value64, 3, PAL_MEMORY_ORDER_SEQ_CST));
+  pal_osAtomicStore64(&value64, 0x200000000ULL, PAL_MEMORY_ORDER_SEQ_CST);
+  expected64 = 0;
+  TEST_ASSERT_FALSE(pal_osAtomicCompareAndSwap64(&value64, &expected64, 1, PAL_MEMORY_ORDER_SEQ_CST));
+  TEST_ASSERT_TRUE(0x200000000ULL == expected64);
+  TEST_ASSERT_TRUE(pal_osAtomicCompareAndSwap64(&value64, &expected64, 1, PAL_MEMORY_ORDER_SEQ_CST));
+  TEST_ASSERT_TRUE(1 == value64);
+
+  TEST_ASSERT_EQUAL_PTR(&first, pal_osAtomicLoadPointer(&pointer, PAL_MEMORY_ORDER_ACQUIRE));
+  TEST_ASSERT_EQUAL_PTR(&first, pal_osAtomicExchangePointer(&pointer, &second, PAL_MEMORY_ORDER_ACQ_REL));
+  TEST_ASSERT_FALSE(pal_osAtomicCompareAndSwapPointer(&pointer, &expectedPointer, &first, PAL_MEMORY_ORDER_SEQ_CST));
+  TEST_ASSERT_EQUAL_PTR(&second, expectedPointer);
+  TEST_ASSERT_TRUE(pal_osAtomicCompareAndSwapPointer(&pointer, &expectedPointer, NULL, PAL_MEMORY_ORDER_SEQ_CST));
+  pal_osAtomicStorePointer(&pointer, &first, PAL_MEMORY_ORDER_RELEASE);
+  TEST_ASSERT_EQUAL_PTR(&first, pointer);
+
+  pal_osAtomicFence(PAL_MEMORY_ORDER_RELAXED);
+  pal_osAtomicFence(PAL_MEMORY_ORDER_ACQUIRE);
+  pal_osAtomicFence(PAL_MEMORY_ORDER_RELEASE);
+  pal_osAtomicFence(PAL_MEMORY_ORDER_SEQ_CST);
+}
+
+TEST(pal_rtos, AtomicStressTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palThreadPriority_t priorities[ATOMIC_STRESS_THREADS] = { PAL_osPriorityRealtime, PAL_osPriorityHigh, PAL_osPriorityAboveNormal };
+  palThreadID_t threadIDs[ATOMIC_STRESS_THREADS] = {0};
+  atomicStressArgument_t arguments[ATOMIC_STRESS_THREADS];
+  uint32_t* stacks[ATOMIC_STRESS_THREADS] = {0};
+  atomicStressShared_t shared;
+  int32_t count = 0;
+  uint32_t i = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  //! every thread adds to the same counters with fetch-add and with compare and swap loops, and sets its own bit
+  memset(&shared, 0, sizeof(shared));
+  memset(arguments, 0, sizeof(arguments));
+  for (i = 0; i < ATOMIC_STRESS_THREADS; ++i)
+  {
+    status = pal_osSemaphoreCreate(0, &arguments[i].done);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+    arguments[i].shared = &shared;
+    arguments[i].index = i;
+    stacks[i] = (uint32_t*)malloc(THREAD_STACK_SIZE);
+    TEST_ASSERT_NOT_NULL(stacks[i]);
+    status = pal_osThreadCreate(palThreadFuncAtomicStress, &arguments[i], priorities[i], THREAD_STACK_SIZE, stacks[i], NULL, &threadIDs[i]);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  }
+
+  for (i = 0; i < ATOMIC_STRESS_THREADS; ++i)
+  {
+    status = pal_osSemaphoreWait(arguments[i].done, PAL_RTOS_WAIT_FOREVER, &count);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  }
+  pal_osDelay(100); // let the threads return before their stacks are freed
+
+  TEST_ASSERT_EQUAL_UINT32(ATOMIC_STRESS_THREADS * ATOMIC_STRESS_ITERATIONS, shared.counter32);
+  TEST_ASSERT_TRUE(((uint64_t)ATOMIC_STRESS_THREADS * ATOMIC_STRESS_ITERATIONS * ATOMIC_STRESS_STEP64) == shared.counter64);
+  TEST_ASSERT_EQUAL_UINT32(ATOMIC_STRESS_THREADS * ATOMIC_STRESS_ITERATIONS, shared.casCounter32);
+  TEST_ASSERT_EQUAL_UINT32((1 << ATOMIC_STRESS_THREADS) - 1, shared.bits);
+  for (i = 0; i < ATOMIC_STRESS_THREADS; ++i)
+  {
+    status = pal_osSemaphoreDelete(&arguments[i].done);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+    free(stacks[i]);
+  }
+  pal_destroy();
+}
+
+//! Wait until the logger thread wrote the given number of lines.
+static void waitForLogLines(uint32_t lines)
+{
+  uint32_t i = 0;
+
+  for (i = 0; (i < 1000) && (g_logTest.lines < lines); ++i)
+  {
+    pal_osDelay(1);
+  }
+  TEST_ASSERT_EQUAL_UINT32(lines, g_logTest.lines);
+}
+
+TEST(pal_rtos, LogUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palLogStats_t before = {0};
+  palLogStats_t after = {0};
+  char expected[LOG_TEST_LINE_SIZE];
+  char name[] = "copied";
+  const char unterminated[4] = { 'w', 'x', 'y', 'z' };
+  uint32_t i = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  memset(&g_logTest, 0, sizeof(g_logTest));
+  status = pal_osSemaphoreCreate(0, &g_logTest.gate);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osLogGetStats(&before);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osLogStart(palTestLogSink);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  //! the logger thread formats the kept arguments as printf would have, %s arguments are copied at the call
+  pal_osLogPrintf(__FUNCTION__, __LINE__, "%d|%5u|%-8s|%.2f|%llx|%c|%%|%hhd\n", -12, 34u, name, 3.14159, 0x123456789ABCULL, 'z', 300);
+  snprintf(expected, sizeof(expected), "%d|%5u|%-8s|%.2f|%llx|%c|%%|%hhd\n", -12, 34u, name, 3.14159, 0x123456789ABCULL, 'z', 300);
+  name[0] = 'X';
+  waitForLogLines(1);
+#ifndef VERBOSE
+  TEST_ASSERT_EQUAL_STRING(expected, g_logTest.lastLine);
+#endif
+  pal_osLogPrintf(__FUNCTION__, __LINE__, "%*d|%.*s|%zu|%ld|%p\n", 6, 7, 3, "abcdef", (size_t)99, -5L, (void*)name);
+  snprintf(expected, sizeof(expected), "%*d|%.*s|%zu|%ld|%p\n", 6, 7, 3, "abcdef", (size_t)99, -5L, (void*)name);
+  waitForLogLines(2);
+#ifndef VERBOSE
+  TEST_ASSERT_EQUAL_STRING(expected, g_logTest.lastLine);
+#endif
+  //! a string with a precision is not read past it, it need not be terminated
+  pal_osLogPrintf(__FUNCTION__, __LINE__, "%.4s|%.*s\n", unterminated, 2, unterminated);
+  waitForLogLines(3);
+#ifndef VERBOSE
+  TEST_ASSERT_EQUAL_STRING("wxyz|wx\n", g_logTest.lastLine);
+#endif
+
+  //! arguments which do not fit the record are dropped from the line and counted
+  pal_osLogPrintf(__FUNCTION__, __LINE__, "%d %d %d %d %d %d %d %d %d %d\n", 1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
+  waitForLogLines(4);
+  status = pal_osLogGetStats(&after);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT32(before.truncated + 1, after.truncated);
+
+  //! while the sink is blocked callers do not wait: the queue fills and the rest of the messages are dropped
+  g_logTest.blocked = true;
+  for (i = 0; i < PAL_LOG_QUEUE_SIZE + 10; ++i)
+  {
+    pal_osLogPrintf(__FUNCTION__, __LINE__, "blocked %u\n", i);
+  }
+  status = pal_osLogGetStats(&after);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_TRUE((after.dropped - before.dropped) >= 9);
+  TEST_ASSERT_EQUAL_UINT32(PAL_LOG_QUEUE_SIZE + 14, (after.logged - before.logged) + (after.dropped - before.dropped));
+  g_logTest.blocked = false;
+  pal_osSemaphoreRelease(g_logTest.gate);
+
+  //! stopping writes the queued messages, and the drops are reported in a line of their own
+  status = pal_osLogStop();
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osLogGetStats(&after);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT32(after.logged - before.logged, after.emitted - before.emitted);
+  TEST_ASSERT_EQUAL_UINT32((after.emitted - before.emitted) + 1, g_logTest.lines);
+  TEST_ASSERT_NOT_NULL(strstr(g_logTest.lastLine, "dropped"));
+
+  status = pal_osLogStop();
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osLogGetStats(NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osSemaphoreDelete(&g_logTest.gate);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_destroy();
+}
+
+TEST(pal_rtos, LogThreadsUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palThreadPriority_t priorities[LOG_TEST_THREADS] = { PAL_osPriorityRealtime, PAL_osPriorityHigh, PAL_osPriorityAboveNormal };
+  palThreadID_t threadIDs[LOG_TEST_THREADS] = {0};
+  logThreadArgument_t arguments[LOG_TEST_THREADS];
+  uint32_t* stacks[LOG_TEST_THREADS] = {0};
+  palLogStats_t before = {0};
+  palLogStats_t after = {0};
+  int32_t count = 0;
+  uint32_t i = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  memset(&g_logTest, 0, sizeof(g_logTest));
+  status = pal_osLogGetStats(&before);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osLogStart(palTestLogSink);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  memset(arguments, 0, sizeof(arguments));
+  for (i = 0; i < LOG_TEST_THREADS; ++i)
+  {
+    status = pal_osSemaphoreCreate(0, &arguments[i].done);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+    arguments[i].index = i;
+    stacks[i] = (uint32_t*)malloc(THREAD_STACK_SIZE);
+    TEST_ASSERT_NOT_NULL(stacks[i]);
+    status = pal_osThreadCreate(palThreadFuncLog, &arguments[i], priorities[i], THREAD_STACK_SIZE, stacks[i], NULL, &threadIDs[i]);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  }
+  for (i = 0; i < LOG_TEST_THREADS; ++i)
+  {
+    status = pal_osSemaphoreWait(arguments[i].done, PAL_RTOS_WAIT_FOREVER, &count);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  }
+  pal_osDelay(100); // let the threads return before their stacks are freed
+
+  status = pal_osLogStop();
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osLogGetStats(&after);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_PRINTF("logger: %u logged %u dropped\n", after.logged - before.logged, after.dropped - before.dropped);
+  //! every message is either written or counted as dropped, and only the drop reports are extra lines
+  TEST_ASSERT_EQUAL_UINT32(LOG_TEST_THREADS * LOG_TEST_MESSAGES, (after.logged - before.logged) + (after.dropped - before.dropped));
+  TEST_ASSERT_EQUAL_UINT32(after.logged - before.logged, after.emitted - before.emitted);
+  TEST_ASSERT_TRUE(g_logTest.lines >= (after.emitted - before.emitted));
+  for (i = 0; i < LOG_TEST_THREADS; ++i)
+  {
+    status = pal_osSemaphoreDelete(&arguments[i].done);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+    free(stacks[i]);
+  }
+  pal_destroy();
+}
+
+TEST(pal_rtos, TraceUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  uint32_t snapshot[(sizeof(palTraceSnapshotHeader_t) + (PAL_TRACE_BUFFER_ENTRIES * sizeof(palTraceEntry_t))) / sizeof(uint32_t)];
+  palTraceSnapshotHeader_t* header = (palTraceSnapshotHeader_t*)snapshot;
+#if PAL_TRACE_ENABLED
+  palTraceEntry_t* entries = (palTraceEntry_t*)(header + 1);
+  palTraceEntry_t* last = NULL;
+  uint32_t i = 0;
+#endif
+  uint32_t length = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  PAL_TRACE("trace test %d %u 0x%x\n", -5, 7u, 0xABCDu);
+  PAL_TRACE("trace test without arguments\n");
+  PAL_TRACE("trace test %u %u %u %u %u %u\n", 1, 2, 3, 4, 5, 6);
+  status = pal_osTraceSnapshot(snapshot, sizeof(snapshot), &length);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT32(PAL_TRACE_SNAPSHOT_MAGIC, header->magic);
+  TEST_ASSERT_EQUAL_UINT32(PAL_TRACE_SNAPSHOT_VERSION, header->version);
+  TEST_ASSERT_EQUAL_UINT32(sizeof(palTraceEntry_t), header->entrySize);
+  TEST_ASSERT_EQUAL_UINT32(sizeof(palTraceSnapshotHeader_t) + (header->entryCount * sizeof(palTraceEntry_t)), length);
+#if PAL_TRACE_ENABLED
+  //! the records map back to their format strings and keep up to PAL_TRACE_MAX_ARGUMENTS arguments
+  TEST_ASSERT_TRUE(header->entryCount >= 3);
+  last = &entries[header->entryCount - 3];
+  TEST_ASSERT_EQUAL_STRING("trace test %d %u 0x%x\n", pal_osTraceFormat(last[0].id));
+  TEST_ASSERT_EQUAL_UINT32(3, last[0].argumentCount);
+  TEST_ASSERT_EQUAL_INT32(-5, (int32_t)last[0].arguments[0]);
+  TEST_ASSERT_EQUAL_UINT32(7, last[0].arguments[1]);
+  TEST_ASSERT_EQUAL_UINT32(0xABCD, last[0].arguments[2]);
+  TEST_ASSERT_EQUAL_STRING("trace test without arguments\n", pal_osTraceFormat(last[1].id));
+  TEST_ASSERT_EQUAL_UINT32(0, last[1].argumentCount);
+  TEST_ASSERT_EQUAL_UINT32(PAL_TRACE_MAX_ARGUMENTS, last[2].argumentCount);
+  TEST_ASSERT_EQUAL_UINT32(1, last[2].arguments[0]);
+  TEST_ASSERT_EQUAL_UINT32(last[0].sequence + 1, last[1].sequence);
+  TEST_ASSERT_EQUAL_UINT32(last[1].sequence + 1, last[2].sequence);
+  TEST_ASSERT_NULL(pal_osTraceFormat(last[0].id + 1));
+
+  //! the buffer keeps the newest records, the older ones are counted as lost
+  for (i = 0; i < 3 * PAL_TRACE_BUFFER_ENTRIES; ++i)
+  {
+    PAL_TRACE("trace test record %u\n", i);
+  }
+  status = pal_osTraceSnapshot(snapshot, sizeof(snapshot), &length);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT32(PAL_TRACE_BUFFER_ENTRIES, header->entryCount);
+  TEST_ASSERT_EQUAL_UINT32(entries[0].sequence - 1, header->lost);
+  for (i = 0; i < PAL_TRACE_BUFFER_ENTRIES; ++i)
+  {
+    TEST_ASSERT_EQUAL_UINT32((2 * PAL_TRACE_BUFFER_ENTRIES) + i, entries[i].arguments[0]);
+  }
+
+  //! a small buffer holds the newest records which fit
+  status = pal_osTraceSnapshot(snapshot, sizeof(palTraceSnapshotHeader_t) + (2 * sizeof(palTraceEntry_t)), &length);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT32(2, header->entryCount);
+  TEST_ASSERT_EQUAL_UINT32((3 * PAL_TRACE_BUFFER_ENTRIES) - 1, entries[1].arguments[0]);
+#endif
+
+  status = pal_osTraceSnapshot(snapshot, sizeof(palTraceSnapshotHeader_t) - 1, &length);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osTraceSnapshot(NULL, sizeof(snapshot), &length);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  pal_destroy();
+}
+
+TEST(pal_rtos, ExecutorUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palExecutorID_t executorID = NULLPTR;
+  int32_t count = 0;
+  uint32_t i = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  memset(&g_executorTest, 0, sizeof(g_executorTest));
+  status = pal_osSemaphoreCreate(0, &g_executorTest.gate);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreCreate(0, &g_executorTest.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osExecutorCreate(0, PAL_osPriorityNormal, THREAD_STACK_SIZE, EXECUTOR_TEST_QUEUE_SIZE, true, &executorID);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osExecutorCreate(EXECUTOR_TEST_WORKERS, PAL_osPriorityNormal, THREAD_STACK_SIZE, EXECUTOR_TEST_QUEUE_SIZE + 1, true, &executorID);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+
+  //! all the submitted work runs and completes, whatever its priority
+  status = pal_osExecutorCreate(EXECUTOR_TEST_WORKERS, PAL_osPriorityNormal, THREAD_STACK_SIZE, EXECUTOR_TEST_QUEUE_SIZE, false, &executorID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osExecutorSubmit(executorID, palWorkFuncCount, NULL, (palWorkPriority_t)(PAL_WORK_PRIORITY_LOW + 1), NULL, NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  g_executorTest.expected = EXECUTOR_TEST_WORK_ITEMS;
+  for (i = 0; i < EXECUTOR_TEST_WORK_ITEMS; ++i)
+  {
+    status = pal_osExecutorSubmit(executorID, palWorkFuncCount, NULL, (palWorkPriority_t)(i % 3), palWorkFuncCompletion, NULL);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  }
+  status = pal_osSemaphoreWait(g_executorTest.done, PAL_RTOS_WAIT_FOREVER, &count);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT32(EXECUTOR_TEST_WORK_ITEMS, g_executorTest.executed);
+  TEST_ASSERT_EQUAL_UINT32(EXECUTOR_TEST_WORK_ITEMS, g_executorTest.completed);
+  status = pal_osExecutorDestroy(&executorID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL(NULLPTR, executorID);
+
+  //! a single worker takes the queued work by priority, and destroying the executor runs the queued work
+  memset(g_executorTest.order, 0, sizeof(g_executorTest.order));
+  g_executorTest.executed = 0;
+  status = pal_osExecutorCreate(1, PAL_osPriorityNormal, THREAD_STACK_SIZE, EXECUTOR_TEST_QUEUE_SIZE, false, &executorID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osExecutorSubmit(executorID, palWorkFuncGate, NULL, PAL_WORK_PRIORITY_HIGH, NULL, NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_osDelay(50); // let the worker take the gate
+  for (i = 0; i < 6; ++i)
+  {
+    status = pal_osExecutorSubmit(executorID, palWorkFuncRecordOrder, (void*)(uintptr_t)(2 - (i % 3)), (palWorkPriority_t)(2 - (i % 3)), NULL, NULL);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  }
+  pal_osSemaphoreRelease(g_executorTest.gate);
+  status = pal_osExecutorDestroy(&executorID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT32(7, g_executorTest.executed);
+  for (i = 0; i < 6; ++i)
+  {
+    TEST_ASSERT_EQUAL_UINT32(i / 2, g_executorTest.order[i]);
+  }
+
+  //! with work stealing, the work queued to a blocked worker is done by the others,
+  //! as much work as a queue holds so it fits even when the other worker did not run yet
+  g_executorTest.executed = 0;
+  g_executorTest.completed = 0;
+  g_executorTest.expected = EXECUTOR_TEST_QUEUE_SIZE;
+  status = pal_osExecutorCreate(2, PAL_osPriorityNormal, THREAD_STACK_SIZE, EXECUTOR_TEST_QUEUE_SIZE, true, &executorID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osExecutorSubmit(executorID, palWorkFuncGate, NULL, PAL_WORK_PRIORITY_HIGH, NULL, NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_osDelay(50);
+  for (i = 0; i < EXECUTOR_TEST_QUEUE_SIZE; ++i)
+  {
+    status = pal_osExecutorSubmit(executorID, palWorkFuncCount, NULL, PAL_WORK_PRIORITY_NORMAL, palWorkFuncCompletion, NULL);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  }
+  status = pal_osSemaphoreWait(g_executorTest.done, 5000, &count);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT32(EXECUTOR_TEST_QUEUE_SIZE, g_executorTest.executed);
+  pal_osSemaphoreRelease(g_executorTest.gate);
+  status = pal_osExecutorDestroy(&executorID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osSemaphoreDelete(&g_executorTest.gate);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreDelete(&g_executorTest.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_destroy();
+}
+
+TEST(pal_rtos, ThreadsScaleUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palThreadID_t threadIDs[THREAD_SCALE_TEST_THREADS] = { 0 };
+  palThreadID_t extraID = NULLPTR;
+  uint32_t *stacks[PAL_MAX_NUMBER_OF_THREADS] = { 0 };
+  uint32_t round = 0;
+  uint32_t i = 0;
+  uint32_t j = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  memset(&g_threadScaleTest, 0, sizeof(g_threadScaleTest));
+  status = pal_osSemaphoreCreate(0, &g_threadScaleTest.release);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osThreadStackAlloc(THREAD_STACK_SIZE, &stacks[0]);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osThreadCreate(palThreadFuncScale, NULL, (palThreadPriority_t)(PAL_osPriorityRealtime + 1), THREAD_STACK_SIZE, stacks[0], NULL, &extraID);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osThreadCreate(palThreadFuncScale, NULL, (palThreadPriority_t)(PAL_osPriorityIdle - 1), THREAD_STACK_SIZE, stacks[0], NULL, &extraID);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+
+  //! many threads share priorities, and the slots of the threads which returned are reused by the next round
+  for (round = 0; round < 2; ++round)
+  {
+    g_threadScaleTest.started = 0;
+    g_threadScaleTest.finished = 0;
+    for (i = 0; i < THREAD_SCALE_TEST_THREADS; ++i)
+    {
+      if (NULL == stacks[i])
+      {
+        status = pal_osThreadStackAlloc(THREAD_STACK_SIZE, &stacks[i]);
+        TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+      }
+      status = pal_osThreadCreate(palThreadFuncScale, NULL, (palThreadPriority_t)(PAL_osPriorityBelowNormal + (i % PAL_THREAD_PRIORITY_LEVELS)), THREAD_STACK_SIZE, stacks[i], NULL, &threadIDs[i]);
+      TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+      TEST_ASSERT_TRUE(threadIDs[i] < PAL_MAX_NUMBER_OF_THREADS);
+      for (j = 0; j < i; ++j)
+      {
+        TEST_ASSERT_NOT_EQUAL(threadIDs[j], threadIDs[i]);
+      }
+    }
+    for (i = 0; (i < 100) && (THREAD_SCALE_TEST_THREADS != pal_osAtomicLoad32(&g_threadScaleTest.started, PAL_MEMORY_ORDER_RELAXED)); ++i)
+    {
+      pal_osDelay(10);
+    }
+    TEST_ASSERT_EQUAL_UINT32(THREAD_SCALE_TEST_THREADS, g_threadScaleTest.started);
+
+    for (i = 0; i < THREAD_SCALE_TEST_THREADS; ++i)
+    {
+      pal_osSemaphoreRelease(g_threadScaleTest.release);
+    }
+    for (i = 0; (i < 100) && (THREAD_SCALE_TEST_THREADS != pal_osAtomicLoad32(&g_threadScaleTest.finished, PAL_MEMORY_ORDER_RELAXED)); ++i)
+    {
+      pal_osDelay(10);
+    }
+    TEST_ASSERT_EQUAL_UINT32(THREAD_SCALE_TEST_THREADS, g_threadScaleTest.finished);
+    pal_osDelay(50); // let the threads return and free their slots
+  }
+
+  //! the registry holds up to PAL_MAX_NUMBER_OF_THREADS threads, the main thread included
+  g_threadScaleTest.started = 0;
+  for (i = 0; i < PAL_MAX_NUMBER_OF_THREADS; ++i)
+  {
+    if (NULL == stacks[i])
+    {
+      status = pal_osThreadStackAlloc(THREAD_STACK_SIZE, &stacks[i]);
+      TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+    }
+    status = pal_osThreadCreate(palThreadFuncScale, NULL, PAL_osPriorityNormal, THREAD_STACK_SIZE, stacks[i], NULL, &extraID);
+    if (PAL_SUCCESS != status)
+    {
+      break;
+    }
+  }
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_RESOURCE, status);
+  TEST_ASSERT_EQUAL_UINT32(PAL_MAX_NUMBER_OF_THREADS - 1, i);
+  for (j = 0; j < i; ++j)
+  {
+    pal_osSemaphoreRelease(g_threadScaleTest.release);
+  }
+  pal_osDelay(100); // let the threads return before the semaphore is deleted
+
+  status = pal_osSemaphoreDelete(&g_threadScaleTest.release);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  for (i = 0; i < PAL_MAX_NUMBER_OF_THREADS; ++i)
+  {
+    pal_osThreadStackFree(&stacks[i]);
+  }
+  pal_destroy();
+}
+
+TEST(pal_rtos, ThreadStackPoolUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palThreadStackClassStats_t before = { 0 };
+  palThreadStackClassStats_t stats = { 0 };
+  palSemaphoreID_t done = NULLPTR;
+  palThreadID_t threadID = NULLPTR;
+  uint32_t notPoolStack[8] = { 0 };
+  uint32_t *stack = NULL;
+  uint32_t *reused = NULL;
+  uint32_t *fake = &notPoolStack[4];
+  uint32_t used = 0;
+  int32_t count = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreCreate(0, &done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osThreadStackAlloc(0, &stack);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osThreadStackAlloc(STACK_POOL_TEST_STACK_SIZE, NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osThreadStackFree(&fake);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osThreadStackGetStats(0xFFFF, &stats);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osThreadStackGetStats(STACK_POOL_TEST_CLASS, &before);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_TRUE(STACK_POOL_TEST_STACK_SIZE <= before.stackSize);
+
+  //! a thread runs on the pool stack, and the high water mark shows how deep it went
+  status = pal_osThreadStackAlloc(STACK_POOL_TEST_STACK_SIZE, &stack);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+#if PAL_THREAD_STACK_PAINT
+  status = pal_osThreadStackHighWaterMark(stack, &used);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT32(0, used);
+#endif
+  status = pal_osThreadCreate(palThreadFuncStackUse, &done, PAL_osPriorityNormal, before.stackSize, stack, NULL, &threadID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreWait(done, PAL_RTOS_WAIT_FOREVER, &count);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_osDelay(100); // let the thread return before its stack is freed
+#if PAL_THREAD_STACK_PAINT
+  status = pal_osThreadStackHighWaterMark(stack, &used);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_TRUE(used >= STACK_POOL_TEST_USED_BYTES);
+  TEST_ASSERT_TRUE(used < before.stackSize);
+  TEST_PRINTF("thread stack high water mark: %u of %u bytes\n", used, before.stackSize);
+#endif
+
+  //! the freed stack is kept by its class and given to the next thread, painted again
+  status = pal_osThreadStackFree(&stack);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL(NULL, stack);
+  status = pal_osThreadStackGetStats(STACK_POOL_TEST_CLASS, &stats);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT32(before.inUse, stats.inUse);
+  TEST_ASSERT_EQUAL_UINT32(before.allocations + 1, stats.allocations);
+#if PAL_THREAD_STACK_PAINT
+  TEST_ASSERT_TRUE(stats.highWaterMark >= used);
+#endif
+  if (before.cached < before.stackCount)
+  {
+    TEST_ASSERT_EQUAL_UINT32(before.cached + 1, stats.cached);
+    status = pal_osThreadStackAlloc(STACK_POOL_TEST_STACK_SIZE, &reused);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+    status = pal_osThreadStackGetStats(STACK_POOL_TEST_CLASS, &before);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+    TEST_ASSERT_EQUAL_UINT32(stats.heapAllocations, before.heapAllocations);
+#if PAL_THREAD_STACK_PAINT
+    status = pal_osThreadStackHighWaterMark(reused, &used);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+    TEST_ASSERT_EQUAL_UINT32(0, used);
+#endif
+    status = pal_osThreadStackFree(&reused);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  }
+
+  //! a stack larger than every class comes from the heap
+  status = pal_osThreadStackAlloc(before.stackSize * 4, &stack);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osThreadStackFree(&stack);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osSemaphoreDelete(&done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_destroy();
+}
+
+TEST(pal_rtos, ThreadStatsUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palThreadStats_t stats = { 0 };
+  threadStatsTest_t test = { 0 };
+  palThreadID_t threadID = NULLPTR;
+  palThreadID_t endedID = NULLPTR;
+  uint32_t *stack = NULL;
+  palThreadID_t statsID = 0;
+  int32_t count = 0;
+  uint32_t dumpLines = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMutexCreate(&test.mutex);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreCreate(0, &test.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreCreate(0, &test.release);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osThreadGetStats(0, NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osThreadGetStats(PAL_MAX_NUMBER_OF_THREADS, &stats);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  //! the PAL main thread is known, its stack is not measured
+  status = pal_osThreadGetStats(0, &stats);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.stackHighWaterMark);
+
+  //! the thread burns CPU, then blocks on the mutex the test holds
+  status = pal_osMutexWait(test.mutex, PAL_RTOS_WAIT_FOREVER);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osThreadStackAlloc(STACK_POOL_TEST_STACK_SIZE, &stack);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osThreadCreate(palThreadFuncStats, &test, PAL_osPriorityNormal, STACK_POOL_TEST_STACK_SIZE, stack, NULL, &threadID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_osDelay(THREAD_STATS_TEST_HOLD_MS);
+  status = pal_osMutexRelease(test.mutex);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreWait(test.done, PAL_RTOS_WAIT_FOREVER, &count);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osThreadGetStats(threadID, &stats);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+#if !PAL_RTOS_MUTEX_FAST_PATH //! the fast path waits on a semaphore, which the platform does not count
+  TEST_ASSERT_EQUAL_UINT32(1, stats.mutexWaits);
+  TEST_ASSERT_TRUE(stats.mutexWaitMicroSec > 0);
+  TEST_ASSERT_TRUE(stats.mutexWaitMicroSec <= (THREAD_STATS_TEST_HOLD_MS * 2000));
+#endif
+#if PAL_THREAD_STACK_PAINT
+  TEST_ASSERT_EQUAL_UINT32(STACK_POOL_TEST_STACK_SIZE, stats.stackSize);
+  TEST_ASSERT_TRUE(stats.stackHighWaterMark >= STACK_POOL_TEST_USED_BYTES);
+  TEST_ASSERT_TRUE(stats.stackHighWaterMark < STACK_POOL_TEST_STACK_SIZE);
+#endif
+#if defined(__LINUX__)
+  TEST_ASSERT_TRUE(stats.runTimeMicroSec >= (THREAD_STATS_TEST_RUN_MS * 1000) / 2);
+  TEST_ASSERT_TRUE(stats.contextSwitches >= 1);
+#endif
+
+  //! the dump writes a line for every thread which has statistics, the logger thread included
+  memset(&g_logTest, 0, sizeof(g_logTest));
+  status = pal_osLogStart(palTestLogSink);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  for (statsID = 0; statsID < PAL_MAX_NUMBER_OF_THREADS; ++statsID)
+  {
+      if (PAL_SUCCESS == pal_osThreadGetStats(statsID, &stats))
+      {
+          ++dumpLines;
+      }
+  }
+  TEST_ASSERT_TRUE(dumpLines >= 3);
+  pal_osThreadStatsDump();
+  status = pal_osLogStop();
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT32(dumpLines, g_logTest.lines);
+  TEST_ASSERT_NOT_NULL(strstr(g_logTest.lastLine, "pal thread stats: id="));
+
+  //! the dump runs from a wheel timer until it is stopped
+  memset(&g_logTest, 0, sizeof(g_logTest));
+  status = pal_osLogStart(palTestLogSink);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osThreadStatsDumpStart(0);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osThreadStatsDumpStart(PAL_TIMER_WHEEL_TICK_MS);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osThreadStatsDumpStart(PAL_TIMER_WHEEL_TICK_MS * 2);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_osDelay(PAL_TIMER_WHEEL_TICK_MS * 5);
+  status = pal_osThreadStatsDumpStop();
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osThreadStatsDumpStop();
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osLogStop();
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_TRUE(g_logTest.lines >= dumpLines);
+  TEST_ASSERT_NOT_NULL(strstr(g_logTest.lastLine, "pal thread stats: id="));
+
+  //! a thread which ended has no statistics
+  status = pal_osSemaphoreRelease(test.release);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  endedID = threadID;
+  status = pal_osThreadTerminate(&threadID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osThreadGetStats(endedID, &stats);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osThreadStackFree(&stack);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osSemaphoreDelete(&test.release);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreDelete(&test.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMutexDelete(&test.mutex);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_destroy();
+}
+
+TEST(pal_rtos, LockStatsUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  threadStatsTest_t test = { 0 };
+  lockStatsFind_t find = { 0 };
+#if PAL_RTOS_CONTENTION_PROFILING
+  palThreadID_t threadID = NULLPTR;
+  uint32_t *stack = NULL;
+  int32_t count = 0;
+#endif
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMutexCreate(&test.mutex);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreCreate(0, &test.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreCreate(0, &test.release);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+#if PAL_RTOS_CONTENTION_PROFILING
+  status = pal_osLockStatsIterate(NULL, NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+
+  //! the mutex knows its holder
+  status = pal_osMutexWait(test.mutex, PAL_RTOS_WAIT_FOREVER);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  find.id = (uintptr_t)test.mutex;
+  status = pal_osLockStatsIterate(palLockStatsFind, &find);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_TRUE(find.found);
+  TEST_ASSERT_EQUAL(PAL_LOCK_TYPE_MUTEX, find.stats.type);
+  TEST_ASSERT_EQUAL_UINT32(1, find.stats.acquisitions);
+  TEST_ASSERT_EQUAL_UINT32(0, find.stats.contendedAcquisitions);
+  TEST_ASSERT_EQUAL(pal_osThreadGetId(), find.stats.holder);
+
+  //! a thread blocks on the held mutex, its wait is timed
+  status = pal_osThreadStackAlloc(STACK_POOL_TEST_STACK_SIZE, &stack);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osThreadCreate(palThreadFuncStats, &test, PAL_osPriorityNormal, STACK_POOL_TEST_STACK_SIZE, stack, NULL, &threadID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_osDelay(THREAD_STATS_TEST_HOLD_MS);
+  status = pal_osMutexRelease(test.mutex);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreWait(test.done, PAL_RTOS_WAIT_FOREVER, &count);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  find.found = false;
+  status = pal_osLockStatsIterate(palLockStatsFind, &find);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_TRUE(find.found);
+  TEST_ASSERT_EQUAL_UINT32(2, find.stats.acquisitions);
+  TEST_ASSERT_EQUAL_UINT32(1, find.stats.contendedAcquisitions);
+  TEST_ASSERT_TRUE(find.stats.totalWaitTicks > 0);
+  TEST_ASSERT_TRUE(find.stats.maxWaitTicks == find.stats.totalWaitTicks);
+  TEST_ASSERT_TRUE(find.stats.totalWaitTicks <= pal_osKernelSysTickMicroSec(THREAD_STATS_TEST_HOLD_MS * 2000));
+  TEST_ASSERT_EQUAL(PAL_INVALID_THREAD, find.stats.holder);
+
+  find.id = (uintptr_t)test.done;
+  find.found = false;
+  status = pal_osLockStatsIterate(palLockStatsFind, &find);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_TRUE(find.found);
+  TEST_ASSERT_EQUAL(PAL_LOCK_TYPE_SEMAPHORE, find.stats.type);
+  TEST_ASSERT_EQUAL_UINT32(1, find.stats.acquisitions);
+  pal_osLockStatsReport();
+
+  status = pal_osSemaphoreRelease(test.release);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osThreadTerminate(&threadID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osThreadStackFree(&stack);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+#else
+  status = pal_osLockStatsIterate(palLockStatsFind, &find);
+  TEST_ASSERT_EQUAL(PAL_ERR_NOT_SUPPORTED, status);
+  pal_osLockStatsReport();
+#endif
+
+  //! a deleted mutex is not listed any more
+  find.id = (uintptr_t)test.mutex;
+  status = pal_osMutexDelete(&test.mutex);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  find.found = false;
+  pal_osLockStatsIterate(palLockStatsFind, &find);
+  TEST_ASSERT_FALSE(find.found);
+
+  status = pal_osSemaphoreDelete(&test.release);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreDelete(&test.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_destroy();
+}
+
+TEST(pal_rtos, RwLockUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palThreadID_t threadID = NULLPTR;
+  rwLockTest_t test;
+  uint32_t *stack = (uint32_t*)malloc(THREAD_STACK_SIZE);
+  uint64_t start = 0;
+  int32_t count = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  memset(&test, 0, sizeof(test));
+
+  status = pal_osRwLockCreate(NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osRwLockReadLock(NULLPTR, 0);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osRwLockWriteLock(NULLPTR, 0);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osRwLockUnlock(NULLPTR);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osRwLockDelete(NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+
+  status = pal_osRwLockCreate(&test.rwLockID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreCreate(0, &test.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osRwLockUnlock(test.rwLockID);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+
+  //! readers hold the lock together, a writer waits for them until its timeout
+  status = pal_osRwLockReadLock(test.rwLockID, 0);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osRwLockReadLock(test.rwLockID, 0);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osRwLockWriteLock(test.rwLockID, 0);
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_TIMEOUT, status);
+  start = pal_osKernelSysTick64();
+  status = pal_osRwLockWriteLock(test.rwLockID, RWLOCK_TEST_WAIT_MS);
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_TIMEOUT, status);
+  TEST_ASSERT_TRUE(pal_osKernelSysMilliSecTick(pal_osKernelSysTick64() - start) >= RWLOCK_TEST_WAIT_MS - 1);
+  //! the writer which gave up does not hold readers back
+  status = pal_osRwLockReadLock(test.rwLockID, 0);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osRwLockUnlock(test.rwLockID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osRwLockUnlock(test.rwLockID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osRwLockUnlock(test.rwLockID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osRwLockUnlock(test.rwLockID);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+
+  //! a writer holds the lock alone
+  status = pal_osRwLockWriteLock(test.rwLockID, 0);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osRwLockReadLock(test.rwLockID, 0);
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_TIMEOUT, status);
+  status = pal_osRwLockReadLock(test.rwLockID, RWLOCK_TEST_WAIT_MS);
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_TIMEOUT, status);
+  status = pal_osRwLockWriteLock(test.rwLockID, 0);
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_TIMEOUT, status);
+  status = pal_osRwLockUnlock(test.rwLockID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  //! a waiting writer holds new readers back, and gets the lock from the last reader
+  status = pal_osRwLockReadLock(test.rwLockID, 0);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osThreadCreate(palThreadFuncRwLockWriter, &test, PAL_osPriorityNormal, THREAD_STACK_SIZE, stack, NULL, &threadID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_osDelay(RWLOCK_TEST_WAIT_MS);
+  status = pal_osRwLockReadLock(test.rwLockID, 0);
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_TIMEOUT, status);
+  TEST_ASSERT_EQUAL_UINT32(0, test.written);
+  status = pal_osRwLockUnlock(test.rwLockID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreWait(test.done, PAL_RTOS_WAIT_FOREVER, &count);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT32(1, test.written);
+  status = pal_osRwLockReadLock(test.rwLockID, 0);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osRwLockUnlock(test.rwLockID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_osDelay(100); // let the thread return before its stack is freed
+  status = pal_osThreadTerminate(&threadID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osRwLockDelete(&test.rwLockID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL(NULLPTR, test.rwLockID);
+  status = pal_osSemaphoreDelete(&test.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  free(stack);
+  pal_destroy();
+}
+
+TEST(pal_rtos, EventFlagsUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palThreadID_t threadID = NULLPTR;
+  syncTest_t test;
+  uint32_t *stack = (uint32_t*)malloc(THREAD_STACK_SIZE);
+  uint32_t flags = 0;
+  int32_t count = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  memset(&test, 0, sizeof(test));
+
+  status = pal_osEventFlagsCreate(NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osEventFlagsSet(NULLPTR, 0x1, NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osEventFlagsWait(NULLPTR, 0x1, PAL_OS_FLAGS_WAIT_ANY, 0, NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osEventFlagsDelete(NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+
+  status = pal_osEventFlagsCreate(&test.eventFlagsID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreCreate(0, &test.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osEventFlagsWait(test.eventFlagsID, 0, PAL_OS_FLAGS_WAIT_ANY, 0, NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+
+  //! a wait clears the flags it waited for
+  status = pal_osEventFlagsSet(test.eventFlagsID, 0x1, &flags);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_HEX32(0x1, flags);
+  status = pal_osEventFlagsWait(test.eventFlagsID, 0x1, PAL_OS_FLAGS_WAIT_ANY, 0, &flags);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_HEX32(0x1, flags);
+  status = pal_osEventFlagsWait(test.eventFlagsID, 0x1, PAL_OS_FLAGS_WAIT_ANY, 0, NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_TIMEOUT, status);
+
+  //! any and all, with and without clearing
+  status = pal_osEventFlagsSet(test.eventFlagsID, 0x3, NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osEventFlagsWait(test.eventFlagsID, 0x7, PAL_OS_FLAGS_WAIT_ALL, SYNC_TEST_WAIT_MS, NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_TIMEOUT, status);
+  status = pal_osEventFlagsWait(test.eventFlagsID, 0x6, PAL_OS_FLAGS_WAIT_ANY | PAL_OS_FLAGS_NO_CLEAR, 0, &flags);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_HEX32(0x3, flags);
+  status = pal_osEventFlagsClear(test.eventFlagsID, 0x3, &flags);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_HEX32(0x3, flags);
+
+  //! a thread waits for all of its flags, the first one alone does not wake it
+  test.waitFlags = 0x5;
+  status = pal_osThreadCreate(palThreadFuncEventFlagsWaiter, &test, PAL_osPriorityNormal, THREAD_STACK_SIZE, stack, NULL, &threadID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_osDelay(SYNC_TEST_WAIT_MS);
+  status = pal_osEventFlagsSet(test.eventFlagsID, 0x9, NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_osDelay(SYNC_TEST_WAIT_MS);
+  TEST_ASSERT_EQUAL_UINT32(0, test.woken);
+  status = pal_osEventFlagsSet(test.eventFlagsID, 0x4, &flags);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_HEX32(0x8, flags);
+  status = pal_osSemaphoreWait(test.done, PAL_RTOS_WAIT_FOREVER, &count);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL_UINT32(1, test.woken);
+  TEST_ASSERT_EQUAL_HEX32(0xD, test.flags);
+  pal_osDelay(100); // let the thread return before its stack is freed
+  status = pal_osThreadTerminate(&threadID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osEventFlagsDelete(&test.eventFlagsID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL(NULLPTR, test.eventFlagsID);
+  status = pal_osSemaphoreDelete(&test.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  free(stack);
+  pal_destroy();
+}
+
+TEST(pal_rtos, CondVarUnityTest)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palThreadID_t threadIDs[SYNC_TEST_WAITERS] = { 0 };
+  uint32_t *stacks[SYNC_TEST_WAITERS] = { 0 };
+  syncTest_t test;
+  int32_t count = 0;
+  uint32_t i = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  memset(&test, 0, sizeof(test));
+
+  status = pal_osCondVarCreate(NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osCondVarSignal(NULLPTR);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osCondVarDelete(NULL);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+
+  status = pal_osCondVarCreate(&test.condVarID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMutexCreate(&test.mutexID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreCreate(0, &test.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osCondVarWait(test.condVarID, NULLPTR, 0);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+
+  //! a wait which is not signaled ends with the mutex held again
+  status = pal_osMutexWait(test.mutexID, PAL_RTOS_WAIT_FOREVER);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osCondVarWait(test.condVarID, test.mutexID, SYNC_TEST_WAIT_MS);
+  TEST_ASSERT_EQUAL(PAL_ERR_RTOS_TIMEOUT, status);
+  status = pal_osMutexRelease(test.mutexID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  //! a mutex held twice is refused rather than kept while the thread sleeps
+  status = pal_osMutexWait(test.mutexID, PAL_RTOS_WAIT_FOREVER);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMutexWait(test.mutexID, PAL_RTOS_WAIT_FOREVER);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osCondVarWait(test.condVarID, test.mutexID, SYNC_TEST_WAIT_MS);
+  TEST_ASSERT_EQUAL(PAL_ERR_INVALID_ARGUMENT, status);
+  status = pal_osMutexRelease(test.mutexID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMutexRelease(test.mutexID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  for (i = 0; i < SYNC_TEST_WAITERS; ++i)
+  {
+    stacks[i] = (uint32_t*)malloc(THREAD_STACK_SIZE);
+    TEST_ASSERT_NOT_NULL(stacks[i]);
+    status = pal_osThreadCreate(palThreadFuncCondVarWaiter, &test, PAL_osPriorityNormal, THREAD_STACK_SIZE, stacks[i], NULL, &threadIDs[i]);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  }
+  pal_osDelay(SYNC_TEST_WAIT_MS);
+
+  //! a signal wakes one thread
+  status = pal_osMutexWait(test.mutexID, PAL_RTOS_WAIT_FOREVER);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  test.tickets = 1;
+  status = pal_osCondVarSignal(test.condVarID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMutexRelease(test.mutexID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreWait(test.done, PAL_RTOS_WAIT_FOREVER, &count);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_osDelay(SYNC_TEST_WAIT_MS);
+  TEST_ASSERT_EQUAL_UINT32(1, test.woken);
+
+  //! a broadcast wakes all of them
+  status = pal_osMutexWait(test.mutexID, PAL_RTOS_WAIT_FOREVER);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  test.tickets = SYNC_TEST_WAITERS - 1;
+  status = pal_osCondVarBroadcast(test.condVarID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMutexRelease(test.mutexID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  for (i = 1; i < SYNC_TEST_WAITERS; ++i)
+  {
+    status = pal_osSemaphoreWait(test.done, PAL_RTOS_WAIT_FOREVER, &count);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  }
+  TEST_ASSERT_EQUAL_UINT32(SYNC_TEST_WAITERS, test.woken);
+  TEST_ASSERT_EQUAL_UINT32(0, test.tickets);
+
+  pal_osDelay(100); // let the threads return before their stacks are freed
+  for (i = 0; i < SYNC_TEST_WAITERS; ++i)
+  {
+    status = pal_osThreadTerminate(&threadIDs[i]);
+    TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+    free(stacks[i]);
+  }
+
+  status = pal_osCondVarDelete(&test.condVarID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  TEST_ASSERT_EQUAL(NULLPTR, test.condVarID);
+  status = pal_osMutexDelete(&test.mutexID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreDelete(&test.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_destroy();
+}
+
+TEST(pal_rtos, RwLockBenchmark)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palThreadID_t threadIDs[RWLOCK_BENCHMARK_MAX_READERS] = { 0 };
+  uint32_t *stacks[RWLOCK_BENCHMARK_MAX_READERS] = { 0 };
+  rwLockTest_t test;
+  uint64_t ticks = 0;
+  uint32_t readers = 0;
+  uint32_t useMutex = 0;
+  uint32_t i = 0;
+  int32_t count = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  memset(&test, 0, sizeof(test));
+  for (i = 0; i < RWLOCK_TEST_TABLE_SIZE; ++i)
+  {
+    test.table[i] = 1;
+  }
+  for (i = 0; i < RWLOCK_BENCHMARK_MAX_READERS; ++i)
+  {
+    stacks[i] = (uint32_t*)malloc(THREAD_STACK_SIZE);
+    TEST_ASSERT_NOT_NULL(stacks[i]);
+  }
+  status = pal_osRwLockCreate(&test.rwLockID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMutexCreate(&test.mutexID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osSemaphoreCreate(0, &test.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  //! the same read only work done by 1 to RWLOCK_BENCHMARK_MAX_READERS threads, under the reader-writer lock and under a mutex
+  for (useMutex = 0; useMutex < 2; ++useMutex)
+  {
+    test.useMutex = (1 == useMutex);
+    for (readers = 1; readers <= RWLOCK_BENCHMARK_MAX_READERS; readers *= 2)
+    {
+      ticks = pal_osKernelSysTick64();
+      for (i = 0; i < readers; ++i)
+      {
+        status = pal_osThreadCreate(palThreadFuncRwLockReader, &test, PAL_osPriorityNormal, THREAD_STACK_SIZE, stacks[i], NULL, &threadIDs[i]);
+        TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+      }
+      for (i = 0; i < readers; ++i)
+      {
+        status = pal_osSemaphoreWait(test.done, PAL_RTOS_WAIT_FOREVER, &count);
+        TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+      }
+      ticks = pal_osKernelSysTick64() - ticks;
+      TEST_PRINTF("%s with %u readers: %u reads/sec\n", test.useMutex ? "pal_osMutexWait/Release" : "pal_osRwLockReadLock/Unlock", readers,
+                  (uint32_t)(((uint64_t)PAL_RTOS_BENCHMARK_ITERATIONS * readers * pal_osKernelSysTickFrequency()) / (ticks + 1)));
+      pal_osDelay(100); // let the threads return before their slots are reused
+      for (i = 0; i < readers; ++i)
+      {
+        status = pal_osThreadTerminate(&threadIDs[i]);
+        TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+      }
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, test.errors);
+
+  status = pal_osSemaphoreDelete(&test.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMutexDelete(&test.mutexID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osRwLockDelete(&test.rwLockID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  for (i = 0; i < RWLOCK_BENCHMARK_MAX_READERS; ++i)
+  {
+    free(stacks[i]);
+  }
+  pal_destroy();
+}
+
+TEST(pal_rtos, MutexBenchmark)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palMutexID_t mutexID = NULLPTR;
+  uint64_t ticks = 0;
+  uint32_t errors = 0;
+  uint32_t i = 0;
+
+  status = pal_init(NULL);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMutexCreate(&mutexID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  //! uncontended pairs, the common case of the locks around the state of PAL and of the log
+  ticks = pal_osKernelSysTick64();
+  for (i = 0; i < PAL_RTOS_BENCHMARK_ITERATIONS; ++i)
+  {
+    if ((PAL_SUCCESS != pal_osMutexWait(mutexID, PAL_RTOS_WAIT_FOREVER)) || (PAL_SUCCESS != pal_osMutexRelease(mutexID)))
+    {
+      errors++;
+    }
+  }
+  ticks = pal_osKernelSysTick64() - ticks;
+
+  TEST_ASSERT_EQUAL(0, errors);
+  TEST_PRINTF("pal_osMutexWait/Release (fast path %s): %u uncontended pairs/sec\n", PAL_RTOS_MUTEX_FAST_PATH ? "on" : "off",
+              (uint32_t)((PAL_RTOS_BENCHMARK_ITERATIONS * pal_osKernelSysTickFrequency()) / (ticks + 1)));
+
+  //! the mutex is recursive, and only its holder releases it
+  status = pal_osMutexWait(mutexID, 0);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMutexWait(mutexID, 0);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMutexRelease(mutexID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMutexRelease(mutexID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  status = pal_osMutexRelease(mutexID);
+  TEST_ASSERT_NOT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osMutexDelete(&mutexID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  pal_destroy();
+}
+
+TEST(pal_rtos, ThreadGetIdBenchmark)
+{
+  palStatus_t status = PAL_SUCCESS;
+  palThreadID_t threadID = NULLPTR;
+  int32_t count = 0;
+  uint32_t *stack = (uint32_t*)malloc(THREAD_STACK_SIZE);
+  palThreadLocalStore_t store = { 0 };
+
+  status = pal_init();
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  memset(&g_threadIdBenchmark, 0, sizeof(g_threadIdBenchmark));
+  status = pal_osSemaphoreCreate(0, &g_threadIdBenchmark.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  g_threadIdBenchmark.store = &store;
+
+  status = pal_osThreadCreate(palThreadFuncGetIdBenchmark, &g_threadIdBenchmark, PAL_osPriorityRealtime, THREAD_STACK_SIZE, stack, &store, &threadID);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  status = pal_osSemaphoreWait(g_threadIdBenchmark.done, PAL_RTOS_WAIT_FOREVER, &count);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+
+  TEST_ASSERT_EQUAL(threadID, g_threadIdBenchmark.threadID);
+  TEST_ASSERT_EQUAL(0, g_threadIdBenchmark.errors);
+  TEST_PRINTF("pal_osThreadGetId: %u calls/sec\n", (uint32_t)((PAL_RTOS_BENCHMARK_ITERATIONS * pal_osKernelSysTickFrequency()) / (g_threadIdBenchmark.getIdTicks + 1)));
+  TEST_PRINTF("pal_osThreadGetLocalStore: %u calls/sec\n", (uint32_t)((PAL_RTOS_BENCHMARK_ITERATIONS * pal_osKernelSysTickFrequency()) / (g_threadIdBenchmark.getLocalStoreTicks + 1)));
+
+  pal_osDelay(100); // let the thread return before its stack is freed
+  status = pal_osSemaphoreDelete(&g_threadIdBenchmark.done);
+  TEST_ASSERT_EQUAL(PAL_SUCCESS, status);
+  free(stack);
+  pal_destroy();
 }
 
 TEST(pal_rtos, pal_init_test)
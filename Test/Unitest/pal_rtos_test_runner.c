@@ -26,6 +26,9 @@ TEST_GROUP_RUNNER(pal_rtos)
 #if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || pal_osKernelSysTick64_Unity)
   RUN_TEST_CASE(pal_rtos, pal_osKernelSysTick64_Unity);
 #endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || TickWraparoundStressTest)
+  RUN_TEST_CASE(pal_rtos, TickWraparoundStressTest);
+#endif
 #if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || pal_osKernelSysTickMicroSec_Unity)
   RUN_TEST_CASE(pal_rtos, pal_osKernelSysTickMicroSec_Unity);
 #endif
@@ -44,15 +47,81 @@ TEST_GROUP_RUNNER(pal_rtos)
 #if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || TimerUnityTest)
   RUN_TEST_CASE(pal_rtos, TimerUnityTest);
 #endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || WheelTimerUnityTest)
+  RUN_TEST_CASE(pal_rtos, WheelTimerUnityTest);
+#endif
 #if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || MemoryPoolUnityTest)
   RUN_TEST_CASE(pal_rtos, MemoryPoolUnityTest);
 #endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || MemoryPoolBulkUnityTest)
+  RUN_TEST_CASE(pal_rtos, MemoryPoolBulkUnityTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || MemoryPoolThreadsUnityTest)
+  RUN_TEST_CASE(pal_rtos, MemoryPoolThreadsUnityTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || SlabUnityTest)
+  RUN_TEST_CASE(pal_rtos, SlabUnityTest);
+#endif
 #if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || MessageUnityTest)
   RUN_TEST_CASE(pal_rtos, MessageUnityTest);
 #endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || TypedMessageUnityTest)
+  RUN_TEST_CASE(pal_rtos, TypedMessageUnityTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || SpscRingUnityTest)
+  RUN_TEST_CASE(pal_rtos, SpscRingUnityTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || SpscRingBenchmark)
+  RUN_TEST_CASE(pal_rtos, SpscRingBenchmark);
+#endif
 #if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || AtomicIncrementUnityTest)
   RUN_TEST_CASE(pal_rtos, AtomicIncrementUnityTest);
 #endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || AtomicOperationsUnityTest)
+  RUN_TEST_CASE(pal_rtos, AtomicOperationsUnityTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || AtomicStressTest)
+  RUN_TEST_CASE(pal_rtos, AtomicStressTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || LogUnityTest)
+  RUN_TEST_CASE(pal_rtos, LogUnityTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || LogThreadsUnityTest)
+  RUN_TEST_CASE(pal_rtos, LogThreadsUnityTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || TraceUnityTest)
+  RUN_TEST_CASE(pal_rtos, TraceUnityTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || ExecutorUnityTest)
+  RUN_TEST_CASE(pal_rtos, ExecutorUnityTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || ThreadsScaleUnityTest)
+  RUN_TEST_CASE(pal_rtos, ThreadsScaleUnityTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || ThreadStackPoolUnityTest)
+  RUN_TEST_CASE(pal_rtos, ThreadStackPoolUnityTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || ThreadStatsUnityTest)
+  RUN_TEST_CASE(pal_rtos, ThreadStatsUnityTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || LockStatsUnityTest)
+  RUN_TEST_CASE(pal_rtos, LockStatsUnityTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || RwLockUnityTest)
+  RUN_TEST_CASE(pal_rtos, RwLockUnityTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || EventFlagsUnityTest)
+  RUN_TEST_CASE(pal_rtos, EventFlagsUnityTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || CondVarUnityTest)
+  RUN_TEST_CASE(pal_rtos, CondVarUnityTest);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || RwLockBenchmark)
+  RUN_TEST_CASE(pal_rtos, RwLockBenchmark);
+#endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || MutexBenchmark)
+  RUN_TEST_CASE(pal_rtos, MutexBenchmark);
+#endif
 
 #if (PAL_INCLUDE || PRIMITIVES_UNITY_TEST || PrimitivesUnityTest1)
   RUN_TEST_CASE(pal_rtos, PrimitivesUnityTest1);
@@ -60,6 +129,9 @@ TEST_GROUP_RUNNER(pal_rtos)
 #if (PAL_INCLUDE || PRIMITIVES_UNITY_TEST || PrimitivesUnityTest2)
   RUN_TEST_CASE(pal_rtos, PrimitivesUnityTest2);
 #endif
+#if (PAL_INCLUDE || BASIC_RTOS_UNITY_TESTS || ThreadGetIdBenchmark)
+  RUN_TEST_CASE(pal_rtos, ThreadGetIdBenchmark);
+#endif
 #if (PAL_INCLUDE || PAL_INIT_REFERENCE || pal_init_test)
 RUN_TEST_CASE(pal_rtos, pal_init_test);
 #endif
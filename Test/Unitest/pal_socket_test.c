@@ -39,6 +39,7 @@ TEST_GROUP(pal_socket);
 #define PAL_NET_TEST_SERVER_HTTP_PORT 8686
 #define PAL_NET_TEST_SERVER_UDP_PORT 8383
 #define PAL_NET_TEST_INCOMING_PORT 8000
+#define PAL_NET_TEST_LOCAL_UDP_PORT 8484
 
 void * g_networkInterface = NULL;
 
@@ -293,7 +294,7 @@ TEST(pal_socket, basicSocketScenario4)
     tv.pal_tv_sec = 5;
     tv.pal_tv_usec = 1000;
     
-    result = pal_plat_socketMiniSelect(socketsToCheck, 2, &tv, palSocketStatus, &numSockets);
+    result = pal_socketMiniSelect(socketsToCheck, 2, &tv, palSocketStatus, &numSockets);
     TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
     //TEST_ASSERT_EQUAL(numSockets, 1);
     //TEST_ASSERT(palSocketStatus[0] >= 0);
@@ -309,7 +310,7 @@ TEST(pal_socket, basicSocketScenario4)
     socketsToCheck[1] = 0;
     tv.pal_tv_sec = 0;
     tv.pal_tv_usec = 20000;
-    result = pal_plat_socketMiniSelect(socketsToCheck, 1, &tv, palSocketStatus, &numSockets);
+    result = pal_socketMiniSelect(socketsToCheck, 1, &tv, palSocketStatus, &numSockets);
     TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
     TEST_ASSERT_EQUAL(numSockets, 0);
     TEST_ASSERT(palSocketStatus[0] == 0);
@@ -426,3 +427,620 @@ TEST(pal_socket, tProvUDPTest)
     result = pal_receiveFrom(sock, buffer, 100, &address2, &addrlen2, &read); //  should get timeout
     TEST_ASSERT_EQUAL(result, PAL_ERR_SOCKET_WOULD_BLOCK);
 }
+
+
+TEST(pal_socket, socketPollerUDPTest)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palSocket_t sock = 0;
+    palSocket_t sock2 = 0;
+    palSocketPollerID_t poller = NULLPTR;
+    palSocketPollEvent_t events[2];
+    uint32_t numberOfEvents = 0;
+    palNetInterfaceInfo_t interfaceInfo;
+    const char* message = "poller";
+    char buffer[PAL_TEST_BUFFER_SIZE] = { 0 };
+    size_t sent = 0;
+    size_t read = 0;
+
+    memset(&interfaceInfo, 0, sizeof(interfaceInfo));
+    result = pal_getNetInterfaceInfo(0, &interfaceInfo);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_setSockAddrPort(&interfaceInfo.address, PAL_NET_TEST_LOCAL_UDP_PORT);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+
+    result = pal_socket(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, &sock);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_socket(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, &sock2);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_bind(sock, &interfaceInfo.address, interfaceInfo.addressSize);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+
+    result = pal_socketPollerCreate(&poller);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_socketPollerAdd(poller, sock, PAL_NET_SOCKET_SELECT_RX_BIT);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+
+    // nothing was sent yet - the wait times out without events.
+    result = pal_socketPollerWait(poller, events, 2, 20, &numberOfEvents);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(numberOfEvents, 0);
+
+    result = pal_sendTo(sock2, message, strlen(message), &interfaceInfo.address, interfaceInfo.addressSize, &sent);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+
+    result = pal_socketPollerWait(poller, events, 2, 1000, &numberOfEvents);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(numberOfEvents, 1);
+    TEST_ASSERT(events[0].socket == sock);
+    TEST_ASSERT(events[0].events & PAL_NET_SOCKET_SELECT_RX_BIT);
+
+    result = pal_receiveFrom(sock, buffer, sizeof(buffer), NULL, NULL, &read);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(read, strlen(message));
+
+    // the same poller is reused with a different interest, a UDP socket can always be written to.
+    result = pal_socketPollerModify(poller, sock, PAL_NET_SOCKET_SELECT_TX_BIT);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_sendTo(sock2, message, strlen(message), &interfaceInfo.address, interfaceInfo.addressSize, &sent);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_socketPollerWait(poller, events, 2, 1000, &numberOfEvents);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(numberOfEvents, 1);
+    TEST_ASSERT(events[0].socket == sock);
+    TEST_ASSERT(events[0].events & PAL_NET_SOCKET_SELECT_TX_BIT);
+
+    result = pal_socketPollerRemove(poller, sock);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_socketPollerDestroy(&poller);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(poller, NULLPTR);
+
+    pal_close(&sock);
+    pal_close(&sock2);
+}
+
+#define PAL_NET_TEST_DATAGRAMS 5
+
+TEST(pal_socket, socketMultiDatagramUDPTest)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palSocket_t sock = 0;
+    palSocket_t sock2 = 0;
+    palNetInterfaceInfo_t interfaceInfo;
+    palDatagram_t datagrams[PAL_NET_TEST_DATAGRAMS + 1];
+    palSocketAddress_t sender;
+    uint16_t port = 0;
+    char messages[PAL_NET_TEST_DATAGRAMS][PAL_TEST_BUFFER_SIZE];
+    char buffers[PAL_NET_TEST_DATAGRAMS + 1][PAL_TEST_BUFFER_SIZE];
+    uint32_t sent = 0;
+    uint32_t received = 0;
+    uint32_t total = 0;
+    uint32_t index = 0;
+
+    memset(&interfaceInfo, 0, sizeof(interfaceInfo));
+    result = pal_getNetInterfaceInfo(0, &interfaceInfo);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_setSockAddrPort(&interfaceInfo.address, PAL_NET_TEST_LOCAL_UDP_PORT);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+
+    result = pal_socket(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, &sock);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_socket(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, &sock2);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_bind(sock, &interfaceInfo.address, interfaceInfo.addressSize);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+
+    result = pal_sendToMulti(sock2, NULL, 1, &sent);
+    TEST_ASSERT_EQUAL(result, PAL_ERR_RTOS_PARAMETER);
+    result = pal_receiveFromMulti(sock, datagrams, 0, &received);
+    TEST_ASSERT_EQUAL(result, PAL_ERR_RTOS_PARAMETER);
+
+    // a burst of datagrams of different lengths goes out with one call.
+    memset(datagrams, 0, sizeof(datagrams));
+    for (index = 0; index < PAL_NET_TEST_DATAGRAMS; ++index)
+    {
+        memset(messages[index], 'a' + index, sizeof(messages[index]));
+        datagrams[index].buffer = messages[index];
+        datagrams[index].length = index + 1;
+        datagrams[index].address = &interfaceInfo.address;
+        datagrams[index].addressLength = interfaceInfo.addressSize;
+    }
+    result = pal_sendToMulti(sock2, datagrams, PAL_NET_TEST_DATAGRAMS, &sent);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(sent, PAL_NET_TEST_DATAGRAMS);
+    for (index = 0; index < PAL_NET_TEST_DATAGRAMS; ++index)
+    {
+        TEST_ASSERT_EQUAL(datagrams[index].status, PAL_SUCCESS);
+        TEST_ASSERT_EQUAL(datagrams[index].bytes, index + 1);
+    }
+
+    // they arrive in order, as many per call as the platform batches, the extra buffer stays unused.
+    while (total < PAL_NET_TEST_DATAGRAMS)
+    {
+        memset(datagrams, 0, sizeof(datagrams));
+        for (index = 0; index < PAL_NET_TEST_DATAGRAMS + 1 - total; ++index)
+        {
+            datagrams[index].buffer = buffers[total + index];
+            datagrams[index].length = PAL_TEST_BUFFER_SIZE;
+        }
+        // the sender is optional, it is asked for the first datagram of each call only.
+        memset(&sender, 0, sizeof(sender));
+        datagrams[0].address = &sender;
+        result = pal_receiveFromMulti(sock, datagrams, PAL_NET_TEST_DATAGRAMS + 1 - total, &received);
+        TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+        TEST_ASSERT(received > 0);
+        TEST_ASSERT_EQUAL(sender.addressType, PAL_AF_INET);
+        TEST_ASSERT_EQUAL(datagrams[0].addressLength, interfaceInfo.addressSize);
+        result = pal_getSockAddrPort(&sender, &port);
+        TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+        TEST_ASSERT(port != 0);
+        for (index = 0; index < received; ++index)
+        {
+            TEST_ASSERT_EQUAL(datagrams[index].status, PAL_SUCCESS);
+            TEST_ASSERT_EQUAL(datagrams[index].bytes, total + index + 1);
+            TEST_ASSERT_EQUAL(buffers[total + index][0], 'a' + total + index);
+        }
+        total += received;
+    }
+    TEST_ASSERT_EQUAL(total, PAL_NET_TEST_DATAGRAMS);
+
+    pal_close(&sock);
+    pal_close(&sock2);
+}
+
+
+TEST(pal_socket, socketScatterGatherUDPTest)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palSocket_t sock = 0;
+    palSocket_t sock2 = 0;
+    palNetInterfaceInfo_t interfaceInfo;
+    palSocketAddress_t sender;
+    palSocketLength_t senderLength = sizeof(sender);
+    uint8_t header[4] = {'h', 'e', 'a', 'd'};
+    uint8_t payload[PAL_TEST_BUFFER_SIZE];
+    uint8_t trailer[2] = {'t', 'r'};
+    uint8_t first[6];
+    uint8_t second[PAL_TEST_BUFFER_SIZE];
+    size_t sent = 0;
+    size_t received = 0;
+    // an empty segment in the middle is skipped.
+    palConstBuffer_t gather[4] = {{0, sizeof(header), header}, {0, 0, NULL}, {0, sizeof(payload), payload}, {0, sizeof(trailer), trailer}};
+    palBuffer_t scatter[2] = {{sizeof(first), 0, first}, {sizeof(second), 0, second}};
+
+    memset(payload, 'p', sizeof(payload));
+    memset(&interfaceInfo, 0, sizeof(interfaceInfo));
+    result = pal_getNetInterfaceInfo(0, &interfaceInfo);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_setSockAddrPort(&interfaceInfo.address, PAL_NET_TEST_LOCAL_UDP_PORT);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+
+    result = pal_socket(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, &sock);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_socket(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, &sock2);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_bind(sock, &interfaceInfo.address, interfaceInfo.addressSize);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+
+    result = pal_sendTov(sock2, gather, 0, &interfaceInfo.address, interfaceInfo.addressSize, &sent);
+    TEST_ASSERT_EQUAL(result, PAL_ERR_RTOS_PARAMETER);
+    result = pal_sendTov(sock2, gather, PAL_NET_MAX_SEGMENTS + 1, &interfaceInfo.address, interfaceInfo.addressSize, &sent);
+    TEST_ASSERT_EQUAL(result, PAL_ERR_RTOS_PARAMETER);
+    result = pal_receiveFromv(sock, scatter, 2, &sender, &senderLength, NULL);
+    TEST_ASSERT_EQUAL(result, PAL_ERR_RTOS_PARAMETER);
+
+    // header, payload and trailer leave as one datagram.
+    result = pal_sendTov(sock2, gather, 4, &interfaceInfo.address, interfaceInfo.addressSize, &sent);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(sent, sizeof(header) + sizeof(payload) + sizeof(trailer));
+
+    // the first segment fills up before the second one is used.
+    memset(&sender, 0, sizeof(sender));
+    result = pal_receiveFromv(sock, scatter, 2, &sender, &senderLength, &received);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(received, sent);
+    TEST_ASSERT_EQUAL(sender.addressType, PAL_AF_INET);
+    TEST_ASSERT_EQUAL(scatter[0].bufferLength, sizeof(first));
+    TEST_ASSERT_EQUAL(scatter[1].bufferLength, sent - sizeof(first));
+    TEST_ASSERT_EQUAL_MEMORY(header, first, sizeof(header));
+    TEST_ASSERT_EQUAL_MEMORY(payload, first + sizeof(header), sizeof(first) - sizeof(header));
+    TEST_ASSERT_EQUAL_MEMORY(payload, second, sizeof(payload) - (sizeof(first) - sizeof(header)));
+    TEST_ASSERT_EQUAL_MEMORY(trailer, second + sizeof(payload) - (sizeof(first) - sizeof(header)), sizeof(trailer));
+
+    pal_close(&sock);
+    pal_close(&sock2);
+}
+
+#define PAL_NET_TEST_NETBUF_BLOCK_SIZE 128
+#define PAL_NET_TEST_NETBUF_BLOCKS 3
+#define PAL_NET_TEST_NETBUF_HEADROOM 8
+
+TEST(pal_socket, socketNetBufUDPTest)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palSocket_t sock = 0;
+    palSocket_t sock2 = 0;
+    palNetInterfaceInfo_t interfaceInfo;
+    palSocketAddress_t sender;
+    palSocketLength_t senderLength = sizeof(sender);
+    palMemoryPoolID_t pool = NULLPTR;
+    palNetBuf_t* header = NULL;
+    palNetBuf_t* payload = NULL;
+    palNetBuf_t* received = NULL;
+    palNetBuf_t* blocks[PAL_NET_TEST_NETBUF_BLOCKS];
+    uint8_t* data = NULL;
+    size_t sent = 0;
+    uint32_t index = 0;
+
+    result = pal_osPoolCreate(PAL_NET_TEST_NETBUF_BLOCK_SIZE, PAL_NET_TEST_NETBUF_BLOCKS, &pool);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+
+    memset(&interfaceInfo, 0, sizeof(interfaceInfo));
+    result = pal_getNetInterfaceInfo(0, &interfaceInfo);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_setSockAddrPort(&interfaceInfo.address, PAL_NET_TEST_LOCAL_UDP_PORT);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+
+    result = pal_socket(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, &sock);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_socket(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, &sock2);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_bind(sock, &interfaceInfo.address, interfaceInfo.addressSize);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+
+    result = pal_netBufAlloc(pool, PAL_NET_TEST_NETBUF_BLOCK_SIZE, &payload);
+    TEST_ASSERT_EQUAL(result, PAL_ERR_BUFFER_TOO_SMALL);
+
+    // the payload is written after the headroom, the header goes in front of it without moving it.
+    result = pal_netBufAlloc(pool, PAL_NET_TEST_NETBUF_HEADROOM, &payload);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(payload->size, PAL_NET_TEST_NETBUF_BLOCK_SIZE - PAL_NET_BUF_HEADER_SIZE);
+    result = pal_netBufAppend(payload, PAL_TEST_BUFFER_SIZE, &data);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    memset(data, 'p', PAL_TEST_BUFFER_SIZE);
+    result = pal_netBufPrepend(payload, PAL_NET_TEST_NETBUF_HEADROOM + 1, &data);
+    TEST_ASSERT_EQUAL(result, PAL_ERR_BUFFER_TOO_SMALL);
+    result = pal_netBufPrepend(payload, 2, &data);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    memcpy(data, "ph", 2);
+
+    // an outer header in a buffer of its own is chained in front, the chain leaves as one datagram.
+    result = pal_netBufAlloc(pool, 0, &header);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_netBufAppend(header, 4, &data);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    memcpy(data, "head", 4);
+    result = pal_netBufChain(header, payload);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(pal_netBufChainLength(header), 4 + 2 + PAL_TEST_BUFFER_SIZE);
+    result = pal_netBufSendTo(sock2, header, &interfaceInfo.address, interfaceInfo.addressSize, &sent);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(sent, 4 + 2 + PAL_TEST_BUFFER_SIZE);
+
+    // the datagram lands in a buffer of the pool, the headers are stripped in place.
+    memset(&sender, 0, sizeof(sender));
+    result = pal_netBufReceiveFrom(sock, pool, PAL_NET_TEST_NETBUF_HEADROOM, &sender, &senderLength, &received);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(sender.addressType, PAL_AF_INET);
+    TEST_ASSERT_EQUAL(received->length, sent);
+    TEST_ASSERT_EQUAL_MEMORY("headph", pal_netBufData(received), 6);
+    result = pal_netBufConsume(received, 6);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(received->length, PAL_TEST_BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(pal_netBufData(received)[0], 'p');
+    TEST_ASSERT_EQUAL(pal_netBufData(received)[PAL_TEST_BUFFER_SIZE - 1], 'p');
+
+    // the pool is exhausted while all three are in use.
+    result = pal_netBufAlloc(pool, 0, &blocks[0]);
+    TEST_ASSERT_EQUAL(result, PAL_ERR_NO_MEMORY);
+
+    // a second reference to the payload keeps it when the chain is freed.
+    result = pal_netBufRef(payload);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_netBufFree(&header);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_NULL(header);
+    TEST_ASSERT_EQUAL(payload->refCount, 1);
+    result = pal_netBufFree(&payload);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_netBufFree(&received);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+
+    // every block is back in the pool.
+    for (index = 0; index < PAL_NET_TEST_NETBUF_BLOCKS; ++index)
+    {
+        result = pal_netBufAlloc(pool, 0, &blocks[index]);
+        TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    }
+    for (index = 0; index < PAL_NET_TEST_NETBUF_BLOCKS; ++index)
+    {
+        result = pal_netBufFree(&blocks[index]);
+        TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    }
+
+    pal_close(&sock);
+    pal_close(&sock2);
+    pal_osPoolDestroy(&pool);
+}
+
+#define PAL_NET_TEST_ASYNC_WAIT_MS 1000
+#define PAL_NET_TEST_ASYNC_QUEUE_SIZE 4
+#define PAL_NET_TEST_ASYNC_OVERFLOW_SOCKETS 2
+
+typedef struct socketContextTest{
+    palSocket_t socket;
+    uint8_t events;
+    palSemaphoreID_t semaphore;
+} socketContextTest_t;
+
+static void socketContextCallback(palSocket_t socket, uint8_t events, void* context)
+{
+    socketContextTest_t* test = (socketContextTest_t*)context;
+    test->socket = socket;
+    test->events |= events;
+    pal_osSemaphoreRelease(test->semaphore);
+}
+
+TEST(pal_socket, socketAsyncContextUDPTest)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palSocket_t sock = 0;
+    palSocket_t sock2 = 0;
+    palSocket_t sock3 = 0;
+    palNetInterfaceInfo_t interfaceInfo;
+    palMessageQID_t queue = NULLPTR;
+    palAsyncSocketEvent_t socketEvent;
+    socketContextTest_t direct;
+    socketContextTest_t deferred;
+    palMessageQID_t smallQueue = NULLPTR;
+    palSocket_t overflowSockets[PAL_NET_TEST_ASYNC_OVERFLOW_SOCKETS] = { 0 };
+    socketContextTest_t overflow[PAL_NET_TEST_ASYNC_OVERFLOW_SOCKETS];
+    palSocketAddress_t overflowAddress;
+    char buffer[PAL_TEST_BUFFER_SIZE] = "async";
+    size_t sent = 0;
+    size_t read = 0;
+    int32_t count = 0;
+    uint32_t i = 0;
+
+    memset(&direct, 0, sizeof(direct));
+    memset(&deferred, 0, sizeof(deferred));
+    result = pal_osSemaphoreCreate(0, &direct.semaphore);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_osSemaphoreCreate(0, &deferred.semaphore);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_osMessageQueueCreateTyped(PAL_NET_TEST_ASYNC_QUEUE_SIZE, sizeof(palAsyncSocketEvent_t), &queue);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+
+    memset(&interfaceInfo, 0, sizeof(interfaceInfo));
+    result = pal_getNetInterfaceInfo(0, &interfaceInfo);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_setSockAddrPort(&interfaceInfo.address, PAL_NET_TEST_LOCAL_UDP_PORT);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+
+    result = pal_asynchronousSocketWithContext(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, NULL, &direct, NULLPTR, &sock);
+    TEST_ASSERT_EQUAL(result, PAL_ERR_RTOS_PARAMETER);
+
+    // the callback runs in the callback context of the stack, and is told which socket it serves.
+    result = pal_asynchronousSocketWithContext(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, socketContextCallback, &direct, NULLPTR, &sock);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_socket(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, &sock2);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_bind(sock, &interfaceInfo.address, interfaceInfo.addressSize);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_sendTo(sock2, buffer, sizeof(buffer), &interfaceInfo.address, interfaceInfo.addressSize, &sent);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    do
+    {
+        result = pal_osSemaphoreWait(direct.semaphore, PAL_NET_TEST_ASYNC_WAIT_MS, &count);
+        TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    } while (0 == (direct.events & PAL_NET_SOCKET_SELECT_RX_BIT));
+    TEST_ASSERT_EQUAL(direct.socket, sock);
+    result = pal_receiveFrom(sock, buffer, sizeof(buffer), NULL, NULL, &read);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(read, sent);
+    pal_close(&sock);
+
+    // the events of a deferred socket wait in the queue for a thread of the application.
+    result = pal_asynchronousSocketWithContext(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, socketContextCallback, &deferred, queue, &sock3);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_bind(sock3, &interfaceInfo.address, interfaceInfo.addressSize);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_sendTo(sock2, buffer, sizeof(buffer), &interfaceInfo.address, interfaceInfo.addressSize, &sent);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    do
+    {
+        result = pal_osMessageGetTyped(queue, PAL_NET_TEST_ASYNC_WAIT_MS, &socketEvent);
+        TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+        TEST_ASSERT_EQUAL(socketEvent.socket, sock3);
+        TEST_ASSERT_EQUAL(socketEvent.context, &deferred);
+        TEST_ASSERT_NOT_NULL(socketEvent.callback);
+        socketEvent.callback(socketEvent.socket, socketEvent.events, socketEvent.context);
+    } while (0 == (socketEvent.events & PAL_NET_SOCKET_SELECT_RX_BIT));
+    TEST_ASSERT_EQUAL(deferred.socket, sock3);
+    result = pal_receiveFrom(sock3, buffer, sizeof(buffer), NULL, NULL, &read);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(read, sent);
+    pal_close(&sock3);
+
+    // the events which find a full queue are posted once it has room, not lost until the socket has another event.
+    result = pal_osMessageQueueCreateTyped(1, sizeof(palAsyncSocketEvent_t), &smallQueue);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    memset(overflow, 0, sizeof(overflow));
+    for (i = 0; i < PAL_NET_TEST_ASYNC_OVERFLOW_SOCKETS; ++i)
+    {
+        result = pal_asynchronousSocketWithContext(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, socketContextCallback, &overflow[i], smallQueue, &overflowSockets[i]);
+        TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+        overflowAddress = interfaceInfo.address;
+        result = pal_setSockAddrPort(&overflowAddress, PAL_NET_TEST_LOCAL_UDP_PORT + 1 + i);
+        TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+        result = pal_bind(overflowSockets[i], &overflowAddress, interfaceInfo.addressSize);
+        TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+        result = pal_sendTo(sock2, buffer, sizeof(buffer), &overflowAddress, interfaceInfo.addressSize, &sent);
+        TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    }
+    pal_osDelay(100); // all the events happen before the first one is taken from the queue.
+    for (i = 0; i < PAL_NET_TEST_ASYNC_OVERFLOW_SOCKETS; ++i)
+    {
+        while (0 == (overflow[i].events & PAL_NET_SOCKET_SELECT_RX_BIT))
+        {
+            result = pal_osMessageGetTyped(smallQueue, PAL_NET_TEST_ASYNC_WAIT_MS, &socketEvent);
+            TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+            socketEvent.callback(socketEvent.socket, socketEvent.events, socketEvent.context);
+        }
+        TEST_ASSERT_EQUAL(overflow[i].socket, overflowSockets[i]);
+    }
+    for (i = 0; i < PAL_NET_TEST_ASYNC_OVERFLOW_SOCKETS; ++i)
+    {
+        pal_close(&overflowSockets[i]);
+    }
+    pal_osMessageQueueDestroy(&smallQueue);
+
+    pal_close(&sock2);
+    pal_osMessageQueueDestroy(&queue);
+    pal_osSemaphoreDelete(&direct.semaphore);
+    pal_osSemaphoreDelete(&deferred.semaphore);
+}
+
+#define PAL_NET_TEST_SELECT_SOCKETS 4
+#define PAL_NET_TEST_SELECT_ROUNDS 4
+#define PAL_NET_TEST_SELECT_DATA_SOCKET 1
+
+TEST(pal_socket, socketMiniSelectReadinessUDPTest)
+{
+    palStatus_t result = PAL_SUCCESS;
+    palSocket_t sockets[PAL_NET_SOCKET_SELECT_MAX_SOCKETS] = { 0 };
+    palSocket_t sender = 0;
+    palNetInterfaceInfo_t interfaceInfo;
+    pal_timeVal_t tv = {0};
+    uint8_t palSocketStatus[PAL_NET_SOCKET_SELECT_MAX_SOCKETS] = { 0 };
+    char buffer[PAL_TEST_BUFFER_SIZE] = "ready";
+    uint32_t numSockets = 0;
+    uint32_t round = 0;
+    uint32_t index = 0;
+    uint32_t sentCount = 0;
+    uint32_t selectedCalls = 0;
+    uint32_t selectedWasted = 0;
+    size_t sent = 0;
+    size_t read = 0;
+
+    memset(&interfaceInfo, 0, sizeof(interfaceInfo));
+    result = pal_getNetInterfaceInfo(0, &interfaceInfo);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+
+    result = pal_socket(PAL_AF_INET, PAL_SOCK_DGRAM, false, 0, &sender);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    for (index = 0; index < PAL_NET_TEST_SELECT_SOCKETS; ++index)
+    {
+        result = pal_socket(PAL_AF_INET, PAL_SOCK_DGRAM, true, 0, &sockets[index]);
+        TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+        result = pal_setSockAddrPort(&interfaceInfo.address, PAL_NET_TEST_LOCAL_UDP_PORT + index);
+        TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+        result = pal_bind(sockets[index], &interfaceInfo.address, interfaceInfo.addressSize);
+        TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    }
+
+    // a negative timeout, or one whose microseconds are out of range, is rejected.
+    tv.pal_tv_sec = -1;
+    result = pal_socketMiniSelectInterest(sockets, PAL_NET_TEST_SELECT_SOCKETS, &tv, PAL_NET_SOCKET_SELECT_RX_BIT, palSocketStatus, &numSockets);
+    TEST_ASSERT_EQUAL(result, PAL_ERR_RTOS_PARAMETER);
+    tv.pal_tv_sec = 0;
+    tv.pal_tv_usec = 1000000;
+    result = pal_socketMiniSelectInterest(sockets, PAL_NET_TEST_SELECT_SOCKETS, &tv, PAL_NET_SOCKET_SELECT_RX_BIT, palSocketStatus, &numSockets);
+    TEST_ASSERT_EQUAL(result, PAL_ERR_RTOS_PARAMETER);
+    tv.pal_tv_usec = 0;
+
+    // nothing was sent yet, so no socket is ready to receive.
+    result = pal_socketMiniSelectInterest(sockets, PAL_NET_TEST_SELECT_SOCKETS, &tv, PAL_NET_SOCKET_SELECT_RX_BIT, palSocketStatus, &numSockets);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(numSockets, 0);
+
+    // only the socket with a datagram pending is set, and only for RX.
+    result = pal_setSockAddrPort(&interfaceInfo.address, PAL_NET_TEST_LOCAL_UDP_PORT + PAL_NET_TEST_SELECT_DATA_SOCKET);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_sendTo(sender, buffer, sizeof(buffer), &interfaceInfo.address, interfaceInfo.addressSize, &sent);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    tv.pal_tv_sec = 1;
+    result = pal_socketMiniSelectInterest(sockets, PAL_NET_TEST_SELECT_SOCKETS, &tv, PAL_NET_SOCKET_SELECT_RX_BIT, palSocketStatus, &numSockets);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(numSockets, 1);
+    for (index = 0; index < PAL_NET_TEST_SELECT_SOCKETS; ++index)
+    {
+        TEST_ASSERT_EQUAL_UINT8((PAL_NET_TEST_SELECT_DATA_SOCKET == index) ? PAL_NET_SOCKET_SELECT_RX_BIT : 0, palSocketStatus[index]);
+    }
+
+    // every socket has room to send, so asking for TX sets all of them, and RX is still set for the socket with data only.
+    tv.pal_tv_sec = 0;
+    result = pal_socketMiniSelect(sockets, PAL_NET_TEST_SELECT_SOCKETS, &tv, palSocketStatus, &numSockets);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(numSockets, PAL_NET_TEST_SELECT_SOCKETS);
+    for (index = 0; index < PAL_NET_TEST_SELECT_SOCKETS; ++index)
+    {
+        TEST_ASSERT_TRUE(PAL_NET_SELECT_IS_TX(palSocketStatus, index));
+        TEST_ASSERT_EQUAL((PAL_NET_TEST_SELECT_DATA_SOCKET == index), PAL_NET_SELECT_IS_RX(palSocketStatus, index));
+        TEST_ASSERT_FALSE(PAL_NET_SELECT_IS_ERR(palSocketStatus, index));
+    }
+
+    // once the datagram is received the socket is not ready to receive, and it still has room to send.
+    result = pal_receiveFrom(sockets[PAL_NET_TEST_SELECT_DATA_SOCKET], buffer, sizeof(buffer), NULL, NULL, &read);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    result = pal_receiveFrom(sockets[PAL_NET_TEST_SELECT_DATA_SOCKET], buffer, sizeof(buffer), NULL, NULL, &read);
+    TEST_ASSERT_EQUAL(result, PAL_ERR_SOCKET_WOULD_BLOCK);
+    result = pal_socketMiniSelectInterest(sockets, PAL_NET_TEST_SELECT_SOCKETS, &tv, PAL_NET_SOCKET_SELECT_RX_BIT, palSocketStatus, &numSockets);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(numSockets, 0);
+    result = pal_socketMiniSelectInterest(sockets, PAL_NET_TEST_SELECT_SOCKETS, &tv, PAL_NET_SOCKET_SELECT_TX_BIT, palSocketStatus, &numSockets);
+    TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+    TEST_ASSERT_EQUAL(numSockets, PAL_NET_TEST_SELECT_SOCKETS);
+    for (index = 0; index < PAL_NET_TEST_SELECT_SOCKETS; ++index)
+    {
+        TEST_ASSERT_EQUAL_UINT8(PAL_NET_SOCKET_SELECT_TX_BIT, palSocketStatus[index]);
+    }
+
+    // every round the other half of the sockets gets a datagram, receiving on the sockets set for RX only never finds one which would block.
+    for (round = 0; round < PAL_NET_TEST_SELECT_ROUNDS; ++round)
+    {
+        sentCount = 0;
+        for (index = 0; index < PAL_NET_TEST_SELECT_SOCKETS; ++index)
+        {
+            if (0 == ((index + round) % 2))
+            {
+                result = pal_setSockAddrPort(&interfaceInfo.address, PAL_NET_TEST_LOCAL_UDP_PORT + index);
+                TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+                result = pal_sendTo(sender, buffer, sizeof(buffer), &interfaceInfo.address, interfaceInfo.addressSize, &sent);
+                TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+                ++sentCount;
+            }
+        }
+
+        do
+        {
+            tv.pal_tv_sec = 1;
+            result = pal_socketMiniSelectInterest(sockets, PAL_NET_TEST_SELECT_SOCKETS, &tv, PAL_NET_SOCKET_SELECT_RX_BIT, palSocketStatus, &numSockets);
+            TEST_ASSERT_EQUAL(result, PAL_SUCCESS);
+            TEST_ASSERT(numSockets > 0);
+        } while (numSockets < sentCount);
+        TEST_ASSERT_EQUAL(numSockets, sentCount);
+
+        for (index = 0; index < PAL_NET_TEST_SELECT_SOCKETS; ++index)
+        {
+            if (!PAL_NET_SELECT_IS_RX(palSocketStatus, index))
+            {
+                continue;
+            }
+            result = pal_receiveFrom(sockets[index], buffer, sizeof(buffer), NULL, NULL, &read);
+            ++selectedCalls;
+            selectedWasted += (PAL_ERR_SOCKET_WOULD_BLOCK == result) ? 1 : 0;
+            TEST_ASSERT((PAL_SUCCESS == result) || (PAL_ERR_SOCKET_WOULD_BLOCK == result));
+        }
+    }
+
+    TEST_PRINTF("receive calls after select: %u wasted of %u\r\n", (unsigned)selectedWasted, (unsigned)selectedCalls);
+    TEST_ASSERT_EQUAL(selectedWasted, 0);
+
+    for (index = 0; index < PAL_NET_TEST_SELECT_SOCKETS; ++index)
+    {
+        pal_close(&sockets[index]);
+    }
+    pal_close(&sender);
+}
@@ -0,0 +1,37 @@
+/*
+* Copyright (c) 2016 ARM Limited. All rights reserved.
+* SPDX-License-Identifier: Apache-2.0
+* Licensed under the Apache License, Version 2.0 (the License); you may
+* not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an AS IS BASIS, WITHOUT
+* WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include <stdio.h>
+
+int UnityMain(int argc, const char* argv[], void (*runAllTests)(void));
+
+void TEST_pal_socket_GROUP_RUNNER(void);
+
+int main(int argc, const char * argv[])
+{
+    const char * myargv[] = {"app","-v"};
+    int failures = 0;
+
+    printf("Start tests\n");
+    fflush(stdout);
+
+    failures = UnityMain(sizeof(myargv)/sizeof(myargv[0]), myargv, TEST_pal_socket_GROUP_RUNNER);
+
+    // This is detected by test runner app, so that it can know when to terminate without waiting for timeout.
+    printf("***END OF TESTS**\n");
+    fflush(stdout);
+    return failures;
+}
@@ -42,6 +42,24 @@ TEST_GROUP_RUNNER(pal_socket)
 #if (PAL_INCLUDE || basicSocketScenario5)
     RUN_TEST_CASE(pal_socket, basicSocketScenario5);
 #endif
+#if (PAL_INCLUDE || socketPollerUDPTest)
+    RUN_TEST_CASE(pal_socket, socketPollerUDPTest);
+#endif
+#if (PAL_INCLUDE || socketMultiDatagramUDPTest)
+    RUN_TEST_CASE(pal_socket, socketMultiDatagramUDPTest);
+#endif
+#if (PAL_INCLUDE || socketScatterGatherUDPTest)
+    RUN_TEST_CASE(pal_socket, socketScatterGatherUDPTest);
+#endif
+#if (PAL_INCLUDE || socketNetBufUDPTest)
+    RUN_TEST_CASE(pal_socket, socketNetBufUDPTest);
+#endif
+#if (PAL_INCLUDE || socketAsyncContextUDPTest)
+    RUN_TEST_CASE(pal_socket, socketAsyncContextUDPTest);
+#endif
+#if (PAL_INCLUDE || socketMiniSelectReadinessUDPTest)
+    RUN_TEST_CASE(pal_socket, socketMiniSelectReadinessUDPTest);
+#endif
 }
 
 // Each of these should be in a separate file.
@@ -34,16 +34,23 @@ $(OUTOBJ):
 	$(MKDIR_QUIET) $@
 
 
+# The mbedOS port is C++, ports for other platforms are plain C.
+ifeq ($(TARGET_PLATFORM),mbedOS)
+PLAT_SRC_EXT:=cpp
+else
+PLAT_SRC_EXT:=c
+endif
+
 INIT_SRC    = $(PAL_ROOT)/Source/PAL-Impl/pal_init.c
 
 RTOS_SRC    = $(PAL_ROOT)/Source/PAL-Impl/Modules/RTOS/pal_rtos.c \
-			        $(PAL_ROOT)/Source/Port/Reference-Impl/$(TARGET_PLATFORM)/RTOS/pal_plat_rtos.cpp \
+			        $(PAL_ROOT)/Source/Port/Reference-Impl/$(TARGET_PLATFORM)/RTOS/pal_plat_rtos.$(PLAT_SRC_EXT) \
 
 SOCKET_SRC  = $(PAL_ROOT)/Source/PAL-Impl/Modules/Networking/pal_network.c \
-			        $(PAL_ROOT)/Source/Port/Reference-Impl/$(TARGET_PLATFORM)/Networking/pal_plat_network.cpp
+			        $(PAL_ROOT)/Source/Port/Reference-Impl/$(TARGET_PLATFORM)/Networking/pal_plat_network.$(PLAT_SRC_EXT)
 
 UPDATE_SRC  = $(PAL_ROOT)/Source/PAL-Impl/Modules/Update/pal_update.c \
-			        $(PAL_ROOT)/Source/Port/Reference-Impl/$(TARGET_PLATFORM)/Update/pal_plat_update.cpp
+			        $(PAL_ROOT)/Source/Port/Reference-Impl/$(TARGET_PLATFORM)/Update/pal_plat_update.$(PLAT_SRC_EXT)
 
 CFSTORE_SRC = $(PAL_ROOT)/Source/PAL-Impl/Modules/CFStore/pal_cfstore.c \
 			 		$(PAL_ROOT)/Source/Port/Reference-Impl/$(TARGET_PLATFORM)/CFStore/pal_plat_cfstore.c \